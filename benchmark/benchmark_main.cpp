@@ -0,0 +1,42 @@
+/**
+ * @file benchmark_main.cpp
+ * @brief Runs the benchmarks of the UI components without a display
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <benchmark/benchmark.h>
+#include <QGuiApplication>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+/**
+ * Models and scenes need an application but no display, the benchmarks run on machines without one. Pass
+ * --benchmark_out=<file> --benchmark_out_format=json to record results for tracking over time, the
+ * tesseract_gui_run_benchmarks target does that.
+ */
+int main(int argc, char** argv)
+{
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+
+  QGuiApplication app(argc, argv);
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file collision_benchmarks.cpp
+ * @brief Benchmarks of the contact result table
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <benchmark/benchmark.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/collision/contact_results_model.h>
+#include "synthetic_workcell.h"
+
+namespace tesseract_gui
+{
+namespace
+{
+constexpr std::size_t LINK_PAIR_COUNT = 100;
+
+/** @brief Show a new set of contact results in the table */
+void BM_ContactResultsModelSetContactResults(benchmark::State& state)
+{
+  const ContactResults::ConstPtr results =
+      createSyntheticContactResults(static_cast<std::size_t>(state.range(0)), LINK_PAIR_COUNT);
+
+  ContactResultsModel model;
+  for (auto _ : state)
+  {
+    model.setContactResults(results);
+    benchmark::DoNotOptimize(model.rowCount());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+/** @brief Alternate between two distance thresholds, as when dragging the threshold slider */
+void BM_ContactResultsModelDistanceFilter(benchmark::State& state)
+{
+  ContactResultsModel model;
+  model.setContactResults(createSyntheticContactResults(static_cast<std::size_t>(state.range(0)), LINK_PAIR_COUNT));
+
+  bool tight{ false };
+  for (auto _ : state)
+  {
+    tight = !tight;
+    model.setDistanceThreshold(tight ? 0.0 : 0.025);
+    benchmark::DoNotOptimize(model.rowCount());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+/** @brief Toggle the visibility of a link pair, as when unchecking a pair in the link pair list */
+void BM_ContactResultsModelLinkPairFilter(benchmark::State& state)
+{
+  ContactResultsModel model;
+  model.setContactResults(createSyntheticContactResults(static_cast<std::size_t>(state.range(0)), LINK_PAIR_COUNT));
+
+  bool visible{ true };
+  for (auto _ : state)
+  {
+    visible = !visible;
+    model.setLinkPairVisible(0, visible);
+    benchmark::DoNotOptimize(model.rowCount());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+}  // namespace
+
+BENCHMARK(BM_ContactResultsModelSetContactResults)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity();
+BENCHMARK(BM_ContactResultsModelDistanceFilter)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity();
+BENCHMARK(BM_ContactResultsModelLinkPairFilter)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity();
+
+}  // namespace tesseract_gui
@@ -0,0 +1,102 @@
+/**
+ * @file joint_trajectory_benchmarks.cpp
+ * @brief Benchmarks of trajectory playback
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/joint_trajectory/trajectory_player.h>
+#include "synthetic_workcell.h"
+
+namespace tesseract_gui
+{
+namespace
+{
+constexpr std::size_t LINK_COUNT = 8;
+
+/** @brief The number of seek times cycled through */
+constexpr std::size_t SEEK_COUNT = 1024;
+
+/** @brief The timeline of the last requested size, a million waypoints take seconds to create and a few hundred MB */
+TrajectoryTimeline::ConstPtr getTimeline(std::size_t waypoint_count)
+{
+  static TrajectoryTimeline::ConstPtr timeline;
+  if (timeline == nullptr || timeline->getWaypointCount() != waypoint_count)
+  {
+    timeline = nullptr;
+    timeline = createSyntheticTimeline(waypoint_count, LINK_COUNT);
+  }
+  return timeline;
+}
+
+std::vector<double> createSeekTimes(double duration)
+{
+  std::mt19937 random(42);
+  std::uniform_real_distribution<double> distribution(0, duration);
+  std::vector<double> times(SEEK_COUNT);
+  for (auto& time : times)
+    time = distribution(random);
+  return times;
+}
+
+/** @brief Seek to random times, each seek interpolates every link and updates the scene */
+void BM_TrajectoryPlayerSeek(benchmark::State& state)
+{
+  const TrajectoryTimeline::ConstPtr timeline = getTimeline(static_cast<std::size_t>(state.range(0)));
+
+  auto scene = std::make_shared<RenderScene>();
+  for (const auto& link_name : timeline->getLinkNames())
+    scene->addLink(link_name);
+
+  TrajectoryPlayer player;
+  player.setScene(scene);
+  player.setTimeline(timeline);
+
+  const std::vector<double> times = createSeekTimes(timeline->getDuration());
+  std::size_t i{ 0 };
+  for (auto _ : state)
+  {
+    player.seek(times[i++ % times.size()]);
+    benchmark::DoNotOptimize(scene->getLinkTransforms().data());
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+/** @brief Locate the waypoints around random times, the part of a seek that depends on the trajectory length */
+void BM_TrajectoryTimelineLocate(benchmark::State& state)
+{
+  const TrajectoryTimeline::ConstPtr timeline = getTimeline(static_cast<std::size_t>(state.range(0)));
+  const std::vector<double> times = createSeekTimes(timeline->getDuration());
+
+  std::size_t i{ 0 };
+  for (auto _ : state)
+    benchmark::DoNotOptimize(timeline->locate(times[i++ % times.size()]));
+
+  state.SetComplexityN(state.range(0));
+}
+}  // namespace
+
+BENCHMARK(BM_TrajectoryPlayerSeek)->RangeMultiplier(10)->Range(1000, 1000000)->Complexity(benchmark::oLogN);
+BENCHMARK(BM_TrajectoryTimelineLocate)->RangeMultiplier(10)->Range(1000, 1000000)->Complexity(benchmark::oLogN);
+
+}  // namespace tesseract_gui
@@ -0,0 +1,145 @@
+/**
+ * @file render_benchmarks.cpp
+ * @brief Benchmarks of the render scene
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <Eigen/Core>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_environment/environment.h>
+#include <tesseract_gui/render/render_scene.h>
+#include "synthetic_workcell.h"
+
+namespace tesseract_gui
+{
+namespace
+{
+/** @brief The number of joint configurations cycled through, so consecutive updates always move every joint */
+constexpr std::size_t CONFIGURATION_COUNT = 64;
+
+std::vector<Eigen::VectorXd> createConfigurations(std::size_t joint_count)
+{
+  std::mt19937 random(42);
+  std::uniform_real_distribution<double> distribution(-M_PI, M_PI);
+  std::vector<Eigen::VectorXd> configurations(CONFIGURATION_COUNT, Eigen::VectorXd(joint_count));
+  for (auto& configuration : configurations)
+  {
+    for (Eigen::Index j = 0; j < configuration.size(); ++j)
+      configuration[j] = distribution(random);
+  }
+  return configurations;
+}
+
+/** @brief Build the render objects of a scene graph, meshes come from the warm mesh cache after the first iteration */
+void BM_RenderSceneLoadSceneGraph(benchmark::State& state)
+{
+  const auto link_count = static_cast<std::size_t>(state.range(0));
+  const tesseract_scene_graph::SceneGraph::Ptr scene_graph = createSyntheticSceneGraph(link_count);
+
+  RenderScene scene;
+  for (auto _ : state)
+  {
+    scene.loadSceneGraph(*scene_graph);
+    benchmark::DoNotOptimize(scene.getObjects().data());
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+/** @brief Forward kinematics of every joint followed by the batched link transform update of the scene */
+void BM_ForwardKinematicsBatchUpdate(benchmark::State& state)
+{
+  const auto link_count = static_cast<std::size_t>(state.range(0));
+  const tesseract_scene_graph::SceneGraph::Ptr scene_graph = createSyntheticSceneGraph(link_count);
+  tesseract_environment::Environment environment;
+  if (!environment.init(*scene_graph))
+  {
+    state.SkipWithError("Failed to initialize the environment");
+    return;
+  }
+
+  const tesseract_scene_graph::StateSolver::UPtr solver = environment.getStateSolver();
+  const std::vector<std::string> joint_names = getSyntheticJointNames(link_count);
+  const std::vector<Eigen::VectorXd> configurations = createConfigurations(joint_names.size());
+
+  RenderScene scene;
+  scene.loadSceneGraph(*scene_graph);
+
+  std::size_t i{ 0 };
+  for (auto _ : state)
+  {
+    scene.updateLinkTransforms(solver->getState(joint_names, configurations[i++ % configurations.size()]));
+    benchmark::DoNotOptimize(scene.getLinkTransforms().data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+/** @brief Only the batched link transform update of the scene from already solved states */
+void BM_RenderSceneUpdateLinkTransforms(benchmark::State& state)
+{
+  const auto link_count = static_cast<std::size_t>(state.range(0));
+  const tesseract_scene_graph::SceneGraph::Ptr scene_graph = createSyntheticSceneGraph(link_count);
+  tesseract_environment::Environment environment;
+  if (!environment.init(*scene_graph))
+  {
+    state.SkipWithError("Failed to initialize the environment");
+    return;
+  }
+
+  const tesseract_scene_graph::StateSolver::UPtr solver = environment.getStateSolver();
+  const std::vector<std::string> joint_names = getSyntheticJointNames(link_count);
+  std::vector<tesseract_scene_graph::SceneState> states;
+  for (const auto& configuration : createConfigurations(joint_names.size()))
+    states.push_back(solver->getState(joint_names, configuration));
+
+  RenderScene scene;
+  scene.loadSceneGraph(*scene_graph);
+
+  std::size_t i{ 0 };
+  for (auto _ : state)
+  {
+    scene.updateLinkTransforms(states[i++ % states.size()]);
+    benchmark::DoNotOptimize(scene.getLinkTransforms().data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+}  // namespace
+
+BENCHMARK(BM_RenderSceneLoadSceneGraph)
+    ->RangeMultiplier(10)
+    ->Range(100, 10000)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity();
+BENCHMARK(BM_ForwardKinematicsBatchUpdate)
+    ->RangeMultiplier(10)
+    ->Range(100, 10000)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity();
+BENCHMARK(BM_RenderSceneUpdateLinkTransforms)
+    ->RangeMultiplier(10)
+    ->Range(100, 10000)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity();
+
+}  // namespace tesseract_gui
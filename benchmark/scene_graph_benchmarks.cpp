@@ -0,0 +1,86 @@
+/**
+ * @file scene_graph_benchmarks.cpp
+ * @brief Benchmarks of the scene graph model
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <memory>
+#include <benchmark/benchmark.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/scene_graph/scene_graph_model.h>
+#include "synthetic_workcell.h"
+
+namespace tesseract_gui
+{
+namespace
+{
+/** @brief Reset the model to a scene graph, the tree is populated lazily so this is the cost of opening a workcell */
+void BM_SceneGraphModelSetSceneGraph(benchmark::State& state)
+{
+  const auto link_count = static_cast<std::size_t>(state.range(0));
+  const tesseract_scene_graph::SceneGraph::ConstPtr scene_graph = createSyntheticSceneGraph(link_count);
+
+  SceneGraphModel model;
+  for (auto _ : state)
+  {
+    model.setSceneGraph(scene_graph);
+    benchmark::DoNotOptimize(model.rowCount());
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+/** @brief Add and remove a link and its joint, as applied for environment commands */
+void BM_SceneGraphModelIncrementalUpdate(benchmark::State& state)
+{
+  const auto link_count = static_cast<std::size_t>(state.range(0));
+  const tesseract_scene_graph::SceneGraph::ConstPtr scene_graph = createSyntheticSceneGraph(link_count);
+
+  SceneGraphModel model;
+  model.setSceneGraph(scene_graph);
+
+  auto link = std::make_shared<tesseract_scene_graph::Link>("added_link");
+  auto joint = std::make_shared<tesseract_scene_graph::Joint>("added_joint");
+  joint->type = tesseract_scene_graph::JointType::FIXED;
+  joint->parent_link_name = scene_graph->getRoot();
+  joint->child_link_name = link->getName();
+
+  for (auto _ : state)
+  {
+    model.addLink(link);
+    model.addJoint(joint);
+    model.removeJoint(joint->getName());
+    model.removeLink(link->getName());
+  }
+
+  state.SetItemsProcessed(state.iterations() * 4);
+  state.SetComplexityN(state.range(0));
+}
+}  // namespace
+
+BENCHMARK(BM_SceneGraphModelSetSceneGraph)
+    ->RangeMultiplier(10)
+    ->Range(100, 10000)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity();
+BENCHMARK(BM_SceneGraphModelIncrementalUpdate)
+    ->RangeMultiplier(10)
+    ->Range(100, 10000)
+    ->Unit(benchmark::kMicrosecond)
+    ->Complexity();
+
+}  // namespace tesseract_gui
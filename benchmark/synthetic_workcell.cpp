@@ -0,0 +1,222 @@
+/**
+ * @file synthetic_workcell.cpp
+ * @brief Synthetic scene graphs, trajectories and contact results for the benchmarks
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <array>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <Eigen/Geometry>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_common/types.h>
+#include <tesseract_geometry/geometries.h>
+#include <tesseract_scene_graph/joint.h>
+#include <tesseract_scene_graph/link.h>
+#include <tesseract_scene_graph/scene_state.h>
+#include "synthetic_workcell.h"
+
+namespace tesseract_gui
+{
+namespace
+{
+/** @brief The number of links of each serial chain, the first is fixed to the base */
+constexpr std::size_t CHAIN_LENGTH = 8;
+
+/** @brief The number of joints of a synthetic trajectory */
+constexpr std::size_t TRAJECTORY_JOINT_COUNT = 6;
+
+/** @brief A UV sphere of 2 * segments * segments triangles */
+tesseract_geometry::Mesh::Ptr createSphereMesh(int segments)
+{
+  auto vertices = std::make_shared<tesseract_common::VectorVector3d>();
+  vertices->reserve(static_cast<std::size_t>((segments + 1) * (segments + 1)));
+  for (int i = 0; i <= segments; ++i)
+  {
+    const double theta = M_PI * i / segments;
+    for (int j = 0; j <= segments; ++j)
+    {
+      const double phi = 2.0 * M_PI * j / segments;
+      vertices->emplace_back(
+          0.05 * std::sin(theta) * std::cos(phi), 0.05 * std::sin(theta) * std::sin(phi), 0.05 * std::cos(theta));
+    }
+  }
+
+  // Faces are stored as the vertex count of the face followed by its vertex indices
+  auto faces = std::make_shared<Eigen::VectorXi>(8 * segments * segments);
+  Eigen::Index f{ 0 };
+  for (int i = 0; i < segments; ++i)
+  {
+    for (int j = 0; j < segments; ++j)
+    {
+      const int a = (i * (segments + 1)) + j;
+      const int b = a + segments + 1;
+      (*faces).segment<4>(f) << 3, a, b, a + 1;
+      (*faces).segment<4>(f + 4) << 3, a + 1, b, b + 1;
+      f += 8;
+    }
+  }
+
+  return std::make_shared<tesseract_geometry::Mesh>(vertices, faces);
+}
+
+tesseract_geometry::Geometry::ConstPtr createGeometry(std::size_t link)
+{
+  // Meshes of four resolutions shared between links, like the repeated parts of a real workcell
+  static const std::array<tesseract_geometry::Mesh::ConstPtr, 4> meshes{
+    createSphereMesh(8), createSphereMesh(16), createSphereMesh(32), createSphereMesh(64)
+  };
+
+  switch (link % 7)
+  {
+    case 0:
+      return std::make_shared<tesseract_geometry::Box>(0.1, 0.1, 0.2);
+    case 1:
+      return std::make_shared<tesseract_geometry::Cylinder>(0.05, 0.2);
+    case 2:
+      return std::make_shared<tesseract_geometry::Sphere>(0.05);
+    default:
+      return meshes[link % meshes.size()];
+  }
+}
+
+Eigen::Isometry3d getLinkTransform(std::size_t link, double time)
+{
+  Eigen::Isometry3d transform = Eigen::Isometry3d::Identity();
+  const double phase = static_cast<double>(link) * 0.3;
+  transform.translation() = Eigen::Vector3d(std::cos(time + phase), std::sin(time + phase), phase);
+  transform.linear() = Eigen::AngleAxisd(time + phase, Eigen::Vector3d::UnitZ()).toRotationMatrix();
+  return transform;
+}
+}  // namespace
+
+tesseract_scene_graph::SceneGraph::Ptr createSyntheticSceneGraph(std::size_t link_count)
+{
+  auto scene_graph = std::make_shared<tesseract_scene_graph::SceneGraph>("synthetic_workcell");
+  scene_graph->addLink(tesseract_scene_graph::Link("base_link"));
+
+  // The chains stand on a square grid
+  const auto chain_count = (link_count + CHAIN_LENGTH - 1) / CHAIN_LENGTH;
+  const auto grid_size = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(chain_count))));
+  for (std::size_t i = 1; i < link_count; ++i)
+  {
+    tesseract_scene_graph::Link link("link_" + std::to_string(i));
+    auto visual = std::make_shared<tesseract_scene_graph::Visual>();
+    visual->geometry = createGeometry(i);
+    link.visual.push_back(visual);
+
+    auto collision = std::make_shared<tesseract_scene_graph::Collision>();
+    collision->geometry = visual->geometry;
+    link.collision.push_back(collision);
+    scene_graph->addLink(link);
+
+    tesseract_scene_graph::Joint joint("joint_" + std::to_string(i));
+    joint.child_link_name = link.getName();
+    const std::size_t position = (i - 1) % CHAIN_LENGTH;
+    if (position == 0)
+    {
+      const std::size_t chain = (i - 1) / CHAIN_LENGTH;
+      joint.type = tesseract_scene_graph::JointType::FIXED;
+      joint.parent_link_name = "base_link";
+      joint.parent_to_joint_origin_transform.translation() = Eigen::Vector3d(
+          static_cast<double>(chain % grid_size), static_cast<double>(chain / grid_size), 0);
+    }
+    else
+    {
+      joint.type = tesseract_scene_graph::JointType::REVOLUTE;
+      joint.parent_link_name = "link_" + std::to_string(i - 1);
+      joint.parent_to_joint_origin_transform.translation() = Eigen::Vector3d(0, 0, 0.2);
+      joint.axis = (position % 2 == 0) ? Eigen::Vector3d::UnitZ() : Eigen::Vector3d::UnitY();
+      joint.limits = std::make_shared<tesseract_scene_graph::JointLimits>();
+      joint.limits->lower = -M_PI;
+      joint.limits->upper = M_PI;
+      joint.limits->velocity = 2.0;
+    }
+    scene_graph->addJoint(joint);
+  }
+
+  return scene_graph;
+}
+
+std::vector<std::string> getSyntheticJointNames(std::size_t link_count)
+{
+  std::vector<std::string> joint_names;
+  for (std::size_t i = 1; i < link_count; ++i)
+  {
+    if ((i - 1) % CHAIN_LENGTH != 0)
+      joint_names.push_back("joint_" + std::to_string(i));
+  }
+  return joint_names;
+}
+
+TrajectoryTimeline::Ptr createSyntheticTimeline(std::size_t waypoint_count, std::size_t link_count)
+{
+  std::vector<std::string> link_names;
+  link_names.reserve(link_count);
+  for (std::size_t i = 0; i < link_count; ++i)
+    link_names.push_back("link_" + std::to_string(i));
+
+  auto timeline = std::make_shared<TrajectoryTimeline>(link_names);
+
+  tesseract_common::JointState waypoint;
+  for (std::size_t j = 0; j < TRAJECTORY_JOINT_COUNT; ++j)
+    waypoint.joint_names.push_back("joint_" + std::to_string(j));
+  waypoint.position.resize(static_cast<Eigen::Index>(TRAJECTORY_JOINT_COUNT));
+
+  tesseract_scene_graph::SceneState state;
+  for (std::size_t w = 0; w < waypoint_count; ++w)
+  {
+    waypoint.time = 0.01 * static_cast<double>(w);
+    for (Eigen::Index j = 0; j < waypoint.position.size(); ++j)
+      waypoint.position[j] = std::sin(waypoint.time + static_cast<double>(j));
+
+    for (std::size_t i = 0; i < link_count; ++i)
+      state.link_transforms[link_names[i]] = getLinkTransform(i, waypoint.time);
+
+    timeline->append(waypoint, state);
+  }
+
+  return timeline;
+}
+
+ContactResults::Ptr createSyntheticContactResults(std::size_t contact_count, std::size_t link_pair_count)
+{
+  std::mt19937 random(42);
+  std::uniform_int_distribution<std::size_t> pair_distribution(0, link_pair_count - 1);
+  std::uniform_real_distribution<double> distance_distribution(-0.05, 0.05);
+  std::uniform_real_distribution<double> point_distribution(-1.0, 1.0);
+
+  auto results = std::make_shared<ContactResults>();
+  tesseract_collision::ContactResult contact;
+  for (std::size_t i = 0; i < contact_count; ++i)
+  {
+    const std::size_t pair = pair_distribution(random);
+    contact.link_names[0] = "link_" + std::to_string(pair);
+    contact.link_names[1] = "link_" + std::to_string(pair + 1);
+    contact.distance = distance_distribution(random);
+    contact.nearest_points[0] =
+        Eigen::Vector3d(point_distribution(random), point_distribution(random), point_distribution(random));
+    contact.normal = Eigen::Vector3d(point_distribution(random), point_distribution(random), 1.0).normalized();
+    contact.nearest_points[1] = contact.nearest_points[0] - (contact.distance * contact.normal);
+    results->add(contact);
+  }
+
+  return results;
+}
+
+}  // namespace tesseract_gui
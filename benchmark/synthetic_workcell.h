@@ -0,0 +1,59 @@
+/**
+ * @file synthetic_workcell.h
+ * @brief Synthetic scene graphs, trajectories and contact results for the benchmarks
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_BENCHMARK_SYNTHETIC_WORKCELL_H
+#define TESSERACT_GUI_BENCHMARK_SYNTHETIC_WORKCELL_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cstddef>
+#include <string>
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_scene_graph/graph.h>
+#include <tesseract_gui/collision/contact_results.h>
+#include <tesseract_gui/joint_trajectory/trajectory_timeline.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief Create a workcell of several serial chains with revolute joints
+ *
+ * Every link has a visual and a collision geometry. The geometry cycles through boxes, cylinders, spheres and
+ * triangle meshes of 128 to 8192 triangles, so the render benchmarks see a mix of small and large meshes. The
+ * result only depends on the link count.
+ */
+tesseract_scene_graph::SceneGraph::Ptr createSyntheticSceneGraph(std::size_t link_count);
+
+/** @brief The names of the movable joints of createSyntheticSceneGraph(), in order */
+std::vector<std::string> getSyntheticJointNames(std::size_t link_count);
+
+/**
+ * @brief Create a timeline of smoothly moving links with a waypoint every 10 ms
+ *
+ * The transforms are generated directly instead of by forward kinematics, so even a million waypoints are created
+ * in seconds.
+ */
+TrajectoryTimeline::Ptr createSyntheticTimeline(std::size_t waypoint_count, std::size_t link_count);
+
+/** @brief Create contacts distributed over a number of link pairs with distances uniform in [-0.05, 0.05] */
+ContactResults::Ptr createSyntheticContactResults(std::size_t contact_count, std::size_t link_pair_count);
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_BENCHMARK_SYNTHETIC_WORKCELL_H
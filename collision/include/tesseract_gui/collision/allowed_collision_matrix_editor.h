@@ -0,0 +1,103 @@
+/**
+ * @file allowed_collision_matrix_editor.h
+ * @brief Editor widget for the allowed collision matrix of an environment
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_COLLISION_ALLOWED_COLLISION_MATRIX_EDITOR_H
+#define TESSERACT_GUI_COLLISION_ALLOWED_COLLISION_MATRIX_EDITOR_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <QWidget>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_environment/environment.h>
+
+class QComboBox;
+class QLabel;
+class QLineEdit;
+class QProgressBar;
+class QPushButton;
+class QSpinBox;
+class QTableView;
+
+namespace tesseract_gui
+{
+class AllowedCollisionMatrixGenerator;
+class AllowedCollisionMatrixModel;
+
+/**
+ * @brief A filterable, sortable table of the allowed link pairs of an environment with add and remove controls
+ *
+ * Edits are collected in the model and applied to the environment with a single command when "Apply" is pressed.
+ * The table uses fixed row heights so views stay responsive with hundreds of thousands of pairs.
+ *
+ * "Generate" samples the environment with an AllowedCollisionMatrixGenerator and streams the pairs it classifies into
+ * the model as pending changes while it runs.
+ */
+class AllowedCollisionMatrixEditor : public QWidget
+{
+  Q_OBJECT
+
+public:
+  explicit AllowedCollisionMatrixEditor(QWidget* parent = nullptr);
+
+  /** @brief Edit the allowed collision matrix of an environment, pending changes are discarded */
+  void setEnvironment(tesseract_environment::Environment::Ptr environment);
+  tesseract_environment::Environment::Ptr getEnvironment() const;
+
+  AllowedCollisionMatrixModel* getModel() const;
+  AllowedCollisionMatrixGenerator* getGenerator() const;
+
+public Q_SLOTS:
+  /** @brief Reload the allowed collision matrix from the environment, pending changes are discarded */
+  void reload();
+
+  /** @brief Apply the pending changes to the environment */
+  void apply();
+
+  /** @brief Generate allowed pairs of the environment with the sample count and seed of the editor */
+  void generate();
+
+private:
+  tesseract_environment::Environment::Ptr environment_;
+  AllowedCollisionMatrixModel* model_;
+  AllowedCollisionMatrixGenerator* generator_;
+  QLineEdit* filter_edit_;
+  QTableView* table_view_;
+  QComboBox* link_a_combo_box_;
+  QComboBox* link_b_combo_box_;
+  QLineEdit* reason_edit_;
+  QPushButton* add_button_;
+  QPushButton* remove_button_;
+  QPushButton* apply_button_;
+  QPushButton* reload_button_;
+  QLabel* status_label_;
+  QSpinBox* sample_count_spin_box_;
+  QSpinBox* seed_spin_box_;
+  QPushButton* generate_button_;
+  QPushButton* cancel_button_;
+  QProgressBar* progress_bar_;
+
+  void onAddClicked();
+  void onRemoveClicked();
+  void updateLinkNames();
+  void updateStatus();
+  void onGenerationFinished(bool cancelled);
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_COLLISION_ALLOWED_COLLISION_MATRIX_EDITOR_H
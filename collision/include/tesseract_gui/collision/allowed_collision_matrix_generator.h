@@ -0,0 +1,201 @@
+/**
+ * @file allowed_collision_matrix_generator.h
+ * @brief Generates a default allowed collision matrix by sampling joint states on a thread pool
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_COLLISION_ALLOWED_COLLISION_MATRIX_GENERATOR_H
+#define TESSERACT_GUI_COLLISION_ALLOWED_COLLISION_MATRIX_GENERATOR_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_collision/core/discrete_contact_manager.h>
+#include <tesseract_environment/environment.h>
+#include <tesseract_gui/collision/allowed_collision_matrix_model.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief Samples random joint states and allows the link pairs which are adjacent, never or always in contact
+ *
+ * The samples are split into batches which the threads of a pool take in turn. Every thread owns a clone of the
+ * contact manager and the state solver and counts the contacts per link pair of its batches, the counts are summed
+ * when a batch is done.
+ *
+ * The joint values of a sample only depend on the seed and the sample index, and a sum does not depend on the order
+ * of its terms, so the result of a completed run is the same as a serial run with the same seed and sample count.
+ *
+ * While running, the pairs classified by the samples completed so far are reported periodically as edits relative to
+ * the previous report, e.g. for AllowedCollisionMatrixModel::modify(). The first report waits for
+ * Settings::stable_sample_count samples, after few samples nearly every pair would be reported as never in contact.
+ * Afterwards a pair can only lose its classification, the threads collect these pairs so a report does not visit
+ * every pair. A pair reported as never or always in contact is removed again once a later sample contradicts it.
+ *
+ * Pairs which were already allowed when generation started (e.g. by the SRDF or the user) are sampled like all others
+ * but never reported, so their reasons are neither overwritten nor removed.
+ */
+class AllowedCollisionMatrixGenerator : public QObject
+{
+  Q_OBJECT
+
+public:
+  struct Settings
+  {
+    /** @brief The number of random joint states */
+    std::size_t sample_count{ 10000 };
+
+    /** @brief The seed of the joint states */
+    std::uint64_t seed{ 0 };
+
+    /** @brief The number of threads, zero for the hardware concurrency */
+    std::size_t thread_count{ 0 };
+
+    /** @brief Pairs closer than this distance count as in contact */
+    double contact_distance{ 0 };
+
+    /** @brief The number of samples before pairs are reported, all samples if there are fewer */
+    std::size_t stable_sample_count{ 1000 };
+  };
+
+  static const std::string ADJACENT_REASON;
+  static const std::string NEVER_REASON;
+  static const std::string ALWAYS_REASON;
+
+  explicit AllowedCollisionMatrixGenerator(QObject* parent = nullptr);
+
+  /** @brief Cancels and waits for a running generation */
+  ~AllowedCollisionMatrixGenerator() override;
+  AllowedCollisionMatrixGenerator(const AllowedCollisionMatrixGenerator&) = delete;
+  AllowedCollisionMatrixGenerator& operator=(const AllowedCollisionMatrixGenerator&) = delete;
+  AllowedCollisionMatrixGenerator(AllowedCollisionMatrixGenerator&&) = delete;
+  AllowedCollisionMatrixGenerator& operator=(AllowedCollisionMatrixGenerator&&) = delete;
+
+  /**
+   * @brief Start generating for an environment, a running generation is cancelled first
+   *
+   * The contact manager and state solver are cloned, the environment is not referenced afterwards.
+   * The current allowed collision matrix of the environment is ignored while sampling.
+   *
+   * @param environment The environment to sample
+   * @param settings The settings of the generation
+   * @param existing The pairs already allowed, e.g. the entries of the model the edits are applied to, which are
+   * left unchanged
+   */
+  void start(const tesseract_environment::Environment& environment,
+             const Settings& settings,
+             const tesseract_scene_graph::AllowedCollisionMatrix& existing = {});
+
+  bool isRunning() const;
+
+  /** @brief The number of samples whose contacts are included in the reported pairs */
+  std::size_t getCompletedSampleCount() const;
+  std::size_t getSampleCount() const;
+
+  /** @brief The pairs allowed by the samples reported so far, without the pairs which were already allowed */
+  std::vector<AllowedCollisionEdit> getAllowedCollisions() const;
+
+  /** @brief Set the interval in which progress and intermediate pairs are reported, defaults to 100 ms */
+  void setReportInterval(int msec);
+  int getReportInterval() const;
+
+public Q_SLOTS:
+  /** @brief Stop reporting and stop the threads after their running batches, the pairs reported so far are kept */
+  void cancel();
+
+Q_SIGNALS:
+  void progressChanged(std::size_t completed, std::size_t total);
+
+  /** @brief The pairs whose classification changed since the previous report */
+  void allowedCollisionsChanged(const std::vector<tesseract_gui::AllowedCollisionEdit>& edits);
+
+  /** @brief All threads stopped, cancelled is false when all samples were completed */
+  void finished(bool cancelled);
+
+  /** @brief Sampling threw, the generation is stopped */
+  void generationFailed(const QString& message);
+
+private:
+  enum class Classification : std::uint8_t
+  {
+    NONE,
+    ADJACENT,
+    NEVER,
+    ALWAYS,
+
+    /** @brief Allowed before generation started, never reported */
+    EXISTING
+  };
+
+  /** @brief Collision object names in alphabetical order, pairs are indexed by their positions */
+  std::vector<std::string> link_names_;
+  std::unordered_map<std::string, std::size_t> link_index_;
+  std::vector<std::string> joint_names_;
+  std::vector<double> joint_lower_;
+  std::vector<double> joint_upper_;
+  std::size_t sample_count_{ 0 };
+  std::size_t stable_sample_count_{ 0 };
+  std::uint64_t seed_{ 0 };
+
+  std::atomic<std::size_t> next_batch_{ 0 };
+  std::atomic<bool> cancelled_{ false };
+
+  mutable std::mutex mutex_;
+
+  /** @brief The number of samples in contact per pair, summed over completed batches */
+  std::vector<std::uint32_t> contact_counts_;
+
+  /** @brief The pairs in contact in every completed sample, as link indices */
+  std::vector<std::pair<std::size_t, std::size_t>> always_pairs_;
+
+  /** @brief The pairs which left the never or always in contact classification since the last report */
+  std::vector<std::pair<std::size_t, std::size_t>> changed_pairs_;
+  std::size_t completed_samples_{ 0 };
+  std::size_t finished_threads_{ 0 };
+  std::string error_;
+
+  std::vector<std::thread> workers_;
+  QTimer report_timer_;
+
+  /** @brief The classification per pair as of the last report */
+  std::vector<Classification> classifications_;
+  std::size_t reported_samples_{ 0 };
+  std::size_t progress_samples_{ 0 };
+
+  void stop();
+  void run(tesseract_collision::DiscreteContactManager::UPtr manager, tesseract_scene_graph::StateSolver::UPtr solver);
+  void report();
+
+  /** @brief Classify every pair by the counts of the first report */
+  std::vector<AllowedCollisionEdit> classify(const std::vector<std::uint32_t>& contact_counts,
+                                             std::size_t completed_samples);
+
+  /** @brief Remove the classification of pairs which left it */
+  std::vector<AllowedCollisionEdit> declassify(const std::vector<std::pair<std::size_t, std::size_t>>& pairs);
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_COLLISION_ALLOWED_COLLISION_MATRIX_GENERATOR_H
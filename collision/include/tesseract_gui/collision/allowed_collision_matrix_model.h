@@ -0,0 +1,207 @@
+/**
+ * @file allowed_collision_matrix_model.h
+ * @brief Table model over a large allowed collision matrix
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_COLLISION_ALLOWED_COLLISION_MATRIX_MODEL_H
+#define TESSERACT_GUI_COLLISION_ALLOWED_COLLISION_MATRIX_MODEL_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <QAbstractTableModel>
+#include <QString>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_environment/commands/modify_allowed_collisions_command.h>
+#include <tesseract_environment/environment.h>
+#include <tesseract_scene_graph/allowed_collision_matrix.h>
+
+namespace tesseract_gui
+{
+/** @brief A change of one link pair of an allowed collision matrix */
+struct AllowedCollisionEdit
+{
+  std::string link_a;
+  std::string link_b;
+
+  /** @brief The reason of an allowed pair, ignored when removing */
+  std::string reason;
+
+  /** @brief Remove the pair instead of allowing it */
+  bool remove{ false };
+};
+
+/**
+ * @brief One row per allowed link pair with the reason, sortable and filterable with hundreds of thousands of pairs
+ *
+ * Link names are stored once in sorted order and referenced by index, reasons are interned, so an entry is three
+ * integers. Entries are kept sorted by link index pair (first index lower than the second), which is alphabetical
+ * order by the first then the second link. Lookups are binary searches and a batch of edits is merged in one pass.
+ *
+ * The rows are a list of entry indices. Filtering tests each link and reason name once and then only compares
+ * integers per entry. Sorting by a column is a stable bucket sort by link index or reason rank of the already
+ * ordered entries, linear in the number of rows. Both are announced as layout changes which keep persistent indices
+ * (e.g. the selection) on their entries. Edits changing only reasons are announced as data changes, edits adding or
+ * removing pairs as layout changes, only setAllowedCollisionMatrix() resets the model.
+ *
+ * Edits are applied to the model immediately and recorded as pending changes, applyChanges() sends all of them to an
+ * environment as a single ModifyAllowedCollisionsCommand.
+ */
+class AllowedCollisionMatrixModel : public QAbstractTableModel
+{
+  Q_OBJECT
+
+public:
+  enum Column
+  {
+    LINK_A_COLUMN = 0,
+    LINK_B_COLUMN,
+    REASON_COLUMN,
+    COLUMN_COUNT
+  };
+
+  explicit AllowedCollisionMatrixModel(QObject* parent = nullptr);
+
+  /**
+   * @brief Reset the model to an allowed collision matrix, pending changes are discarded
+   * @param acm The allowed collision matrix
+   * @param link_names Additional links which can be used in edits, e.g. all links of the environment
+   */
+  void setAllowedCollisionMatrix(const tesseract_scene_graph::AllowedCollisionMatrix& acm,
+                                 const std::vector<std::string>& link_names = {});
+
+  /** @brief Reset the model to the allowed collision matrix and links of an environment */
+  void setEnvironment(const tesseract_environment::Environment& environment);
+
+  /** @brief Create an allowed collision matrix of all entries */
+  tesseract_scene_graph::AllowedCollisionMatrix getAllowedCollisionMatrix() const;
+
+  /** @brief The known links in alphabetical order */
+  const std::vector<std::string>& getLinkNames() const;
+
+  /** @brief The number of allowed pairs, including those hidden by the filter */
+  std::size_t getEntryCount() const;
+
+  bool isCollisionAllowed(const std::string& link_a, const std::string& link_b) const;
+
+  /** @brief Apply a batch of edits, later edits of the same pair override earlier ones */
+  void modify(const std::vector<AllowedCollisionEdit>& edits);
+  void addAllowedCollision(const std::string& link_a, const std::string& link_b, const std::string& reason);
+  void removeAllowedCollision(const std::string& link_a, const std::string& link_b);
+
+  /** @brief The number of pairs changed since the last reset or applyChanges() */
+  std::size_t getPendingChangeCount() const;
+
+  /**
+   * @brief Create a single command applying the pending changes
+   *
+   * Only additions or only removals are sent as ADD or REMOVE command of the changed pairs, a mix of both replaces the
+   * whole matrix.
+   *
+   * @return The command, nullptr without pending changes
+   */
+  tesseract_environment::ModifyAllowedCollisionsCommand::Ptr createCommand() const;
+
+  /**
+   * @brief Apply the pending changes to an environment with one command
+   * @return False if the environment rejected the command, the changes stay pending
+   */
+  bool applyChanges(tesseract_environment::Environment& environment);
+
+  /** @brief Show only pairs where a link or the reason contains the text, case insensitive */
+  void setFilter(const QString& text);
+  QString getFilter() const;
+
+  /** @brief The index of the row in the (unfiltered) entries */
+  std::size_t getEntryIndex(int row) const;
+
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+  int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+  QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+  Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+  /** @brief Change the reason of a pair */
+  bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
+
+  /** @brief Remove the pairs of the rows */
+  bool removeRows(int row, int count, const QModelIndex& parent = QModelIndex()) override;
+
+  void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+Q_SIGNALS:
+  void pendingChangesChanged(std::size_t count);
+
+private:
+  struct Entry
+  {
+    std::uint32_t link_a;
+    std::uint32_t link_b;
+    std::uint32_t reason;
+  };
+
+  /** @brief Marks a removed pair in pending_changes_ */
+  static constexpr std::uint32_t REMOVED = std::numeric_limits<std::uint32_t>::max();
+
+  std::vector<std::string> link_names_;
+  std::unordered_map<std::string, std::uint32_t> link_index_;
+  std::vector<std::string> reasons_;
+  std::unordered_map<std::string, std::uint32_t> reason_index_;
+
+  /** @brief Sorted by link_a then link_b, link_a < link_b */
+  std::vector<Entry> entries_;
+
+  /** @brief The changed pairs by link names with their new reason or REMOVED */
+  std::map<std::pair<std::string, std::string>, std::uint32_t> pending_changes_;
+
+  std::vector<std::uint32_t> rows_;
+  QString filter_;
+  int sort_column_{ -1 };
+  Qt::SortOrder sort_order_{ Qt::AscendingOrder };
+
+  std::uint32_t getReasonIndex(const std::string& reason);
+
+  /** @brief Add links to link_names_ keeping it sorted, remapping the indices of all entries */
+  void addLinkNames(std::vector<std::string> link_names);
+
+  /** @brief The index of the entry of a pair, -1 if not allowed */
+  std::ptrdiff_t findEntry(std::uint32_t link_a, std::uint32_t link_b) const;
+
+  /** @brief Compute the rows from the filter and sort order */
+  std::vector<std::uint32_t> computeRows() const;
+
+  /** @brief Replace the rows with a layout change, remapping persistent indices by entry */
+  void setRows(std::vector<std::uint32_t> rows);
+
+  /**
+   * @brief Move persistent indices from rows_ to new rows during a layout change
+   * @param rows The new rows into entries_
+   * @param entry_map The new index of every entry of rows_, -1 if it was removed, the same index if empty
+   */
+  void remapPersistentIndexes(const std::vector<std::uint32_t>& rows, const std::vector<std::int64_t>& entry_map);
+
+  void setPendingChange(std::uint32_t link_a, std::uint32_t link_b, std::uint32_t reason);
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_COLLISION_ALLOWED_COLLISION_MATRIX_MODEL_H
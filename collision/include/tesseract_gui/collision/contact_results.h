@@ -0,0 +1,116 @@
+/**
+ * @file contact_results.h
+ * @brief Compact storage of contact results for display
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_COLLISION_CONTACT_RESULTS_H
+#define TESSERACT_GUI_COLLISION_CONTACT_RESULTS_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_collision/core/types.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief The contacts of a ContactResultMap flattened into one array of fixed size records
+ *
+ * A tesseract_collision::ContactResult carries transforms, local points and continuous collision data which are not
+ * displayed, copying them for tens of thousands of contacts costs more than the check itself. Only the world space
+ * nearest points, the normal and the distance are kept as floats, the link names are stored once per link pair. The
+ * records have a fixed layout so renderers can upload getContacts() as an instance buffer without repacking.
+ */
+class ContactResults
+{
+public:
+  using Ptr = std::shared_ptr<ContactResults>;
+  using ConstPtr = std::shared_ptr<const ContactResults>;
+
+  struct Contact
+  {
+    /** @brief The nearest point on the first link in world coordinates */
+    std::array<float, 3> point_a;
+
+    /** @brief The nearest point on the second link in world coordinates */
+    std::array<float, 3> point_b;
+
+    /** @brief The contact normal pointing from the first to the second link */
+    std::array<float, 3> normal;
+
+    /** @brief The signed distance, negative when penetrating */
+    float distance;
+
+    /** @brief The index into getLinkPairs() */
+    std::uint32_t link_pair;
+  };
+
+  ContactResults() = default;
+  explicit ContactResults(const tesseract_collision::ContactResultMap& results);
+
+  void add(const tesseract_collision::ContactResult& result);
+  void add(const tesseract_collision::ContactResultMap& results);
+  void clear();
+
+  std::size_t size() const;
+  bool empty() const;
+
+  const std::vector<Contact>& getContacts() const;
+
+  /** @brief The link names of each link pair, in the order of their first contact */
+  const std::vector<std::pair<std::string, std::string>>& getLinkPairs() const;
+
+  /** @brief The index of a link pair in getLinkPairs() in either order, -1 if it has no contacts */
+  int findLinkPair(const std::string& link_a, const std::string& link_b) const;
+
+private:
+  std::vector<Contact> contacts_;
+  std::vector<std::pair<std::string, std::string>> link_pairs_;
+  std::map<std::pair<std::string, std::string>, std::uint32_t> link_pair_index_;
+
+  std::uint32_t getLinkPairIndex(const std::string& link_a, const std::string& link_b);
+};
+
+/**
+ * @brief Selects the contacts shown by ContactResultsModel and ContactResultsOverlay
+ *
+ * A contact is visible when its distance does not exceed the distance threshold and its link pair is not hidden.
+ * Link pairs are identified by their index in ContactResults::getLinkPairs().
+ */
+struct ContactResultFilter
+{
+  /** @brief Contacts with a larger distance are hidden */
+  double distance_threshold{ std::numeric_limits<double>::infinity() };
+
+  /** @brief Hidden link pairs by link pair index, pairs beyond the end are visible */
+  std::vector<bool> hidden_link_pairs;
+
+  void setLinkPairVisible(std::size_t link_pair, bool visible);
+  bool isLinkPairVisible(std::size_t link_pair) const;
+  bool isVisible(const ContactResults::Contact& contact) const;
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_COLLISION_CONTACT_RESULTS_H
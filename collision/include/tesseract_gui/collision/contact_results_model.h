@@ -0,0 +1,107 @@
+/**
+ * @file contact_results_model.h
+ * @brief Table model over contact results
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_COLLISION_CONTACT_RESULTS_MODEL_H
+#define TESSERACT_GUI_COLLISION_CONTACT_RESULTS_MODEL_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cstdint>
+#include <vector>
+#include <QAbstractTableModel>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/collision/contact_results.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief One row per visible contact with its links, distance, nearest points and normal
+ *
+ * The model keeps no per row data besides the index of the contact, cells are formatted in data() when a view asks
+ * for them, so a view only touches the rows on screen regardless of the number of contacts. Changing the filter
+ * recomputes the list of visible contact indices and announces it as a layout change, persistent indices (e.g. the
+ * selection) of contacts which stay visible follow their contact instead of the view being reset.
+ */
+class ContactResultsModel : public QAbstractTableModel
+{
+  Q_OBJECT
+
+public:
+  enum Column
+  {
+    LINK_A_COLUMN = 0,
+    LINK_B_COLUMN,
+    DISTANCE_COLUMN,
+    POINT_A_COLUMN,
+    POINT_B_COLUMN,
+    NORMAL_COLUMN,
+    COLUMN_COUNT
+  };
+
+  enum Role
+  {
+    /** @brief The index of the contact in ContactResults::getContacts() */
+    ContactIndexRole = Qt::UserRole + 1,
+    /** @brief The index of the link pair in ContactResults::getLinkPairs() */
+    LinkPairRole
+  };
+
+  explicit ContactResultsModel(QObject* parent = nullptr);
+
+  /** @brief Reset the model to new results, the filter is kept */
+  void setContactResults(ContactResults::ConstPtr results);
+  ContactResults::ConstPtr getContactResults() const;
+
+  void clear();
+
+  void setFilter(ContactResultFilter filter);
+  const ContactResultFilter& getFilter() const;
+
+  /** @brief Show only contacts with a distance less or equal to the threshold */
+  void setDistanceThreshold(double distance);
+  void setLinkPairVisible(std::size_t link_pair, bool visible);
+
+  /** @brief The index of the contact shown in a row */
+  std::size_t getContactIndex(int row) const;
+
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+  int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+  QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+Q_SIGNALS:
+  /** @brief The filter changed, e.g. to forward it to ContactResultsOverlay::setFilter() */
+  void filterChanged();
+
+private:
+  ContactResults::ConstPtr results_;
+  ContactResultFilter filter_;
+
+  /** @brief The contact index of every row */
+  std::vector<std::uint32_t> rows_;
+
+  /** @brief Compute the visible rows */
+  std::vector<std::uint32_t> filterRows() const;
+
+  /** @brief Replace the visible rows, remapping persistent indices */
+  void applyFilter();
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_COLLISION_CONTACT_RESULTS_MODEL_H
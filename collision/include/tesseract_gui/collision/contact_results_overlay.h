@@ -0,0 +1,104 @@
+/**
+ * @file contact_results_overlay.h
+ * @brief Draws contact points and normals with instanced rendering
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_COLLISION_CONTACT_RESULTS_OVERLAY_H
+#define TESSERACT_GUI_COLLISION_CONTACT_RESULTS_OVERLAY_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <memory>
+#include <QOpenGLShaderProgram>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/collision/contact_results.h>
+#include <tesseract_gui/render/render_overlay.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief Draws every contact as crosses at both nearest points, a line between them and its normal
+ *
+ * All contacts are drawn with a single instanced line draw call: a fixed set of line vertices describes one contact
+ * and the contact records of ContactResults are uploaded unchanged as per instance attributes. Penetrating contacts
+ * are red, the others yellow and normals blue.
+ *
+ * The filter is evaluated in the vertex shader, the distance threshold is a uniform and the hidden link pairs are a
+ * small integer texture with one texel per link pair, so changing the filter never touches the instance buffer. The
+ * instance buffer is only uploaded when new results are set.
+ *
+ * Setters may be called without the context current, changes are uploaded by the next render().
+ */
+class ContactResultsOverlay : public RenderOverlay
+{
+public:
+  using Ptr = std::shared_ptr<ContactResultsOverlay>;
+  using ConstPtr = std::shared_ptr<const ContactResultsOverlay>;
+
+  ContactResultsOverlay() = default;
+
+  void setContactResults(ContactResults::ConstPtr results);
+  ContactResults::ConstPtr getContactResults() const;
+
+  void setFilter(ContactResultFilter filter);
+  const ContactResultFilter& getFilter() const;
+
+  /** @brief The half size of the crosses marking the nearest points in meters */
+  void setMarkerSize(float size);
+  float getMarkerSize() const;
+
+  /** @brief The length of the drawn normals in meters */
+  void setNormalLength(float length);
+  float getNormalLength() const;
+
+  void setVisible(bool visible);
+  bool isVisible() const;
+
+  void initialize(QOpenGLExtraFunctions& gl) override;
+  void cleanup(QOpenGLExtraFunctions& gl) override;
+  void render(QOpenGLExtraFunctions& gl, const Eigen::Matrix4f& view_projection, const Camera& camera) override;
+
+private:
+  ContactResults::ConstPtr results_;
+  ContactResultFilter filter_;
+  float marker_size_{ 0.01F };
+  float normal_length_{ 0.05F };
+  bool visible_{ true };
+
+  /** @brief Set when the results or the filter changed since the last upload */
+  bool results_dirty_{ true };
+  bool filter_dirty_{ true };
+
+  std::unique_ptr<QOpenGLShaderProgram> program_;
+  int view_projection_location_{ -1 };
+  int marker_size_location_{ -1 };
+  int normal_length_location_{ -1 };
+  int distance_threshold_location_{ -1 };
+  int link_pair_visibility_location_{ -1 };
+
+  GLuint vao_{ 0 };
+  GLuint vertex_buffer_{ 0 };
+  GLuint instance_buffer_{ 0 };
+  GLuint link_pair_texture_{ 0 };
+  GLsizei instance_count_{ 0 };
+
+  void uploadContacts(QOpenGLExtraFunctions& gl);
+  void uploadFilter(QOpenGLExtraFunctions& gl);
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_COLLISION_CONTACT_RESULTS_OVERLAY_H
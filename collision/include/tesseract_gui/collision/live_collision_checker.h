@@ -0,0 +1,147 @@
+/**
+ * @file live_collision_checker.h
+ * @brief Continuously checks the collision state while joints are manipulated
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_COLLISION_LIVE_COLLISION_CHECKER_H
+#define TESSERACT_GUI_COLLISION_LIVE_COLLISION_CHECKER_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_collision/core/discrete_contact_manager.h>
+#include <tesseract_environment/environment.h>
+#include <tesseract_gui/collision/contact_results.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief Checks for contacts on a worker thread whenever joint values change
+ *
+ * setEnvironment() clones the discrete contact manager and the state solver of an environment once. The worker keeps
+ * both for its lifetime: each check applies only the joint values changed since the previous check to the solver and
+ * only passes the collision objects whose transform changed to the contact manager, so its broadphase is updated
+ * incrementally instead of being rebuilt.
+ *
+ * Joint values arriving while a check runs are merged and handled by a single following check, so a dragged slider
+ * never queues up work. Completed results are delivered once per frame at most through contactResultsChanged(),
+ * intermediate results completed within the same frame are skipped.
+ *
+ * Changes to the environment (e.g. added links or allowed collisions) require calling setEnvironment() again.
+ */
+class LiveCollisionChecker : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit LiveCollisionChecker(QObject* parent = nullptr);
+
+  /** @brief Stops the worker, a running check is completed first */
+  ~LiveCollisionChecker() override;
+  LiveCollisionChecker(const LiveCollisionChecker&) = delete;
+  LiveCollisionChecker& operator=(const LiveCollisionChecker&) = delete;
+  LiveCollisionChecker(LiveCollisionChecker&&) = delete;
+  LiveCollisionChecker& operator=(LiveCollisionChecker&&) = delete;
+
+  /**
+   * @brief Check the environment, starting from its current state
+   *
+   * The contact manager and state solver are cloned, the environment is not referenced afterwards.
+   * If enabled a check of the current state is started.
+   */
+  void setEnvironment(const tesseract_environment::Environment& environment);
+
+  /** @brief The request used for every check, defaults to reporting all contacts */
+  void setContactRequest(const tesseract_collision::ContactRequest& request);
+
+  bool isEnabled() const;
+
+  /** @brief The results of the last delivered check, empty while disabled */
+  ContactResults::ConstPtr getContactResults() const;
+
+  /** @brief The duration of the last delivered check in milliseconds, including the state update */
+  double getLastCheckDuration() const;
+
+  /** @brief Set the interval in which results are delivered, defaults to the primary screen refresh rate */
+  void setFrameInterval(int msec);
+  int getFrameInterval() const;
+
+public Q_SLOTS:
+  /** @brief Enable or disable checking, disabling clears the results */
+  void setEnabled(bool enabled);
+
+  /** @brief Update joint values, e.g. connected to JointStateIngest::jointValuesChanged() or a slider */
+  void setJointValues(const std::unordered_map<std::string, double>& joint_values);
+
+Q_SIGNALS:
+  void enabledChanged(bool enabled);
+
+  /** @brief The results of a check completed since the previous frame */
+  void contactResultsChanged(const tesseract_gui::ContactResults::ConstPtr& results);
+
+  /** @brief A check threw, checking is disabled */
+  void checkFailed(const QString& message);
+
+private:
+  struct Result
+  {
+    ContactResults::ConstPtr results;
+    double duration{ 0 };
+  };
+
+  mutable std::mutex mutex_;
+  std::condition_variable condition_;
+
+  /** @brief The joint values changed since the worker took the last request */
+  std::unordered_map<std::string, double> pending_values_;
+  bool check_requested_{ false };
+  bool enabled_{ false };
+  bool stopping_{ false };
+  tesseract_collision::ContactRequest contact_request_{ tesseract_collision::ContactTestType::ALL };
+
+  /** @brief Incremented when checking is disabled, results of checks started before are dropped */
+  std::uint64_t generation_{ 0 };
+
+  /** @brief The latest completed result not yet delivered */
+  Result completed_;
+  bool has_completed_{ false };
+
+  std::thread worker_;
+  QTimer frame_timer_;
+
+  ContactResults::ConstPtr results_;
+  double last_check_duration_{ 0 };
+
+  void stop();
+  void run(tesseract_collision::DiscreteContactManager::UPtr manager,
+           tesseract_scene_graph::StateSolver::UPtr solver,
+           std::vector<std::string> active_links);
+  void deliverResults();
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_COLLISION_LIVE_COLLISION_CHECKER_H
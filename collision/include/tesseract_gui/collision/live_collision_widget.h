@@ -0,0 +1,60 @@
+/**
+ * @file live_collision_widget.h
+ * @brief Toggle and status display for a live collision checker
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_COLLISION_LIVE_COLLISION_WIDGET_H
+#define TESSERACT_GUI_COLLISION_LIVE_COLLISION_WIDGET_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <QWidget>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/collision/contact_results.h>
+
+class QCheckBox;
+class QLabel;
+
+namespace tesseract_gui
+{
+class LiveCollisionChecker;
+
+/**
+ * @brief A "Live collision" check box with the number of contacts and the duration of the last check
+ *
+ * Meant to be placed next to joint manipulation controls, e.g. sliders feeding LiveCollisionChecker::setJointValues().
+ */
+class LiveCollisionWidget : public QWidget
+{
+  Q_OBJECT
+
+public:
+  explicit LiveCollisionWidget(LiveCollisionChecker* checker, QWidget* parent = nullptr);
+
+  LiveCollisionChecker* getChecker() const;
+
+private:
+  LiveCollisionChecker* checker_;
+  QCheckBox* enabled_check_box_;
+  QLabel* status_label_;
+
+  void onEnabledChanged(bool enabled);
+  void onContactResultsChanged(const ContactResults::ConstPtr& results);
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_COLLISION_LIVE_COLLISION_WIDGET_H
@@ -0,0 +1,263 @@
+/**
+ * @file allowed_collision_matrix_editor.cpp
+ * @brief Editor widget for the allowed collision matrix of an environment
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <limits>
+#include <set>
+#include <QComboBox>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QItemSelectionModel>
+#include <QLabel>
+#include <QLineEdit>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QStringList>
+#include <QTableView>
+#include <QVBoxLayout>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/collision/allowed_collision_matrix_editor.h>
+#include <tesseract_gui/collision/allowed_collision_matrix_generator.h>
+#include <tesseract_gui/collision/allowed_collision_matrix_model.h>
+
+namespace tesseract_gui
+{
+AllowedCollisionMatrixEditor::AllowedCollisionMatrixEditor(QWidget* parent)
+  : QWidget(parent)
+  , model_(new AllowedCollisionMatrixModel(this))
+  , generator_(new AllowedCollisionMatrixGenerator(this))
+  , filter_edit_(new QLineEdit(this))
+  , table_view_(new QTableView(this))
+  , link_a_combo_box_(new QComboBox(this))
+  , link_b_combo_box_(new QComboBox(this))
+  , reason_edit_(new QLineEdit(this))
+  , add_button_(new QPushButton("Add", this))
+  , remove_button_(new QPushButton("Remove", this))
+  , apply_button_(new QPushButton("Apply", this))
+  , reload_button_(new QPushButton("Reload", this))
+  , status_label_(new QLabel(this))
+  , sample_count_spin_box_(new QSpinBox(this))
+  , seed_spin_box_(new QSpinBox(this))
+  , generate_button_(new QPushButton("Generate", this))
+  , cancel_button_(new QPushButton("Cancel", this))
+  , progress_bar_(new QProgressBar(this))
+{
+  filter_edit_->setPlaceholderText("Filter links and reasons");
+  filter_edit_->setClearButtonEnabled(true);
+  reason_edit_->setPlaceholderText("Reason");
+  reason_edit_->setText("User");
+
+  table_view_->setModel(model_);
+  table_view_->setSortingEnabled(true);
+  table_view_->sortByColumn(AllowedCollisionMatrixModel::LINK_A_COLUMN, Qt::AscendingOrder);
+  table_view_->setSelectionBehavior(QAbstractItemView::SelectRows);
+  table_view_->horizontalHeader()->setStretchLastSection(true);
+
+  // Fixed row heights keep the view from measuring every row of large matrices
+  table_view_->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+  table_view_->verticalHeader()->setDefaultSectionSize(table_view_->fontMetrics().height() + 6);
+  table_view_->verticalHeader()->hide();
+
+  sample_count_spin_box_->setRange(1, 100000000);
+  sample_count_spin_box_->setValue(10000);
+  sample_count_spin_box_->setSuffix(" samples");
+  seed_spin_box_->setRange(0, std::numeric_limits<int>::max());
+  seed_spin_box_->setPrefix("Seed ");
+  cancel_button_->setEnabled(false);
+  progress_bar_->setRange(0, 100);
+  progress_bar_->setValue(0);
+
+  auto* generate_layout = new QHBoxLayout();
+  generate_layout->addWidget(sample_count_spin_box_);
+  generate_layout->addWidget(seed_spin_box_);
+  generate_layout->addWidget(progress_bar_, 1);
+  generate_layout->addWidget(cancel_button_);
+  generate_layout->addWidget(generate_button_);
+
+  auto* add_layout = new QHBoxLayout();
+  add_layout->addWidget(link_a_combo_box_, 1);
+  add_layout->addWidget(link_b_combo_box_, 1);
+  add_layout->addWidget(reason_edit_, 1);
+  add_layout->addWidget(add_button_);
+
+  auto* button_layout = new QHBoxLayout();
+  button_layout->addWidget(remove_button_);
+  button_layout->addWidget(status_label_, 1);
+  button_layout->addWidget(reload_button_);
+  button_layout->addWidget(apply_button_);
+
+  auto* layout = new QVBoxLayout(this);
+  layout->addWidget(filter_edit_);
+  layout->addWidget(table_view_, 1);
+  layout->addLayout(add_layout);
+  layout->addLayout(generate_layout);
+  layout->addLayout(button_layout);
+
+  connect(filter_edit_, &QLineEdit::textChanged, model_, &AllowedCollisionMatrixModel::setFilter);
+  connect(add_button_, &QPushButton::clicked, this, &AllowedCollisionMatrixEditor::onAddClicked);
+  connect(remove_button_, &QPushButton::clicked, this, &AllowedCollisionMatrixEditor::onRemoveClicked);
+  connect(apply_button_, &QPushButton::clicked, this, &AllowedCollisionMatrixEditor::apply);
+  connect(reload_button_, &QPushButton::clicked, this, &AllowedCollisionMatrixEditor::reload);
+  connect(model_,
+          &AllowedCollisionMatrixModel::pendingChangesChanged,
+          this,
+          &AllowedCollisionMatrixEditor::updateStatus);
+  connect(model_, &AllowedCollisionMatrixModel::layoutChanged, this, &AllowedCollisionMatrixEditor::updateStatus);
+  connect(model_, &AllowedCollisionMatrixModel::modelReset, this, &AllowedCollisionMatrixEditor::updateStatus);
+
+  connect(generate_button_, &QPushButton::clicked, this, &AllowedCollisionMatrixEditor::generate);
+  connect(cancel_button_, &QPushButton::clicked, generator_, &AllowedCollisionMatrixGenerator::cancel);
+  connect(generator_,
+          &AllowedCollisionMatrixGenerator::allowedCollisionsChanged,
+          model_,
+          &AllowedCollisionMatrixModel::modify);
+  connect(generator_,
+          &AllowedCollisionMatrixGenerator::progressChanged,
+          this,
+          [this](std::size_t completed, std::size_t total) {
+            progress_bar_->setValue((total == 0) ? 100 : static_cast<int>((100 * completed) / total));
+          });
+  connect(generator_,
+          &AllowedCollisionMatrixGenerator::finished,
+          this,
+          &AllowedCollisionMatrixEditor::onGenerationFinished);
+  connect(generator_, &AllowedCollisionMatrixGenerator::generationFailed, this, [this](const QString& message) {
+    status_label_->setText(QString("Generation failed: %1").arg(message));
+  });
+
+  setEnabled(false);
+  updateStatus();
+}
+
+void AllowedCollisionMatrixEditor::setEnvironment(tesseract_environment::Environment::Ptr environment)
+{
+  environment_ = std::move(environment);
+  reload();
+}
+
+tesseract_environment::Environment::Ptr AllowedCollisionMatrixEditor::getEnvironment() const { return environment_; }
+
+AllowedCollisionMatrixModel* AllowedCollisionMatrixEditor::getModel() const { return model_; }
+
+AllowedCollisionMatrixGenerator* AllowedCollisionMatrixEditor::getGenerator() const { return generator_; }
+
+void AllowedCollisionMatrixEditor::reload()
+{
+  generator_->cancel();
+  setEnabled(environment_ != nullptr);
+  if (environment_ == nullptr)
+    model_->setAllowedCollisionMatrix(tesseract_scene_graph::AllowedCollisionMatrix());
+  else
+    model_->setEnvironment(*environment_);
+
+  updateLinkNames();
+}
+
+void AllowedCollisionMatrixEditor::apply()
+{
+  if (environment_ == nullptr)
+    return;
+
+  if (!model_->applyChanges(*environment_))
+    status_label_->setText("The environment rejected the changes");
+}
+
+void AllowedCollisionMatrixEditor::generate()
+{
+  if (environment_ == nullptr)
+    return;
+
+  AllowedCollisionMatrixGenerator::Settings settings;
+  settings.sample_count = static_cast<std::size_t>(sample_count_spin_box_->value());
+  settings.seed = static_cast<std::uint64_t>(seed_spin_box_->value());
+  try
+  {
+    generator_->start(*environment_, settings, model_->getAllowedCollisionMatrix());
+  }
+  catch (const std::exception& e)
+  {
+    status_label_->setText(QString("Generation failed: %1").arg(e.what()));
+    return;
+  }
+
+  generate_button_->setEnabled(false);
+  cancel_button_->setEnabled(true);
+}
+
+void AllowedCollisionMatrixEditor::onAddClicked()
+{
+  const QString link_a = link_a_combo_box_->currentText();
+  const QString link_b = link_b_combo_box_->currentText();
+  if (link_a.isEmpty() || link_b.isEmpty() || link_a == link_b)
+    return;
+
+  model_->addAllowedCollision(link_a.toStdString(), link_b.toStdString(), reason_edit_->text().toStdString());
+}
+
+void AllowedCollisionMatrixEditor::onRemoveClicked()
+{
+  std::set<int> rows;
+  for (const QModelIndex& index : table_view_->selectionModel()->selectedIndexes())
+    rows.insert(index.row());
+
+  std::vector<AllowedCollisionEdit> edits;
+  edits.reserve(rows.size());
+  for (const int row : rows)
+  {
+    edits.push_back({ model_->index(row, AllowedCollisionMatrixModel::LINK_A_COLUMN).data().toString().toStdString(),
+                      model_->index(row, AllowedCollisionMatrixModel::LINK_B_COLUMN).data().toString().toStdString(),
+                      "",
+                      true });
+  }
+  model_->modify(edits);
+}
+
+void AllowedCollisionMatrixEditor::updateLinkNames()
+{
+  QStringList link_names;
+  link_names.reserve(static_cast<int>(model_->getLinkNames().size()));
+  for (const auto& link_name : model_->getLinkNames())
+    link_names.append(QString::fromStdString(link_name));
+
+  for (QComboBox* combo_box : { link_a_combo_box_, link_b_combo_box_ })
+  {
+    combo_box->clear();
+    combo_box->addItems(link_names);
+  }
+}
+
+void AllowedCollisionMatrixEditor::onGenerationFinished(bool cancelled)
+{
+  generate_button_->setEnabled(true);
+  cancel_button_->setEnabled(false);
+  if (cancelled)
+    progress_bar_->setValue(0);
+}
+
+void AllowedCollisionMatrixEditor::updateStatus()
+{
+  status_label_->setText(QString("%1 of %2 pairs, %3 pending changes")
+                             .arg(model_->rowCount())
+                             .arg(model_->getEntryCount())
+                             .arg(model_->getPendingChangeCount()));
+  apply_button_->setEnabled(model_->getPendingChangeCount() > 0);
+}
+
+}  // namespace tesseract_gui
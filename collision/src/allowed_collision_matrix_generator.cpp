@@ -0,0 +1,415 @@
+/**
+ * @file allowed_collision_matrix_generator.cpp
+ * @brief Generates a default allowed collision matrix by sampling joint states on a thread pool
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <stdexcept>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/common/instrumentation.h>
+#include <tesseract_gui/common/splitmix_random.h>
+#include <tesseract_gui/collision/allowed_collision_matrix_generator.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+/** @brief The number of samples a thread takes at once */
+constexpr std::size_t BATCH_SIZE = 64;
+
+/** @brief The index of the pair of links i < j among n links */
+std::size_t getPairIndex(std::size_t i, std::size_t j, std::size_t n)
+{
+  return ((i * (2 * n - i - 1)) / 2) + (j - i - 1);
+}
+
+}  // namespace
+
+const std::string AllowedCollisionMatrixGenerator::ADJACENT_REASON = "Adjacent";
+const std::string AllowedCollisionMatrixGenerator::NEVER_REASON = "Never";
+const std::string AllowedCollisionMatrixGenerator::ALWAYS_REASON = "Always";
+
+AllowedCollisionMatrixGenerator::AllowedCollisionMatrixGenerator(QObject* parent) : QObject(parent)
+{
+  report_timer_.setInterval(100);
+  connect(&report_timer_, &QTimer::timeout, this, &AllowedCollisionMatrixGenerator::report);
+}
+
+AllowedCollisionMatrixGenerator::~AllowedCollisionMatrixGenerator() { stop(); }
+
+void AllowedCollisionMatrixGenerator::start(const tesseract_environment::Environment& environment,
+                                            const Settings& settings,
+                                            const tesseract_scene_graph::AllowedCollisionMatrix& existing)
+{
+  tesseract_collision::DiscreteContactManager::UPtr manager = environment.getDiscreteContactManager();
+  if (manager == nullptr)
+    throw std::runtime_error("AllowedCollisionMatrixGenerator, environment has no discrete contact manager!");
+
+  tesseract_scene_graph::StateSolver::UPtr solver = environment.getStateSolver();
+  if (solver == nullptr)
+    throw std::runtime_error("AllowedCollisionMatrixGenerator, environment has no state solver!");
+
+  tesseract_scene_graph::SceneGraph::ConstPtr scene_graph = environment.getSceneGraph();
+  if (scene_graph == nullptr)
+    throw std::runtime_error("AllowedCollisionMatrixGenerator, environment has no scene graph!");
+
+  stop();
+  report_timer_.stop();
+
+  link_names_ = manager->getCollisionObjects();
+  std::sort(link_names_.begin(), link_names_.end());
+  link_index_.clear();
+  for (std::size_t i = 0; i < link_names_.size(); ++i)
+    link_index_[link_names_[i]] = i;
+
+  // Continuous joints and joints without usable limits are sampled over one revolution
+  joint_names_ = solver->getActiveJointNames();
+  joint_lower_.assign(joint_names_.size(), -M_PI);
+  joint_upper_.assign(joint_names_.size(), M_PI);
+  for (std::size_t i = 0; i < joint_names_.size(); ++i)
+  {
+    const tesseract_scene_graph::Joint::ConstPtr joint = scene_graph->getJoint(joint_names_[i]);
+    if (joint == nullptr || joint->limits == nullptr || joint->type == tesseract_scene_graph::JointType::CONTINUOUS)
+      continue;
+
+    if (std::isfinite(joint->limits->lower) && std::isfinite(joint->limits->upper) &&
+        joint->limits->lower < joint->limits->upper)
+    {
+      joint_lower_[i] = joint->limits->lower;
+      joint_upper_[i] = joint->limits->upper;
+    }
+  }
+
+  // Every pair is checked, regardless of the current allowed collision matrix
+  manager->setActiveCollisionObjects(link_names_);
+  manager->setIsContactAllowedFn([](const std::string&, const std::string&) { return false; });
+  manager->setDefaultCollisionMarginData(settings.contact_distance);
+
+  const std::size_t link_count = link_names_.size();
+  const std::size_t pair_count = (link_count * (link_count - std::min<std::size_t>(link_count, 1))) / 2;
+  classifications_.assign(pair_count, Classification::NONE);
+  for (const auto& allowed_collision : existing.getAllAllowedCollisions())
+  {
+    auto a = link_index_.find(allowed_collision.first.first);
+    auto b = link_index_.find(allowed_collision.first.second);
+    if (a == link_index_.end() || b == link_index_.end() || a->second == b->second)
+      continue;
+
+    const std::size_t i = std::min(a->second, b->second);
+    const std::size_t j = std::max(a->second, b->second);
+    classifications_[getPairIndex(i, j, link_count)] = Classification::EXISTING;
+  }
+
+  std::vector<AllowedCollisionEdit> adjacent;
+  for (std::size_t i = 0; i < link_count; ++i)
+  {
+    for (const auto& adjacent_link : scene_graph->getAdjacentLinkNames(link_names_[i]))
+    {
+      auto it = link_index_.find(adjacent_link);
+      if (it == link_index_.end() || it->second <= i)
+        continue;
+
+      Classification& classification = classifications_[getPairIndex(i, it->second, link_count)];
+      if (classification == Classification::EXISTING)
+        continue;
+
+      classification = Classification::ADJACENT;
+      adjacent.push_back({ link_names_[i], adjacent_link, ADJACENT_REASON, false });
+    }
+  }
+
+  sample_count_ = settings.sample_count;
+  stable_sample_count_ = std::max<std::size_t>(1, std::min(settings.stable_sample_count, sample_count_));
+  seed_ = settings.seed;
+  reported_samples_ = 0;
+  progress_samples_ = 0;
+  next_batch_ = 0;
+  cancelled_ = false;
+  {
+    std::scoped_lock lock(mutex_);
+    contact_counts_.assign(pair_count, 0);
+    always_pairs_.clear();
+    changed_pairs_.clear();
+    completed_samples_ = 0;
+    finished_threads_ = 0;
+    error_.clear();
+  }
+
+  const std::size_t batch_count = (sample_count_ + BATCH_SIZE - 1) / BATCH_SIZE;
+  std::size_t thread_count = settings.thread_count;
+  if (thread_count == 0)
+    thread_count = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+  thread_count = std::max<std::size_t>(1, std::min(thread_count, batch_count));
+
+  std::vector<std::pair<tesseract_collision::DiscreteContactManager::UPtr, tesseract_scene_graph::StateSolver::UPtr>>
+      clones;
+  clones.reserve(thread_count);
+  for (std::size_t i = 0; i < thread_count; ++i)
+  {
+    clones.emplace_back(manager->clone(), solver->clone());
+    if (clones.back().first == nullptr || clones.back().second == nullptr)
+      throw std::runtime_error("AllowedCollisionMatrixGenerator, failed to clone the contact manager or state solver!");
+  }
+
+  workers_.reserve(thread_count);
+  for (auto& clone : clones)
+  {
+    workers_.emplace_back([this, manager = std::move(clone.first), solver = std::move(clone.second)]() mutable {
+      run(std::move(manager), std::move(solver));
+    });
+  }
+
+  report_timer_.start();
+  emit progressChanged(0, sample_count_);
+  if (!adjacent.empty())
+    emit allowedCollisionsChanged(adjacent);
+}
+
+bool AllowedCollisionMatrixGenerator::isRunning() const { return !workers_.empty(); }
+
+std::size_t AllowedCollisionMatrixGenerator::getCompletedSampleCount() const { return reported_samples_; }
+
+std::size_t AllowedCollisionMatrixGenerator::getSampleCount() const { return sample_count_; }
+
+std::vector<AllowedCollisionEdit> AllowedCollisionMatrixGenerator::getAllowedCollisions() const
+{
+  std::vector<AllowedCollisionEdit> allowed_collisions;
+  const std::size_t link_count = link_names_.size();
+  std::size_t pair = 0;
+  for (std::size_t i = 0; i < link_count; ++i)
+  {
+    for (std::size_t j = i + 1; j < link_count; ++j, ++pair)
+    {
+      switch (classifications_[pair])
+      {
+        case Classification::ADJACENT:
+          allowed_collisions.push_back({ link_names_[i], link_names_[j], ADJACENT_REASON, false });
+          break;
+        case Classification::NEVER:
+          allowed_collisions.push_back({ link_names_[i], link_names_[j], NEVER_REASON, false });
+          break;
+        case Classification::ALWAYS:
+          allowed_collisions.push_back({ link_names_[i], link_names_[j], ALWAYS_REASON, false });
+          break;
+        case Classification::NONE:
+        case Classification::EXISTING:
+          break;
+      }
+    }
+  }
+  return allowed_collisions;
+}
+
+void AllowedCollisionMatrixGenerator::setReportInterval(int msec) { report_timer_.setInterval(msec); }
+
+int AllowedCollisionMatrixGenerator::getReportInterval() const { return report_timer_.interval(); }
+
+void AllowedCollisionMatrixGenerator::cancel() { cancelled_ = true; }
+
+void AllowedCollisionMatrixGenerator::stop()
+{
+  cancelled_ = true;
+  for (auto& worker : workers_)
+    worker.join();
+  workers_.clear();
+}
+
+void AllowedCollisionMatrixGenerator::run(tesseract_collision::DiscreteContactManager::UPtr manager,
+                                          tesseract_scene_graph::StateSolver::UPtr solver)
+{
+  // Only whether a pair is in contact matters, not its distance or penetration
+  tesseract_collision::ContactRequest request(tesseract_collision::ContactTestType::CLOSEST);
+  request.calculate_distance = false;
+  request.calculate_penetration = false;
+
+  Eigen::VectorXd joint_values(static_cast<Eigen::Index>(joint_names_.size()));
+  tesseract_collision::ContactResultMap contacts;
+  std::vector<std::pair<std::size_t, std::size_t>> batch_contacts;
+  const std::size_t link_count = link_names_.size();
+  try
+  {
+    while (!cancelled_)
+    {
+      const std::size_t first = next_batch_.fetch_add(1) * BATCH_SIZE;
+      if (first >= sample_count_)
+        break;
+
+      const ScopedTimer timer("collision", "acm batch");
+      const std::size_t last = std::min(first + BATCH_SIZE, sample_count_);
+      batch_contacts.clear();
+      for (std::size_t sample = first; sample < last; ++sample)
+      {
+        SplitMixRandom random(seed_, sample);
+        for (std::size_t i = 0; i < joint_names_.size(); ++i)
+          joint_values[static_cast<Eigen::Index>(i)] =
+              joint_lower_[i] + (random.next() * (joint_upper_[i] - joint_lower_[i]));
+
+        manager->setCollisionObjectsTransform(solver->getState(joint_names_, joint_values).link_transforms);
+
+        contacts.clear();
+        manager->contactTest(contacts, request);
+        for (const auto& contact : contacts)
+        {
+          const std::size_t a = link_index_.at(contact.first.first);
+          const std::size_t b = link_index_.at(contact.first.second);
+          if (a != b)
+            batch_contacts.emplace_back(std::min(a, b), std::max(a, b));
+        }
+      }
+      std::sort(batch_contacts.begin(), batch_contacts.end());
+
+      std::scoped_lock lock(mutex_);
+      const bool first_batch = (completed_samples_ == 0);
+      for (const auto& pair : batch_contacts)
+      {
+        if (contact_counts_[getPairIndex(pair.first, pair.second, link_count)]++ == 0)
+          changed_pairs_.push_back(pair);
+      }
+      completed_samples_ += last - first;
+
+      // Pairs only stay in contact in every sample if they were before this batch
+      auto is_always = [this, link_count](const std::pair<std::size_t, std::size_t>& pair) {
+        return contact_counts_[getPairIndex(pair.first, pair.second, link_count)] == completed_samples_;
+      };
+      if (first_batch)
+      {
+        std::unique_copy(batch_contacts.begin(), batch_contacts.end(), std::back_inserter(always_pairs_));
+        always_pairs_.erase(std::remove_if(always_pairs_.begin(),
+                                           always_pairs_.end(),
+                                           [&is_always](const auto& pair) { return !is_always(pair); }),
+                            always_pairs_.end());
+      }
+      else
+      {
+        auto always_end = std::stable_partition(always_pairs_.begin(), always_pairs_.end(), is_always);
+        changed_pairs_.insert(changed_pairs_.end(), always_end, always_pairs_.end());
+        always_pairs_.erase(always_end, always_pairs_.end());
+      }
+    }
+  }
+  catch (const std::exception& e)
+  {
+    cancelled_ = true;
+    std::scoped_lock lock(mutex_);
+    if (error_.empty())
+      error_ = e.what();
+  }
+
+  std::scoped_lock lock(mutex_);
+  ++finished_threads_;
+}
+
+void AllowedCollisionMatrixGenerator::report()
+{
+  // The counts are only copied for the first report, later reports take the pairs collected by the threads
+  std::vector<std::uint32_t> contact_counts;
+  std::vector<std::pair<std::size_t, std::size_t>> changed_pairs;
+  std::size_t completed_samples{ 0 };
+  bool all_finished{ false };
+  bool update{ false };
+  std::string error;
+  {
+    std::scoped_lock lock(mutex_);
+    completed_samples = completed_samples_;
+    all_finished = (finished_threads_ == workers_.size());
+    error = error_;
+    update = (!cancelled_ && completed_samples != reported_samples_ && completed_samples >= stable_sample_count_);
+    if (update && reported_samples_ == 0)
+      contact_counts = contact_counts_;
+    if (update)
+      changed_pairs.swap(changed_pairs_);
+  }
+
+  // Nothing is reported after cancelling, so a cancelled run can be discarded right away
+  if (cancelled_)
+    update = false;
+  else if (completed_samples != progress_samples_)
+    emit progressChanged(completed_samples, sample_count_);
+  progress_samples_ = completed_samples;
+
+  if (update)
+  {
+    const std::vector<AllowedCollisionEdit> edits =
+        (reported_samples_ == 0) ? classify(contact_counts, completed_samples) : declassify(changed_pairs);
+    reported_samples_ = completed_samples;
+    if (!edits.empty())
+      emit allowedCollisionsChanged(edits);
+  }
+
+  if (!all_finished)
+    return;
+
+  report_timer_.stop();
+  stop();
+
+  if (!error.empty())
+    emit generationFailed(QString::fromStdString(error));
+
+  emit finished(reported_samples_ < sample_count_);
+}
+
+std::vector<AllowedCollisionEdit>
+AllowedCollisionMatrixGenerator::classify(const std::vector<std::uint32_t>& contact_counts,
+                                          std::size_t completed_samples)
+{
+  const ScopedTimer timer("collision", "acm classify");
+  std::vector<AllowedCollisionEdit> edits;
+  const std::size_t link_count = link_names_.size();
+  std::size_t pair = 0;
+  for (std::size_t i = 0; i < link_count; ++i)
+  {
+    for (std::size_t j = i + 1; j < link_count; ++j, ++pair)
+    {
+      if (classifications_[pair] != Classification::NONE)
+        continue;
+
+      if (contact_counts[pair] == 0)
+      {
+        classifications_[pair] = Classification::NEVER;
+        edits.push_back({ link_names_[i], link_names_[j], NEVER_REASON, false });
+      }
+      else if (contact_counts[pair] == completed_samples)
+      {
+        classifications_[pair] = Classification::ALWAYS;
+        edits.push_back({ link_names_[i], link_names_[j], ALWAYS_REASON, false });
+      }
+    }
+  }
+  return edits;
+}
+
+std::vector<AllowedCollisionEdit>
+AllowedCollisionMatrixGenerator::declassify(const std::vector<std::pair<std::size_t, std::size_t>>& pairs)
+{
+  std::vector<AllowedCollisionEdit> edits;
+  const std::size_t link_count = link_names_.size();
+  for (const auto& link_pair : pairs)
+  {
+    Classification& classification = classifications_[getPairIndex(link_pair.first, link_pair.second, link_count)];
+    if (classification != Classification::NEVER && classification != Classification::ALWAYS)
+      continue;
+
+    classification = Classification::NONE;
+    edits.push_back({ link_names_[link_pair.first], link_names_[link_pair.second], "", true });
+  }
+  return edits;
+}
+
+}  // namespace tesseract_gui
@@ -0,0 +1,564 @@
+/**
+ * @file allowed_collision_matrix_model.cpp
+ * @brief Table model over a large allowed collision matrix
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <numeric>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/collision/allowed_collision_matrix_model.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+std::uint64_t getKey(std::uint32_t link_a, std::uint32_t link_b)
+{
+  return (static_cast<std::uint64_t>(link_a) << 32U) | link_b;
+}
+
+/** @brief Stable counting sort of rows by a key in [0, bucket_count) */
+template <typename KeyFn>
+void bucketSort(std::vector<std::uint32_t>& rows, std::size_t bucket_count, const KeyFn& key)
+{
+  std::vector<std::size_t> offsets(bucket_count + 1, 0);
+  for (const std::uint32_t row : rows)
+    ++offsets[key(row) + 1];
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  std::vector<std::uint32_t> sorted(rows.size());
+  for (const std::uint32_t row : rows)
+    sorted[offsets[key(row)]++] = row;
+  rows.swap(sorted);
+}
+
+/** @brief For each name whether it contains the text */
+std::vector<bool> matchNames(const std::vector<std::string>& names, const QString& text)
+{
+  std::vector<bool> matches(names.size());
+  for (std::size_t i = 0; i < names.size(); ++i)
+    matches[i] = QString::fromStdString(names[i]).contains(text, Qt::CaseInsensitive);
+  return matches;
+}
+}  // namespace
+
+AllowedCollisionMatrixModel::AllowedCollisionMatrixModel(QObject* parent) : QAbstractTableModel(parent) {}
+
+void AllowedCollisionMatrixModel::setAllowedCollisionMatrix(const tesseract_scene_graph::AllowedCollisionMatrix& acm,
+                                                            const std::vector<std::string>& link_names)
+{
+  const auto& allowed_collisions = acm.getAllAllowedCollisions();
+
+  beginResetModel();
+  link_names_ = link_names;
+  link_names_.reserve(link_names_.size() + (2 * allowed_collisions.size()));
+  for (const auto& allowed_collision : allowed_collisions)
+  {
+    link_names_.push_back(allowed_collision.first.first);
+    link_names_.push_back(allowed_collision.first.second);
+  }
+  std::sort(link_names_.begin(), link_names_.end());
+  link_names_.erase(std::unique(link_names_.begin(), link_names_.end()), link_names_.end());
+  link_names_.shrink_to_fit();
+
+  link_index_.clear();
+  for (std::size_t i = 0; i < link_names_.size(); ++i)
+    link_index_[link_names_[i]] = static_cast<std::uint32_t>(i);
+
+  reasons_.clear();
+  reason_index_.clear();
+  entries_.clear();
+  entries_.reserve(allowed_collisions.size());
+  for (const auto& allowed_collision : allowed_collisions)
+  {
+    std::uint32_t link_a = link_index_.at(allowed_collision.first.first);
+    std::uint32_t link_b = link_index_.at(allowed_collision.first.second);
+    if (link_a == link_b)
+      continue;
+
+    if (link_a > link_b)
+      std::swap(link_a, link_b);
+    entries_.push_back({ link_a, link_b, getReasonIndex(allowed_collision.second) });
+  }
+
+  const auto less = [](const Entry& a, const Entry& b) {
+    return getKey(a.link_a, a.link_b) < getKey(b.link_a, b.link_b);
+  };
+  const auto equal = [](const Entry& a, const Entry& b) { return a.link_a == b.link_a && a.link_b == b.link_b; };
+  std::sort(entries_.begin(), entries_.end(), less);
+  entries_.erase(std::unique(entries_.begin(), entries_.end(), equal), entries_.end());
+
+  pending_changes_.clear();
+  rows_ = computeRows();
+  endResetModel();
+
+  emit pendingChangesChanged(0);
+}
+
+void AllowedCollisionMatrixModel::setEnvironment(const tesseract_environment::Environment& environment)
+{
+  const tesseract_scene_graph::AllowedCollisionMatrix::ConstPtr acm = environment.getAllowedCollisionMatrix();
+  setAllowedCollisionMatrix((acm != nullptr) ? *acm : tesseract_scene_graph::AllowedCollisionMatrix(),
+                            environment.getLinkNames());
+}
+
+tesseract_scene_graph::AllowedCollisionMatrix AllowedCollisionMatrixModel::getAllowedCollisionMatrix() const
+{
+  tesseract_scene_graph::AllowedCollisionMatrix acm;
+  acm.reserveAllowedCollisionMatrix(entries_.size());
+  for (const Entry& entry : entries_)
+    acm.addAllowedCollision(link_names_[entry.link_a], link_names_[entry.link_b], reasons_[entry.reason]);
+  return acm;
+}
+
+const std::vector<std::string>& AllowedCollisionMatrixModel::getLinkNames() const { return link_names_; }
+
+std::size_t AllowedCollisionMatrixModel::getEntryCount() const { return entries_.size(); }
+
+bool AllowedCollisionMatrixModel::isCollisionAllowed(const std::string& link_a, const std::string& link_b) const
+{
+  auto a = link_index_.find(link_a);
+  auto b = link_index_.find(link_b);
+  if (a == link_index_.end() || b == link_index_.end())
+    return false;
+
+  return findEntry(std::min(a->second, b->second), std::max(a->second, b->second)) >= 0;
+}
+
+void AllowedCollisionMatrixModel::modify(const std::vector<AllowedCollisionEdit>& edits)
+{
+  if (edits.empty())
+    return;
+
+  std::vector<std::string> new_link_names;
+  for (const auto& edit : edits)
+  {
+    for (const std::string* link : { &edit.link_a, &edit.link_b })
+    {
+      if (link_index_.count(*link) == 0)
+        new_link_names.push_back(*link);
+    }
+  }
+  if (!new_link_names.empty())
+    addLinkNames(std::move(new_link_names));
+
+  std::vector<Entry> changes;
+  changes.reserve(edits.size());
+  for (const auto& edit : edits)
+  {
+    std::uint32_t link_a = link_index_.at(edit.link_a);
+    std::uint32_t link_b = link_index_.at(edit.link_b);
+    if (link_a == link_b)
+      continue;
+
+    if (link_a > link_b)
+      std::swap(link_a, link_b);
+    changes.push_back({ link_a, link_b, edit.remove ? REMOVED : getReasonIndex(edit.reason) });
+  }
+
+  // Stable, so the last edit of a pair is the last of its run
+  std::stable_sort(changes.begin(), changes.end(), [](const Entry& a, const Entry& b) {
+    return getKey(a.link_a, a.link_b) < getKey(b.link_a, b.link_b);
+  });
+
+  // Merge the changes, recording where every entry moved and which kept their pair but changed their reason
+  std::vector<Entry> merged;
+  merged.reserve(entries_.size() + changes.size());
+  std::vector<std::int64_t> entry_map(entries_.size(), -1);
+  std::vector<std::uint32_t> changed_reasons;
+  bool pairs_changed{ false };
+  std::size_t e = 0;
+  auto copy_entry = [&]() {
+    entry_map[e] = static_cast<std::int64_t>(merged.size());
+    merged.push_back(entries_[e++]);
+  };
+  for (std::size_t c = 0; c < changes.size(); ++c)
+  {
+    const Entry& change = changes[c];
+    const std::uint64_t key = getKey(change.link_a, change.link_b);
+    if (c + 1 < changes.size() && getKey(changes[c + 1].link_a, changes[c + 1].link_b) == key)
+      continue;
+
+    while (e < entries_.size() && getKey(entries_[e].link_a, entries_[e].link_b) < key)
+      copy_entry();
+
+    std::uint32_t previous = REMOVED;
+    if (e < entries_.size() && getKey(entries_[e].link_a, entries_[e].link_b) == key)
+    {
+      previous = entries_[e].reason;
+      if (change.reason != REMOVED)
+        entry_map[e] = static_cast<std::int64_t>(merged.size());
+      ++e;
+    }
+
+    if (change.reason == previous)
+    {
+      if (previous != REMOVED)
+        merged.push_back(change);
+      continue;
+    }
+
+    if (change.reason != REMOVED && previous != REMOVED)
+      changed_reasons.push_back(static_cast<std::uint32_t>(merged.size()));
+    else
+      pairs_changed = true;
+
+    if (change.reason != REMOVED)
+      merged.push_back(change);
+
+    setPendingChange(change.link_a, change.link_b, change.reason);
+  }
+  while (e < entries_.size())
+    copy_entry();
+
+  // Rows only change with added or removed pairs or if they depend on the reasons, the view keeps its selection and
+  // scroll position in either case
+  if (pairs_changed || (!changed_reasons.empty() && (!filter_.isEmpty() || sort_column_ == REASON_COLUMN)))
+  {
+    emit layoutAboutToBeChanged();
+    entries_.swap(merged);
+    std::vector<std::uint32_t> rows = computeRows();
+    remapPersistentIndexes(rows, entry_map);
+    rows_.swap(rows);
+    emit layoutChanged();
+  }
+  else if (!changed_reasons.empty())
+  {
+    entries_.swap(merged);
+    std::vector<int> entry_rows(entries_.size(), -1);
+    for (std::size_t row = 0; row < rows_.size(); ++row)
+      entry_rows[rows_[row]] = static_cast<int>(row);
+
+    for (const std::uint32_t entry : changed_reasons)
+    {
+      const QModelIndex changed = index(entry_rows[entry], REASON_COLUMN);
+      emit dataChanged(changed, changed);
+    }
+  }
+
+  emit pendingChangesChanged(pending_changes_.size());
+}
+
+void AllowedCollisionMatrixModel::addAllowedCollision(const std::string& link_a,
+                                                      const std::string& link_b,
+                                                      const std::string& reason)
+{
+  modify({ AllowedCollisionEdit{ link_a, link_b, reason, false } });
+}
+
+void AllowedCollisionMatrixModel::removeAllowedCollision(const std::string& link_a, const std::string& link_b)
+{
+  modify({ AllowedCollisionEdit{ link_a, link_b, "", true } });
+}
+
+std::size_t AllowedCollisionMatrixModel::getPendingChangeCount() const { return pending_changes_.size(); }
+
+tesseract_environment::ModifyAllowedCollisionsCommand::Ptr AllowedCollisionMatrixModel::createCommand() const
+{
+  if (pending_changes_.empty())
+    return nullptr;
+
+  bool has_additions = false;
+  bool has_removals = false;
+  for (const auto& change : pending_changes_)
+  {
+    if (change.second == REMOVED)
+      has_removals = true;
+    else
+      has_additions = true;
+  }
+
+  if (has_additions && has_removals)
+    return std::make_shared<tesseract_environment::ModifyAllowedCollisionsCommand>(
+        getAllowedCollisionMatrix(), tesseract_environment::ModifyAllowedCollisionsType::REPLACE);
+
+  tesseract_scene_graph::AllowedCollisionMatrix acm;
+  acm.reserveAllowedCollisionMatrix(pending_changes_.size());
+  for (const auto& change : pending_changes_)
+    acm.addAllowedCollision(
+        change.first.first, change.first.second, has_additions ? reasons_[change.second] : std::string());
+
+  return std::make_shared<tesseract_environment::ModifyAllowedCollisionsCommand>(
+      std::move(acm),
+      has_additions ? tesseract_environment::ModifyAllowedCollisionsType::ADD :
+                      tesseract_environment::ModifyAllowedCollisionsType::REMOVE);
+}
+
+bool AllowedCollisionMatrixModel::applyChanges(tesseract_environment::Environment& environment)
+{
+  const tesseract_environment::ModifyAllowedCollisionsCommand::Ptr command = createCommand();
+  if (command == nullptr)
+    return true;
+
+  if (!environment.applyCommand(command))
+    return false;
+
+  pending_changes_.clear();
+  emit pendingChangesChanged(0);
+  return true;
+}
+
+void AllowedCollisionMatrixModel::setFilter(const QString& text)
+{
+  if (text == filter_)
+    return;
+
+  filter_ = text;
+  setRows(computeRows());
+}
+
+QString AllowedCollisionMatrixModel::getFilter() const { return filter_; }
+
+std::size_t AllowedCollisionMatrixModel::getEntryIndex(int row) const
+{
+  return rows_.at(static_cast<std::size_t>(row));
+}
+
+int AllowedCollisionMatrixModel::rowCount(const QModelIndex& parent) const
+{
+  if (parent.isValid())
+    return 0;
+
+  return static_cast<int>(rows_.size());
+}
+
+int AllowedCollisionMatrixModel::columnCount(const QModelIndex& parent) const
+{
+  if (parent.isValid())
+    return 0;
+
+  return COLUMN_COUNT;
+}
+
+QVariant AllowedCollisionMatrixModel::data(const QModelIndex& index, int role) const
+{
+  if (!index.isValid() || (role != Qt::DisplayRole && role != Qt::EditRole))
+    return {};
+
+  const Entry& entry = entries_[rows_[static_cast<std::size_t>(index.row())]];
+  switch (index.column())
+  {
+    case LINK_A_COLUMN:
+      return QString::fromStdString(link_names_[entry.link_a]);
+    case LINK_B_COLUMN:
+      return QString::fromStdString(link_names_[entry.link_b]);
+    case REASON_COLUMN:
+      return QString::fromStdString(reasons_[entry.reason]);
+    default:
+      return {};
+  }
+}
+
+QVariant AllowedCollisionMatrixModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+  if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+    return {};
+
+  switch (section)
+  {
+    case LINK_A_COLUMN:
+      return "Link A";
+    case LINK_B_COLUMN:
+      return "Link B";
+    case REASON_COLUMN:
+      return "Reason";
+    default:
+      return {};
+  }
+}
+
+Qt::ItemFlags AllowedCollisionMatrixModel::flags(const QModelIndex& index) const
+{
+  Qt::ItemFlags flags = QAbstractTableModel::flags(index);
+  if (index.isValid() && index.column() == REASON_COLUMN)
+    flags |= Qt::ItemIsEditable;
+
+  return flags;
+}
+
+bool AllowedCollisionMatrixModel::setData(const QModelIndex& index, const QVariant& value, int role)
+{
+  if (!index.isValid() || index.column() != REASON_COLUMN || role != Qt::EditRole)
+    return false;
+
+  // Through modify() so the rows are recomputed if the filter or the sort order depend on the reason
+  const Entry& entry = entries_[rows_[static_cast<std::size_t>(index.row())]];
+  const std::string reason = value.toString().toStdString();
+  if (reason == reasons_[entry.reason])
+    return false;
+
+  modify({ AllowedCollisionEdit{ link_names_[entry.link_a], link_names_[entry.link_b], reason, false } });
+  return true;
+}
+
+bool AllowedCollisionMatrixModel::removeRows(int row, int count, const QModelIndex& parent)
+{
+  if (parent.isValid() || row < 0 || count <= 0 || row + count > rowCount())
+    return false;
+
+  std::vector<AllowedCollisionEdit> edits;
+  edits.reserve(static_cast<std::size_t>(count));
+  for (int r = row; r < row + count; ++r)
+  {
+    const Entry& entry = entries_[rows_[static_cast<std::size_t>(r)]];
+    edits.push_back({ link_names_[entry.link_a], link_names_[entry.link_b], "", true });
+  }
+  modify(edits);
+  return true;
+}
+
+void AllowedCollisionMatrixModel::sort(int column, Qt::SortOrder order)
+{
+  sort_column_ = column;
+  sort_order_ = order;
+  setRows(computeRows());
+}
+
+std::uint32_t AllowedCollisionMatrixModel::getReasonIndex(const std::string& reason)
+{
+  auto it = reason_index_.find(reason);
+  if (it != reason_index_.end())
+    return it->second;
+
+  const auto index = static_cast<std::uint32_t>(reasons_.size());
+  reasons_.push_back(reason);
+  reason_index_.emplace(reason, index);
+  return index;
+}
+
+void AllowedCollisionMatrixModel::addLinkNames(std::vector<std::string> link_names)
+{
+  std::vector<std::string> merged = link_names_;
+  merged.insert(merged.end(), link_names.begin(), link_names.end());
+  std::sort(merged.begin(), merged.end());
+  merged.erase(std::unique(merged.begin(), merged.end()), merged.end());
+
+  // The new order is a monotonic mapping of the old one, so the entries stay sorted
+  std::vector<std::uint32_t> new_index(link_names_.size());
+  for (std::size_t i = 0; i < link_names_.size(); ++i)
+    new_index[i] = static_cast<std::uint32_t>(
+        std::lower_bound(merged.begin(), merged.end(), link_names_[i]) - merged.begin());
+
+  for (Entry& entry : entries_)
+  {
+    entry.link_a = new_index[entry.link_a];
+    entry.link_b = new_index[entry.link_b];
+  }
+
+  link_names_.swap(merged);
+  link_index_.clear();
+  for (std::size_t i = 0; i < link_names_.size(); ++i)
+    link_index_[link_names_[i]] = static_cast<std::uint32_t>(i);
+}
+
+std::ptrdiff_t AllowedCollisionMatrixModel::findEntry(std::uint32_t link_a, std::uint32_t link_b) const
+{
+  const std::uint64_t key = getKey(link_a, link_b);
+  auto it = std::lower_bound(entries_.begin(), entries_.end(), key, [](const Entry& entry, std::uint64_t value) {
+    return getKey(entry.link_a, entry.link_b) < value;
+  });
+
+  if (it == entries_.end() || getKey(it->link_a, it->link_b) != key)
+    return -1;
+
+  return it - entries_.begin();
+}
+
+std::vector<std::uint32_t> AllowedCollisionMatrixModel::computeRows() const
+{
+  std::vector<std::uint32_t> rows;
+  rows.reserve(entries_.size());
+  if (filter_.isEmpty())
+  {
+    for (std::size_t i = 0; i < entries_.size(); ++i)
+      rows.push_back(static_cast<std::uint32_t>(i));
+  }
+  else
+  {
+    const std::vector<bool> link_matches = matchNames(link_names_, filter_);
+    const std::vector<bool> reason_matches = matchNames(reasons_, filter_);
+    for (std::size_t i = 0; i < entries_.size(); ++i)
+    {
+      const Entry& entry = entries_[i];
+      if (link_matches[entry.link_a] || link_matches[entry.link_b] || reason_matches[entry.reason])
+        rows.push_back(static_cast<std::uint32_t>(i));
+    }
+  }
+
+  // Rows are in entry order, which is sorted by the first then the second link
+  if (sort_column_ == LINK_B_COLUMN)
+  {
+    bucketSort(rows, link_names_.size(), [this](std::uint32_t row) { return entries_[row].link_b; });
+  }
+  else if (sort_column_ == REASON_COLUMN)
+  {
+    std::vector<std::uint32_t> order(reasons_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(
+        order.begin(), order.end(), [this](std::uint32_t a, std::uint32_t b) { return reasons_[a] < reasons_[b]; });
+
+    std::vector<std::uint32_t> rank(reasons_.size());
+    for (std::size_t i = 0; i < order.size(); ++i)
+      rank[order[i]] = static_cast<std::uint32_t>(i);
+
+    bucketSort(rows, reasons_.size(), [this, &rank](std::uint32_t row) { return rank[entries_[row].reason]; });
+  }
+
+  if (sort_column_ >= 0 && sort_order_ == Qt::DescendingOrder)
+    std::reverse(rows.begin(), rows.end());
+
+  return rows;
+}
+
+void AllowedCollisionMatrixModel::setRows(std::vector<std::uint32_t> rows)
+{
+  emit layoutAboutToBeChanged();
+  remapPersistentIndexes(rows, {});
+  rows_.swap(rows);
+  emit layoutChanged();
+}
+
+void AllowedCollisionMatrixModel::remapPersistentIndexes(const std::vector<std::uint32_t>& rows,
+                                                         const std::vector<std::int64_t>& entry_map)
+{
+  const QModelIndexList old_indexes = persistentIndexList();
+  if (old_indexes.isEmpty())
+    return;
+
+  std::vector<int> new_rows(entries_.size(), -1);
+  for (std::size_t row = 0; row < rows.size(); ++row)
+    new_rows[rows[row]] = static_cast<int>(row);
+
+  QModelIndexList new_indexes;
+  new_indexes.reserve(old_indexes.size());
+  for (const QModelIndex& old_index : old_indexes)
+  {
+    const std::uint32_t old_entry = rows_[static_cast<std::size_t>(old_index.row())];
+    const std::int64_t entry = entry_map.empty() ? static_cast<std::int64_t>(old_entry) : entry_map[old_entry];
+    const int row = (entry < 0) ? -1 : new_rows[static_cast<std::size_t>(entry)];
+    new_indexes.append((row < 0) ? QModelIndex() : createIndex(row, old_index.column()));
+  }
+  changePersistentIndexList(old_indexes, new_indexes);
+}
+
+void AllowedCollisionMatrixModel::setPendingChange(std::uint32_t link_a, std::uint32_t link_b, std::uint32_t reason)
+{
+  pending_changes_[std::make_pair(link_names_[link_a], link_names_[link_b])] = reason;
+}
+
+}  // namespace tesseract_gui
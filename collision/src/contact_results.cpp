@@ -0,0 +1,112 @@
+/**
+ * @file contact_results.cpp
+ * @brief Compact storage of contact results for display
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_gui/collision/contact_results.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+std::array<float, 3> toFloat(const Eigen::Vector3d& vector)
+{
+  return { static_cast<float>(vector.x()), static_cast<float>(vector.y()), static_cast<float>(vector.z()) };
+}
+}  // namespace
+
+ContactResults::ContactResults(const tesseract_collision::ContactResultMap& results) { add(results); }
+
+void ContactResults::add(const tesseract_collision::ContactResult& result)
+{
+  Contact contact{};
+  contact.point_a = toFloat(result.nearest_points[0]);
+  contact.point_b = toFloat(result.nearest_points[1]);
+  contact.normal = toFloat(result.normal);
+  contact.distance = static_cast<float>(result.distance);
+  contact.link_pair = getLinkPairIndex(result.link_names[0], result.link_names[1]);
+  contacts_.push_back(contact);
+}
+
+void ContactResults::add(const tesseract_collision::ContactResultMap& results)
+{
+  for (const auto& pair : results)
+  {
+    contacts_.reserve(contacts_.size() + pair.second.size());
+    for (const auto& result : pair.second)
+      add(result);
+  }
+}
+
+void ContactResults::clear()
+{
+  contacts_.clear();
+  link_pairs_.clear();
+  link_pair_index_.clear();
+}
+
+std::size_t ContactResults::size() const { return contacts_.size(); }
+
+bool ContactResults::empty() const { return contacts_.empty(); }
+
+const std::vector<ContactResults::Contact>& ContactResults::getContacts() const { return contacts_; }
+
+const std::vector<std::pair<std::string, std::string>>& ContactResults::getLinkPairs() const { return link_pairs_; }
+
+int ContactResults::findLinkPair(const std::string& link_a, const std::string& link_b) const
+{
+  auto it = link_pair_index_.find(std::make_pair(link_a, link_b));
+  if (it == link_pair_index_.end())
+    it = link_pair_index_.find(std::make_pair(link_b, link_a));
+
+  return (it == link_pair_index_.end()) ? -1 : static_cast<int>(it->second);
+}
+
+std::uint32_t ContactResults::getLinkPairIndex(const std::string& link_a, const std::string& link_b)
+{
+  auto key = std::make_pair(link_a, link_b);
+  auto it = link_pair_index_.find(key);
+  if (it != link_pair_index_.end())
+    return it->second;
+
+  const auto index = static_cast<std::uint32_t>(link_pairs_.size());
+  link_pairs_.push_back(key);
+  link_pair_index_.emplace(std::move(key), index);
+  return index;
+}
+
+void ContactResultFilter::setLinkPairVisible(std::size_t link_pair, bool visible)
+{
+  if (link_pair >= hidden_link_pairs.size())
+  {
+    if (visible)
+      return;
+
+    hidden_link_pairs.resize(link_pair + 1, false);
+  }
+  hidden_link_pairs[link_pair] = !visible;
+}
+
+bool ContactResultFilter::isLinkPairVisible(std::size_t link_pair) const
+{
+  return link_pair >= hidden_link_pairs.size() || !hidden_link_pairs[link_pair];
+}
+
+bool ContactResultFilter::isVisible(const ContactResults::Contact& contact) const
+{
+  return static_cast<double>(contact.distance) <= distance_threshold && isLinkPairVisible(contact.link_pair);
+}
+
+}  // namespace tesseract_gui
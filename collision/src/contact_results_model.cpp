@@ -0,0 +1,195 @@
+/**
+ * @file contact_results_model.cpp
+ * @brief Table model over contact results
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <QString>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/collision/contact_results_model.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+QString formatVector(const std::array<float, 3>& vector)
+{
+  return QString("%1, %2, %3").arg(vector[0], 0, 'f', 4).arg(vector[1], 0, 'f', 4).arg(vector[2], 0, 'f', 4);
+}
+}  // namespace
+
+ContactResultsModel::ContactResultsModel(QObject* parent) : QAbstractTableModel(parent) {}
+
+void ContactResultsModel::setContactResults(ContactResults::ConstPtr results)
+{
+  beginResetModel();
+  results_ = std::move(results);
+  rows_ = filterRows();
+  endResetModel();
+}
+
+ContactResults::ConstPtr ContactResultsModel::getContactResults() const { return results_; }
+
+void ContactResultsModel::clear() { setContactResults(nullptr); }
+
+void ContactResultsModel::setFilter(ContactResultFilter filter)
+{
+  filter_ = std::move(filter);
+  applyFilter();
+}
+
+const ContactResultFilter& ContactResultsModel::getFilter() const { return filter_; }
+
+void ContactResultsModel::setDistanceThreshold(double distance)
+{
+  filter_.distance_threshold = distance;
+  applyFilter();
+}
+
+void ContactResultsModel::setLinkPairVisible(std::size_t link_pair, bool visible)
+{
+  filter_.setLinkPairVisible(link_pair, visible);
+  applyFilter();
+}
+
+std::size_t ContactResultsModel::getContactIndex(int row) const { return rows_.at(static_cast<std::size_t>(row)); }
+
+int ContactResultsModel::rowCount(const QModelIndex& parent) const
+{
+  if (parent.isValid())
+    return 0;
+
+  return static_cast<int>(rows_.size());
+}
+
+int ContactResultsModel::columnCount(const QModelIndex& parent) const
+{
+  if (parent.isValid())
+    return 0;
+
+  return COLUMN_COUNT;
+}
+
+QVariant ContactResultsModel::data(const QModelIndex& index, int role) const
+{
+  if (!index.isValid())
+    return {};
+
+  const std::uint32_t contact_index = rows_[static_cast<std::size_t>(index.row())];
+  const ContactResults::Contact& contact = results_->getContacts()[contact_index];
+  if (role == ContactIndexRole)
+    return contact_index;
+
+  if (role == LinkPairRole)
+    return contact.link_pair;
+
+  if (role != Qt::DisplayRole)
+    return {};
+
+  const auto& link_pair = results_->getLinkPairs()[contact.link_pair];
+  switch (index.column())
+  {
+    case LINK_A_COLUMN:
+      return QString::fromStdString(link_pair.first);
+    case LINK_B_COLUMN:
+      return QString::fromStdString(link_pair.second);
+    case DISTANCE_COLUMN:
+      return contact.distance;
+    case POINT_A_COLUMN:
+      return formatVector(contact.point_a);
+    case POINT_B_COLUMN:
+      return formatVector(contact.point_b);
+    case NORMAL_COLUMN:
+      return formatVector(contact.normal);
+    default:
+      return {};
+  }
+}
+
+QVariant ContactResultsModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+  if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+    return {};
+
+  switch (section)
+  {
+    case LINK_A_COLUMN:
+      return "Link A";
+    case LINK_B_COLUMN:
+      return "Link B";
+    case DISTANCE_COLUMN:
+      return "Distance";
+    case POINT_A_COLUMN:
+      return "Point A";
+    case POINT_B_COLUMN:
+      return "Point B";
+    case NORMAL_COLUMN:
+      return "Normal";
+    default:
+      return {};
+  }
+}
+
+std::vector<std::uint32_t> ContactResultsModel::filterRows() const
+{
+  std::vector<std::uint32_t> rows;
+  if (results_ == nullptr)
+    return rows;
+
+  const auto& contacts = results_->getContacts();
+  rows.reserve(contacts.size());
+  for (std::size_t i = 0; i < contacts.size(); ++i)
+  {
+    if (filter_.isVisible(contacts[i]))
+      rows.push_back(static_cast<std::uint32_t>(i));
+  }
+  return rows;
+}
+
+void ContactResultsModel::applyFilter()
+{
+  std::vector<std::uint32_t> rows = filterRows();
+  if (rows != rows_)
+  {
+    emit layoutAboutToBeChanged();
+
+    const QModelIndexList old_indexes = persistentIndexList();
+    if (!old_indexes.isEmpty())
+    {
+      // Map contact index to its new row, contacts which got filtered out lose their persistent indices
+      std::vector<int> new_rows(results_->size(), -1);
+      for (std::size_t row = 0; row < rows.size(); ++row)
+        new_rows[rows[row]] = static_cast<int>(row);
+
+      QModelIndexList new_indexes;
+      new_indexes.reserve(old_indexes.size());
+      for (const QModelIndex& old_index : old_indexes)
+      {
+        const int row = new_rows[rows_[static_cast<std::size_t>(old_index.row())]];
+        new_indexes.append((row < 0) ? QModelIndex() : createIndex(row, old_index.column()));
+      }
+      changePersistentIndexList(old_indexes, new_indexes);
+    }
+
+    rows_.swap(rows);
+    emit layoutChanged();
+  }
+
+  emit filterChanged();
+}
+
+}  // namespace tesseract_gui
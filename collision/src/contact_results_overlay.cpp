@@ -0,0 +1,289 @@
+/**
+ * @file contact_results_overlay.cpp
+ * @brief Draws contact points and normals with instanced rendering
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/collision/contact_results_overlay.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+/** @brief The width of the link pair visibility texture, link pair i is texel (i % width, i / width) */
+constexpr std::size_t LINK_PAIR_TEXTURE_WIDTH = 1024;
+
+/**
+ * @brief The line vertices of one contact
+ *
+ * x selects the anchor: 0 the first nearest point, 1 the second nearest point, 2 the first nearest point moved along
+ * the normal by y times the normal length. For the anchors 0 and 1 yzw is an offset scaled by the marker size.
+ */
+// clang-format off
+const float CONTACT_VERTICES[] = {
+  0, -1, 0, 0,   0, 1, 0, 0,
+  0, 0, -1, 0,   0, 0, 1, 0,
+  0, 0, 0, -1,   0, 0, 0, 1,
+  1, -1, 0, 0,   1, 1, 0, 0,
+  1, 0, -1, 0,   1, 0, 1, 0,
+  1, 0, 0, -1,   1, 0, 0, 1,
+  0, 0, 0, 0,    1, 0, 0, 0,
+  2, 0, 0, 0,    2, 1, 0, 0,
+};
+// clang-format on
+constexpr GLsizei CONTACT_VERTEX_COUNT = sizeof(CONTACT_VERTICES) / (4 * sizeof(float));
+
+const char* VERTEX_SHADER = R"(
+#version 330 core
+layout(location = 0) in vec4 vertex;
+layout(location = 1) in vec3 point_a;
+layout(location = 2) in vec3 point_b;
+layout(location = 3) in vec3 normal;
+layout(location = 4) in float distance;
+layout(location = 5) in uint link_pair;
+
+uniform mat4 view_projection;
+uniform float marker_size;
+uniform float normal_length;
+uniform float distance_threshold;
+uniform usampler2D link_pair_visibility;
+
+out vec4 color;
+
+void main()
+{
+  int width = textureSize(link_pair_visibility, 0).x;
+  ivec2 texel = ivec2(int(link_pair) % width, int(link_pair) / width);
+  if (distance > distance_threshold || texelFetch(link_pair_visibility, texel, 0).r == 0u)
+  {
+    // Outside of the clip volume, the line is discarded before rasterization
+    gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+    color = vec4(0.0);
+    return;
+  }
+
+  int anchor = int(vertex.x + 0.5);
+  vec3 position;
+  if (anchor == 0)
+    position = point_a + (vertex.yzw * marker_size);
+  else if (anchor == 1)
+    position = point_b + (vertex.yzw * marker_size);
+  else
+    position = point_a + (normal * (vertex.y * normal_length));
+
+  if (anchor == 2)
+    color = vec4(0.2, 0.6, 1.0, 1.0);
+  else if (distance < 0.0)
+    color = vec4(1.0, 0.1, 0.1, 1.0);
+  else
+    color = vec4(1.0, 0.85, 0.1, 1.0);
+
+  gl_Position = view_projection * vec4(position, 1.0);
+}
+)";
+
+const char* FRAGMENT_SHADER = R"(
+#version 330 core
+in vec4 color;
+
+out vec4 fragment_color;
+
+void main()
+{
+  fragment_color = color;
+}
+)";
+}  // namespace
+
+void ContactResultsOverlay::setContactResults(ContactResults::ConstPtr results)
+{
+  results_ = std::move(results);
+  results_dirty_ = true;
+  filter_dirty_ = true;
+}
+
+ContactResults::ConstPtr ContactResultsOverlay::getContactResults() const { return results_; }
+
+void ContactResultsOverlay::setFilter(ContactResultFilter filter)
+{
+  filter_ = std::move(filter);
+  filter_dirty_ = true;
+}
+
+const ContactResultFilter& ContactResultsOverlay::getFilter() const { return filter_; }
+
+void ContactResultsOverlay::setMarkerSize(float size) { marker_size_ = std::max(size, 0.0F); }
+
+float ContactResultsOverlay::getMarkerSize() const { return marker_size_; }
+
+void ContactResultsOverlay::setNormalLength(float length) { normal_length_ = std::max(length, 0.0F); }
+
+float ContactResultsOverlay::getNormalLength() const { return normal_length_; }
+
+void ContactResultsOverlay::setVisible(bool visible) { visible_ = visible; }
+
+bool ContactResultsOverlay::isVisible() const { return visible_; }
+
+void ContactResultsOverlay::initialize(QOpenGLExtraFunctions& gl)
+{
+  program_ = std::make_unique<QOpenGLShaderProgram>();
+  if (!program_->addShaderFromSourceCode(QOpenGLShader::Vertex, VERTEX_SHADER) ||
+      !program_->addShaderFromSourceCode(QOpenGLShader::Fragment, FRAGMENT_SHADER) || !program_->link())
+    throw std::runtime_error("ContactResultsOverlay, failed to build shader program: " +
+                             program_->log().toStdString());
+
+  view_projection_location_ = program_->uniformLocation("view_projection");
+  marker_size_location_ = program_->uniformLocation("marker_size");
+  normal_length_location_ = program_->uniformLocation("normal_length");
+  distance_threshold_location_ = program_->uniformLocation("distance_threshold");
+  link_pair_visibility_location_ = program_->uniformLocation("link_pair_visibility");
+
+  gl.glGenVertexArrays(1, &vao_);
+  gl.glBindVertexArray(vao_);
+
+  gl.glGenBuffers(1, &vertex_buffer_);
+  gl.glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_);
+  gl.glBufferData(GL_ARRAY_BUFFER, sizeof(CONTACT_VERTICES), CONTACT_VERTICES, GL_STATIC_DRAW);
+  gl.glEnableVertexAttribArray(0);
+  gl.glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+  using Contact = ContactResults::Contact;
+  const auto stride = static_cast<GLsizei>(sizeof(Contact));
+  gl.glGenBuffers(1, &instance_buffer_);
+  gl.glBindBuffer(GL_ARRAY_BUFFER, instance_buffer_);
+  const auto attribute = [&gl, stride](GLuint location, GLint size, std::size_t offset) {
+    gl.glEnableVertexAttribArray(location);
+    gl.glVertexAttribPointer(location, size, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const void*>(offset));
+    gl.glVertexAttribDivisor(location, 1);
+  };
+  attribute(1, 3, offsetof(Contact, point_a));
+  attribute(2, 3, offsetof(Contact, point_b));
+  attribute(3, 3, offsetof(Contact, normal));
+  attribute(4, 1, offsetof(Contact, distance));
+  gl.glEnableVertexAttribArray(5);
+  gl.glVertexAttribIPointer(
+      5, 1, GL_UNSIGNED_INT, stride, reinterpret_cast<const void*>(offsetof(Contact, link_pair)));
+  gl.glVertexAttribDivisor(5, 1);
+
+  gl.glBindVertexArray(0);
+  gl.glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  gl.glGenTextures(1, &link_pair_texture_);
+  gl.glBindTexture(GL_TEXTURE_2D, link_pair_texture_);
+  gl.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  gl.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  gl.glBindTexture(GL_TEXTURE_2D, 0);
+
+  instance_count_ = 0;
+  results_dirty_ = true;
+  filter_dirty_ = true;
+}
+
+void ContactResultsOverlay::cleanup(QOpenGLExtraFunctions& gl)
+{
+  gl.glDeleteTextures(1, &link_pair_texture_);
+  gl.glDeleteBuffers(1, &instance_buffer_);
+  gl.glDeleteBuffers(1, &vertex_buffer_);
+  gl.glDeleteVertexArrays(1, &vao_);
+  link_pair_texture_ = 0;
+  instance_buffer_ = 0;
+  vertex_buffer_ = 0;
+  vao_ = 0;
+  instance_count_ = 0;
+  program_.reset();
+}
+
+void ContactResultsOverlay::render(QOpenGLExtraFunctions& gl,
+                                   const Eigen::Matrix4f& view_projection,
+                                   const Camera& /*camera*/)
+{
+  if (results_dirty_)
+    uploadContacts(gl);
+
+  if (filter_dirty_)
+    uploadFilter(gl);
+
+  if (!visible_ || instance_count_ == 0)
+    return;
+
+  const float threshold =
+      static_cast<float>(std::min(filter_.distance_threshold, static_cast<double>(std::numeric_limits<float>::max())));
+
+  program_->bind();
+  gl.glUniformMatrix4fv(view_projection_location_, 1, GL_FALSE, view_projection.data());
+  gl.glUniform1f(marker_size_location_, marker_size_);
+  gl.glUniform1f(normal_length_location_, normal_length_);
+  gl.glUniform1f(distance_threshold_location_, threshold);
+  gl.glActiveTexture(GL_TEXTURE0);
+  gl.glBindTexture(GL_TEXTURE_2D, link_pair_texture_);
+  gl.glUniform1i(link_pair_visibility_location_, 0);
+
+  gl.glBindVertexArray(vao_);
+  gl.glDrawArraysInstanced(GL_LINES, 0, CONTACT_VERTEX_COUNT, instance_count_);
+
+  gl.glBindVertexArray(0);
+  gl.glBindTexture(GL_TEXTURE_2D, 0);
+  program_->release();
+}
+
+void ContactResultsOverlay::uploadContacts(QOpenGLExtraFunctions& gl)
+{
+  const std::size_t count = (results_ == nullptr) ? 0 : results_->size();
+  gl.glBindBuffer(GL_ARRAY_BUFFER, instance_buffer_);
+  gl.glBufferData(GL_ARRAY_BUFFER,
+                  static_cast<GLsizeiptr>(count * sizeof(ContactResults::Contact)),
+                  (count > 0) ? results_->getContacts().data() : nullptr,
+                  GL_STATIC_DRAW);
+  gl.glBindBuffer(GL_ARRAY_BUFFER, 0);
+  instance_count_ = static_cast<GLsizei>(count);
+  results_dirty_ = false;
+}
+
+void ContactResultsOverlay::uploadFilter(QOpenGLExtraFunctions& gl)
+{
+  const std::size_t link_pair_count = (results_ == nullptr) ? 0 : results_->getLinkPairs().size();
+  const std::size_t width = std::max<std::size_t>(std::min(link_pair_count, LINK_PAIR_TEXTURE_WIDTH), 1);
+  const std::size_t height = std::max<std::size_t>((link_pair_count + width - 1) / width, 1);
+
+  std::vector<std::uint8_t> visibility(width * height, 0);
+  for (std::size_t i = 0; i < link_pair_count; ++i)
+    visibility[i] = filter_.isLinkPairVisible(i) ? 1 : 0;
+
+  gl.glBindTexture(GL_TEXTURE_2D, link_pair_texture_);
+  gl.glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  gl.glTexImage2D(GL_TEXTURE_2D,
+                  0,
+                  GL_R8UI,
+                  static_cast<GLsizei>(width),
+                  static_cast<GLsizei>(height),
+                  0,
+                  GL_RED_INTEGER,
+                  GL_UNSIGNED_BYTE,
+                  visibility.data());
+  gl.glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+  gl.glBindTexture(GL_TEXTURE_2D, 0);
+  filter_dirty_ = false;
+}
+
+}  // namespace tesseract_gui
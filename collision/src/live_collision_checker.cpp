@@ -0,0 +1,277 @@
+/**
+ * @file live_collision_checker.cpp
+ * @brief Continuously checks the collision state while joints are manipulated
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <stdexcept>
+#include <unordered_set>
+#include <QMetaObject>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/common/frame_interval.h>
+#include <tesseract_gui/common/instrumentation.h>
+#include <tesseract_gui/collision/live_collision_checker.h>
+
+namespace tesseract_gui
+{
+LiveCollisionChecker::LiveCollisionChecker(QObject* parent)
+  : QObject(parent), results_(std::make_shared<ContactResults>())
+{
+  frame_timer_.setTimerType(Qt::PreciseTimer);
+  frame_timer_.setInterval(getDefaultFrameInterval());
+  connect(&frame_timer_, &QTimer::timeout, this, &LiveCollisionChecker::deliverResults);
+}
+
+LiveCollisionChecker::~LiveCollisionChecker() { stop(); }
+
+void LiveCollisionChecker::setEnvironment(const tesseract_environment::Environment& environment)
+{
+  tesseract_collision::DiscreteContactManager::UPtr manager = environment.getDiscreteContactManager();
+  if (manager == nullptr)
+    throw std::runtime_error("LiveCollisionChecker, environment has no discrete contact manager!");
+
+  tesseract_scene_graph::StateSolver::UPtr solver = environment.getStateSolver();
+  if (solver == nullptr)
+    throw std::runtime_error("LiveCollisionChecker, environment has no state solver!");
+
+  // Only links moved by joints can change their contacts, static links are only checked against them
+  std::vector<std::string> active_links = solver->getActiveLinkNames();
+  manager->setActiveCollisionObjects(active_links);
+
+  stop();
+
+  {
+    std::scoped_lock lock(mutex_);
+    pending_values_.clear();
+    check_requested_ = true;
+    stopping_ = false;
+    has_completed_ = false;
+    ++generation_;
+  }
+
+  worker_ = std::thread([this,
+                         manager = std::move(manager),
+                         solver = std::move(solver),
+                         active_links = std::move(active_links)]() mutable {
+    run(std::move(manager), std::move(solver), std::move(active_links));
+  });
+  condition_.notify_one();
+}
+
+void LiveCollisionChecker::setContactRequest(const tesseract_collision::ContactRequest& request)
+{
+  {
+    std::scoped_lock lock(mutex_);
+    contact_request_ = request;
+    check_requested_ = true;
+  }
+  condition_.notify_one();
+}
+
+bool LiveCollisionChecker::isEnabled() const
+{
+  std::scoped_lock lock(mutex_);
+  return enabled_;
+}
+
+ContactResults::ConstPtr LiveCollisionChecker::getContactResults() const { return results_; }
+
+double LiveCollisionChecker::getLastCheckDuration() const { return last_check_duration_; }
+
+void LiveCollisionChecker::setFrameInterval(int msec) { frame_timer_.setInterval(msec); }
+
+int LiveCollisionChecker::getFrameInterval() const { return frame_timer_.interval(); }
+
+void LiveCollisionChecker::setEnabled(bool enabled)
+{
+  {
+    std::scoped_lock lock(mutex_);
+    if (enabled_ == enabled)
+      return;
+
+    enabled_ = enabled;
+    if (enabled)
+    {
+      check_requested_ = true;
+    }
+    else
+    {
+      has_completed_ = false;
+      ++generation_;
+    }
+  }
+
+  if (enabled)
+  {
+    condition_.notify_one();
+    frame_timer_.start();
+  }
+  else
+  {
+    frame_timer_.stop();
+    results_ = std::make_shared<ContactResults>();
+    last_check_duration_ = 0;
+    emit contactResultsChanged(results_);
+  }
+
+  emit enabledChanged(enabled);
+}
+
+void LiveCollisionChecker::setJointValues(const std::unordered_map<std::string, double>& joint_values)
+{
+  {
+    std::scoped_lock lock(mutex_);
+    for (const auto& joint_value : joint_values)
+      pending_values_[joint_value.first] = joint_value.second;
+    check_requested_ = true;
+  }
+  condition_.notify_one();
+}
+
+void LiveCollisionChecker::stop()
+{
+  {
+    std::scoped_lock lock(mutex_);
+    stopping_ = true;
+  }
+  condition_.notify_one();
+
+  if (worker_.joinable())
+    worker_.join();
+}
+
+void LiveCollisionChecker::run(tesseract_collision::DiscreteContactManager::UPtr manager,
+                               tesseract_scene_graph::StateSolver::UPtr solver,
+                               std::vector<std::string> active_links)
+{
+  // The transforms last passed to the contact manager, the cloned manager starts in the state of the environment
+  tesseract_common::VectorIsometry3d applied_transforms;
+  applied_transforms.reserve(active_links.size());
+  {
+    const tesseract_scene_graph::SceneState state = solver->getState();
+    for (const auto& link : active_links)
+    {
+      auto it = state.link_transforms.find(link);
+      applied_transforms.push_back((it == state.link_transforms.end()) ? Eigen::Isometry3d::Identity() : it->second);
+    }
+  }
+
+  // Joint values for joints unknown to the solver (e.g. from a joint state topic of another robot) are ignored
+  const std::vector<std::string> joint_names = solver->getActiveJointNames();
+  const std::unordered_set<std::string> known_joints(joint_names.begin(), joint_names.end());
+
+  std::vector<std::string> changed_links;
+  tesseract_common::VectorIsometry3d changed_transforms;
+  while (true)
+  {
+    std::unordered_map<std::string, double> joint_values;
+    tesseract_collision::ContactRequest request;
+    std::uint64_t generation{ 0 };
+    {
+      std::unique_lock lock(mutex_);
+      condition_.wait(lock, [this]() { return stopping_ || (enabled_ && check_requested_); });
+      if (stopping_)
+        return;
+
+      joint_values.swap(pending_values_);
+      check_requested_ = false;
+      request = contact_request_;
+      generation = generation_;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    Result result;
+    try
+    {
+      for (auto it = joint_values.begin(); it != joint_values.end();)
+        it = (known_joints.count(it->first) == 0) ? joint_values.erase(it) : std::next(it);
+
+      if (!joint_values.empty())
+        solver->setState(joint_values);
+
+      const tesseract_scene_graph::SceneState state = solver->getState();
+      changed_links.clear();
+      changed_transforms.clear();
+      for (std::size_t i = 0; i < active_links.size(); ++i)
+      {
+        auto it = state.link_transforms.find(active_links[i]);
+        if (it == state.link_transforms.end() || it->second.matrix() == applied_transforms[i].matrix())
+          continue;
+
+        applied_transforms[i] = it->second;
+        changed_links.push_back(active_links[i]);
+        changed_transforms.push_back(it->second);
+      }
+
+      if (!changed_links.empty())
+        manager->setCollisionObjectsTransform(changed_links, changed_transforms);
+
+      tesseract_collision::ContactResultMap contacts;
+      manager->contactTest(contacts, request);
+      result.results = std::make_shared<ContactResults>(contacts);
+    }
+    catch (const std::exception& e)
+    {
+      const QString message = QString::fromStdString(e.what());
+      QMetaObject::invokeMethod(
+          this,
+          [this, message]() {
+            setEnabled(false);
+            emit checkFailed(message);
+          },
+          Qt::QueuedConnection);
+      continue;
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+    result.duration = std::chrono::duration<double, std::milli>(end - start).count();
+    if (Instrumentation::instance().isEnabled())
+    {
+      Instrumentation::instance().recordTimer("collision", "check", start, end);
+      recordCounter("collision", "contacts", static_cast<std::int64_t>(result.results->size()));
+    }
+
+    std::scoped_lock lock(mutex_);
+    if (generation == generation_)
+    {
+      completed_ = std::move(result);
+      has_completed_ = true;
+    }
+  }
+}
+
+void LiveCollisionChecker::deliverResults()
+{
+  Result result;
+  {
+    std::scoped_lock lock(mutex_);
+    if (!has_completed_)
+      return;
+
+    result = std::move(completed_);
+    has_completed_ = false;
+  }
+
+  results_ = std::move(result.results);
+  last_check_duration_ = result.duration;
+  emit contactResultsChanged(results_);
+}
+
+}  // namespace tesseract_gui
@@ -0,0 +1,80 @@
+/**
+ * @file live_collision_widget.cpp
+ * @brief Toggle and status display for a live collision checker
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <stdexcept>
+#include <QCheckBox>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QSignalBlocker>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/collision/live_collision_checker.h>
+#include <tesseract_gui/collision/live_collision_widget.h>
+
+namespace tesseract_gui
+{
+LiveCollisionWidget::LiveCollisionWidget(LiveCollisionChecker* checker, QWidget* parent)
+  : QWidget(parent)
+  , checker_(checker)
+  , enabled_check_box_(new QCheckBox("Live collision", this))
+  , status_label_(new QLabel(this))
+{
+  if (checker_ == nullptr)
+    throw std::runtime_error("LiveCollisionWidget, checker is a nullptr!");
+
+  auto* layout = new QHBoxLayout(this);
+  layout->addWidget(enabled_check_box_);
+  layout->addWidget(status_label_, 1);
+
+  connect(enabled_check_box_, &QCheckBox::toggled, checker_, &LiveCollisionChecker::setEnabled);
+  connect(checker_, &LiveCollisionChecker::enabledChanged, this, &LiveCollisionWidget::onEnabledChanged);
+  connect(checker_,
+          &LiveCollisionChecker::contactResultsChanged,
+          this,
+          &LiveCollisionWidget::onContactResultsChanged);
+  connect(checker_, &LiveCollisionChecker::checkFailed, status_label_, &QLabel::setText);
+
+  onEnabledChanged(checker_->isEnabled());
+}
+
+LiveCollisionChecker* LiveCollisionWidget::getChecker() const { return checker_; }
+
+void LiveCollisionWidget::onEnabledChanged(bool enabled)
+{
+  {
+    const QSignalBlocker blocker(enabled_check_box_);
+    enabled_check_box_->setChecked(enabled);
+  }
+  status_label_->clear();
+}
+
+void LiveCollisionWidget::onContactResultsChanged(const ContactResults::ConstPtr& results)
+{
+  if (!checker_->isEnabled() || results == nullptr)
+  {
+    status_label_->clear();
+    return;
+  }
+
+  status_label_->setText(QString("%1 contacts, %2 ms")
+                             .arg(results->size())
+                             .arg(checker_->getLastCheckDuration(), 0, 'f', 1));
+}
+
+}  // namespace tesseract_gui
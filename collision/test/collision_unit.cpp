@@ -0,0 +1,321 @@
+/**
+ * @file collision_unit.cpp
+ * @brief Tests of the collision component
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cmath>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QPersistentModelIndex>
+#include <QString>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_environment/commands/add_contact_managers_plugin_info_command.h>
+#include <tesseract_geometry/geometries.h>
+#include <tesseract_gui/collision/allowed_collision_matrix_generator.h>
+#include <tesseract_gui/collision/allowed_collision_matrix_model.h>
+
+using namespace tesseract_gui;
+
+namespace
+{
+/** @brief Reset a model to the pairs a-b, b-c and c-d with the reasons x, y and z */
+void setAllowedCollisions(AllowedCollisionMatrixModel& model)
+{
+  tesseract_scene_graph::AllowedCollisionMatrix acm;
+  acm.addAllowedCollision("a", "b", "x");
+  acm.addAllowedCollision("c", "b", "y");
+  acm.addAllowedCollision("c", "d", "z");
+  model.setAllowedCollisionMatrix(acm);
+}
+
+std::string getText(const AllowedCollisionMatrixModel& model, int row, int column)
+{
+  return model.data(model.index(row, column)).toString().toStdString();
+}
+
+/** @brief The visible rows as "link_a link_b reason" */
+std::vector<std::string> getRows(const AllowedCollisionMatrixModel& model)
+{
+  std::vector<std::string> rows;
+  for (int row = 0; row < model.rowCount(); ++row)
+  {
+    rows.push_back(getText(model, row, AllowedCollisionMatrixModel::LINK_A_COLUMN) + " " +
+                   getText(model, row, AllowedCollisionMatrixModel::LINK_B_COLUMN) + " " +
+                   getText(model, row, AllowedCollisionMatrixModel::REASON_COLUMN));
+  }
+  return rows;
+}
+
+/**
+ * @brief An arm rotating about the base through a post, a box overlapping the post and a box out of reach
+ *
+ * All links but the arm are fixed to the base, the arm is in contact with the post and the overlapping box in some
+ * joint states.
+ */
+tesseract_environment::Environment::Ptr createEnvironment()
+{
+  auto scene_graph = std::make_shared<tesseract_scene_graph::SceneGraph>("acm_generator");
+  auto add_link = [&scene_graph](const std::string& name, const Eigen::Vector3d& position) {
+    tesseract_scene_graph::Link link(name);
+    auto collision = std::make_shared<tesseract_scene_graph::Collision>();
+    collision->geometry = std::make_shared<tesseract_geometry::Box>(0.2, 0.2, 0.2);
+    collision->origin.translation() = position;
+    link.collision.push_back(collision);
+    scene_graph->addLink(link);
+
+    if (name == "base_link")
+      return;
+
+    tesseract_scene_graph::Joint joint(name + "_joint");
+    joint.parent_link_name = "base_link";
+    joint.child_link_name = name;
+    joint.type = tesseract_scene_graph::JointType::FIXED;
+    if (name == "arm")
+    {
+      joint.type = tesseract_scene_graph::JointType::REVOLUTE;
+      joint.axis = Eigen::Vector3d::UnitZ();
+      joint.limits = std::make_shared<tesseract_scene_graph::JointLimits>();
+      joint.limits->lower = -M_PI;
+      joint.limits->upper = M_PI;
+    }
+    scene_graph->addJoint(joint);
+  };
+  add_link("base_link", Eigen::Vector3d::Zero());
+  add_link("arm", Eigen::Vector3d(1, 0, 0));
+  add_link("post", Eigen::Vector3d(1, 0, 0));
+  add_link("always", Eigen::Vector3d(1, 0.1, 0));
+  add_link("far", Eigen::Vector3d(5, 0, 0));
+  scene_graph->setRoot("base_link");
+
+  auto environment = std::make_shared<tesseract_environment::Environment>();
+  if (!environment->init(*scene_graph))
+    return nullptr;
+
+  tesseract_common::ContactManagersPluginInfo plugin_info;
+  plugin_info.search_libraries.insert("tesseract_collision_bullet_factories");
+  plugin_info.discrete_plugin_infos.plugins["BulletDiscreteBVHManager"].class_name = "BulletDiscreteBVHManagerFactory";
+  plugin_info.discrete_plugin_infos.default_plugin = "BulletDiscreteBVHManager";
+  if (!environment->applyCommand(
+          std::make_shared<tesseract_environment::AddContactManagersPluginInfoCommand>(plugin_info)))
+    return nullptr;
+
+  return environment;
+}
+
+/** @brief Run a generation to the end and apply its reports to a model of the existing pairs */
+std::vector<std::string> generate(const tesseract_environment::Environment& environment,
+                                  const AllowedCollisionMatrixGenerator::Settings& settings,
+                                  const tesseract_scene_graph::AllowedCollisionMatrix& existing = {})
+{
+  AllowedCollisionMatrixModel model;
+  model.setAllowedCollisionMatrix(existing);
+
+  AllowedCollisionMatrixGenerator generator;
+  generator.setReportInterval(1);
+  QObject::connect(&generator,
+                   &AllowedCollisionMatrixGenerator::allowedCollisionsChanged,
+                   [&model](const std::vector<AllowedCollisionEdit>& edits) { model.modify(edits); });
+
+  QEventLoop loop;
+  bool cancelled{ true };
+  QObject::connect(&generator, &AllowedCollisionMatrixGenerator::finished, [&loop, &cancelled](bool value) {
+    cancelled = value;
+    loop.quit();
+  });
+
+  generator.start(environment, settings, model.getAllowedCollisionMatrix());
+  loop.exec();
+  EXPECT_FALSE(cancelled);
+  EXPECT_EQ(generator.getCompletedSampleCount(), settings.sample_count);
+
+  // The final pairs of the generator are the reported ones, without the existing pairs
+  for (const AllowedCollisionEdit& edit : generator.getAllowedCollisions())
+  {
+    EXPECT_TRUE(model.isCollisionAllowed(edit.link_a, edit.link_b));
+    EXPECT_FALSE(existing.isCollisionAllowed(edit.link_a, edit.link_b));
+  }
+
+  return getRows(model);
+}
+}  // namespace
+
+TEST(TesseractGuiCollisionUnit, AllowedCollisionMatrixModelModify)  // NOLINT
+{
+  AllowedCollisionMatrixModel model;
+  setAllowedCollisions(model);
+  EXPECT_EQ(getRows(model), std::vector<std::string>({ "a b x", "b c y", "c d z" }));
+  EXPECT_EQ(model.getPendingChangeCount(), 0U);
+
+  // One batch changing, removing and adding pairs, in either link order and with repeated pairs
+  model.modify({ { "b", "a", "x2", false },
+                 { "a", "b", "x3", false },
+                 { "c", "b", "", true },
+                 { "d", "e", "new", false },
+                 { "c", "e", "temporary", false },
+                 { "e", "c", "", true },
+                 { "a", "a", "self", false } });
+
+  EXPECT_EQ(getRows(model), std::vector<std::string>({ "a b x3", "c d z", "d e new" }));
+  EXPECT_EQ(model.getEntryCount(), 3U);
+  EXPECT_EQ(model.getLinkNames(), std::vector<std::string>({ "a", "b", "c", "d", "e" }));
+  EXPECT_TRUE(model.isCollisionAllowed("b", "a"));
+  EXPECT_FALSE(model.isCollisionAllowed("b", "c"));
+  EXPECT_FALSE(model.isCollisionAllowed("c", "e"));
+  EXPECT_FALSE(model.isCollisionAllowed("a", "a"));
+
+  // The pair added and removed in the same batch is no change
+  EXPECT_EQ(model.getPendingChangeCount(), 3U);
+  auto command = model.createCommand();
+  ASSERT_NE(command, nullptr);
+  EXPECT_EQ(command->getModifyType(), tesseract_environment::ModifyAllowedCollisionsType::REPLACE);
+
+  // Removing a pair which is not allowed changes nothing
+  model.modify({ { "a", "e", "", true } });
+  EXPECT_EQ(model.getEntryCount(), 3U);
+  EXPECT_EQ(model.getPendingChangeCount(), 3U);
+
+  // Only removals are sent as a removal command
+  setAllowedCollisions(model);
+  model.removeAllowedCollision("c", "d");
+  command = model.createCommand();
+  ASSERT_NE(command, nullptr);
+  EXPECT_EQ(command->getModifyType(), tesseract_environment::ModifyAllowedCollisionsType::REMOVE);
+}
+
+TEST(TesseractGuiCollisionUnit, AllowedCollisionMatrixModelSetData)  // NOLINT
+{
+  AllowedCollisionMatrixModel model;
+  setAllowedCollisions(model);
+
+  // A reason edited out of the filter hides its row
+  model.setFilter("y");
+  ASSERT_EQ(getRows(model), std::vector<std::string>({ "b c y" }));
+  EXPECT_FALSE(model.setData(model.index(0, AllowedCollisionMatrixModel::REASON_COLUMN), QString("y")));
+  EXPECT_TRUE(model.setData(model.index(0, AllowedCollisionMatrixModel::REASON_COLUMN), QString("w")));
+  EXPECT_TRUE(getRows(model).empty());
+  EXPECT_EQ(model.getPendingChangeCount(), 1U);
+
+  // A reason edited while sorting by reason moves its row
+  model.setFilter("");
+  model.sort(AllowedCollisionMatrixModel::REASON_COLUMN);
+  ASSERT_EQ(getRows(model), std::vector<std::string>({ "b c w", "a b x", "c d z" }));
+  EXPECT_TRUE(model.setData(model.index(0, AllowedCollisionMatrixModel::REASON_COLUMN), QString("zz")));
+  EXPECT_EQ(getRows(model), std::vector<std::string>({ "a b x", "c d z", "b c zz" }));
+
+  // Links are not editable
+  EXPECT_FALSE(model.setData(model.index(0, AllowedCollisionMatrixModel::LINK_A_COLUMN), QString("e")));
+}
+
+TEST(TesseractGuiCollisionUnit, AllowedCollisionMatrixModelPersistentIndexes)  // NOLINT
+{
+  AllowedCollisionMatrixModel model;
+  setAllowedCollisions(model);
+  const QPersistentModelIndex b_c(model.index(1, AllowedCollisionMatrixModel::LINK_B_COLUMN));
+  const QPersistentModelIndex c_d(model.index(2, AllowedCollisionMatrixModel::LINK_B_COLUMN));
+
+  // Entries inserted before an entry move its index, removed entries invalidate theirs
+  model.modify(
+      { { "a", "b", "", true }, { "a", "c", "new", false }, { "a", "d", "new", false }, { "b", "c", "", true } });
+  ASSERT_EQ(getRows(model), std::vector<std::string>({ "a c new", "a d new", "c d z" }));
+  EXPECT_FALSE(b_c.isValid());
+  ASSERT_TRUE(c_d.isValid());
+  EXPECT_EQ(c_d.row(), 2);
+  EXPECT_EQ(c_d.column(), AllowedCollisionMatrixModel::LINK_B_COLUMN);
+
+  // A reason change of another entry keeps the index in place
+  model.addAllowedCollision("a", "c", "changed");
+  EXPECT_EQ(c_d.row(), 2);
+
+  // Filtering and sorting follow the entry
+  model.setFilter("z");
+  EXPECT_EQ(c_d.row(), 0);
+  model.setFilter("");
+  model.sort(AllowedCollisionMatrixModel::LINK_A_COLUMN, Qt::DescendingOrder);
+  EXPECT_EQ(c_d.row(), 0);
+  EXPECT_EQ(c_d.data().toString().toStdString(), "d");
+
+  // An entry hidden by the filter invalidates its index
+  model.setFilter("new");
+  EXPECT_FALSE(c_d.isValid());
+}
+
+TEST(TesseractGuiCollisionUnit, AllowedCollisionMatrixGeneratorThreadCount)  // NOLINT
+{
+  auto environment = createEnvironment();
+  ASSERT_NE(environment, nullptr);
+
+  // Fewer stable samples than samples, so pairs are also removed again by later samples
+  AllowedCollisionMatrixGenerator::Settings settings;
+  settings.sample_count = 1000;
+  settings.stable_sample_count = 100;
+  settings.seed = 7;
+
+  const std::vector<std::string> expected({ "always base_link Adjacent",
+                                            "always far Never",
+                                            "always post Always",
+                                            "arm base_link Adjacent",
+                                            "arm far Never",
+                                            "base_link far Adjacent",
+                                            "base_link post Adjacent",
+                                            "far post Never" });
+  for (std::size_t thread_count = 1; thread_count <= 3; ++thread_count)
+  {
+    settings.thread_count = thread_count;
+    EXPECT_EQ(generate(*environment, settings), expected) << "thread count " << thread_count;
+  }
+}
+
+TEST(TesseractGuiCollisionUnit, AllowedCollisionMatrixGeneratorExisting)  // NOLINT
+{
+  auto environment = createEnvironment();
+  ASSERT_NE(environment, nullptr);
+
+  AllowedCollisionMatrixGenerator::Settings settings;
+  settings.sample_count = 1000;
+  settings.stable_sample_count = 100;
+  settings.thread_count = 2;
+
+  // Existing pairs keep their reasons, whether they would be classified or not
+  tesseract_scene_graph::AllowedCollisionMatrix existing;
+  existing.addAllowedCollision("arm", "base_link", "User");
+  existing.addAllowedCollision("always", "post", "User");
+  existing.addAllowedCollision("arm", "post", "User");
+  existing.addAllowedCollision("far", "post", "User");
+  EXPECT_EQ(generate(*environment, settings, existing),
+            std::vector<std::string>({ "always base_link Adjacent",
+                                       "always far Never",
+                                       "always post User",
+                                       "arm base_link User",
+                                       "arm far Never",
+                                       "arm post User",
+                                       "base_link far Adjacent",
+                                       "base_link post Adjacent",
+                                       "far post User" }));
+}
+
+int main(int argc, char** argv)
+{
+  // The generator reports from a timer of the event loop
+  QCoreApplication app(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,33 @@
+/**
+ * @file frame_interval.h
+ * @brief The default interval of frame timers
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_COMMON_FRAME_INTERVAL_H
+#define TESSERACT_GUI_COMMON_FRAME_INTERVAL_H
+
+namespace tesseract_gui
+{
+/**
+ * @brief The refresh interval of the primary screen in milliseconds, 16 without a screen or GUI application
+ *
+ * Components delivering results from worker threads batch them on a timer with this interval, more frequent updates
+ * could not be shown anyway.
+ */
+int getDefaultFrameInterval();
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_COMMON_FRAME_INTERVAL_H
@@ -0,0 +1,172 @@
+/**
+ * @file instrumentation.h
+ * @brief Scoped timers and counters reported by all components, exportable as a Chrome trace
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_COMMON_INSTRUMENTATION_H
+#define TESSERACT_GUI_COMMON_INSTRUMENTATION_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+namespace tesseract_gui
+{
+/**
+ * @brief Collects the durations of scoped timers and the values of counters (e.g. queue depths) from all threads
+ *
+ * Components report with ScopedTimer and recordCounter() under a category naming the component and a name naming the
+ * operation, e.g. ("collision", "check"). Both are not copied and must be string literals. Recording is disabled by
+ * default and costs a single atomic load per timer then; set the environment variable TESSERACT_GUI_INSTRUMENTATION=1
+ * or call setEnabled() to turn it on.
+ *
+ * While enabled every timer and counter updates its statistics and appends an event to a bounded trace buffer which
+ * keeps the most recent events. writeChromeTrace() exports that buffer in the Chrome trace event format, which
+ * chrome://tracing and https://ui.perfetto.dev open.
+ */
+class Instrumentation
+{
+public:
+  /** @brief Durations in milliseconds */
+  struct TimerStatistics
+  {
+    std::string category;
+    std::string name;
+    std::uint64_t count{ 0 };
+    double last{ 0 };
+    double total{ 0 };
+    double max{ 0 };
+  };
+
+  struct CounterStatistics
+  {
+    std::string category;
+    std::string name;
+    std::int64_t last{ 0 };
+    std::int64_t max{ 0 };
+  };
+
+  /** @brief The instance all components report to */
+  static Instrumentation& instance();
+
+  ~Instrumentation() = default;
+  Instrumentation(const Instrumentation&) = delete;
+  Instrumentation& operator=(const Instrumentation&) = delete;
+  Instrumentation(Instrumentation&&) = delete;
+  Instrumentation& operator=(Instrumentation&&) = delete;
+
+  void setEnabled(bool enabled);
+  bool isEnabled() const;
+
+  /** @brief The number of trace events kept, defaults to 200000, older events are overwritten */
+  void setTraceCapacity(std::size_t capacity);
+  std::size_t getTraceCapacity() const;
+
+  /** @brief Record a duration, usually called by ScopedTimer */
+  void recordTimer(const char* category,
+                   const char* name,
+                   std::chrono::steady_clock::time_point start,
+                   std::chrono::steady_clock::time_point end);
+
+  /** @brief Record the current value of a counter, e.g. the depth of a queue */
+  void recordCounter(const char* category, const char* name, std::int64_t value);
+
+  /** @brief The statistics of all timers since the last reset(), sorted by category and name */
+  std::vector<TimerStatistics> getTimerStatistics() const;
+
+  /** @brief The statistics of all counters since the last reset(), sorted by category and name */
+  std::vector<CounterStatistics> getCounterStatistics() const;
+
+  /** @brief Clear all statistics and trace events */
+  void reset();
+
+  /** @brief Write the trace events as Chrome trace JSON */
+  void writeChromeTrace(std::ostream& stream) const;
+
+  /** @brief Write the trace events as Chrome trace JSON to a file, throws if it can not be written */
+  void saveChromeTrace(const std::string& path) const;
+
+private:
+  struct TraceEvent
+  {
+    const char* category;
+    const char* name;
+    std::int64_t timestamp;
+
+    /** @brief The duration in nanoseconds of a timer or the value of a counter */
+    std::int64_t value;
+    std::uint32_t thread;
+    bool counter;
+  };
+
+  using Key = std::pair<const char*, const char*>;
+
+  Instrumentation();
+
+  std::atomic<bool> enabled_{ false };
+  std::chrono::steady_clock::time_point epoch_;
+
+  mutable std::mutex mutex_;
+  std::map<Key, TimerStatistics> timers_;
+  std::map<Key, CounterStatistics> counters_;
+
+  /** @brief Ring buffer of trace events, once full next_event_ is the slot overwritten next */
+  std::vector<TraceEvent> events_;
+  std::size_t trace_capacity_{ 200000 };
+  std::size_t next_event_{ 0 };
+
+  void appendEvent(const TraceEvent& event);
+};
+
+/**
+ * @brief Reports the time from its construction to its destruction to Instrumentation::instance()
+ *
+ * Nothing is recorded if instrumentation was disabled when the timer was constructed.
+ * @code
+ * const ScopedTimer timer("render", "frame");
+ * @endcode
+ */
+class ScopedTimer
+{
+public:
+  ScopedTimer(const char* category, const char* name);
+  ~ScopedTimer();
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+  ScopedTimer(ScopedTimer&&) = delete;
+  ScopedTimer& operator=(ScopedTimer&&) = delete;
+
+private:
+  const char* category_;
+  const char* name_;
+  bool active_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+/** @brief Record a counter value if instrumentation is enabled */
+void recordCounter(const char* category, const char* name, std::int64_t value);
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_COMMON_INSTRUMENTATION_H
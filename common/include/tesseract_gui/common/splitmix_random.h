@@ -0,0 +1,60 @@
+/**
+ * @file splitmix_random.h
+ * @brief Reproducible random numbers per sample
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_COMMON_SPLITMIX_RANDOM_H
+#define TESSERACT_GUI_COMMON_SPLITMIX_RANDOM_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cstdint>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+namespace tesseract_gui
+{
+/**
+ * @brief A splitmix64 sequence determined by a seed and a stream index, e.g. the index of a sample
+ *
+ * Threads taking samples in any order draw the same numbers for a sample as a serial run, which keeps results of
+ * parallel generators reproducible.
+ */
+class SplitMixRandom
+{
+public:
+  SplitMixRandom(std::uint64_t seed, std::uint64_t stream) : state_(mix(seed + mix(stream))) {}
+
+  /** @brief Uniform in [0, 1) */
+  double next()
+  {
+    state_ += INCREMENT;
+    return static_cast<double>(mix(state_) >> 11U) * (1.0 / 9007199254740992.0);
+  }
+
+private:
+  static constexpr std::uint64_t INCREMENT = 0x9E3779B97F4A7C15ULL;
+  std::uint64_t state_;
+
+  static std::uint64_t mix(std::uint64_t z)
+  {
+    z = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31U);
+  }
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_COMMON_SPLITMIX_RANDOM_H
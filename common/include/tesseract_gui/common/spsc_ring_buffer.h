@@ -0,0 +1,109 @@
+/**
+ * @file spsc_ring_buffer.h
+ * @brief A bounded lock-free single producer single consumer queue
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_COMMON_SPSC_RING_BUFFER_H
+#define TESSERACT_GUI_COMMON_SPSC_RING_BUFFER_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+namespace tesseract_gui
+{
+/**
+ * @brief A fixed capacity ring buffer which one thread pushes into while another thread pops from it without locking
+ *
+ * Slots are allocated once on construction and values are moved in and out of them. The capacity is rounded up to a
+ * power of two. Only one thread may call push() and only one thread may call pop() at any time.
+ */
+template <typename T>
+class SPSCRingBuffer
+{
+public:
+  /** @param capacity The minimum number of values the buffer can hold */
+  explicit SPSCRingBuffer(std::size_t capacity)
+  {
+    if (capacity == 0)
+      throw std::runtime_error("SPSCRingBuffer, capacity must be greater than zero!");
+
+    std::size_t size = 1;
+    while (size < capacity)
+      size <<= 1U;
+
+    buffer_.resize(size);
+    mask_ = size - 1;
+  }
+
+  /**
+   * @brief Push a value, only call from the producer thread
+   * @return False if the buffer is full, the value is not consumed in that case
+   */
+  bool push(T&& value)
+  {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) == buffer_.size())
+      return false;
+
+    buffer_[head & mask_] = std::move(value);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool push(const T& value)
+  {
+    T copy(value);
+    return push(std::move(copy));
+  }
+
+  /**
+   * @brief Pop the oldest value, only call from the consumer thread
+   * @return False if the buffer is empty
+   */
+  bool pop(T& value)
+  {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail == head_.load(std::memory_order_acquire))
+      return false;
+
+    value = std::move(buffer_[tail & mask_]);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /** @brief The number of values in the buffer, only exact when called from the producer or consumer thread */
+  std::size_t size() const { return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire); }
+
+  bool empty() const { return size() == 0; }
+
+  std::size_t capacity() const { return buffer_.size(); }
+
+private:
+  std::vector<T> buffer_;
+  std::size_t mask_{ 0 };
+
+  /** @brief Producer and consumer indices on separate cache lines so the two threads do not contend */
+  alignas(64) std::atomic<std::size_t> head_{ 0 };
+  alignas(64) std::atomic<std::size_t> tail_{ 0 };
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_COMMON_SPSC_RING_BUFFER_H
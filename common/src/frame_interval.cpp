@@ -0,0 +1,42 @@
+/**
+ * @file frame_interval.cpp
+ * @brief The default interval of frame timers
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <cmath>
+#include <QGuiApplication>
+#include <QScreen>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/common/frame_interval.h>
+
+namespace tesseract_gui
+{
+int getDefaultFrameInterval()
+{
+  if (qobject_cast<QGuiApplication*>(QCoreApplication::instance()) != nullptr)
+  {
+    const QScreen* screen = QGuiApplication::primaryScreen();
+    if (screen != nullptr && screen->refreshRate() > 0)
+      return std::max(1, static_cast<int>(std::lround(1000.0 / screen->refreshRate())));
+  }
+
+  return 16;
+}
+
+}  // namespace tesseract_gui
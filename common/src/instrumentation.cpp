@@ -0,0 +1,291 @@
+/**
+ * @file instrumentation.cpp
+ * @brief Scoped timers and counters reported by all components, exportable as a Chrome trace
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/common/instrumentation.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+/** @brief A small id per thread in the order threads first report, trace viewers show one row per id */
+std::uint32_t getThreadId()
+{
+  static std::atomic<std::uint32_t> next_id{ 1 };
+  thread_local const std::uint32_t id = next_id++;
+  return id;
+}
+
+void writeJsonString(std::ostream& stream, const char* text)
+{
+  stream << '"';
+  for (const char* c = text; *c != '\0'; ++c)
+  {
+    if (*c == '"' || *c == '\\')
+      stream << '\\' << *c;
+    else if (static_cast<unsigned char>(*c) < 0x20)
+      stream << ' ';
+    else
+      stream << *c;
+  }
+  stream << '"';
+}
+
+/** @brief Write nanoseconds as the microseconds expected by the trace format */
+void writeMicroseconds(std::ostream& stream, std::int64_t nanoseconds)
+{
+  stream << (nanoseconds / 1000) << '.' << std::setw(3) << std::setfill('0') << std::abs(nanoseconds % 1000)
+         << std::setfill(' ');
+}
+
+}  // namespace
+
+Instrumentation& Instrumentation::instance()
+{
+  static Instrumentation instrumentation;
+  return instrumentation;
+}
+
+Instrumentation::Instrumentation() : epoch_(std::chrono::steady_clock::now())
+{
+  const char* variable = std::getenv("TESSERACT_GUI_INSTRUMENTATION");
+  enabled_ = (variable != nullptr && std::strcmp(variable, "") != 0 && std::strcmp(variable, "0") != 0);
+}
+
+void Instrumentation::setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+
+bool Instrumentation::isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+void Instrumentation::setTraceCapacity(std::size_t capacity)
+{
+  std::scoped_lock lock(mutex_);
+  trace_capacity_ = std::max<std::size_t>(capacity, 1);
+  events_.clear();
+  next_event_ = 0;
+}
+
+std::size_t Instrumentation::getTraceCapacity() const
+{
+  std::scoped_lock lock(mutex_);
+  return trace_capacity_;
+}
+
+void Instrumentation::recordTimer(const char* category,
+                                  const char* name,
+                                  std::chrono::steady_clock::time_point start,
+                                  std::chrono::steady_clock::time_point end)
+{
+  const double duration = std::chrono::duration<double, std::milli>(end - start).count();
+  const TraceEvent event{ category,
+                          name,
+                          std::chrono::duration_cast<std::chrono::nanoseconds>(start - epoch_).count(),
+                          std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count(),
+                          getThreadId(),
+                          false };
+
+  std::scoped_lock lock(mutex_);
+  TimerStatistics& statistics = timers_[Key(category, name)];
+  ++statistics.count;
+  statistics.last = duration;
+  statistics.total += duration;
+  statistics.max = std::max(statistics.max, duration);
+  appendEvent(event);
+}
+
+void Instrumentation::recordCounter(const char* category, const char* name, std::int64_t value)
+{
+  const auto timestamp = std::chrono::steady_clock::now() - epoch_;
+  const TraceEvent event{ category,
+                          name,
+                          std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp).count(),
+                          value,
+                          getThreadId(),
+                          true };
+
+  std::scoped_lock lock(mutex_);
+  auto it = counters_.find(Key(category, name));
+  if (it == counters_.end())
+  {
+    CounterStatistics statistics;
+    statistics.max = value;
+    it = counters_.emplace(Key(category, name), statistics).first;
+  }
+
+  it->second.last = value;
+  it->second.max = std::max(it->second.max, value);
+  appendEvent(event);
+}
+
+std::vector<Instrumentation::TimerStatistics> Instrumentation::getTimerStatistics() const
+{
+  // The same literal may have different addresses in different libraries, entries are merged by their text
+  std::map<std::pair<std::string, std::string>, TimerStatistics> merged;
+  {
+    std::scoped_lock lock(mutex_);
+    for (const auto& timer : timers_)
+    {
+      TimerStatistics& statistics = merged[std::make_pair(timer.first.first, timer.first.second)];
+      statistics.count += timer.second.count;
+      statistics.last = timer.second.last;
+      statistics.total += timer.second.total;
+      statistics.max = std::max(statistics.max, timer.second.max);
+    }
+  }
+
+  std::vector<TimerStatistics> statistics;
+  statistics.reserve(merged.size());
+  for (auto& entry : merged)
+  {
+    entry.second.category = entry.first.first;
+    entry.second.name = entry.first.second;
+    statistics.push_back(std::move(entry.second));
+  }
+  return statistics;
+}
+
+std::vector<Instrumentation::CounterStatistics> Instrumentation::getCounterStatistics() const
+{
+  std::map<std::pair<std::string, std::string>, CounterStatistics> merged;
+  {
+    std::scoped_lock lock(mutex_);
+    for (const auto& counter : counters_)
+    {
+      auto it = merged.find(std::make_pair(counter.first.first, counter.first.second));
+      if (it == merged.end())
+      {
+        merged.emplace(std::make_pair(counter.first.first, counter.first.second), counter.second);
+        continue;
+      }
+
+      it->second.last = counter.second.last;
+      it->second.max = std::max(it->second.max, counter.second.max);
+    }
+  }
+
+  std::vector<CounterStatistics> statistics;
+  statistics.reserve(merged.size());
+  for (auto& entry : merged)
+  {
+    entry.second.category = entry.first.first;
+    entry.second.name = entry.first.second;
+    statistics.push_back(std::move(entry.second));
+  }
+  return statistics;
+}
+
+void Instrumentation::reset()
+{
+  std::scoped_lock lock(mutex_);
+  timers_.clear();
+  counters_.clear();
+  events_.clear();
+  next_event_ = 0;
+}
+
+void Instrumentation::writeChromeTrace(std::ostream& stream) const
+{
+  std::vector<TraceEvent> events;
+  {
+    std::scoped_lock lock(mutex_);
+    // Once the buffer is full the oldest event is the one overwritten next
+    const auto oldest = static_cast<std::ptrdiff_t>((events_.size() < trace_capacity_) ? 0 : next_event_);
+    events.reserve(events_.size());
+    events.insert(events.end(), events_.begin() + oldest, events_.end());
+    events.insert(events.end(), events_.begin(), events_.begin() + oldest);
+  }
+
+  stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  for (std::size_t i = 0; i < events.size(); ++i)
+  {
+    const TraceEvent& event = events[i];
+    if (i > 0)
+      stream << ',';
+
+    stream << "\n{\"name\":";
+    writeJsonString(stream, event.name);
+    stream << ",\"cat\":";
+    writeJsonString(stream, event.category);
+    stream << ",\"ph\":\"" << (event.counter ? 'C' : 'X') << "\",\"ts\":";
+    writeMicroseconds(stream, event.timestamp);
+    stream << ",\"pid\":1,\"tid\":" << event.thread;
+    if (event.counter)
+    {
+      stream << ",\"args\":{\"value\":" << event.value << '}';
+    }
+    else
+    {
+      stream << ",\"dur\":";
+      writeMicroseconds(stream, event.value);
+    }
+    stream << '}';
+  }
+  stream << "\n]}\n";
+}
+
+void Instrumentation::saveChromeTrace(const std::string& path) const
+{
+  std::ofstream file(path);
+  if (!file)
+    throw std::runtime_error("Instrumentation, failed to open '" + path + "'!");
+
+  writeChromeTrace(file);
+  if (!file)
+    throw std::runtime_error("Instrumentation, failed to write '" + path + "'!");
+}
+
+void Instrumentation::appendEvent(const TraceEvent& event)
+{
+  if (events_.size() < trace_capacity_)
+  {
+    events_.push_back(event);
+    return;
+  }
+
+  events_[next_event_] = event;
+  next_event_ = (next_event_ + 1) % trace_capacity_;
+}
+
+ScopedTimer::ScopedTimer(const char* category, const char* name)
+  : category_(category), name_(name), active_(Instrumentation::instance().isEnabled())
+{
+  if (active_)
+    start_ = std::chrono::steady_clock::now();
+}
+
+ScopedTimer::~ScopedTimer()
+{
+  if (active_)
+    Instrumentation::instance().recordTimer(category_, name_, start_, std::chrono::steady_clock::now());
+}
+
+void recordCounter(const char* category, const char* name, std::int64_t value)
+{
+  Instrumentation& instrumentation = Instrumentation::instance();
+  if (instrumentation.isEnabled())
+    instrumentation.recordCounter(category, name, value);
+}
+
+}  // namespace tesseract_gui
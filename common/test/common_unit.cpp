@@ -0,0 +1,127 @@
+/**
+ * @file common_unit.cpp
+ * @brief Tests of the common utilities
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <gtest/gtest.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/common/spsc_ring_buffer.h>
+
+using tesseract_gui::SPSCRingBuffer;
+
+TEST(TesseractGuiCommonUnit, SPSCRingBufferCapacity)  // NOLINT
+{
+  EXPECT_THROW(SPSCRingBuffer<int>(0), std::runtime_error);  // NOLINT
+  EXPECT_EQ(SPSCRingBuffer<int>(1).capacity(), 1U);
+  EXPECT_EQ(SPSCRingBuffer<int>(5).capacity(), 8U);
+  EXPECT_EQ(SPSCRingBuffer<int>(8).capacity(), 8U);
+  EXPECT_EQ(SPSCRingBuffer<int>(1000).capacity(), 1024U);
+}
+
+TEST(TesseractGuiCommonUnit, SPSCRingBufferEmptyAndFull)  // NOLINT
+{
+  SPSCRingBuffer<std::unique_ptr<int>> ring(4);
+  std::unique_ptr<int> value;
+  EXPECT_TRUE(ring.empty());
+  EXPECT_FALSE(ring.pop(value));
+
+  for (int i = 0; i < 4; ++i)
+    EXPECT_TRUE(ring.push(std::make_unique<int>(i)));
+  EXPECT_EQ(ring.size(), 4U);
+
+  // A rejected value is not consumed
+  auto rejected = std::make_unique<int>(4);
+  EXPECT_FALSE(ring.push(std::move(rejected)));
+  ASSERT_NE(rejected, nullptr);
+  EXPECT_EQ(*rejected, 4);
+
+  for (int i = 0; i < 4; ++i)
+  {
+    ASSERT_TRUE(ring.pop(value));
+    EXPECT_EQ(*value, i);
+  }
+  EXPECT_TRUE(ring.empty());
+  EXPECT_FALSE(ring.pop(value));
+}
+
+TEST(TesseractGuiCommonUnit, SPSCRingBufferWrapAround)  // NOLINT
+{
+  // Three values in flight in a buffer of four walk the indices around it many times
+  SPSCRingBuffer<int> ring(4);
+  int next_push{ 0 };
+  int next_pop{ 0 };
+  for (int i = 0; i < 3; ++i)
+    ASSERT_TRUE(ring.push(next_push++));
+
+  for (int cycle = 0; cycle < 100; ++cycle)
+  {
+    ASSERT_TRUE(ring.push(next_push++));
+    EXPECT_FALSE(ring.push(-1));
+    EXPECT_EQ(ring.size(), 4U);
+
+    int value{ -1 };
+    ASSERT_TRUE(ring.pop(value));
+    EXPECT_EQ(value, next_pop++);
+    EXPECT_EQ(ring.size(), 3U);
+  }
+
+  int value{ -1 };
+  while (ring.pop(value))
+    EXPECT_EQ(value, next_pop++);
+  EXPECT_EQ(next_pop, next_push);
+}
+
+TEST(TesseractGuiCommonUnit, SPSCRingBufferThreads)  // NOLINT
+{
+  constexpr int count = 100000;
+  SPSCRingBuffer<int> ring(16);
+
+  std::thread producer([&ring]() {
+    for (int i = 0; i < count; ++i)
+    {
+      while (!ring.push(i))
+        std::this_thread::yield();
+    }
+  });
+
+  int expected{ 0 };
+  while (expected < count)
+  {
+    int value{ -1 };
+    if (!ring.pop(value))
+    {
+      std::this_thread::yield();
+      continue;
+    }
+    ASSERT_EQ(value, expected);
+    ++expected;
+  }
+  producer.join();
+  EXPECT_TRUE(ring.empty());
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
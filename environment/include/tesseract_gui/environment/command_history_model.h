@@ -0,0 +1,92 @@
+/**
+ * @file command_history_model.h
+ * @brief Table model of the commands applied to a monitored environment
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_ENVIRONMENT_COMMAND_HISTORY_MODEL_H
+#define TESSERACT_GUI_ENVIRONMENT_COMMAND_HISTORY_MODEL_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <QAbstractTableModel>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/environment/environment_history.h>
+
+namespace tesseract_gui
+{
+class EnvironmentMonitor;
+
+/**
+ * @brief One row per command of a monitored environment, the row of a command is its revision minus one
+ *
+ * The rows are generated from the EnvironmentHistory on demand, so views with uniform row heights only format the
+ * visible commands. Applied commands are appended as inserted rows, the model is only reset when the monitored
+ * environment is replaced or the history lost track of its revisions.
+ */
+class CommandHistoryModel : public QAbstractTableModel
+{
+  Q_OBJECT
+
+public:
+  enum Column
+  {
+    REVISION_COLUMN = 0,
+    TYPE_COLUMN,
+    COLUMN_COUNT
+  };
+
+  enum Role
+  {
+    RevisionRole = Qt::UserRole + 1
+  };
+
+  CommandHistoryModel(EnvironmentMonitor* monitor, QObject* parent = nullptr);
+
+  const EnvironmentHistory& getHistory() const;
+
+  /** @brief Set the number of revisions between snapshots of the history, resets the model */
+  void setSnapshotInterval(int snapshot_interval);
+  int getSnapshotInterval() const;
+
+  /** @brief Mark the row of a revision, e.g. the one shown, zero for none */
+  void setCurrentRevision(int revision);
+  int getCurrentRevision() const;
+
+  /** @brief The revision after the command of the row of the index */
+  int getRevision(const QModelIndex& index) const;
+  QModelIndex getIndex(int revision) const;
+
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+  int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+  QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+public Q_SLOTS:
+  /** @brief Reset the history from the monitored environment */
+  void reset();
+
+private Q_SLOTS:
+  void onCommandsApplied(const tesseract_environment::Commands& commands, int revision);
+
+private:
+  EnvironmentMonitor* monitor_;
+  EnvironmentHistory history_;
+  int current_revision_{ 0 };
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_ENVIRONMENT_COMMAND_HISTORY_MODEL_H
@@ -0,0 +1,82 @@
+/**
+ * @file command_history_widget.h
+ * @brief Lists the commands of a monitored environment and recreates the environment at a selected revision
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_ENVIRONMENT_COMMAND_HISTORY_WIDGET_H
+#define TESSERACT_GUI_ENVIRONMENT_COMMAND_HISTORY_WIDGET_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <QWidget>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_environment/environment.h>
+
+class QLabel;
+class QPushButton;
+class QTableView;
+
+namespace tesseract_gui
+{
+class CommandHistoryModel;
+class EnvironmentMonitor;
+
+/**
+ * @brief A table of the commands applied to an environment, activating a row jumps to the revision of that command
+ *
+ * Jumping recreates the environment at the revision from the nearest snapshot of the history and emits it through
+ * revisionChanged(), e.g. to show it in a render widget, the monitored environment is not modified. "Latest" returns
+ * to the monitored environment. The table uses fixed row heights so views stay responsive with long histories.
+ */
+class CommandHistoryWidget : public QWidget
+{
+  Q_OBJECT
+
+public:
+  explicit CommandHistoryWidget(EnvironmentMonitor* monitor, QWidget* parent = nullptr);
+
+  CommandHistoryModel* getModel() const;
+
+  /** @brief The revision shown, zero for the monitored environment */
+  int getRevision() const;
+
+public Q_SLOTS:
+  /** @brief Recreate the environment at a revision in [1, getModel()->rowCount()] */
+  void setRevision(int revision);
+
+  /** @brief Return to the monitored environment */
+  void showLatest();
+
+Q_SIGNALS:
+  /**
+   * @brief The environment to show changed
+   * @param environment The recreated environment, or the monitored environment when returning to the latest
+   * @param revision The revision, zero for the monitored environment
+   */
+  void revisionChanged(const tesseract_environment::Environment::ConstPtr& environment, int revision);
+
+private:
+  EnvironmentMonitor* monitor_;
+  CommandHistoryModel* model_;
+  QTableView* table_view_;
+  QPushButton* latest_button_;
+  QLabel* status_label_;
+  int revision_{ 0 };
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_ENVIRONMENT_COMMAND_HISTORY_WIDGET_H
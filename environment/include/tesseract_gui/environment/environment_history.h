@@ -0,0 +1,99 @@
+/**
+ * @file environment_history.h
+ * @brief The command history of an environment with periodic snapshots for fast access to any revision
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_ENVIRONMENT_ENVIRONMENT_HISTORY_H
+#define TESSERACT_GUI_ENVIRONMENT_ENVIRONMENT_HISTORY_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <map>
+#include <memory>
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_environment/environment.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief Recreates an environment at any revision of its command history by replaying from the nearest snapshot
+ *
+ * The environment revision is the number of commands applied, the command at index i results in revision i + 1.
+ * A clone of the environment is kept about every snapshot interval revisions, so recreating a revision clones the
+ * nearest snapshot before it and replays at most about snapshot interval commands, independent of the length of the
+ * history.
+ *
+ * Commands appended while monitoring take their snapshot by cloning the live environment, which may already be at a
+ * later revision than the appended commands. Only setEnvironment() replays the whole history, once, to create the
+ * snapshots of the revisions applied before monitoring started.
+ */
+class EnvironmentHistory
+{
+public:
+  using Ptr = std::shared_ptr<EnvironmentHistory>;
+  using ConstPtr = std::shared_ptr<const EnvironmentHistory>;
+
+  /** @param snapshot_interval The number of revisions between snapshots */
+  explicit EnvironmentHistory(int snapshot_interval = 100);
+
+  /** @brief Reset to the command history of an environment, replaying it once to create the snapshots */
+  void setEnvironment(const tesseract_environment::Environment& environment);
+
+  void clear();
+
+  /**
+   * @brief Append commands applied to an environment
+   * @param commands The commands applied in a single call to applyCommands()
+   * @param revision The environment revision after the commands were applied
+   * @param environment The environment, cloned as snapshot when the interval since the last snapshot is exceeded
+   * @return False if the commands do not continue the history, it must be reset with setEnvironment()
+   */
+  bool append(const tesseract_environment::Commands& commands,
+              int revision,
+              const tesseract_environment::Environment& environment);
+
+  /** @brief The revision after the last command of the history */
+  int getRevision() const;
+  const tesseract_environment::Commands& getCommands() const;
+
+  int getSnapshotInterval() const;
+  std::vector<int> getSnapshotRevisions() const;
+
+  /** @brief The number of commands getEnvironment() replays for a revision */
+  int getReplayCount(int revision) const;
+
+  /**
+   * @brief Recreate the environment at a revision
+   * @param revision The revision in [1, getRevision()]
+   * @return A new environment independent of the history and its snapshots
+   */
+  tesseract_environment::Environment::UPtr getEnvironment(int revision) const;
+
+private:
+  int snapshot_interval_;
+  tesseract_environment::Commands commands_;
+
+  /** @brief Environments by revision, the latest snapshot may be ahead of the commands */
+  std::map<int, tesseract_environment::Environment::ConstPtr> snapshots_;
+
+  /** @brief The snapshot getEnvironment() replays a revision from, end() if replaying from the first command */
+  std::map<int, tesseract_environment::Environment::ConstPtr>::const_iterator findSnapshot(int revision) const;
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_ENVIRONMENT_ENVIRONMENT_HISTORY_H
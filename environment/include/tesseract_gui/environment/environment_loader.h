@@ -0,0 +1,131 @@
+/**
+ * @file environment_loader.h
+ * @brief Loads environments from URDF and SRDF on a background thread
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_ENVIRONMENT_ENVIRONMENT_LOADER_H
+#define TESSERACT_GUI_ENVIRONMENT_ENVIRONMENT_LOADER_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <memory>
+#include <string>
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_common/resource_locator.h>
+#include <tesseract_environment/environment.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief Builds an environment from URDF and SRDF without blocking the thread of this object
+ *
+ * A load runs in three stages on a single background thread: the URDF is parsed into a scene graph, the SRDF is
+ * processed and finally the environment is initialized. Loading is not parallel, the mesh files are located, read and
+ * decoded one after another by the URDF parser of tesseract, the only gain is that the thread of this object (usually
+ * the GUI thread) stays responsive. Progress is reported through progressChanged() and the result is delivered with a
+ * single environmentLoaded() once the environment is fully built, so connecting it to
+ * EnvironmentMonitor::setEnvironment() swaps the displayed environment in one step.
+ *
+ * Only one load is active at a time, starting a new load cancels the previous one. Cancellation is checked between
+ * stages and before every resource, signals of a cancelled load are never emitted. All methods must be called from
+ * the thread of this object.
+ */
+class EnvironmentLoader : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit EnvironmentLoader(QObject* parent = nullptr);
+
+  /** @brief Cancels the active load and waits for the worker to finish */
+  ~EnvironmentLoader() override;
+  EnvironmentLoader(const EnvironmentLoader&) = delete;
+  EnvironmentLoader& operator=(const EnvironmentLoader&) = delete;
+  EnvironmentLoader(EnvironmentLoader&&) = delete;
+  EnvironmentLoader& operator=(EnvironmentLoader&&) = delete;
+
+  /** @brief The locator used for the URDF, SRDF and mesh URLs, defaults to a GeneralResourceLocator */
+  void setResourceLocator(std::shared_ptr<const tesseract_common::ResourceLocator> locator);
+  std::shared_ptr<const tesseract_common::ResourceLocator> getResourceLocator() const;
+
+  /**
+   * @brief Load an environment from resource URLs (e.g. package:// or file paths)
+   * @param urdf_url The URDF to load
+   * @param srdf_url The SRDF to load, may be empty
+   */
+  void load(const std::string& urdf_url, const std::string& srdf_url = "");
+
+  /**
+   * @brief Load an environment from URDF and SRDF strings
+   * @param urdf_xml The URDF xml
+   * @param srdf_xml The SRDF xml, may be empty
+   */
+  void loadString(const std::string& urdf_xml, const std::string& srdf_xml = "");
+
+  /** @brief Cancel the active load, loadCancelled() is emitted if a load was active */
+  void cancel();
+
+  /** @brief Check if a load is active */
+  bool isLoading() const;
+
+Q_SIGNALS:
+  /** @brief A load was started */
+  void loadStarted();
+
+  /**
+   * @brief The active load progressed
+   * @param percent The overall progress from 0 to 100
+   * @param message A description of the current stage
+   */
+  void progressChanged(int percent, const QString& message);
+
+  /** @brief The active load finished */
+  void environmentLoaded(tesseract_environment::Environment::Ptr environment);
+
+  /** @brief The active load failed */
+  void loadFailed(const QString& message);
+
+  /** @brief The active load was cancelled */
+  void loadCancelled();
+
+private:
+  struct Request;
+  struct Context;
+
+  std::shared_ptr<const tesseract_common::ResourceLocator> locator_;
+  QThreadPool pool_;
+
+  /** @brief The context of the active load, nullptr if no load is active */
+  std::shared_ptr<Context> active_;
+
+  void start(Request request);
+  void run(const std::shared_ptr<Context>& context);
+
+  /** @brief Post a progress update, only posted if the percentage changed */
+  void postProgress(const std::shared_ptr<Context>& context, int percent, const std::string& message);
+
+  /** @brief Post the result of a load, ignored if the context is no longer active */
+  void postFinished(const std::shared_ptr<Context>& context,
+                    tesseract_environment::Environment::Ptr environment,
+                    const std::string& error);
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_ENVIRONMENT_ENVIRONMENT_LOADER_H
@@ -0,0 +1,91 @@
+/**
+ * @file environment_monitor.h
+ * @brief Forwards tesseract environment events to the Qt event loop
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_ENVIRONMENT_ENVIRONMENT_MONITOR_H
+#define TESSERACT_GUI_ENVIRONMENT_ENVIRONMENT_MONITOR_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include <QObject>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_environment/environment.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief Subscribes to the event callbacks of an environment and re-emits them as signals in the thread of this object
+ *
+ * Environment events are triggered on whichever thread applied the commands while the environment is locked, so the
+ * callback only stores the event and schedules a single delivery. Everything received before the event loop gets to
+ * that delivery is emitted together, which keeps the GUI thread cost of a high rate command stream to one wake-up per
+ * event loop iteration. Command batches are emitted in order with the environment revision after each batch, scene
+ * state changes are coalesced to the most recent state.
+ */
+class EnvironmentMonitor : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit EnvironmentMonitor(QObject* parent = nullptr);
+  ~EnvironmentMonitor() override;
+  EnvironmentMonitor(const EnvironmentMonitor&) = delete;
+  EnvironmentMonitor& operator=(const EnvironmentMonitor&) = delete;
+  EnvironmentMonitor(EnvironmentMonitor&&) = delete;
+  EnvironmentMonitor& operator=(EnvironmentMonitor&&) = delete;
+
+  /**
+   * @brief Monitor the provided environment, events of the previous environment are no longer delivered
+   * @param environment The environment to monitor, may be nullptr
+   */
+  void setEnvironment(tesseract_environment::Environment::Ptr environment);
+  tesseract_environment::Environment::Ptr getEnvironment() const;
+
+Q_SIGNALS:
+  /** @brief The monitored environment was replaced */
+  void environmentChanged();
+
+  /**
+   * @brief Commands were applied to the environment
+   * @param commands The commands applied in a single call to applyCommands()
+   * @param revision The environment revision after the commands were applied
+   */
+  void commandsApplied(const tesseract_environment::Commands& commands, int revision);
+
+  /** @brief The most recent scene state of the environment */
+  void sceneStateChanged(const tesseract_scene_graph::SceneState& state);
+
+private:
+  tesseract_environment::Environment::Ptr environment_;
+
+  std::mutex mutex_;
+  std::vector<std::pair<tesseract_environment::Commands, int>> pending_commands_;
+  std::unique_ptr<tesseract_scene_graph::SceneState> pending_state_;
+  bool delivery_scheduled_{ false };
+
+  std::size_t getCallbackKey() const;
+  void onEvent(const tesseract_environment::Event& event);
+  void deliver();
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_ENVIRONMENT_ENVIRONMENT_MONITOR_H
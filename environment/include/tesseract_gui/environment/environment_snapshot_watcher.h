@@ -0,0 +1,74 @@
+/**
+ * @file environment_snapshot_watcher.h
+ * @brief Delivers the snapshots published to a shared environment once per frame
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_ENVIRONMENT_ENVIRONMENT_SNAPSHOT_WATCHER_H
+#define TESSERACT_GUI_ENVIRONMENT_ENVIRONMENT_SNAPSHOT_WATCHER_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <QObject>
+#include <QTimer>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/environment/shared_environment.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief Polls a shared environment once per frame and emits the latest snapshot when it changed
+ *
+ * Publishers never wait for the GUI: snapshots published within the same frame are skipped and polling is a single
+ * atomic load, so the GUI thread only does work when there is something new to show.
+ */
+class EnvironmentSnapshotWatcher : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit EnvironmentSnapshotWatcher(QObject* parent = nullptr);
+
+  /** @brief Watch a shared environment, its latest snapshot is emitted on the next frame */
+  void setSharedEnvironment(SharedEnvironment::ConstPtr shared_environment);
+  SharedEnvironment::ConstPtr getSharedEnvironment() const;
+
+  /** @brief The last emitted snapshot, nullptr before the first */
+  EnvironmentSnapshot::ConstPtr getSnapshot() const;
+
+  /** @brief Set the polling interval, defaults to the primary screen refresh rate */
+  void setFrameInterval(int msec);
+  int getFrameInterval() const;
+
+public Q_SLOTS:
+  /** @brief Check for a new snapshot now instead of on the next frame */
+  void poll();
+
+Q_SIGNALS:
+  /** @brief A snapshot of a different environment revision, e.g. to reload the scene from its scene graph */
+  void revisionChanged(const tesseract_gui::EnvironmentSnapshot::ConstPtr& snapshot);
+
+  /** @brief A new snapshot, emitted after revisionChanged() when both changed */
+  void snapshotChanged(const tesseract_gui::EnvironmentSnapshot::ConstPtr& snapshot);
+
+private:
+  SharedEnvironment::ConstPtr shared_environment_;
+  EnvironmentSnapshot::ConstPtr snapshot_;
+  QTimer frame_timer_;
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_ENVIRONMENT_ENVIRONMENT_SNAPSHOT_WATCHER_H
@@ -0,0 +1,78 @@
+/**
+ * @file scene_graph_model_updater.h
+ * @brief Keeps a scene graph model in sync with an environment through targeted row updates
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_ENVIRONMENT_SCENE_GRAPH_MODEL_UPDATER_H
+#define TESSERACT_GUI_ENVIRONMENT_SCENE_GRAPH_MODEL_UPDATER_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <QObject>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_environment/commands.h>
+
+namespace tesseract_gui
+{
+class EnvironmentMonitor;
+class SceneGraphModel;
+
+/**
+ * @brief Translates the commands applied to a monitored environment into SceneGraphModel row updates
+ *
+ * The model is only reset when the monitored environment is replaced or a command can not be expressed as link and
+ * joint changes (e.g. AddSceneGraph). All other scene graph commands result in inserts, removals or dataChanged for
+ * the affected rows. Commands which do not change the scene graph (allowed collisions, contact managers, etc.) are
+ * ignored.
+ */
+class SceneGraphModelUpdater : public QObject
+{
+  Q_OBJECT
+
+public:
+  SceneGraphModelUpdater(SceneGraphModel* model, EnvironmentMonitor* monitor, QObject* parent = nullptr);
+
+  /** @brief The environment revision the model currently reflects */
+  int getRevision() const;
+
+public Q_SLOTS:
+  /** @brief Reset the model from a snapshot of the monitored environment */
+  void reset();
+
+private Q_SLOTS:
+  void onCommandsApplied(const tesseract_environment::Commands& commands, int revision);
+
+private:
+  SceneGraphModel* model_;
+  EnvironmentMonitor* monitor_;
+  int revision_{ 0 };
+
+  /** @brief The root link of the snapshot the model was last reset from, the parent of links added without a joint */
+  std::string root_link_name_;
+
+  /**
+   * @brief Apply a single command to the model
+   * @return False if the command can not be applied incrementally and the model must be reset
+   */
+  bool applyCommand(const tesseract_environment::Command& command);
+
+  /** @brief Remove a link and everything below it, mirroring how the environment removes links */
+  void removeLinkRecursive(const std::string& link_name);
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_ENVIRONMENT_SCENE_GRAPH_MODEL_UPDATER_H
@@ -0,0 +1,99 @@
+/**
+ * @file shared_environment.h
+ * @brief Immutable versioned environment snapshots shared between planning threads and the GUI
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_ENVIRONMENT_SHARED_ENVIRONMENT_H
+#define TESSERACT_GUI_ENVIRONMENT_SHARED_ENVIRONMENT_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cstdint>
+#include <memory>
+#include <mutex>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_environment/environment.h>
+#include <tesseract_scene_graph/allowed_collision_matrix.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief A consistent view of an environment which never changes once published
+ *
+ * Snapshots of the same environment revision share their scene graph and allowed collision matrix, only the state
+ * is stored per snapshot.
+ */
+struct EnvironmentSnapshot
+{
+  using ConstPtr = std::shared_ptr<const EnvironmentSnapshot>;
+
+  /** @brief Incremented by every publish */
+  std::uint64_t version{ 0 };
+
+  /** @brief The environment revision of the scene graph and allowed collision matrix */
+  int revision{ 0 };
+
+  tesseract_scene_graph::SceneGraph::ConstPtr scene_graph;
+  tesseract_scene_graph::AllowedCollisionMatrix::ConstPtr allowed_collision_matrix;
+  tesseract_scene_graph::SceneState state;
+};
+
+/**
+ * @brief Read-mostly sharing of an environment between the threads modifying it and the GUI
+ *
+ * The thread which owns an environment (e.g. a planner) publishes it after changing it. Readers get the latest
+ * snapshot with a single atomic shared pointer load and can then use it without any locks for as long as they hold
+ * it, publishing only swaps in a new snapshot. Readers never touch the environment, so it is not locked or cloned
+ * when the GUI needs a consistent view.
+ *
+ * Publishing copies the scene graph and allowed collision matrix only when the environment revision changed since
+ * the previous snapshot, otherwise they are shared and only the state is taken. State only updates (e.g. a robot
+ * moving along a trajectory) can be published without the environment.
+ *
+ * publish(const Environment&) reads the environment without locking it, call it from the thread modifying the
+ * environment or while no other thread modifies it. All snapshots of one SharedEnvironment must come from the same
+ * environment, revisions of different environments are not comparable. Concurrent publishers are serialized.
+ */
+class SharedEnvironment
+{
+public:
+  using Ptr = std::shared_ptr<SharedEnvironment>;
+  using ConstPtr = std::shared_ptr<const SharedEnvironment>;
+
+  SharedEnvironment();
+
+  /** @brief The latest snapshot, never nullptr, empty with version zero until the first publish */
+  EnvironmentSnapshot::ConstPtr getSnapshot() const;
+
+  /** @brief Publish the scene graph, allowed collision matrix and state of an environment */
+  EnvironmentSnapshot::ConstPtr publish(const tesseract_environment::Environment& environment);
+
+  /** @brief Publish a new state for the scene graph of the latest snapshot */
+  EnvironmentSnapshot::ConstPtr publish(const tesseract_scene_graph::SceneState& state);
+
+private:
+  /** @brief Only accessed through std::atomic_load and std::atomic_store */
+  EnvironmentSnapshot::ConstPtr snapshot_;
+
+  /** @brief Serializes publishers, readers never take it */
+  std::mutex publish_mutex_;
+
+  void store(std::shared_ptr<EnvironmentSnapshot> snapshot);
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_ENVIRONMENT_SHARED_ENVIRONMENT_H
@@ -0,0 +1,238 @@
+/**
+ * @file command_history_model.cpp
+ * @brief Table model of the commands applied to a monitored environment
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <exception>
+#include <QFont>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/environment/command_history_model.h>
+#include <tesseract_gui/environment/environment_monitor.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+QString toQString(tesseract_environment::CommandType type)
+{
+  using tesseract_environment::CommandType;
+
+  switch (type)
+  {
+    case CommandType::ADD_LINK:
+      return "Add Link";
+    case CommandType::MOVE_LINK:
+      return "Move Link";
+    case CommandType::MOVE_JOINT:
+      return "Move Joint";
+    case CommandType::REMOVE_LINK:
+      return "Remove Link";
+    case CommandType::REMOVE_JOINT:
+      return "Remove Joint";
+    case CommandType::CHANGE_LINK_ORIGIN:
+      return "Change Link Origin";
+    case CommandType::CHANGE_JOINT_ORIGIN:
+      return "Change Joint Origin";
+    case CommandType::CHANGE_LINK_COLLISION_ENABLED:
+      return "Change Link Collision Enabled";
+    case CommandType::CHANGE_LINK_VISIBILITY:
+      return "Change Link Visibility";
+    case CommandType::MODIFY_ALLOWED_COLLISIONS:
+      return "Modify Allowed Collisions";
+    case CommandType::REMOVE_ALLOWED_COLLISION_LINK:
+      return "Remove Allowed Collision Link";
+    case CommandType::ADD_SCENE_GRAPH:
+      return "Add Scene Graph";
+    case CommandType::CHANGE_JOINT_POSITION_LIMITS:
+      return "Change Joint Position Limits";
+    case CommandType::CHANGE_JOINT_VELOCITY_LIMITS:
+      return "Change Joint Velocity Limits";
+    case CommandType::CHANGE_JOINT_ACCELERATION_LIMITS:
+      return "Change Joint Acceleration Limits";
+    case CommandType::ADD_KINEMATICS_INFORMATION:
+      return "Add Kinematics Information";
+    case CommandType::REPLACE_JOINT:
+      return "Replace Joint";
+    case CommandType::CHANGE_COLLISION_MARGINS:
+      return "Change Collision Margins";
+    case CommandType::ADD_CONTACT_MANAGERS_PLUGIN_INFO:
+      return "Add Contact Managers Plugin Info";
+    case CommandType::SET_ACTIVE_CONTINUOUS_CONTACT_MANAGER:
+      return "Set Active Continuous Contact Manager";
+    case CommandType::SET_ACTIVE_DISCRETE_CONTACT_MANAGER:
+      return "Set Active Discrete Contact Manager";
+    case CommandType::ADD_TRAJECTORY_LINK:
+      return "Add Trajectory Link";
+    default:
+      return "Unknown";
+  }
+}
+}  // namespace
+
+CommandHistoryModel::CommandHistoryModel(EnvironmentMonitor* monitor, QObject* parent)
+  : QAbstractTableModel(parent), monitor_(monitor)
+{
+  connect(monitor_, &EnvironmentMonitor::environmentChanged, this, &CommandHistoryModel::reset);
+  connect(monitor_, &EnvironmentMonitor::commandsApplied, this, &CommandHistoryModel::onCommandsApplied);
+  reset();
+}
+
+const EnvironmentHistory& CommandHistoryModel::getHistory() const { return history_; }
+
+void CommandHistoryModel::setSnapshotInterval(int snapshot_interval)
+{
+  if (snapshot_interval == history_.getSnapshotInterval())
+    return;
+
+  history_ = EnvironmentHistory(snapshot_interval);
+  reset();
+}
+
+int CommandHistoryModel::getSnapshotInterval() const { return history_.getSnapshotInterval(); }
+
+void CommandHistoryModel::setCurrentRevision(int revision)
+{
+  if (revision == current_revision_)
+    return;
+
+  const int previous = current_revision_;
+  current_revision_ = revision;
+  for (const int changed : { previous, current_revision_ })
+  {
+    if (changed >= 1 && changed <= history_.getRevision())
+      emit dataChanged(index(changed - 1, REVISION_COLUMN), index(changed - 1, COLUMN_COUNT - 1));
+  }
+}
+
+int CommandHistoryModel::getCurrentRevision() const { return current_revision_; }
+
+int CommandHistoryModel::getRevision(const QModelIndex& index) const { return index.isValid() ? index.row() + 1 : 0; }
+
+QModelIndex CommandHistoryModel::getIndex(int revision) const
+{
+  if (revision < 1 || revision > history_.getRevision())
+    return {};
+
+  return index(revision - 1, REVISION_COLUMN);
+}
+
+int CommandHistoryModel::rowCount(const QModelIndex& parent) const
+{
+  if (parent.isValid())
+    return 0;
+
+  return history_.getRevision();
+}
+
+int CommandHistoryModel::columnCount(const QModelIndex& parent) const
+{
+  if (parent.isValid())
+    return 0;
+
+  return COLUMN_COUNT;
+}
+
+QVariant CommandHistoryModel::data(const QModelIndex& index, int role) const
+{
+  if (!index.isValid())
+    return {};
+
+  const int revision = getRevision(index);
+  switch (role)
+  {
+    case Qt::DisplayRole:
+    {
+      if (index.column() == REVISION_COLUMN)
+        return revision;
+
+      const auto& command = history_.getCommands()[static_cast<std::size_t>(index.row())];
+      return (command == nullptr) ? QString("Unknown") : toQString(command->getType());
+    }
+    case Qt::FontRole:
+    {
+      if (revision != current_revision_)
+        return {};
+
+      QFont font;
+      font.setBold(true);
+      return font;
+    }
+    case RevisionRole:
+      return revision;
+    default:
+      return {};
+  }
+}
+
+QVariant CommandHistoryModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+  if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+    return {};
+
+  switch (section)
+  {
+    case REVISION_COLUMN:
+      return "Revision";
+    case TYPE_COLUMN:
+      return "Command";
+    default:
+      return {};
+  }
+}
+
+void CommandHistoryModel::reset()
+{
+  beginResetModel();
+  current_revision_ = 0;
+  tesseract_environment::Environment::Ptr env = monitor_->getEnvironment();
+  try
+  {
+    if (env == nullptr)
+      history_.clear();
+    else
+      history_.setEnvironment(*env);
+  }
+  catch (const std::exception&)
+  {
+    // A history which can not be replayed can not be browsed either
+    history_.clear();
+  }
+  endResetModel();
+}
+
+void CommandHistoryModel::onCommandsApplied(const tesseract_environment::Commands& commands, int revision)
+{
+  tesseract_environment::Environment::Ptr env = monitor_->getEnvironment();
+
+  // Already contained in the history the model was last reset from
+  if (env == nullptr || commands.empty() || revision <= history_.getRevision())
+    return;
+
+  const int first = history_.getRevision();
+  if (revision - static_cast<int>(commands.size()) != first)
+  {
+    reset();
+    return;
+  }
+
+  beginInsertRows(QModelIndex(), first, revision - 1);
+  history_.append(commands, revision, *env);
+  endInsertRows();
+}
+
+}  // namespace tesseract_gui
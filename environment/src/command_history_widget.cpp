@@ -0,0 +1,117 @@
+/**
+ * @file command_history_widget.cpp
+ * @brief Lists the commands of a monitored environment and recreates the environment at a selected revision
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <exception>
+#include <QElapsedTimer>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QPushButton>
+#include <QTableView>
+#include <QVBoxLayout>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/environment/command_history_widget.h>
+#include <tesseract_gui/environment/command_history_model.h>
+#include <tesseract_gui/environment/environment_monitor.h>
+
+namespace tesseract_gui
+{
+CommandHistoryWidget::CommandHistoryWidget(EnvironmentMonitor* monitor, QWidget* parent)
+  : QWidget(parent)
+  , monitor_(monitor)
+  , model_(new CommandHistoryModel(monitor, this))
+  , table_view_(new QTableView(this))
+  , latest_button_(new QPushButton("Latest", this))
+  , status_label_(new QLabel(this))
+{
+  table_view_->setModel(model_);
+  table_view_->setSelectionBehavior(QAbstractItemView::SelectRows);
+  table_view_->setSelectionMode(QAbstractItemView::SingleSelection);
+  table_view_->horizontalHeader()->setStretchLastSection(true);
+
+  // Fixed row heights keep the view from measuring every row of long histories
+  table_view_->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+  table_view_->verticalHeader()->setDefaultSectionSize(table_view_->fontMetrics().height() + 6);
+  table_view_->verticalHeader()->hide();
+
+  auto* button_layout = new QHBoxLayout();
+  button_layout->addWidget(status_label_, 1);
+  button_layout->addWidget(latest_button_);
+
+  auto* layout = new QVBoxLayout(this);
+  layout->addWidget(table_view_, 1);
+  layout->addLayout(button_layout);
+
+  connect(table_view_, &QTableView::activated, this, [this](const QModelIndex& index) {
+    setRevision(model_->getRevision(index));
+  });
+  connect(latest_button_, &QPushButton::clicked, this, &CommandHistoryWidget::showLatest);
+
+  // The model reset discards the recreated environment, the monitored environment is shown again
+  connect(monitor_, &EnvironmentMonitor::environmentChanged, this, &CommandHistoryWidget::showLatest);
+
+  status_label_->setText("Latest");
+  latest_button_->setEnabled(false);
+}
+
+CommandHistoryModel* CommandHistoryWidget::getModel() const { return model_; }
+
+int CommandHistoryWidget::getRevision() const { return revision_; }
+
+void CommandHistoryWidget::setRevision(int revision)
+{
+  const int replay_count = model_->getHistory().getReplayCount(revision);
+  QElapsedTimer timer;
+  timer.start();
+
+  tesseract_environment::Environment::ConstPtr environment;
+  try
+  {
+    environment = model_->getHistory().getEnvironment(revision);
+  }
+  catch (const std::exception& e)
+  {
+    status_label_->setText(QString("Failed to recreate revision %1: %2").arg(revision).arg(e.what()));
+    return;
+  }
+
+  revision_ = revision;
+  model_->setCurrentRevision(revision);
+  latest_button_->setEnabled(true);
+  status_label_->setText(QString("Revision %1 of %2, replayed %3 commands in %4 ms")
+                             .arg(revision)
+                             .arg(model_->getHistory().getRevision())
+                             .arg(replay_count)
+                             .arg(timer.elapsed()));
+
+  emit revisionChanged(environment, revision);
+}
+
+void CommandHistoryWidget::showLatest()
+{
+  revision_ = 0;
+  model_->setCurrentRevision(0);
+  latest_button_->setEnabled(false);
+  status_label_->setText("Latest");
+
+  emit revisionChanged(monitor_->getEnvironment(), 0);
+}
+
+}  // namespace tesseract_gui
@@ -0,0 +1,153 @@
+/**
+ * @file environment_history.cpp
+ * @brief The command history of an environment with periodic snapshots for fast access to any revision
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/common/instrumentation.h>
+#include <tesseract_gui/environment/environment_history.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+tesseract_environment::Commands sliceCommands(const tesseract_environment::Commands& commands, int first, int last)
+{
+  return { commands.begin() + first, commands.begin() + last };
+}
+}  // namespace
+
+EnvironmentHistory::EnvironmentHistory(int snapshot_interval) : snapshot_interval_(snapshot_interval)
+{
+  if (snapshot_interval_ < 1)
+    throw std::runtime_error("EnvironmentHistory, snapshot interval must be positive!");
+}
+
+void EnvironmentHistory::setEnvironment(const tesseract_environment::Environment& environment)
+{
+  clear();
+  if (!environment.isInitialized())
+    return;
+
+  // The clone is taken under the environment lock, so the command history and revision are consistent
+  tesseract_environment::Environment::UPtr latest = environment.clone();
+  commands_ = latest->getCommandHistory();
+  const int revision = static_cast<int>(commands_.size());
+  if (latest->getRevision() != revision)
+    throw std::runtime_error("EnvironmentHistory, environment revision does not match its command history!");
+
+  auto replica = std::make_unique<tesseract_environment::Environment>();
+  for (int snapshot = std::min(snapshot_interval_, revision); snapshot < revision; snapshot += snapshot_interval_)
+  {
+    const bool applied = (replica->getRevision() == 0) ?
+                             replica->init(sliceCommands(commands_, 0, snapshot)) :
+                             replica->applyCommands(sliceCommands(commands_, replica->getRevision(), snapshot));
+    if (!applied)
+      throw std::runtime_error("EnvironmentHistory, failed to replay the command history!");
+
+    snapshots_[snapshot] = replica->clone();
+  }
+
+  snapshots_[revision] = std::move(latest);
+}
+
+void EnvironmentHistory::clear()
+{
+  commands_.clear();
+  snapshots_.clear();
+}
+
+bool EnvironmentHistory::append(const tesseract_environment::Commands& commands,
+                                int revision,
+                                const tesseract_environment::Environment& environment)
+{
+  if (revision - static_cast<int>(commands.size()) != getRevision())
+    return false;
+
+  commands_.insert(commands_.end(), commands.begin(), commands.end());
+
+  const int last_snapshot = snapshots_.empty() ? 0 : snapshots_.rbegin()->first;
+  if (revision - last_snapshot >= snapshot_interval_)
+  {
+    tesseract_environment::Environment::UPtr snapshot = environment.clone();
+    const int snapshot_revision = snapshot->getRevision();
+    snapshots_[snapshot_revision] = std::move(snapshot);
+  }
+
+  return true;
+}
+
+int EnvironmentHistory::getRevision() const { return static_cast<int>(commands_.size()); }
+
+const tesseract_environment::Commands& EnvironmentHistory::getCommands() const { return commands_; }
+
+int EnvironmentHistory::getSnapshotInterval() const { return snapshot_interval_; }
+
+std::vector<int> EnvironmentHistory::getSnapshotRevisions() const
+{
+  std::vector<int> revisions;
+  revisions.reserve(snapshots_.size());
+  for (const auto& snapshot : snapshots_)
+    revisions.push_back(snapshot.first);
+  return revisions;
+}
+
+int EnvironmentHistory::getReplayCount(int revision) const
+{
+  auto it = findSnapshot(revision);
+  return (it == snapshots_.end()) ? revision : revision - it->first;
+}
+
+tesseract_environment::Environment::UPtr EnvironmentHistory::getEnvironment(int revision) const
+{
+  if (revision < 1 || revision > getRevision())
+    throw std::runtime_error("EnvironmentHistory, revision is out of range!");
+
+  const ScopedTimer timer("environment", "replay history");
+  tesseract_environment::Environment::UPtr environment;
+  bool applied{ true };
+  auto it = findSnapshot(revision);
+  if (it == snapshots_.end())
+  {
+    environment = std::make_unique<tesseract_environment::Environment>();
+    applied = environment->init(sliceCommands(commands_, 0, revision));
+  }
+  else
+  {
+    environment = it->second->clone();
+    if (it->first < revision)
+      applied = environment->applyCommands(sliceCommands(commands_, it->first, revision));
+  }
+
+  if (!applied)
+    throw std::runtime_error("EnvironmentHistory, failed to replay the command history!");
+
+  return environment;
+}
+
+std::map<int, tesseract_environment::Environment::ConstPtr>::const_iterator
+EnvironmentHistory::findSnapshot(int revision) const
+{
+  auto it = snapshots_.upper_bound(revision);
+  return (it == snapshots_.begin()) ? snapshots_.end() : std::prev(it);
+}
+
+}  // namespace tesseract_gui
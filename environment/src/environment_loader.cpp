@@ -0,0 +1,342 @@
+/**
+ * @file environment_loader.cpp
+ * @brief Loads environments from URDF and SRDF on a background thread
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+#include <QMetaObject>
+#include <QRunnable>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/common/instrumentation.h>
+#include <tesseract_gui/environment/environment_loader.h>
+#include <tesseract_srdf/srdf_model.h>
+#include <tesseract_urdf/urdf_parser.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+class FunctionRunnable : public QRunnable
+{
+public:
+  explicit FunctionRunnable(std::function<void()> function) : function_(std::move(function)) {}
+
+  void run() override { function_(); }
+
+private:
+  std::function<void()> function_;
+};
+
+/**
+ * @brief Forwards lookups to the wrapped locator
+ *
+ * The callback is invoked before every lookup with the number of lookups so far, it reports progress and throws to
+ * abort the parse when the load is cancelled.
+ */
+class ProgressResourceLocator : public tesseract_common::ResourceLocator
+{
+public:
+  ProgressResourceLocator(std::shared_ptr<const tesseract_common::ResourceLocator> locator,
+                          std::function<void(std::size_t)> callback)
+    : locator_(std::move(locator)), callback_(std::move(callback))
+  {
+  }
+
+  tesseract_common::Resource::Ptr locateResource(const std::string& url) const override
+  {
+    callback_(++located_);
+    return locator_->locateResource(url);
+  }
+
+private:
+  std::shared_ptr<const tesseract_common::ResourceLocator> locator_;
+  std::function<void(std::size_t)> callback_;
+  mutable std::size_t located_{ 0 };
+};
+
+/** @brief Find the unique values of all filename attributes, URDF only uses them for meshes */
+std::vector<std::string> findResourceUrls(const std::string& xml)
+{
+  static const std::string attribute = "filename";
+
+  std::vector<std::string> urls;
+  std::unordered_set<std::string> found;
+  std::size_t pos = xml.find(attribute);
+  while (pos != std::string::npos)
+  {
+    std::size_t i = pos + attribute.size();
+    while (i < xml.size() && (std::isspace(static_cast<unsigned char>(xml[i])) != 0))
+      ++i;
+
+    if (i < xml.size() && xml[i] == '=')
+    {
+      ++i;
+      while (i < xml.size() && (std::isspace(static_cast<unsigned char>(xml[i])) != 0))
+        ++i;
+
+      if (i < xml.size() && (xml[i] == '"' || xml[i] == '\''))
+      {
+        const std::size_t end = xml.find(xml[i], i + 1);
+        if (end == std::string::npos)
+          break;
+
+        std::string url = xml.substr(i + 1, end - i - 1);
+        if (!url.empty() && found.insert(url).second)
+          urls.push_back(std::move(url));
+
+        i = end;
+      }
+    }
+
+    pos = xml.find(attribute, i);
+  }
+
+  return urls;
+}
+
+std::string readResource(const tesseract_common::ResourceLocator& locator, const std::string& url)
+{
+  tesseract_common::Resource::Ptr resource = locator.locateResource(url);
+  if (resource == nullptr)
+    throw std::runtime_error("EnvironmentLoader, failed to locate '" + url + "'!");
+
+  const std::vector<uint8_t> bytes = resource->getResourceContents();
+  return { bytes.begin(), bytes.end() };
+}
+
+/** @brief Tesseract parsers nest exceptions, join all messages */
+std::string getMessage(const std::exception& e)
+{
+  std::string message = e.what();
+  try
+  {
+    std::rethrow_if_nested(e);
+  }
+  catch (const std::exception& nested)
+  {
+    message += "\n" + getMessage(nested);
+  }
+  catch (...)
+  {
+  }
+  return message;
+}
+}  // namespace
+
+struct EnvironmentLoader::Request
+{
+  std::string urdf_url;
+  std::string srdf_url;
+  std::string urdf_xml;
+  std::string srdf_xml;
+};
+
+struct EnvironmentLoader::Context
+{
+  Request request;
+  std::shared_ptr<const tesseract_common::ResourceLocator> locator;
+  std::atomic<bool> cancelled{ false };
+  std::atomic<int> percent{ -1 };
+
+  void checkCancelled() const
+  {
+    if (cancelled)
+      throw std::runtime_error("EnvironmentLoader, load cancelled!");
+  }
+};
+
+EnvironmentLoader::EnvironmentLoader(QObject* parent)
+  : QObject(parent), locator_(std::make_shared<tesseract_common::GeneralResourceLocator>())
+{
+  // A load runs on a single thread, a cancelled load may still finish its current stage while the next one starts
+  pool_.setMaxThreadCount(2);
+}
+
+EnvironmentLoader::~EnvironmentLoader()
+{
+  if (active_ != nullptr)
+    active_->cancelled = true;
+
+  pool_.waitForDone();
+}
+
+void EnvironmentLoader::setResourceLocator(std::shared_ptr<const tesseract_common::ResourceLocator> locator)
+{
+  if (locator == nullptr)
+    throw std::runtime_error("EnvironmentLoader, resource locator is a nullptr!");
+
+  locator_ = std::move(locator);
+}
+
+std::shared_ptr<const tesseract_common::ResourceLocator> EnvironmentLoader::getResourceLocator() const
+{
+  return locator_;
+}
+
+void EnvironmentLoader::load(const std::string& urdf_url, const std::string& srdf_url)
+{
+  Request request;
+  request.urdf_url = urdf_url;
+  request.srdf_url = srdf_url;
+  start(std::move(request));
+}
+
+void EnvironmentLoader::loadString(const std::string& urdf_xml, const std::string& srdf_xml)
+{
+  Request request;
+  request.urdf_xml = urdf_xml;
+  request.srdf_xml = srdf_xml;
+  start(std::move(request));
+}
+
+void EnvironmentLoader::cancel()
+{
+  if (active_ == nullptr)
+    return;
+
+  // The worker may still run until its next check, everything it posts is ignored once it is no longer active
+  active_->cancelled = true;
+  active_.reset();
+  emit loadCancelled();
+}
+
+bool EnvironmentLoader::isLoading() const { return (active_ != nullptr); }
+
+void EnvironmentLoader::start(Request request)
+{
+  cancel();
+
+  auto context = std::make_shared<Context>();
+  context->request = std::move(request);
+  context->locator = locator_;
+  active_ = context;
+
+  emit loadStarted();
+  pool_.start(new FunctionRunnable([this, context]() { run(context); }));
+}
+
+void EnvironmentLoader::run(const std::shared_ptr<Context>& context)
+{
+  const ScopedTimer timer("environment", "load");
+  try
+  {
+    const Request& request = context->request;
+
+    postProgress(context, 0, "Reading URDF");
+    const std::string urdf_xml =
+        request.urdf_url.empty() ? request.urdf_xml : readResource(*context->locator, request.urdf_url);
+    const std::string srdf_xml =
+        request.srdf_url.empty() ? request.srdf_xml : readResource(*context->locator, request.srdf_url);
+    if (urdf_xml.empty())
+      throw std::runtime_error("EnvironmentLoader, URDF is empty!");
+
+    context->checkCancelled();
+
+    // Stage 1: parse the URDF, which locates and decodes the meshes one after another on this thread
+    const std::size_t total = std::max<std::size_t>(1, findResourceUrls(urdf_xml).size());
+    auto locator = std::make_shared<ProgressResourceLocator>(context->locator, [this, context, total](std::size_t n) {
+      context->checkCancelled();
+      postProgress(context, 5 + static_cast<int>((85 * std::min(n, total)) / total), "Parsing URDF");
+    });
+
+    postProgress(context, 5, "Parsing URDF");
+    tesseract_scene_graph::SceneGraph::UPtr scene_graph;
+    {
+      const ScopedTimer parse_timer("environment", "parse urdf");
+      scene_graph = tesseract_urdf::parseURDFString(urdf_xml, *locator);
+    }
+    if (scene_graph == nullptr)
+      throw std::runtime_error("EnvironmentLoader, failed to parse URDF!");
+
+    // Stage 2: process the SRDF
+    tesseract_srdf::SRDFModel::Ptr srdf;
+    if (!srdf_xml.empty())
+    {
+      postProgress(context, 90, "Processing SRDF");
+      srdf = std::make_shared<tesseract_srdf::SRDFModel>();
+      srdf->initString(*scene_graph, srdf_xml, *locator);
+    }
+
+    context->checkCancelled();
+
+    // Stage 3: build the environment
+    postProgress(context, 95, "Initializing environment");
+    auto environment = std::make_shared<tesseract_environment::Environment>();
+    if (!environment->init(*scene_graph, srdf))
+      throw std::runtime_error("EnvironmentLoader, failed to initialize environment!");
+
+    context->checkCancelled();
+    postFinished(context, std::move(environment), "");
+  }
+  catch (const std::exception& e)
+  {
+    postFinished(context, nullptr, getMessage(e));
+  }
+}
+
+void EnvironmentLoader::postProgress(const std::shared_ptr<Context>& context, int percent, const std::string& message)
+{
+  // Only post increasing percentages
+  int current = context->percent.load();
+  do
+  {
+    if (percent <= current)
+      return;
+  } while (!context->percent.compare_exchange_weak(current, percent));
+
+  QMetaObject::invokeMethod(
+      this,
+      [this, context, percent, message]() {
+        if (active_ == context)
+          emit progressChanged(percent, QString::fromStdString(message));
+      },
+      Qt::QueuedConnection);
+}
+
+void EnvironmentLoader::postFinished(const std::shared_ptr<Context>& context,
+                                     tesseract_environment::Environment::Ptr environment,
+                                     const std::string& error)
+{
+  QMetaObject::invokeMethod(
+      this,
+      [this, context, environment, error]() {
+        if (active_ != context)
+          return;
+
+        active_.reset();
+        if (environment != nullptr)
+        {
+          emit progressChanged(100, "Done");
+          emit environmentLoaded(environment);
+        }
+        else
+        {
+          emit loadFailed(QString::fromStdString(error));
+        }
+      },
+      Qt::QueuedConnection);
+}
+
+}  // namespace tesseract_gui
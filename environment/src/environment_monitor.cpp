@@ -0,0 +1,108 @@
+/**
+ * @file environment_monitor.cpp
+ * @brief Forwards tesseract environment events to the Qt event loop
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <functional>
+#include <QMetaObject>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/environment/environment_monitor.h>
+#include <tesseract_environment/events.h>
+
+namespace tesseract_gui
+{
+EnvironmentMonitor::EnvironmentMonitor(QObject* parent) : QObject(parent) {}
+
+EnvironmentMonitor::~EnvironmentMonitor()
+{
+  if (environment_ != nullptr)
+    environment_->removeEventCallback(getCallbackKey());
+}
+
+void EnvironmentMonitor::setEnvironment(tesseract_environment::Environment::Ptr environment)
+{
+  // Removing the callback takes the environment lock so no callback is running once this returns
+  if (environment_ != nullptr)
+    environment_->removeEventCallback(getCallbackKey());
+
+  {
+    std::scoped_lock lock(mutex_);
+    pending_commands_.clear();
+    pending_state_.reset();
+  }
+
+  environment_ = std::move(environment);
+  if (environment_ != nullptr)
+    environment_->addEventCallback(getCallbackKey(),
+                                   [this](const tesseract_environment::Event& event) { onEvent(event); });
+
+  emit environmentChanged();
+}
+
+tesseract_environment::Environment::Ptr EnvironmentMonitor::getEnvironment() const { return environment_; }
+
+std::size_t EnvironmentMonitor::getCallbackKey() const { return std::hash<const EnvironmentMonitor*>()(this); }
+
+void EnvironmentMonitor::onEvent(const tesseract_environment::Event& event)
+{
+  std::scoped_lock lock(mutex_);
+  switch (event.type)
+  {
+    case tesseract_environment::Events::COMMAND_APPLIED:
+    {
+      const auto& e = static_cast<const tesseract_environment::CommandAppliedEvent&>(event);
+      pending_commands_.emplace_back(e.commands, e.revision);
+      break;
+    }
+    case tesseract_environment::Events::SCENE_STATE_CHANGED:
+    {
+      const auto& e = static_cast<const tesseract_environment::SceneStateChangedEvent&>(event);
+      if (pending_state_ == nullptr)
+        pending_state_ = std::make_unique<tesseract_scene_graph::SceneState>(e.state);
+      else
+        *pending_state_ = e.state;
+      break;
+    }
+  }
+
+  if (!delivery_scheduled_)
+  {
+    delivery_scheduled_ = true;
+    QMetaObject::invokeMethod(this, [this]() { deliver(); }, Qt::QueuedConnection);
+  }
+}
+
+void EnvironmentMonitor::deliver()
+{
+  std::vector<std::pair<tesseract_environment::Commands, int>> commands;
+  std::unique_ptr<tesseract_scene_graph::SceneState> state;
+  {
+    std::scoped_lock lock(mutex_);
+    commands.swap(pending_commands_);
+    state.swap(pending_state_);
+    delivery_scheduled_ = false;
+  }
+
+  for (const auto& batch : commands)
+    emit commandsApplied(batch.first, batch.second);
+
+  if (state != nullptr)
+    emit sceneStateChanged(*state);
+}
+
+}  // namespace tesseract_gui
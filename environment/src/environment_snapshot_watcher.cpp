@@ -0,0 +1,68 @@
+/**
+ * @file environment_snapshot_watcher.cpp
+ * @brief Delivers the snapshots published to a shared environment once per frame
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_gui/common/frame_interval.h>
+#include <tesseract_gui/environment/environment_snapshot_watcher.h>
+
+namespace tesseract_gui
+{
+EnvironmentSnapshotWatcher::EnvironmentSnapshotWatcher(QObject* parent) : QObject(parent)
+{
+  frame_timer_.setTimerType(Qt::PreciseTimer);
+  frame_timer_.setInterval(getDefaultFrameInterval());
+  connect(&frame_timer_, &QTimer::timeout, this, &EnvironmentSnapshotWatcher::poll);
+}
+
+void EnvironmentSnapshotWatcher::setSharedEnvironment(SharedEnvironment::ConstPtr shared_environment)
+{
+  shared_environment_ = std::move(shared_environment);
+  snapshot_ = nullptr;
+  if (shared_environment_ != nullptr)
+    frame_timer_.start();
+  else
+    frame_timer_.stop();
+}
+
+SharedEnvironment::ConstPtr EnvironmentSnapshotWatcher::getSharedEnvironment() const { return shared_environment_; }
+
+EnvironmentSnapshot::ConstPtr EnvironmentSnapshotWatcher::getSnapshot() const { return snapshot_; }
+
+void EnvironmentSnapshotWatcher::setFrameInterval(int msec) { frame_timer_.setInterval(msec); }
+
+int EnvironmentSnapshotWatcher::getFrameInterval() const { return frame_timer_.interval(); }
+
+void EnvironmentSnapshotWatcher::poll()
+{
+  if (shared_environment_ == nullptr)
+    return;
+
+  EnvironmentSnapshot::ConstPtr snapshot = shared_environment_->getSnapshot();
+  if (snapshot_ != nullptr && snapshot->version == snapshot_->version)
+    return;
+
+  // Snapshots of the same revision share the scene graph, comparing it also detects a reset of the revision
+  const bool revision_changed = (snapshot_ == nullptr || snapshot->scene_graph != snapshot_->scene_graph ||
+                                 snapshot->revision != snapshot_->revision);
+  snapshot_ = std::move(snapshot);
+
+  if (revision_changed)
+    emit revisionChanged(snapshot_);
+
+  emit snapshotChanged(snapshot_);
+}
+
+}  // namespace tesseract_gui
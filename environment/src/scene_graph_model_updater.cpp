@@ -0,0 +1,273 @@
+/**
+ * @file scene_graph_model_updater.cpp
+ * @brief Keeps a scene graph model in sync with an environment through targeted row updates
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <string>
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/common/instrumentation.h>
+#include <tesseract_gui/environment/scene_graph_model_updater.h>
+#include <tesseract_gui/environment/environment_monitor.h>
+#include <tesseract_gui/scene_graph/scene_graph_model.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+/** @brief Copy a joint of the model so it can be modified without touching the instance the model references */
+tesseract_scene_graph::Joint::Ptr cloneJoint(const SceneGraphModel& model, const std::string& name)
+{
+  auto joint = model.getJoint(name);
+  if (joint == nullptr)
+    return nullptr;
+
+  auto copy = std::make_shared<tesseract_scene_graph::Joint>(joint->clone());
+  copy->limits = (joint->limits != nullptr) ? std::make_shared<tesseract_scene_graph::JointLimits>(*joint->limits) :
+                                              std::make_shared<tesseract_scene_graph::JointLimits>();
+  return copy;
+}
+}  // namespace
+
+SceneGraphModelUpdater::SceneGraphModelUpdater(SceneGraphModel* model, EnvironmentMonitor* monitor, QObject* parent)
+  : QObject(parent), model_(model), monitor_(monitor)
+{
+  connect(monitor_, &EnvironmentMonitor::environmentChanged, this, &SceneGraphModelUpdater::reset);
+  connect(monitor_, &EnvironmentMonitor::commandsApplied, this, &SceneGraphModelUpdater::onCommandsApplied);
+  reset();
+}
+
+int SceneGraphModelUpdater::getRevision() const { return revision_; }
+
+void SceneGraphModelUpdater::reset()
+{
+  tesseract_environment::Environment::Ptr env = monitor_->getEnvironment();
+  if (env == nullptr || !env->isInitialized())
+  {
+    revision_ = 0;
+    root_link_name_.clear();
+    model_->clear();
+    return;
+  }
+
+  // The clone is taken under the environment lock, so the scene graph and revision are consistent and no other thread
+  // can modify the links and joints the model references.
+  tesseract_environment::Environment::UPtr snapshot = env->clone();
+  revision_ = snapshot->getRevision();
+  root_link_name_ = snapshot->getRootLinkName();
+  model_->setSceneGraph(snapshot->getSceneGraph());
+}
+
+void SceneGraphModelUpdater::onCommandsApplied(const tesseract_environment::Commands& commands, int revision)
+{
+  // Already contained in the snapshot the model was last reset from
+  if (revision <= revision_)
+    return;
+
+  const ScopedTimer timer("environment", "update model");
+  for (const auto& command : commands)
+  {
+    if (!applyCommand(*command))
+    {
+      reset();
+      return;
+    }
+  }
+
+  revision_ = revision;
+}
+
+bool SceneGraphModelUpdater::applyCommand(const tesseract_environment::Command& command)
+{
+  using namespace tesseract_environment;
+
+  switch (command.getType())
+  {
+    case CommandType::ADD_LINK:
+    {
+      const auto& cmd = static_cast<const AddLinkCommand&>(command);
+      const std::string& link_name = cmd.getLink()->getName();
+      tesseract_scene_graph::Joint::ConstPtr joint = cmd.getJoint();
+
+      // Like the environment, a new link without a joint is attached to the root by a fixed joint
+      if (joint == nullptr && model_->getLink(link_name) == nullptr)
+      {
+        if (root_link_name_.empty())
+          return false;
+
+        auto fixed_joint = std::make_shared<tesseract_scene_graph::Joint>("joint_" + link_name);
+        fixed_joint->type = tesseract_scene_graph::JointType::FIXED;
+        fixed_joint->parent_link_name = root_link_name_;
+        fixed_joint->child_link_name = link_name;
+        joint = fixed_joint;
+      }
+
+      model_->addLink(cmd.getLink());
+      if (joint != nullptr)
+        model_->addJoint(joint);
+      return true;
+    }
+    case CommandType::MOVE_LINK:
+    {
+      const auto& cmd = static_cast<const MoveLinkCommand&>(command);
+      const std::string& child_link_name = cmd.getJoint()->child_link_name;
+
+      std::vector<std::string> parent_joints;
+      for (const auto& joint : model_->getJoints())
+      {
+        if (joint->child_link_name == child_link_name)
+          parent_joints.push_back(joint->getName());
+      }
+
+      for (const auto& joint_name : parent_joints)
+        model_->removeJoint(joint_name);
+
+      model_->addJoint(cmd.getJoint());
+      return true;
+    }
+    case CommandType::MOVE_JOINT:
+    {
+      const auto& cmd = static_cast<const MoveJointCommand&>(command);
+      auto joint = cloneJoint(*model_, cmd.getJointName());
+      if (joint == nullptr)
+        return false;
+
+      joint->parent_link_name = cmd.getParentLink();
+      model_->addJoint(joint);
+      return true;
+    }
+    case CommandType::REMOVE_LINK:
+    {
+      const auto& cmd = static_cast<const RemoveLinkCommand&>(command);
+      removeLinkRecursive(cmd.getLinkName());
+      return true;
+    }
+    case CommandType::REMOVE_JOINT:
+    {
+      const auto& cmd = static_cast<const RemoveJointCommand&>(command);
+      auto joint = model_->getJoint(cmd.getJointName());
+      if (joint == nullptr)
+        return false;
+
+      model_->removeJoint(joint->getName());
+      removeLinkRecursive(joint->child_link_name);
+      return true;
+    }
+    case CommandType::CHANGE_LINK_ORIGIN:
+    {
+      // Links do not carry an origin in the scene graph, there is nothing in the model to update
+      return true;
+    }
+    case CommandType::CHANGE_JOINT_ORIGIN:
+    {
+      const auto& cmd = static_cast<const ChangeJointOriginCommand&>(command);
+      auto joint = cloneJoint(*model_, cmd.getJointName());
+      if (joint == nullptr)
+        return false;
+
+      joint->parent_to_joint_origin_transform = cmd.getOrigin();
+      model_->addJoint(joint);
+      return true;
+    }
+    case CommandType::CHANGE_JOINT_POSITION_LIMITS:
+    {
+      const auto& cmd = static_cast<const ChangeJointPositionLimitsCommand&>(command);
+      for (const auto& limit : cmd.getLimits())
+      {
+        auto joint = cloneJoint(*model_, limit.first);
+        if (joint == nullptr)
+          return false;
+
+        joint->limits->lower = limit.second.first;
+        joint->limits->upper = limit.second.second;
+        model_->addJoint(joint);
+      }
+      return true;
+    }
+    case CommandType::CHANGE_JOINT_VELOCITY_LIMITS:
+    {
+      const auto& cmd = static_cast<const ChangeJointVelocityLimitsCommand&>(command);
+      for (const auto& limit : cmd.getLimits())
+      {
+        auto joint = cloneJoint(*model_, limit.first);
+        if (joint == nullptr)
+          return false;
+
+        joint->limits->velocity = limit.second;
+        model_->addJoint(joint);
+      }
+      return true;
+    }
+    case CommandType::CHANGE_JOINT_ACCELERATION_LIMITS:
+    {
+      const auto& cmd = static_cast<const ChangeJointAccelerationLimitsCommand&>(command);
+      for (const auto& limit : cmd.getLimits())
+      {
+        auto joint = cloneJoint(*model_, limit.first);
+        if (joint == nullptr)
+          return false;
+
+        joint->limits->acceleration = limit.second;
+        model_->addJoint(joint);
+      }
+      return true;
+    }
+    case CommandType::REPLACE_JOINT:
+    {
+      const auto& cmd = static_cast<const ReplaceJointCommand&>(command);
+      model_->addJoint(cmd.getJoint());
+      return true;
+    }
+    case CommandType::ADD_SCENE_GRAPH:
+      return false;
+    default:
+      // Allowed collisions, contact managers, kinematics information, visibility, etc. are not part of the model
+      return true;
+  }
+}
+
+void SceneGraphModelUpdater::removeLinkRecursive(const std::string& link_name)
+{
+  std::vector<std::string> links{ link_name };
+  while (!links.empty())
+  {
+    const std::string link = links.back();
+    links.pop_back();
+
+    std::vector<std::string> joints;
+    for (const auto& joint : model_->getJoints())
+    {
+      if (joint->parent_link_name == link)
+      {
+        joints.push_back(joint->getName());
+        links.push_back(joint->child_link_name);
+      }
+      else if (joint->child_link_name == link)
+      {
+        joints.push_back(joint->getName());
+      }
+    }
+
+    for (const auto& joint : joints)
+      model_->removeJoint(joint);
+
+    model_->removeLink(link);
+  }
+}
+
+}  // namespace tesseract_gui
@@ -0,0 +1,86 @@
+/**
+ * @file shared_environment.cpp
+ * @brief Immutable versioned environment snapshots shared between planning threads and the GUI
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <atomic>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/common/instrumentation.h>
+#include <tesseract_gui/environment/shared_environment.h>
+
+namespace tesseract_gui
+{
+SharedEnvironment::SharedEnvironment() : snapshot_(std::make_shared<const EnvironmentSnapshot>()) {}
+
+EnvironmentSnapshot::ConstPtr SharedEnvironment::getSnapshot() const { return std::atomic_load(&snapshot_); }
+
+EnvironmentSnapshot::ConstPtr SharedEnvironment::publish(const tesseract_environment::Environment& environment)
+{
+  const ScopedTimer timer("environment", "publish");
+  std::scoped_lock lock(publish_mutex_);
+  const EnvironmentSnapshot::ConstPtr previous = std::atomic_load(&snapshot_);
+
+  auto snapshot = std::make_shared<EnvironmentSnapshot>();
+  snapshot->revision = environment.getRevision();
+  if (previous->scene_graph != nullptr && previous->revision == snapshot->revision)
+  {
+    snapshot->scene_graph = previous->scene_graph;
+    snapshot->allowed_collision_matrix = previous->allowed_collision_matrix;
+  }
+  else
+  {
+    // The environment modifies its scene graph and allowed collision matrix in place, so they are copied once per
+    // revision
+    const tesseract_scene_graph::SceneGraph::ConstPtr scene_graph = environment.getSceneGraph();
+    if (scene_graph != nullptr)
+      snapshot->scene_graph = scene_graph->clone();
+
+    const tesseract_scene_graph::AllowedCollisionMatrix::ConstPtr acm = environment.getAllowedCollisionMatrix();
+    snapshot->allowed_collision_matrix = (acm != nullptr) ?
+                                             std::make_shared<tesseract_scene_graph::AllowedCollisionMatrix>(*acm) :
+                                             std::make_shared<tesseract_scene_graph::AllowedCollisionMatrix>();
+  }
+  snapshot->state = environment.getState();
+  snapshot->version = previous->version + 1;
+
+  store(snapshot);
+  return snapshot;
+}
+
+EnvironmentSnapshot::ConstPtr SharedEnvironment::publish(const tesseract_scene_graph::SceneState& state)
+{
+  std::scoped_lock lock(publish_mutex_);
+  const EnvironmentSnapshot::ConstPtr previous = std::atomic_load(&snapshot_);
+
+  auto snapshot = std::make_shared<EnvironmentSnapshot>();
+  snapshot->revision = previous->revision;
+  snapshot->scene_graph = previous->scene_graph;
+  snapshot->allowed_collision_matrix = previous->allowed_collision_matrix;
+  snapshot->state = state;
+  snapshot->version = previous->version + 1;
+
+  store(snapshot);
+  return snapshot;
+}
+
+void SharedEnvironment::store(std::shared_ptr<EnvironmentSnapshot> snapshot)
+{
+  std::atomic_store(&snapshot_, EnvironmentSnapshot::ConstPtr(std::move(snapshot)));
+}
+
+}  // namespace tesseract_gui
@@ -0,0 +1,153 @@
+/**
+ * @file environment_unit.cpp
+ * @brief Tests of the environment component
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_environment/commands/add_link_command.h>
+#include <tesseract_gui/environment/environment_history.h>
+
+using namespace tesseract_gui;
+
+namespace
+{
+/** @brief A command adding a link fixed to the base */
+tesseract_environment::Command::Ptr createAddLinkCommand(int index)
+{
+  tesseract_scene_graph::Link link("link_" + std::to_string(index));
+  tesseract_scene_graph::Joint joint("joint_" + std::to_string(index));
+  joint.type = tesseract_scene_graph::JointType::FIXED;
+  joint.parent_link_name = "base_link";
+  joint.child_link_name = link.getName();
+  return std::make_shared<tesseract_environment::AddLinkCommand>(link, joint);
+}
+
+/** @brief Apply commands adding the links [first, last) one at a time */
+void addLinks(tesseract_environment::Environment& environment, int first, int last)
+{
+  for (int i = first; i < last; ++i)
+    ASSERT_TRUE(environment.applyCommand(createAddLinkCommand(i)));
+}
+
+std::vector<std::string> getSortedLinkNames(const tesseract_environment::Environment& environment)
+{
+  std::vector<std::string> link_names = environment.getLinkNames();
+  std::sort(link_names.begin(), link_names.end());
+  return link_names;
+}
+
+/** @brief Every revision is recreated like a replay of the history from the first command */
+void checkRevisions(const EnvironmentHistory& history, int max_replay_count)
+{
+  const tesseract_environment::Commands& commands = history.getCommands();
+  for (int revision = 1; revision <= history.getRevision(); ++revision)
+  {
+    EXPECT_LE(history.getReplayCount(revision), max_replay_count) << "revision " << revision;
+
+    tesseract_environment::Environment expected;
+    ASSERT_TRUE(expected.init(tesseract_environment::Commands(commands.begin(), commands.begin() + revision)));
+
+    tesseract_environment::Environment::UPtr environment = history.getEnvironment(revision);
+    ASSERT_NE(environment, nullptr);
+    EXPECT_EQ(environment->getRevision(), revision);
+    EXPECT_EQ(getSortedLinkNames(*environment), getSortedLinkNames(expected)) << "revision " << revision;
+  }
+}
+}  // namespace
+
+TEST(TesseractGuiEnvironmentUnit, EnvironmentHistoryReplay)  // NOLINT
+{
+  tesseract_scene_graph::SceneGraph scene_graph("history");
+  scene_graph.addLink(tesseract_scene_graph::Link("base_link"));
+  scene_graph.setRoot("base_link");
+
+  tesseract_environment::Environment environment;
+  ASSERT_TRUE(environment.init(scene_graph));
+  addLinks(environment, 0, 10);
+
+  EnvironmentHistory history(4);
+  history.setEnvironment(environment);
+  const int revision = environment.getRevision();
+  ASSERT_EQ(history.getRevision(), revision);
+
+  // Snapshots every interval revisions and at the current revision
+  std::vector<int> snapshots;
+  for (int snapshot = 4; snapshot < revision; snapshot += 4)
+    snapshots.push_back(snapshot);
+  snapshots.push_back(revision);
+  EXPECT_EQ(history.getSnapshotRevisions(), snapshots);
+  EXPECT_EQ(history.getReplayCount(revision), 0);
+  checkRevisions(history, 3);
+
+  EXPECT_THROW(history.getEnvironment(0), std::runtime_error);             // NOLINT
+  EXPECT_THROW(history.getEnvironment(revision + 1), std::runtime_error);  // NOLINT
+}
+
+TEST(TesseractGuiEnvironmentUnit, EnvironmentHistoryAppend)  // NOLINT
+{
+  tesseract_scene_graph::SceneGraph scene_graph("history");
+  scene_graph.addLink(tesseract_scene_graph::Link("base_link"));
+  scene_graph.setRoot("base_link");
+
+  tesseract_environment::Environment environment;
+  ASSERT_TRUE(environment.init(scene_graph));
+
+  EnvironmentHistory history(4);
+  history.setEnvironment(environment);
+
+  // Commands applied one at a time while monitoring
+  for (int i = 0; i < 6; ++i)
+  {
+    addLinks(environment, i, i + 1);
+    const tesseract_environment::Commands& commands = environment.getCommandHistory();
+    ASSERT_TRUE(history.append({ commands.back() }, environment.getRevision(), environment));
+  }
+  EXPECT_EQ(history.getRevision(), environment.getRevision());
+  checkRevisions(history, 3);
+
+  // Commands which do not continue the history are rejected
+  EXPECT_FALSE(history.append({ createAddLinkCommand(6) }, environment.getRevision() + 2, environment));
+  EXPECT_EQ(history.getRevision(), environment.getRevision());
+
+  // The live environment is already ahead of the appended commands when it is cloned, replays must not start from
+  // that snapshot for the revisions before it. A batch of five commands adds up to five to the replay count.
+  const int revision = environment.getRevision();
+  addLinks(environment, 6, 12);
+  const tesseract_environment::Commands& commands = environment.getCommandHistory();
+  ASSERT_TRUE(
+      history.append({ commands.begin() + revision, commands.begin() + revision + 5 }, revision + 5, environment));
+  EXPECT_EQ(history.getSnapshotRevisions().back(), environment.getRevision());
+  EXPECT_EQ(history.getRevision(), revision + 5);
+  checkRevisions(history, 3 + 5);
+
+  ASSERT_TRUE(history.append({ commands.back() }, environment.getRevision(), environment));
+  EXPECT_EQ(history.getReplayCount(environment.getRevision()), 0);
+  checkRevisions(history, 3 + 5);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
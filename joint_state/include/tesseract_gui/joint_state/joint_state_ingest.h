@@ -0,0 +1,111 @@
+/**
+ * @file joint_state_ingest.h
+ * @brief Coalesces high rate joint states from any thread into at most one update per frame
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_JOINT_STATE_JOINT_STATE_INGEST_H
+#define TESSERACT_GUI_JOINT_STATE_JOINT_STATE_INGEST_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <array>
+#include <atomic>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <QObject>
+#include <QTimer>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_common/joint_state.h>
+#include <tesseract_gui/common/spsc_ring_buffer.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief Ingestion path for joint states published faster than the display refresh rate
+ *
+ * A producer thread (e.g. a controller callback at 1 kHz) calls push(), which moves the state into a lock-free ring
+ * and never blocks. Once per frame the thread owning this object drains the ring, keeps only the latest value of each
+ * joint and emits a single jointStateChanged() containing the joints updated during that frame. Connect it to
+ * JointStateModel::updateJointState() for the table and jointValuesChanged() to SceneStateUpdater::setJointValues()
+ * for the 3D view.
+ *
+ * Only one thread may push at a time, use one ingest per producer when joint states arrive from several threads.
+ * When the ring is full the incoming state is dropped and counted in getDroppedCount().
+ */
+class JointStateIngest : public QObject
+{
+  Q_OBJECT
+
+public:
+  /**
+   * @param capacity The number of joint states buffered between frames
+   * @param parent The parent object
+   */
+  explicit JointStateIngest(std::size_t capacity = 1024, QObject* parent = nullptr);
+
+  /**
+   * @brief Queue a joint state, may be called from any single producer thread
+   * @return False if the ring was full and the state was dropped
+   */
+  bool push(tesseract_common::JointState state);
+
+  /** @brief The number of states dropped because the ring was full */
+  std::size_t getDroppedCount() const;
+
+  /** @brief The number of states waiting for the next frame */
+  std::size_t getQueueDepth() const;
+
+  /** @brief Set the interval between frames, defaults to the primary screen refresh rate */
+  void setFrameInterval(int msec);
+  int getFrameInterval() const;
+
+public Q_SLOTS:
+  /** @brief Drain the ring and emit the coalesced joint states, called automatically once per frame */
+  void flush();
+
+Q_SIGNALS:
+  /**
+   * @brief The latest values of the joints which changed since the previous frame
+   *
+   * Entries are NaN for the values of joints whose producer did not provide them.
+   */
+  void jointStateChanged(const tesseract_common::JointState& state);
+
+  /**
+   * @brief The latest positions of the joints which changed since the previous frame
+   *
+   * Joints whose position has not been received yet are left out, not emitted if none is left.
+   */
+  void jointValuesChanged(const std::unordered_map<std::string, double>& joint_values);
+
+private:
+  SPSCRingBuffer<tesseract_common::JointState> ring_;
+  std::atomic<std::size_t> dropped_count_{ 0 };
+  QTimer frame_timer_;
+
+  /** @brief The latest known state per joint, indexed through joint_index_ */
+  std::unordered_map<std::string, std::size_t> joint_index_;
+  std::vector<std::string> joint_names_;
+  std::vector<std::array<double, 4>> values_;
+  std::vector<std::size_t> dirty_;
+  std::vector<bool> is_dirty_;
+  double time_{ 0 };
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_JOINT_STATE_JOINT_STATE_INGEST_H
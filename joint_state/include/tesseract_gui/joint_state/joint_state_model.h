@@ -0,0 +1,86 @@
+/**
+ * @file joint_state_model.h
+ * @brief A table model of joint positions, velocities, accelerations and efforts
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_JOINT_STATE_JOINT_STATE_MODEL_H
+#define TESSERACT_GUI_JOINT_STATE_JOINT_STATE_MODEL_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <QAbstractTableModel>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_common/joint_state.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief One row per joint with its position, velocity, acceleration and effort
+ *
+ * Values which were never provided are NaN and shown as empty cells.
+ */
+class JointStateModel : public QAbstractTableModel
+{
+  Q_OBJECT
+
+public:
+  enum Column
+  {
+    NAME_COLUMN = 0,
+    POSITION_COLUMN,
+    VELOCITY_COLUMN,
+    ACCELERATION_COLUMN,
+    EFFORT_COLUMN,
+    COLUMN_COUNT
+  };
+
+  explicit JointStateModel(QObject* parent = nullptr);
+
+  /** @brief Reset the model to the provided joints with unknown values */
+  void setJointNames(const std::vector<std::string>& joint_names);
+  const std::vector<std::string>& getJointNames() const;
+
+  void clear();
+
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+  int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+  QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+public Q_SLOTS:
+  /**
+   * @brief Update the rows of the joints in the state
+   *
+   * Joints which are not in the model yet are appended. Empty velocity, acceleration or effort vectors leave the
+   * current values untouched. A single dataChanged is emitted covering all updated rows.
+   */
+  void updateJointState(const tesseract_common::JointState& state);
+
+private:
+  std::vector<std::string> joint_names_;
+  std::unordered_map<std::string, int> joint_index_;
+
+  /** @brief Position, velocity, acceleration and effort per row */
+  std::vector<std::array<double, 4>> values_;
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_JOINT_STATE_JOINT_STATE_MODEL_H
@@ -0,0 +1,140 @@
+/**
+ * @file joint_state_ingest.cpp
+ * @brief Coalesces high rate joint states from any thread into at most one update per frame
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/common/frame_interval.h>
+#include <tesseract_gui/common/instrumentation.h>
+#include <tesseract_gui/joint_state/joint_state_ingest.h>
+
+namespace tesseract_gui
+{
+JointStateIngest::JointStateIngest(std::size_t capacity, QObject* parent) : QObject(parent), ring_(capacity)
+{
+  frame_timer_.setTimerType(Qt::PreciseTimer);
+  connect(&frame_timer_, &QTimer::timeout, this, &JointStateIngest::flush);
+  frame_timer_.start(getDefaultFrameInterval());
+}
+
+bool JointStateIngest::push(tesseract_common::JointState state)
+{
+  if (ring_.push(std::move(state)))
+    return true;
+
+  dropped_count_.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+std::size_t JointStateIngest::getDroppedCount() const { return dropped_count_.load(std::memory_order_relaxed); }
+
+std::size_t JointStateIngest::getQueueDepth() const { return ring_.size(); }
+
+void JointStateIngest::setFrameInterval(int msec) { frame_timer_.start(msec); }
+
+int JointStateIngest::getFrameInterval() const { return frame_timer_.interval(); }
+
+void JointStateIngest::flush()
+{
+  static const std::array<double, 4> unknown_values{ std::numeric_limits<double>::quiet_NaN(),
+                                                     std::numeric_limits<double>::quiet_NaN(),
+                                                     std::numeric_limits<double>::quiet_NaN(),
+                                                     std::numeric_limits<double>::quiet_NaN() };
+
+  const ScopedTimer timer("joint_state", "flush");
+  recordCounter("joint_state", "queue depth", static_cast<std::int64_t>(ring_.size()));
+  recordCounter("joint_state", "dropped", static_cast<std::int64_t>(getDroppedCount()));
+
+  // Bound the work per frame to what was buffered between two frames so a producer can not starve the event loop
+  tesseract_common::JointState state;
+  for (std::size_t i = ring_.capacity(); i > 0 && ring_.pop(state); --i)
+  {
+    const auto n = static_cast<Eigen::Index>(state.joint_names.size());
+    const std::array<const Eigen::VectorXd*, 4> sources{ &state.position,
+                                                         &state.velocity,
+                                                         &state.acceleration,
+                                                         &state.effort };
+    for (Eigen::Index j = 0; j < n; ++j)
+    {
+      const std::string& name = state.joint_names[static_cast<std::size_t>(j)];
+      auto it = joint_index_.find(name);
+      if (it == joint_index_.end())
+      {
+        it = joint_index_.emplace(name, joint_names_.size()).first;
+        joint_names_.push_back(name);
+        values_.push_back(unknown_values);
+        is_dirty_.push_back(false);
+      }
+
+      const std::size_t idx = it->second;
+      for (std::size_t c = 0; c < sources.size(); ++c)
+      {
+        if (sources[c]->size() == n)
+          values_[idx][c] = (*sources[c])(j);
+      }
+
+      if (!is_dirty_[idx])
+      {
+        is_dirty_[idx] = true;
+        dirty_.push_back(idx);
+      }
+    }
+    time_ = state.time;
+  }
+
+  if (dirty_.empty())
+    return;
+
+  const auto n = static_cast<Eigen::Index>(dirty_.size());
+  tesseract_common::JointState changed;
+  changed.joint_names.reserve(dirty_.size());
+  changed.position.resize(n);
+  changed.velocity.resize(n);
+  changed.acceleration.resize(n);
+  changed.effort.resize(n);
+  changed.time = time_;
+
+  std::unordered_map<std::string, double> joint_values;
+  joint_values.reserve(dirty_.size());
+  for (Eigen::Index i = 0; i < n; ++i)
+  {
+    const std::size_t idx = dirty_[static_cast<std::size_t>(i)];
+    const auto& values = values_[idx];
+    changed.joint_names.push_back(joint_names_[idx]);
+    changed.position(i) = values[0];
+    changed.velocity(i) = values[1];
+    changed.acceleration(i) = values[2];
+    changed.effort(i) = values[3];
+    is_dirty_[idx] = false;
+
+    // The state solver would turn an unknown position into NaN link transforms
+    if (!std::isnan(values[0]))
+      joint_values[joint_names_[idx]] = values[0];
+  }
+  dirty_.clear();
+
+  emit jointStateChanged(changed);
+  if (!joint_values.empty())
+    emit jointValuesChanged(joint_values);
+}
+
+}  // namespace tesseract_gui
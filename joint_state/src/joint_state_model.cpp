@@ -0,0 +1,150 @@
+/**
+ * @file joint_state_model.cpp
+ * @brief A table model of joint positions, velocities, accelerations and efforts
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <cmath>
+#include <limits>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/common/instrumentation.h>
+#include <tesseract_gui/joint_state/joint_state_model.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+const std::array<double, 4> UNKNOWN_VALUES{ std::numeric_limits<double>::quiet_NaN(),
+                                            std::numeric_limits<double>::quiet_NaN(),
+                                            std::numeric_limits<double>::quiet_NaN(),
+                                            std::numeric_limits<double>::quiet_NaN() };
+}
+
+JointStateModel::JointStateModel(QObject* parent) : QAbstractTableModel(parent) {}
+
+void JointStateModel::setJointNames(const std::vector<std::string>& joint_names)
+{
+  beginResetModel();
+  joint_names_ = joint_names;
+  joint_index_.clear();
+  for (std::size_t i = 0; i < joint_names_.size(); ++i)
+    joint_index_[joint_names_[i]] = static_cast<int>(i);
+  values_.assign(joint_names_.size(), UNKNOWN_VALUES);
+  endResetModel();
+}
+
+const std::vector<std::string>& JointStateModel::getJointNames() const { return joint_names_; }
+
+void JointStateModel::clear() { setJointNames({}); }
+
+int JointStateModel::rowCount(const QModelIndex& parent) const
+{
+  if (parent.isValid())
+    return 0;
+
+  return static_cast<int>(joint_names_.size());
+}
+
+int JointStateModel::columnCount(const QModelIndex& parent) const
+{
+  if (parent.isValid())
+    return 0;
+
+  return COLUMN_COUNT;
+}
+
+QVariant JointStateModel::data(const QModelIndex& index, int role) const
+{
+  if (!index.isValid() || (role != Qt::DisplayRole && role != Qt::EditRole))
+    return {};
+
+  const auto row = static_cast<std::size_t>(index.row());
+  if (index.column() == NAME_COLUMN)
+    return QString::fromStdString(joint_names_[row]);
+
+  const double value = values_[row][static_cast<std::size_t>(index.column() - POSITION_COLUMN)];
+  if (std::isnan(value))
+    return {};
+
+  return value;
+}
+
+QVariant JointStateModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+  if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+    return {};
+
+  switch (section)
+  {
+    case NAME_COLUMN:
+      return "Name";
+    case POSITION_COLUMN:
+      return "Position";
+    case VELOCITY_COLUMN:
+      return "Velocity";
+    case ACCELERATION_COLUMN:
+      return "Acceleration";
+    case EFFORT_COLUMN:
+      return "Effort";
+    default:
+      return {};
+  }
+}
+
+void JointStateModel::updateJointState(const tesseract_common::JointState& state)
+{
+  const ScopedTimer timer("joint_state", "update model");
+  const auto n = static_cast<Eigen::Index>(state.joint_names.size());
+  const std::array<const Eigen::VectorXd*, 4> sources{ &state.position,
+                                                       &state.velocity,
+                                                       &state.acceleration,
+                                                       &state.effort };
+
+  int first_row = std::numeric_limits<int>::max();
+  int last_row = -1;
+  for (Eigen::Index i = 0; i < n; ++i)
+  {
+    const std::string& name = state.joint_names[static_cast<std::size_t>(i)];
+    auto it = joint_index_.find(name);
+    if (it == joint_index_.end())
+    {
+      const auto row = static_cast<int>(joint_names_.size());
+      beginInsertRows(QModelIndex(), row, row);
+      joint_names_.push_back(name);
+      values_.push_back(UNKNOWN_VALUES);
+      it = joint_index_.emplace(name, row).first;
+      endInsertRows();
+    }
+
+    const int row = it->second;
+    auto& values = values_[static_cast<std::size_t>(row)];
+    for (std::size_t c = 0; c < sources.size(); ++c)
+    {
+      if (sources[c]->size() == n)
+        values[c] = (*sources[c])(i);
+    }
+
+    first_row = std::min(first_row, row);
+    last_row = std::max(last_row, row);
+  }
+
+  if (last_row >= 0)
+    emit dataChanged(index(first_row, POSITION_COLUMN), index(last_row, EFFORT_COLUMN));
+}
+
+}  // namespace tesseract_gui
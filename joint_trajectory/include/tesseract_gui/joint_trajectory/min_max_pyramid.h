@@ -0,0 +1,76 @@
+/**
+ * @file min_max_pyramid.h
+ * @brief Minimum and maximum of any sample range of a signal from a pyramid of power of two blocks
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_JOINT_TRAJECTORY_MIN_MAX_PYRAMID_H
+#define TESSERACT_GUI_JOINT_TRAJECTORY_MIN_MAX_PYRAMID_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cstddef>
+#include <utility>
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+namespace tesseract_gui
+{
+/**
+ * @brief A min/max mipmap of a sampled signal, answering the range of any run of samples without reading them
+ *
+ * Level k stores the minimum and maximum of every aligned block of 2^k samples, level 0 being the samples themselves.
+ * A query splits the run into at most two blocks per level like a segment tree, so it reads O(log(run length)) values
+ * however long the signal is, and a plot reads O(width) values per frame at any zoom. The minima and the maxima of the
+ * levels above the samples each take about as much memory as the samples, about twice the samples together.
+ *
+ * NaN samples (missing values) are ignored, the range of a run of only NaN samples is NaN.
+ */
+class MinMaxPyramid
+{
+public:
+  MinMaxPyramid() = default;
+
+  /** @brief Build all levels of a signal */
+  explicit MinMaxPyramid(std::vector<float> samples);
+
+  std::size_t size() const;
+  bool empty() const;
+
+  /** @brief The samples */
+  const std::vector<float>& getSamples() const;
+
+  /**
+   * @brief The minimum and maximum of the samples [begin, end)
+   * @return NaN if the run is empty or only contains NaN
+   */
+  std::pair<float, float> getRange(std::size_t begin, std::size_t end) const;
+
+  /** @brief The minimum and maximum of all samples */
+  std::pair<float, float> getRange() const;
+
+  /** @brief The memory used in bytes */
+  std::size_t getByteSize() const;
+
+private:
+  std::vector<float> samples_;
+
+  /** @brief The blocks of levels 1 and up, level k is mins_[k - 1] */
+  std::vector<std::vector<float>> mins_;
+  std::vector<std::vector<float>> maxs_;
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_JOINT_TRAJECTORY_MIN_MAX_PYRAMID_H
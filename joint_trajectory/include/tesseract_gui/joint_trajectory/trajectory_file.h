@@ -0,0 +1,135 @@
+/**
+ * @file trajectory_file.h
+ * @brief A memory mapped, columnar binary trajectory file
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_JOINT_TRAJECTORY_TRAJECTORY_FILE_H
+#define TESSERACT_GUI_JOINT_TRAJECTORY_TRAJECTORY_FILE_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <QFile>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_common/joint_state.h>
+#include <tesseract_gui/joint_trajectory/trajectory_plot_data.h>
+#include <tesseract_gui/joint_trajectory/trajectory_timeline.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief A trajectory stored as columns of a binary file which is memory mapped instead of read
+ *
+ * A fixed size header holds the version, the counts and the offset of every column, followed by the joint and link
+ * names and the columns, each aligned to 64 bytes:
+ * - the time of every waypoint as double, relative to the first with the timing of TrajectoryTimeline
+ * - per available TrajectoryChannel the float values ordered by joint then waypoint, NaN where a waypoint has none
+ * - optionally the link transforms of a TrajectoryTimeline, one float column per component (position xyz then
+ *   quaternion xyzw) ordered by waypoint then link
+ *
+ * Opening a file only reads the header and the names, every value is found from the offsets in O(1) and the
+ * operating system pages the columns in when they are first read. Seeking a TrajectoryTimeline of a file touches
+ * the pages of two waypoints, plotting a joint reads its columns only. Files use the byte order of the machine.
+ */
+class TrajectoryFile
+{
+public:
+  using Ptr = std::shared_ptr<TrajectoryFile>;
+  using ConstPtr = std::shared_ptr<const TrajectoryFile>;
+
+  /** @brief The version written by write(), files of other versions are rejected */
+  static constexpr std::uint32_t VERSION = 1;
+
+  /**
+   * @brief Map a trajectory file
+   * @throws std::runtime_error if the file can not be mapped or is not a valid trajectory file
+   */
+  explicit TrajectoryFile(const std::string& path);
+  ~TrajectoryFile() = default;
+  TrajectoryFile(const TrajectoryFile&) = delete;
+  TrajectoryFile& operator=(const TrajectoryFile&) = delete;
+  TrajectoryFile(TrajectoryFile&&) = delete;
+  TrajectoryFile& operator=(TrajectoryFile&&) = delete;
+
+  /**
+   * @brief Write a trajectory
+   * @param path The file
+   * @param trajectory The trajectory, the joints of the first waypoint are stored
+   * @param timeline Optional link transforms of the trajectory stored with it, e.g. for the links of a scene
+   * @throws std::runtime_error if the trajectory is empty, the timeline has a different number of waypoints or the
+   * file can not be written
+   */
+  static void write(const std::string& path,
+                    const tesseract_common::JointTrajectory& trajectory,
+                    const TrajectoryTimeline* timeline = nullptr);
+
+  const std::string& getPath() const;
+  std::size_t getWaypointCount() const;
+  const std::vector<std::string>& getJointNames() const;
+
+  /** @brief The absolute time of the first waypoint */
+  double getStartTime() const;
+
+  /** @brief The time of every waypoint relative to the first one */
+  const double* getTimes() const;
+  double getDuration() const;
+
+  bool hasChannel(TrajectoryChannel channel) const;
+
+  /** @brief The values of a channel ordered by joint then waypoint, nullptr if the channel is not available */
+  const float* getChannel(TrajectoryChannel channel) const;
+
+  /** @brief A value of an available channel, NaN if the waypoint does not contain the joint */
+  float getValue(TrajectoryChannel channel, std::size_t joint, std::size_t waypoint) const;
+
+  bool hasLinkTransforms() const;
+
+  /** @brief The links of the stored link transforms, empty without link transforms */
+  const std::vector<std::string>& getLinkNames() const;
+
+  /**
+   * @brief A component of the stored link transforms
+   * @param component The component, position xyz then quaternion xyzw
+   * @return getWaypointCount() * getLinkNames().size() floats ordered by waypoint then link
+   */
+  const float* getLinkTransforms(std::size_t component) const;
+
+  /** @brief The size of the file in bytes, of which only the pages read are in memory */
+  std::size_t getFileSize() const;
+
+private:
+  std::string path_;
+  QFile file_;
+  const uchar* data_{ nullptr };
+  std::size_t file_size_{ 0 };
+
+  std::size_t waypoint_count_{ 0 };
+  double start_time_{ 0 };
+  std::vector<std::string> joint_names_;
+  std::vector<std::string> link_names_;
+  const double* times_{ nullptr };
+  std::array<const float*, TrajectoryPlotData::CHANNEL_COUNT> channels_{};
+  std::array<const float*, TrajectoryTimeline::TRANSFORM_SIZE> link_transforms_{};
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_JOINT_TRAJECTORY_TRAJECTORY_FILE_H
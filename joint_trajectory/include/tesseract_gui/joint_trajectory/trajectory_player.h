@@ -0,0 +1,145 @@
+/**
+ * @file trajectory_player.h
+ * @brief Plays a trajectory timeline into a render scene
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_JOINT_TRAJECTORY_TRAJECTORY_PLAYER_H
+#define TESSERACT_GUI_JOINT_TRAJECTORY_TRAJECTORY_PLAYER_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <vector>
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/joint_trajectory/trajectory_file.h>
+#include <tesseract_gui/joint_trajectory/trajectory_timeline.h>
+#include <tesseract_gui/render/render_scene.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief Plays a TrajectoryTimeline in real time by writing interpolated link transforms into a RenderScene
+ *
+ * Every frame and every seek costs one interpolation of the timeline and one RenderScene::setLinkTransforms(), no
+ * kinematics are evaluated. The timeline must have been created with the link names of the scene (see
+ * loadTrajectory()). Connect timeChanged() to the update() of the widget displaying the scene.
+ *
+ * Timelines which are still growing (see TrajectoryStream) are supported, call updateTimeline() after waypoints were
+ * appended. While paused at the end the player follows the newest waypoint.
+ */
+class TrajectoryPlayer : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit TrajectoryPlayer(QObject* parent = nullptr);
+
+  /** @brief The scene receiving the link transforms, may be nullptr */
+  void setScene(RenderScene::Ptr scene);
+  RenderScene::Ptr getScene() const;
+
+  /**
+   * @brief Set the timeline to play, playback pauses and the time is reset to zero
+   * @throws std::runtime_error if the timeline links do not match the links of the scene
+   */
+  void setTimeline(TrajectoryTimeline::ConstPtr timeline);
+  TrajectoryTimeline::ConstPtr getTimeline() const;
+
+  /** @brief Create a timeline for the links of the scene and set it */
+  void loadTrajectory(const tesseract_environment::Environment& environment,
+                      const tesseract_common::JointTrajectory& trajectory);
+
+  /**
+   * @brief Play a trajectory file, its link transforms are played from the mapped file if they were stored for the
+   * links of the scene, otherwise they are computed once from its joint positions
+   */
+  void loadTrajectory(const tesseract_environment::Environment& environment, TrajectoryFile::ConstPtr file);
+
+  double getTime() const;
+  double getDuration() const;
+  bool isPlaying() const;
+
+  /** @brief Playback speed relative to real time */
+  void setPlaybackSpeed(double speed);
+  double getPlaybackSpeed() const;
+
+  /** @brief Restart from the beginning when the end is reached instead of stopping */
+  void setLoop(bool loop);
+  bool getLoop() const;
+
+  /** @brief Jump to the newest waypoint when the timeline grows while paused at its end */
+  void setFollowLatest(bool follow);
+  bool getFollowLatest() const;
+
+  /** @brief Set the interval between frames during playback */
+  void setFrameInterval(int msec);
+  int getFrameInterval() const;
+
+public Q_SLOTS:
+  void play();
+  void pause();
+
+  /** @brief Pause and seek to the beginning */
+  void stop();
+
+  /** @brief Seek to a time in seconds, clamped to the duration */
+  void seek(double time);
+
+  /** @brief Waypoints were appended to the timeline */
+  void updateTimeline();
+
+Q_SIGNALS:
+  /** @brief The time changed and the link transforms of the scene were updated */
+  void timeChanged(double time);
+
+  void playingChanged(bool playing);
+
+  /** @brief The timeline was replaced */
+  void timelineChanged();
+
+  /** @brief The duration of the timeline changed because waypoints were appended */
+  void durationChanged(double duration);
+
+  /** @brief Playback reached the end without looping */
+  void finished();
+
+private:
+  RenderScene::Ptr scene_;
+  TrajectoryTimeline::ConstPtr timeline_;
+  std::vector<float> link_transforms_;
+  double time_{ 0 };
+  double speed_{ 1 };
+  bool loop_{ false };
+  bool follow_latest_{ true };
+
+  /** @brief The duration at the last updateTimeline(), used to detect if the player was at the end */
+  double known_duration_{ 0 };
+
+  QTimer frame_timer_;
+
+  /** @brief Measures real time since playback started at play_start_time_ */
+  QElapsedTimer clock_;
+  double play_start_time_{ 0 };
+
+  void onFrame();
+  void applyTime(double time);
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_JOINT_TRAJECTORY_TRAJECTORY_PLAYER_H
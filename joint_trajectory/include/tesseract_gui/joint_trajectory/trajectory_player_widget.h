@@ -0,0 +1,72 @@
+/**
+ * @file trajectory_player_widget.h
+ * @brief Playback controls for a trajectory player
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_JOINT_TRAJECTORY_TRAJECTORY_PLAYER_WIDGET_H
+#define TESSERACT_GUI_JOINT_TRAJECTORY_TRAJECTORY_PLAYER_WIDGET_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <QWidget>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+class QCheckBox;
+class QDoubleSpinBox;
+class QLabel;
+class QSlider;
+class QToolButton;
+
+namespace tesseract_gui
+{
+class TrajectoryPlayer;
+
+/**
+ * @brief Play, pause and stop buttons, a time slider, playback speed and loop controls for a TrajectoryPlayer
+ *
+ * Dragging the slider seeks the player directly, which only interpolates the precomputed timeline. The memory used
+ * by the loaded timeline is shown next to the controls.
+ */
+class TrajectoryPlayerWidget : public QWidget
+{
+  Q_OBJECT
+
+public:
+  /** @brief The number of slider steps over the duration of the trajectory */
+  static constexpr int SLIDER_STEPS = 10000;
+
+  explicit TrajectoryPlayerWidget(TrajectoryPlayer* player, QWidget* parent = nullptr);
+
+  TrajectoryPlayer* getPlayer() const;
+
+private:
+  TrajectoryPlayer* player_;
+  QToolButton* play_button_;
+  QToolButton* stop_button_;
+  QSlider* slider_;
+  QLabel* time_label_;
+  QDoubleSpinBox* speed_spin_box_;
+  QCheckBox* loop_check_box_;
+  QLabel* memory_label_;
+
+  void onTimeChanged(double time);
+  void onTimelineChanged();
+  void onPlayingChanged(bool playing);
+  void onSliderValueChanged(int value);
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_JOINT_TRAJECTORY_TRAJECTORY_PLAYER_WIDGET_H
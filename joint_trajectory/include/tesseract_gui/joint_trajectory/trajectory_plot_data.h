@@ -0,0 +1,111 @@
+/**
+ * @file trajectory_plot_data.h
+ * @brief The joint channels of a trajectory prepared for plotting at any zoom
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_JOINT_TRAJECTORY_TRAJECTORY_PLOT_DATA_H
+#define TESSERACT_GUI_JOINT_TRAJECTORY_TRAJECTORY_PLOT_DATA_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <array>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_common/joint_state.h>
+#include <tesseract_gui/joint_trajectory/min_max_pyramid.h>
+
+namespace tesseract_gui
+{
+class TrajectoryFile;
+
+enum class TrajectoryChannel
+{
+  POSITION = 0,
+  VELOCITY = 1,
+  ACCELERATION = 2,
+  EFFORT = 3
+};
+
+/**
+ * @brief The position, velocity, acceleration and effort of every joint of a trajectory as MinMaxPyramid
+ *
+ * Times follow TrajectoryTiming like those of TrajectoryTimeline, so plot times match the time of a TrajectoryPlayer.
+ * Values missing from a waypoint are NaN, a channel missing from all waypoints is not available.
+ */
+class TrajectoryPlotData
+{
+public:
+  using Ptr = std::shared_ptr<TrajectoryPlotData>;
+  using ConstPtr = std::shared_ptr<const TrajectoryPlotData>;
+
+  static constexpr std::size_t CHANNEL_COUNT = 4;
+
+  /** @brief The values of every joint of a channel, empty if the channel is not available */
+  using ChannelSamples = std::vector<std::vector<float>>;
+
+  /** @brief The joints of the first waypoint are plotted */
+  explicit TrajectoryPlotData(const tesseract_common::JointTrajectory& trajectory);
+
+  /** @brief The channels of a trajectory file, its columns are copied without creating waypoints */
+  explicit TrajectoryPlotData(const TrajectoryFile& file);
+
+  /**
+   * @brief Plot samples from another source
+   * @param joint_names The joints
+   * @param times The time of every sample relative to the first, not decreasing
+   * @param channels Indexed by TrajectoryChannel, one vector of values per joint or none
+   */
+  TrajectoryPlotData(std::vector<std::string> joint_names,
+                     std::vector<double> times,
+                     std::array<ChannelSamples, CHANNEL_COUNT> channels);
+
+  const std::vector<std::string>& getJointNames() const;
+  std::size_t getSampleCount() const;
+  const std::vector<double>& getTimes() const;
+  double getDuration() const;
+
+  /** @brief The index of the first sample at or after a time */
+  std::size_t findSample(double time) const;
+
+  bool hasChannel(TrajectoryChannel channel) const;
+
+  /** @brief The values of a joint, the channel must be available */
+  const MinMaxPyramid& getPyramid(TrajectoryChannel channel, std::size_t joint) const;
+
+  /** @brief The minimum and maximum of all joints of a channel, NaN if it is not available */
+  std::pair<float, float> getRange(TrajectoryChannel channel) const;
+
+  /** @brief The memory used in bytes */
+  std::size_t getByteSize() const;
+
+  /** @brief The name of a channel, e.g. for axis labels */
+  static const char* getChannelName(TrajectoryChannel channel);
+
+private:
+  std::vector<std::string> joint_names_;
+  std::vector<double> times_;
+  std::array<std::vector<MinMaxPyramid>, CHANNEL_COUNT> pyramids_;
+  std::array<std::pair<float, float>, CHANNEL_COUNT> ranges_;
+
+  void build(std::array<ChannelSamples, CHANNEL_COUNT> channels);
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_JOINT_TRAJECTORY_TRAJECTORY_PLOT_DATA_H
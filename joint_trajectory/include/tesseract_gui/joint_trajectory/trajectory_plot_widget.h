@@ -0,0 +1,122 @@
+/**
+ * @file trajectory_plot_widget.h
+ * @brief Plots the joint channels of long trajectories with a cursor linked to a trajectory player
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_JOINT_TRAJECTORY_TRAJECTORY_PLOT_WIDGET_H
+#define TESSERACT_GUI_JOINT_TRAJECTORY_TRAJECTORY_PLOT_WIDGET_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <array>
+#include <vector>
+#include <QPoint>
+#include <QWidget>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/joint_trajectory/trajectory_plot_data.h>
+
+class QPainter;
+
+namespace tesseract_gui
+{
+class TrajectoryPlayer;
+
+/**
+ * @brief Plots every joint of the available channels of TrajectoryPlotData in stacked lanes over a shared time axis
+ *
+ * Drawing never visits the samples of the view: every pixel column draws the minimum to maximum of the samples it
+ * covers from the MinMaxPyramid of a joint, the samples are only drawn as lines once fewer of them are visible than
+ * the plot has pixels. Panning and zooming only change the view, so both take the same time for a thousand or
+ * millions of samples.
+ *
+ * Drag to pan, use the wheel to zoom around the mouse and double click to show the whole trajectory. A click moves
+ * the cursor and emits timeSelected(), which seeks the linked player.
+ */
+class TrajectoryPlotWidget : public QWidget
+{
+  Q_OBJECT
+
+public:
+  explicit TrajectoryPlotWidget(QWidget* parent = nullptr);
+
+  /** @brief The data to plot, the view is reset to the whole trajectory */
+  void setData(TrajectoryPlotData::ConstPtr data);
+  TrajectoryPlotData::ConstPtr getData() const;
+
+  /**
+   * @brief Link the cursor to a player, its time moves the cursor and clicks seek it
+   * @param player The player, nullptr to unlink, must outlive the widget or be unlinked
+   */
+  void setPlayer(TrajectoryPlayer* player);
+  TrajectoryPlayer* getPlayer() const;
+
+  /** @brief Show or hide the lane of a channel, channels the data does not have are never shown */
+  void setChannelVisible(TrajectoryChannel channel, bool visible);
+  bool isChannelVisible(TrajectoryChannel channel) const;
+
+  /** @brief Show a time range, clamped to the duration of the data */
+  void setView(double start, double end);
+  double getViewStart() const;
+  double getViewEnd() const;
+
+  double getCursorTime() const;
+
+  QSize sizeHint() const override;
+
+public Q_SLOTS:
+  void setCursorTime(double time);
+
+  /** @brief Show the whole trajectory */
+  void resetView();
+
+Q_SIGNALS:
+  /** @brief A time was clicked */
+  void timeSelected(double time);
+
+  void viewChanged(double start, double end);
+
+protected:
+  void paintEvent(QPaintEvent* event) override;
+  void mousePressEvent(QMouseEvent* event) override;
+  void mouseMoveEvent(QMouseEvent* event) override;
+  void mouseReleaseEvent(QMouseEvent* event) override;
+  void mouseDoubleClickEvent(QMouseEvent* event) override;
+  void wheelEvent(QWheelEvent* event) override;
+
+private:
+  TrajectoryPlotData::ConstPtr data_;
+  TrajectoryPlayer* player_{ nullptr };
+  std::array<bool, TrajectoryPlotData::CHANNEL_COUNT> channel_visible_{ true, true, true, true };
+  double view_start_{ 0 };
+  double view_end_{ 1 };
+  double cursor_time_{ 0 };
+
+  QPoint last_mouse_position_;
+  QPoint press_position_;
+  bool dragging_{ false };
+
+  /** @brief The first sample of every pixel column and the end of the last, rebuilt every paint */
+  std::vector<std::size_t> column_samples_;
+
+  QRect getPlotRect() const;
+  double toTime(double x) const;
+  double toX(double time) const;
+  void drawLane(QPainter& painter, const QRect& lane, TrajectoryChannel channel);
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_JOINT_TRAJECTORY_TRAJECTORY_PLOT_WIDGET_H
@@ -0,0 +1,131 @@
+/**
+ * @file trajectory_stream.h
+ * @brief Builds a trajectory timeline from waypoints arriving incrementally
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_JOINT_TRAJECTORY_TRAJECTORY_STREAM_H
+#define TESSERACT_GUI_JOINT_TRAJECTORY_TRAJECTORY_STREAM_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <QObject>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/joint_trajectory/trajectory_timeline.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief Extends a TrajectoryTimeline with waypoints pushed from any thread, e.g. a planner progress callback
+ *
+ * Pushed waypoints are queued and their forward kinematics computed on a worker thread with a clone of the state
+ * solver. Completed batches are appended to the timeline in the thread of this object, which only copies the new link
+ * transforms into the timeline, the waypoints already stored are never copied or moved. Each batch is announced with
+ * waypointsAppended(), connect it to TrajectoryPlayer::updateTimeline() to show partial results while the planner
+ * is still running.
+ *
+ * If the kinematics of a waypoint fail, e.g. because of an unknown joint, the waypoints before it are appended, the
+ * stream stops and streamFailed() is emitted. Waypoints pushed after that are ignored until the next start().
+ */
+class TrajectoryStream : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit TrajectoryStream(QObject* parent = nullptr);
+
+  /** @brief Stops the worker, waypoints not yet appended are discarded */
+  ~TrajectoryStream() override;
+  TrajectoryStream(const TrajectoryStream&) = delete;
+  TrajectoryStream& operator=(const TrajectoryStream&) = delete;
+  TrajectoryStream(TrajectoryStream&&) = delete;
+  TrajectoryStream& operator=(TrajectoryStream&&) = delete;
+
+  /**
+   * @brief Start a new stream, waypoints of the previous stream not yet appended are discarded
+   * @param environment The environment providing the kinematics, its state solver is cloned
+   * @param link_names The links stored in the timeline, usually RenderScene::getLinkNames()
+   * @return The timeline receiving the waypoints, initially empty
+   */
+  TrajectoryTimeline::ConstPtr start(const tesseract_environment::Environment& environment,
+                                     std::vector<std::string> link_names);
+
+  /** @brief The timeline of the current stream, nullptr before start() */
+  TrajectoryTimeline::ConstPtr getTimeline() const;
+
+  /**
+   * @brief Queue a waypoint, may be called from any thread
+   * @throws std::runtime_error if the waypoint does not have a position for every joint name
+   */
+  void push(tesseract_common::JointState waypoint);
+
+  /**
+   * @brief Queue all waypoints of a (partial) trajectory, may be called from any thread
+   * @throws std::runtime_error if a waypoint does not have a position for every joint name, nothing is queued then
+   */
+  void push(const tesseract_common::JointTrajectory& waypoints);
+
+  /** @brief Mark the stream complete, finished() is emitted once all queued waypoints were appended */
+  void finish();
+
+  /** @brief The number of waypoints queued but not yet appended */
+  std::size_t getPendingCount() const;
+
+Q_SIGNALS:
+  /**
+   * @brief Waypoints were appended to the timeline
+   * @param waypoint_count The total number of waypoints of the timeline
+   */
+  void waypointsAppended(std::size_t waypoint_count);
+
+  /** @brief All waypoints of a finished stream were appended */
+  void finished();
+
+  /** @brief The kinematics of a waypoint failed and the stream stopped */
+  void streamFailed(const QString& message);
+
+private:
+  struct Batch;
+
+  TrajectoryTimeline::Ptr timeline_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable condition_;
+  std::vector<tesseract_common::JointState> queue_;
+  std::size_t pending_count_{ 0 };
+  bool finish_requested_{ false };
+  bool stopping_{ false };
+
+  /** @brief Set by the worker when the kinematics of a waypoint failed, pushes are ignored */
+  bool failed_{ false };
+
+  /** @brief Incremented by start(), batches of previous streams are dropped */
+  std::size_t generation_{ 0 };
+
+  std::thread worker_;
+
+  void stop();
+  void run(tesseract_scene_graph::StateSolver::UPtr solver, std::size_t generation);
+  void appendBatch(const std::shared_ptr<Batch>& batch);
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_JOINT_TRAJECTORY_TRAJECTORY_STREAM_H
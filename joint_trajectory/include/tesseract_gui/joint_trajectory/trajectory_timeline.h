@@ -0,0 +1,215 @@
+/**
+ * @file trajectory_timeline.h
+ * @brief Precomputed link transforms of every waypoint of a joint trajectory
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_JOINT_TRAJECTORY_TRAJECTORY_TIMELINE_H
+#define TESSERACT_GUI_JOINT_TRAJECTORY_TRAJECTORY_TIMELINE_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <array>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <Eigen/Core>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_common/joint_state.h>
+#include <tesseract_environment/environment.h>
+#include <tesseract_gui/joint_trajectory/trajectory_timing.h>
+
+namespace tesseract_gui
+{
+class TrajectoryFile;
+
+/**
+ * @brief The link transforms of every waypoint of a trajectory, stored as float32 structure of arrays
+ *
+ * Forward kinematics runs once per waypoint when waypoints are added (in parallel for complete trajectories, each
+ * thread using its own state solver), after that seeking only interpolates between the two surrounding waypoints:
+ * positions linearly, rotations by normalized quaternion interpolation. A link transform takes seven floats (position
+ * and quaternion), each component is stored in its own array ordered by waypoint then link, so a seek reads two
+ * contiguous runs per component. Joint positions are stored per joint for plotting.
+ *
+ * Waypoints are stored in chunks of CHUNK_SIZE which are allocated once and never moved, so append() extends a
+ * timeline without copying the waypoints already stored (see TrajectoryStream). A timeline of a TrajectoryFile with
+ * link transforms stores nothing, its chunks point into the columns of the mapped file.
+ *
+ * Waypoints are timed by TrajectoryTiming, trajectories without timing (all waypoint times equal) are played with
+ * DEFAULT_WAYPOINT_INTERVAL between waypoints.
+ * A timeline is not thread safe while it is appended to, a complete timeline can be shared between threads.
+ */
+class TrajectoryTimeline
+{
+public:
+  using Ptr = std::shared_ptr<TrajectoryTimeline>;
+  using ConstPtr = std::shared_ptr<const TrajectoryTimeline>;
+
+  /** @brief The number of floats per link transform */
+  static constexpr std::size_t TRANSFORM_SIZE = 7;
+
+  /** @brief The number of floats per link in the output of interpolateLinkTransforms(), a column major 4x4 matrix */
+  static constexpr std::size_t MATRIX_SIZE = 16;
+
+  /** @brief The number of waypoints per storage chunk */
+  static constexpr std::size_t CHUNK_SIZE = 1024;
+
+  /** @brief The time between waypoints of trajectories without timing in seconds */
+  static constexpr double DEFAULT_WAYPOINT_INTERVAL = TrajectoryTiming::DEFAULT_WAYPOINT_INTERVAL;
+
+  /**
+   * @brief Create an empty timeline to append() to
+   * @param link_names The links to store, in the order written by interpolateLinkTransforms()
+   */
+  explicit TrajectoryTimeline(std::vector<std::string> link_names);
+
+  /**
+   * @brief Precompute the link transforms of all waypoints of a trajectory
+   * @param environment The environment providing the kinematics, only used during construction
+   * @param trajectory The trajectory, joints missing from a waypoint keep their value in the environment
+   * @param link_names The links to store, in the order written by interpolateLinkTransforms()
+   * @param thread_count The number of threads used, zero uses one per core
+   */
+  TrajectoryTimeline(const tesseract_environment::Environment& environment,
+                     const tesseract_common::JointTrajectory& trajectory,
+                     std::vector<std::string> link_names,
+                     std::size_t thread_count = 0);
+
+  /**
+   * @brief Precompute the link transforms of all waypoints of a trajectory file from its joint positions
+   * @param environment The environment providing the kinematics, only used during construction
+   * @param file The trajectory file, joints without a position at a waypoint keep their value in the environment
+   * @param link_names The links to store, in the order written by interpolateLinkTransforms()
+   * @param thread_count The number of threads used, zero uses one per core
+   * @throws std::runtime_error if the file has no joint positions
+   */
+  TrajectoryTimeline(const tesseract_environment::Environment& environment,
+                     const TrajectoryFile& file,
+                     std::vector<std::string> link_names,
+                     std::size_t thread_count = 0);
+
+  /**
+   * @brief Play the link transforms stored in a trajectory file without copying them
+   * @param file The trajectory file, kept mapped by the timeline
+   * @throws std::runtime_error if the file has no link transforms or no joint positions
+   */
+  explicit TrajectoryTimeline(std::shared_ptr<const TrajectoryFile> file);
+
+  /**
+   * @brief Append a waypoint
+   * @param waypoint The waypoint, its joints are matched by name to getJointNames()
+   * @param state The scene state of the waypoint computed by the caller, e.g. on a worker thread
+   * @throws std::runtime_error if the timeline views a trajectory file
+   */
+  void append(const tesseract_common::JointState& waypoint, const tesseract_scene_graph::SceneState& state);
+
+  const std::vector<std::string>& getLinkNames() const;
+
+  /** @brief The joints of the first waypoint, the joints of getJointPosition() */
+  const std::vector<std::string>& getJointNames() const;
+
+  std::size_t getWaypointCount() const;
+
+  /** @brief The time of a waypoint relative to the first one */
+  double getTime(std::size_t waypoint) const;
+  double getDuration() const;
+
+  /**
+   * @brief Find the waypoints surrounding a time
+   * @return The index of the waypoint before the time and the interpolation factor towards the next one
+   */
+  std::pair<std::size_t, float> locate(double time) const;
+
+  /**
+   * @brief Interpolate all link transforms at a time
+   * @param time The time, clamped to the duration
+   * @param data Buffer of at least getLinkNames().size() * MATRIX_SIZE floats receiving column major 4x4 matrices,
+   * left unchanged if the timeline is empty
+   */
+  void interpolateLinkTransforms(double time, float* data) const;
+
+  /** @brief Interpolate the positions of getJointNames() at a time */
+  void interpolateJointPositions(double time, Eigen::VectorXd& positions) const;
+
+  /** @brief The position of a joint at a waypoint, NaN if the waypoint does not contain the joint */
+  float getJointPosition(std::size_t joint_index, std::size_t waypoint) const;
+
+  /**
+   * @brief A component of the link transforms at a waypoint
+   * @param component The component, position xyz then quaternion xyzw
+   * @return getLinkNames().size() floats
+   */
+  const float* getLinkTransformComponent(std::size_t component, std::size_t waypoint) const;
+
+  /** @brief The memory used by the timeline in bytes, a mapped trajectory file is not counted */
+  std::size_t getByteSize() const;
+
+private:
+  /**
+   * @brief Storage of CHUNK_SIZE waypoints
+   *
+   * Component c of link l at waypoint i of the chunk is transforms[c][i * link count + l] (position xyz then
+   * quaternion xyzw), the position of joint j is joint_positions[j * CHUNK_SIZE + i].
+   *
+   * Waypoints are read through the data pointers, which point into the vectors or, leaving the vectors empty, into
+   * the same layout of a mapped TrajectoryFile where joint positions are joint_stride apart.
+   */
+  struct Chunk
+  {
+    std::vector<double> times;
+    std::array<std::vector<float>, TRANSFORM_SIZE> transforms;
+    std::vector<float> joint_positions;
+
+    const double* time_data{ nullptr };
+    std::array<const float*, TRANSFORM_SIZE> transform_data{};
+    const float* joint_position_data{ nullptr };
+    std::size_t joint_stride{ CHUNK_SIZE };
+  };
+
+  std::vector<std::string> link_names_;
+  std::vector<std::string> joint_names_;
+  std::unordered_map<std::string, std::size_t> joint_index_;
+  std::vector<std::unique_ptr<Chunk>> chunks_;
+  std::size_t waypoint_count_{ 0 };
+
+  /** @brief The file viewed by the chunks */
+  std::shared_ptr<const TrajectoryFile> file_;
+
+  TrajectoryTiming timing_;
+
+  void setJointNames(const std::vector<std::string>& joint_names);
+
+  /** @brief Add storage for count more waypoints */
+  void reserveWaypoints(std::size_t count);
+
+  void setJointPositions(std::size_t waypoint, const tesseract_common::JointState& state);
+  void setTransforms(std::size_t waypoint, const tesseract_common::TransformMap& link_transforms);
+
+  void computeTransforms(const tesseract_environment::Environment& environment,
+                         const tesseract_common::JointTrajectory& trajectory,
+                         std::size_t begin,
+                         std::size_t end);
+  void computeTransforms(const tesseract_environment::Environment& environment,
+                         const TrajectoryFile& file,
+                         std::size_t begin,
+                         std::size_t end);
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_JOINT_TRAJECTORY_TRAJECTORY_TIMELINE_H
@@ -0,0 +1,66 @@
+/**
+ * @file trajectory_timing.h
+ * @brief The timing rule shared by trajectory playback, plots and files
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_JOINT_TRAJECTORY_TRAJECTORY_TIMING_H
+#define TESSERACT_GUI_JOINT_TRAJECTORY_TRAJECTORY_TIMING_H
+
+namespace tesseract_gui
+{
+/**
+ * @brief Assigns consecutive waypoints their time relative to the first waypoint
+ *
+ * TrajectoryTimeline, TrajectoryPlotData and TrajectoryFile all time waypoints through this class so playback, plots
+ * and files agree. Times never decrease, and as long as all waypoints had the time of the first one (trajectories
+ * without timing) they are DEFAULT_WAYPOINT_INTERVAL apart.
+ */
+class TrajectoryTiming
+{
+public:
+  /** @brief The time between waypoints of trajectories without timing in seconds */
+  static constexpr double DEFAULT_WAYPOINT_INTERVAL = 0.1;
+
+  TrajectoryTiming() = default;
+
+  /**
+   * @brief Continue the timing of waypoints which are already timed, e.g. those of a trajectory file
+   * @param start_time The absolute time of the first waypoint
+   * @param last_time The relative time of the last waypoint, the trajectory is considered timed if it is positive
+   */
+  TrajectoryTiming(double start_time, double last_time);
+
+  /**
+   * @brief Time the next waypoint
+   * @param waypoint_time The absolute time of the waypoint
+   * @return The time of the waypoint relative to the first one
+   */
+  double getNextTime(double waypoint_time);
+
+  /** @brief The absolute time of the first waypoint, 0 before the first waypoint */
+  double getStartTime() const;
+
+private:
+  double start_time_{ 0 };
+  double last_time_{ 0 };
+  bool started_{ false };
+
+  /** @brief False as long as all waypoints had the time of the first one */
+  bool timed_{ false };
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_JOINT_TRAJECTORY_TRAJECTORY_TIMING_H
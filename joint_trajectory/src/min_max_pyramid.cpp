@@ -0,0 +1,104 @@
+/**
+ * @file min_max_pyramid.cpp
+ * @brief Minimum and maximum of any sample range of a signal from a pyramid of power of two blocks
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <cmath>
+#include <limits>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/joint_trajectory/min_max_pyramid.h>
+
+namespace tesseract_gui
+{
+MinMaxPyramid::MinMaxPyramid(std::vector<float> samples) : samples_(std::move(samples))
+{
+  // Only whole blocks are stored, a query never needs the partial block at the end of a level
+  const std::vector<float>* mins = &samples_;
+  const std::vector<float>* maxs = &samples_;
+  while (mins->size() >= 2)
+  {
+    const std::size_t count = mins->size() / 2;
+    std::vector<float> level_mins(count);
+    std::vector<float> level_maxs(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      // fmin and fmax return the other argument if one is NaN
+      level_mins[i] = std::fmin((*mins)[2 * i], (*mins)[(2 * i) + 1]);
+      level_maxs[i] = std::fmax((*maxs)[2 * i], (*maxs)[(2 * i) + 1]);
+    }
+
+    mins_.push_back(std::move(level_mins));
+    maxs_.push_back(std::move(level_maxs));
+    mins = &mins_.back();
+    maxs = &maxs_.back();
+  }
+}
+
+std::size_t MinMaxPyramid::size() const { return samples_.size(); }
+
+bool MinMaxPyramid::empty() const { return samples_.empty(); }
+
+const std::vector<float>& MinMaxPyramid::getSamples() const { return samples_; }
+
+std::pair<float, float> MinMaxPyramid::getRange(std::size_t begin, std::size_t end) const
+{
+  float min = std::numeric_limits<float>::quiet_NaN();
+  float max = std::numeric_limits<float>::quiet_NaN();
+  end = std::min(end, samples_.size());
+  if (begin >= end)
+    return { min, max };
+
+  // Take the unaligned block at either end of the run, then continue with the whole blocks of the next level
+  std::size_t level{ 0 };
+  while (begin < end)
+  {
+    const std::vector<float>& mins = (level == 0) ? samples_ : mins_[level - 1];
+    const std::vector<float>& maxs = (level == 0) ? samples_ : maxs_[level - 1];
+    if ((begin & 1U) != 0)
+    {
+      min = std::fmin(min, mins[begin]);
+      max = std::fmax(max, maxs[begin]);
+      ++begin;
+    }
+    if ((end & 1U) != 0)
+    {
+      --end;
+      min = std::fmin(min, mins[end]);
+      max = std::fmax(max, maxs[end]);
+    }
+
+    begin /= 2;
+    end /= 2;
+    ++level;
+  }
+
+  return { min, max };
+}
+
+std::pair<float, float> MinMaxPyramid::getRange() const { return getRange(0, samples_.size()); }
+
+std::size_t MinMaxPyramid::getByteSize() const
+{
+  std::size_t size = samples_.size() * sizeof(float);
+  for (std::size_t k = 0; k < mins_.size(); ++k)
+    size += (mins_[k].size() + maxs_[k].size()) * sizeof(float);
+  return size;
+}
+
+}  // namespace tesseract_gui
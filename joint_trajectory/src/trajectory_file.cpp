@@ -0,0 +1,318 @@
+/**
+ * @file trajectory_file.cpp
+ * @brief A memory mapped, columnar binary trajectory file
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/common/instrumentation.h>
+#include <tesseract_gui/joint_trajectory/trajectory_file.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+constexpr std::array<char, 8> FILE_MAGIC{ 'T', 'G', 'U', 'I', 'T', 'R', 'A', 'J' };
+
+/** @brief Columns start at multiples of this many bytes */
+constexpr std::uint64_t COLUMN_ALIGNMENT = 64;
+
+/** @brief The fixed size part of the file, the index of the columns, an offset of zero marks a missing column */
+struct FileHeader
+{
+  std::array<char, 8> magic;
+  std::uint32_t version;
+  std::uint32_t joint_count;
+  std::uint32_t link_count;
+  std::uint32_t reserved;
+  std::uint64_t waypoint_count;
+  double start_time;
+
+  /** @brief The joint then link names, each a uint32 length followed by its characters */
+  std::uint64_t names_offset;
+  std::uint64_t names_size;
+
+  std::uint64_t times_offset;
+  std::array<std::uint64_t, TrajectoryPlotData::CHANNEL_COUNT> channel_offsets;
+  std::array<std::uint64_t, TrajectoryTimeline::TRANSFORM_SIZE> link_transform_offsets;
+};
+
+std::uint64_t align(std::uint64_t offset)
+{
+  return (offset + COLUMN_ALIGNMENT - 1) / COLUMN_ALIGNMENT * COLUMN_ALIGNMENT;
+}
+
+std::uint64_t getNamesSize(const std::vector<std::string>& names)
+{
+  std::uint64_t size{ 0 };
+  for (const auto& name : names)
+    size += sizeof(std::uint32_t) + name.size();
+  return size;
+}
+
+/** @brief Writes sequentially and tracks the offset for padding */
+class Writer
+{
+public:
+  explicit Writer(const std::string& path) : file_(path, std::ios::binary) {}
+
+  bool good() const { return file_.good(); }
+
+  template <typename T>
+  void write(const T* data, std::size_t count)
+  {
+    file_.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+    offset_ += count * sizeof(T);
+  }
+
+  void writeNames(const std::vector<std::string>& names)
+  {
+    for (const auto& name : names)
+    {
+      const auto length = static_cast<std::uint32_t>(name.size());
+      write(&length, 1);
+      write(name.data(), name.size());
+    }
+  }
+
+  /** @brief Write zeros up to an offset */
+  void pad(std::uint64_t offset)
+  {
+    static const std::array<char, COLUMN_ALIGNMENT> zeros{};
+    while (offset_ < offset)
+      write(zeros.data(), std::min<std::uint64_t>(offset - offset_, zeros.size()));
+  }
+
+private:
+  std::ofstream file_;
+  std::uint64_t offset_{ 0 };
+};
+
+/** @brief Reads the names section of a mapped file without reading past its end */
+std::vector<std::string> readNames(const uchar*& data, const uchar* end, std::size_t count)
+{
+  std::vector<std::string> names;
+  names.reserve(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    std::uint32_t length{ 0 };
+    if (end - data < static_cast<std::ptrdiff_t>(sizeof(length)))
+      return {};
+    std::memcpy(&length, data, sizeof(length));
+    data += sizeof(length);
+
+    if (end - data < static_cast<std::ptrdiff_t>(length))
+      return {};
+    names.emplace_back(reinterpret_cast<const char*>(data), length);
+    data += length;
+  }
+  return names;
+}
+}  // namespace
+
+TrajectoryFile::TrajectoryFile(const std::string& path) : path_(path), file_(QString::fromStdString(path))
+{
+  const ScopedTimer timer("trajectory", "map file");
+  if (!file_.open(QIODevice::ReadOnly))
+    throw std::runtime_error("TrajectoryFile, failed to open '" + path + "'!");
+
+  // Mapping reads nothing, pages are read from disk when they are first accessed
+  file_size_ = static_cast<std::size_t>(file_.size());
+  if (file_size_ < sizeof(FileHeader))
+    throw std::runtime_error("TrajectoryFile, '" + path + "' is not a trajectory file!");
+
+  data_ = file_.map(0, file_.size());
+  if (data_ == nullptr)
+    throw std::runtime_error("TrajectoryFile, failed to map '" + path + "'!");
+
+  FileHeader header{};
+  std::memcpy(&header, data_, sizeof(header));
+  if (header.magic != FILE_MAGIC)
+    throw std::runtime_error("TrajectoryFile, '" + path + "' is not a trajectory file!");
+
+  if (header.version != VERSION)
+    throw std::runtime_error("TrajectoryFile, '" + path + "' has unsupported version " +
+                             std::to_string(header.version) + "!");
+
+  // Every column has to lie inside of the file, a corrupt index would otherwise read past the mapping
+  waypoint_count_ = header.waypoint_count;
+  auto get_column = [this, &header, &path](std::uint64_t offset, std::uint64_t value_size, std::uint64_t count) {
+    if (offset == 0)
+      return static_cast<const uchar*>(nullptr);
+
+    if (count > 0 && waypoint_count_ > std::numeric_limits<std::uint64_t>::max() / value_size / count)
+      throw std::runtime_error("TrajectoryFile, '" + path + "' has an invalid waypoint count!");
+
+    const std::uint64_t size = waypoint_count_ * value_size * count;
+    if (offset % COLUMN_ALIGNMENT != 0 || offset < sizeof(FileHeader) || offset > file_size_ ||
+        size > file_size_ - offset)
+      throw std::runtime_error("TrajectoryFile, '" + path + "' is truncated!");
+
+    return data_ + offset;
+  };
+
+  if (header.times_offset == 0 || waypoint_count_ == 0)
+    throw std::runtime_error("TrajectoryFile, '" + path + "' has no waypoints!");
+
+  times_ = reinterpret_cast<const double*>(get_column(header.times_offset, sizeof(double), 1));
+  for (std::size_t c = 0; c < channels_.size(); ++c)
+    channels_[c] = reinterpret_cast<const float*>(
+        get_column(header.channel_offsets[c], sizeof(float), header.joint_count));
+  for (std::size_t c = 0; c < link_transforms_.size(); ++c)
+    link_transforms_[c] = reinterpret_cast<const float*>(
+        get_column(header.link_transform_offsets[c], sizeof(float), header.link_count));
+
+  // Link transforms are stored with all of their components or not at all
+  auto is_missing = [](const float* column) { return column == nullptr; };
+  if (std::any_of(link_transforms_.begin(), link_transforms_.end(), is_missing) &&
+      !std::all_of(link_transforms_.begin(), link_transforms_.end(), is_missing))
+    throw std::runtime_error("TrajectoryFile, '" + path + "' has incomplete link transforms!");
+
+  if (header.names_offset > file_size_ || header.names_size > file_size_ - header.names_offset)
+    throw std::runtime_error("TrajectoryFile, '" + path + "' is truncated!");
+
+  const uchar* names = data_ + header.names_offset;
+  const uchar* names_end = names + header.names_size;
+  joint_names_ = readNames(names, names_end, header.joint_count);
+  link_names_ = readNames(names, names_end, header.link_count);
+  if (joint_names_.size() != header.joint_count || link_names_.size() != header.link_count)
+    throw std::runtime_error("TrajectoryFile, '" + path + "' has invalid names!");
+
+  start_time_ = header.start_time;
+}
+
+void TrajectoryFile::write(const std::string& path,
+                           const tesseract_common::JointTrajectory& trajectory,
+                           const TrajectoryTimeline* timeline)
+{
+  const ScopedTimer timer("trajectory", "write file");
+
+  // The columns and the timing are extracted like for plotting
+  const TrajectoryPlotData data(trajectory);
+  const std::size_t waypoint_count = data.getSampleCount();
+  if (timeline != nullptr && timeline->getWaypointCount() != waypoint_count)
+    throw std::runtime_error("TrajectoryFile, timeline does not match the trajectory!");
+
+  const std::vector<std::string>& joint_names = data.getJointNames();
+  const std::vector<std::string> link_names = (timeline != nullptr) ? timeline->getLinkNames() :
+                                                                      std::vector<std::string>();
+
+  FileHeader header{};
+  header.magic = FILE_MAGIC;
+  header.version = VERSION;
+  header.joint_count = static_cast<std::uint32_t>(joint_names.size());
+  header.link_count = static_cast<std::uint32_t>(link_names.size());
+  header.waypoint_count = waypoint_count;
+  header.start_time = trajectory.front().time;
+
+  // Lay out the columns first, the header holds their offsets
+  std::uint64_t end = sizeof(FileHeader);
+  auto allocate = [&end](std::uint64_t size) {
+    const std::uint64_t offset = align(end);
+    end = offset + size;
+    return offset;
+  };
+
+  header.names_size = getNamesSize(joint_names) + getNamesSize(link_names);
+  header.names_offset = allocate(header.names_size);
+  header.times_offset = allocate(waypoint_count * sizeof(double));
+  for (std::size_t c = 0; c < TrajectoryPlotData::CHANNEL_COUNT; ++c)
+  {
+    if (data.hasChannel(static_cast<TrajectoryChannel>(c)))
+      header.channel_offsets[c] = allocate(joint_names.size() * waypoint_count * sizeof(float));
+  }
+  if (timeline != nullptr)
+  {
+    for (auto& offset : header.link_transform_offsets)
+      offset = allocate(link_names.size() * waypoint_count * sizeof(float));
+  }
+
+  Writer file(path);
+  if (!file.good())
+    throw std::runtime_error("TrajectoryFile, failed to open '" + path + "'!");
+
+  file.write(&header, 1);
+  file.pad(header.names_offset);
+  file.writeNames(joint_names);
+  file.writeNames(link_names);
+  file.pad(header.times_offset);
+  file.write(data.getTimes().data(), waypoint_count);
+  for (std::size_t c = 0; c < TrajectoryPlotData::CHANNEL_COUNT; ++c)
+  {
+    if (header.channel_offsets[c] == 0)
+      continue;
+
+    file.pad(header.channel_offsets[c]);
+    for (std::size_t j = 0; j < joint_names.size(); ++j)
+      file.write(data.getPyramid(static_cast<TrajectoryChannel>(c), j).getSamples().data(), waypoint_count);
+  }
+
+  if (timeline != nullptr)
+  {
+    for (std::size_t c = 0; c < TrajectoryTimeline::TRANSFORM_SIZE; ++c)
+    {
+      file.pad(header.link_transform_offsets[c]);
+      for (std::size_t w = 0; w < waypoint_count; ++w)
+        file.write(timeline->getLinkTransformComponent(c, w), link_names.size());
+    }
+  }
+
+  if (!file.good())
+    throw std::runtime_error("TrajectoryFile, failed to write '" + path + "'!");
+}
+
+const std::string& TrajectoryFile::getPath() const { return path_; }
+
+std::size_t TrajectoryFile::getWaypointCount() const { return waypoint_count_; }
+
+const std::vector<std::string>& TrajectoryFile::getJointNames() const { return joint_names_; }
+
+double TrajectoryFile::getStartTime() const { return start_time_; }
+
+const double* TrajectoryFile::getTimes() const { return times_; }
+
+double TrajectoryFile::getDuration() const { return times_[waypoint_count_ - 1]; }
+
+bool TrajectoryFile::hasChannel(TrajectoryChannel channel) const
+{
+  return channels_[static_cast<std::size_t>(channel)] != nullptr;
+}
+
+const float* TrajectoryFile::getChannel(TrajectoryChannel channel) const
+{
+  return channels_[static_cast<std::size_t>(channel)];
+}
+
+float TrajectoryFile::getValue(TrajectoryChannel channel, std::size_t joint, std::size_t waypoint) const
+{
+  return channels_[static_cast<std::size_t>(channel)][(joint * waypoint_count_) + waypoint];
+}
+
+bool TrajectoryFile::hasLinkTransforms() const { return link_transforms_.front() != nullptr; }
+
+const std::vector<std::string>& TrajectoryFile::getLinkNames() const { return link_names_; }
+
+const float* TrajectoryFile::getLinkTransforms(std::size_t component) const { return link_transforms_[component]; }
+
+std::size_t TrajectoryFile::getFileSize() const { return file_size_; }
+
+}  // namespace tesseract_gui
@@ -0,0 +1,221 @@
+/**
+ * @file trajectory_player.cpp
+ * @brief Plays a trajectory timeline into a render scene
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/common/instrumentation.h>
+#include <tesseract_gui/joint_trajectory/trajectory_player.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+void checkLinks(const RenderScene::Ptr& scene, const TrajectoryTimeline::ConstPtr& timeline)
+{
+  if (scene != nullptr && timeline != nullptr && scene->getLinkNames() != timeline->getLinkNames())
+    throw std::runtime_error("TrajectoryPlayer, timeline links do not match the links of the scene!");
+}
+}  // namespace
+
+TrajectoryPlayer::TrajectoryPlayer(QObject* parent) : QObject(parent)
+{
+  frame_timer_.setTimerType(Qt::PreciseTimer);
+  frame_timer_.setInterval(16);
+  connect(&frame_timer_, &QTimer::timeout, this, &TrajectoryPlayer::onFrame);
+}
+
+void TrajectoryPlayer::setScene(RenderScene::Ptr scene)
+{
+  checkLinks(scene, timeline_);
+  scene_ = std::move(scene);
+  if (timeline_ != nullptr)
+    applyTime(time_);
+}
+
+RenderScene::Ptr TrajectoryPlayer::getScene() const { return scene_; }
+
+void TrajectoryPlayer::setTimeline(TrajectoryTimeline::ConstPtr timeline)
+{
+  checkLinks(scene_, timeline);
+  pause();
+  timeline_ = std::move(timeline);
+  link_transforms_.clear();
+  if (timeline_ != nullptr)
+    link_transforms_.resize(timeline_->getLinkNames().size() * TrajectoryTimeline::MATRIX_SIZE);
+  known_duration_ = getDuration();
+
+  emit timelineChanged();
+  applyTime(0);
+}
+
+TrajectoryTimeline::ConstPtr TrajectoryPlayer::getTimeline() const { return timeline_; }
+
+void TrajectoryPlayer::loadTrajectory(const tesseract_environment::Environment& environment,
+                                      const tesseract_common::JointTrajectory& trajectory)
+{
+  if (scene_ == nullptr)
+    throw std::runtime_error("TrajectoryPlayer, a scene is required to load a trajectory!");
+
+  setTimeline(std::make_shared<TrajectoryTimeline>(environment, trajectory, scene_->getLinkNames()));
+}
+
+void TrajectoryPlayer::loadTrajectory(const tesseract_environment::Environment& environment,
+                                      TrajectoryFile::ConstPtr file)
+{
+  if (scene_ == nullptr)
+    throw std::runtime_error("TrajectoryPlayer, a scene is required to load a trajectory!");
+
+  if (file->hasLinkTransforms() && file->getLinkNames() == scene_->getLinkNames())
+    setTimeline(std::make_shared<TrajectoryTimeline>(std::move(file)));
+  else
+    setTimeline(std::make_shared<TrajectoryTimeline>(environment, *file, scene_->getLinkNames()));
+}
+
+double TrajectoryPlayer::getTime() const { return time_; }
+
+double TrajectoryPlayer::getDuration() const { return (timeline_ != nullptr) ? timeline_->getDuration() : 0.0; }
+
+bool TrajectoryPlayer::isPlaying() const { return frame_timer_.isActive(); }
+
+void TrajectoryPlayer::setPlaybackSpeed(double speed)
+{
+  // Restart the clock so the speed change applies from the current time on
+  play_start_time_ = time_;
+  clock_.restart();
+  speed_ = std::max(speed, 0.0);
+}
+
+double TrajectoryPlayer::getPlaybackSpeed() const { return speed_; }
+
+void TrajectoryPlayer::setLoop(bool loop) { loop_ = loop; }
+
+bool TrajectoryPlayer::getLoop() const { return loop_; }
+
+void TrajectoryPlayer::setFollowLatest(bool follow) { follow_latest_ = follow; }
+
+bool TrajectoryPlayer::getFollowLatest() const { return follow_latest_; }
+
+void TrajectoryPlayer::setFrameInterval(int msec) { frame_timer_.setInterval(std::max(1, msec)); }
+
+int TrajectoryPlayer::getFrameInterval() const { return frame_timer_.interval(); }
+
+void TrajectoryPlayer::play()
+{
+  if (timeline_ == nullptr || isPlaying())
+    return;
+
+  if (time_ >= getDuration())
+    applyTime(0);
+
+  play_start_time_ = time_;
+  clock_.start();
+  frame_timer_.start();
+  emit playingChanged(true);
+}
+
+void TrajectoryPlayer::pause()
+{
+  if (!isPlaying())
+    return;
+
+  frame_timer_.stop();
+  emit playingChanged(false);
+}
+
+void TrajectoryPlayer::stop()
+{
+  pause();
+  applyTime(0);
+}
+
+void TrajectoryPlayer::seek(double time)
+{
+  if (timeline_ == nullptr)
+    return;
+
+  applyTime(time);
+  if (isPlaying())
+  {
+    play_start_time_ = time_;
+    clock_.restart();
+  }
+}
+
+void TrajectoryPlayer::updateTimeline()
+{
+  if (timeline_ == nullptr)
+    return;
+
+  const bool at_end = (time_ >= known_duration_);
+  known_duration_ = getDuration();
+  emit durationChanged(known_duration_);
+
+  // The first waypoints of a stream have to be applied even if following is disabled
+  if ((follow_latest_ && at_end && !isPlaying()) || timeline_->getWaypointCount() == 1)
+    applyTime(follow_latest_ ? known_duration_ : time_);
+}
+
+void TrajectoryPlayer::onFrame()
+{
+  const double duration = getDuration();
+  double time = play_start_time_ + (speed_ * static_cast<double>(clock_.nsecsElapsed()) * 1e-9);
+  if (time < duration)
+  {
+    applyTime(time);
+    return;
+  }
+
+  if (loop_ && duration > 0)
+  {
+    time = std::fmod(time, duration);
+    play_start_time_ = time;
+    clock_.restart();
+    applyTime(time);
+    return;
+  }
+
+  applyTime(duration);
+  pause();
+  emit finished();
+}
+
+void TrajectoryPlayer::applyTime(double time)
+{
+  if (timeline_ == nullptr)
+  {
+    time_ = 0;
+    return;
+  }
+
+  time_ = std::clamp(time, 0.0, timeline_->getDuration());
+  if (scene_ != nullptr && timeline_->getWaypointCount() > 0 &&
+      scene_->getLinkNames().size() == timeline_->getLinkNames().size())
+  {
+    const ScopedTimer timer("trajectory", "interpolate");
+    timeline_->interpolateLinkTransforms(time_, link_transforms_.data());
+    scene_->setLinkTransforms(link_transforms_.data(), timeline_->getLinkNames().size());
+  }
+
+  emit timeChanged(time_);
+}
+
+}  // namespace tesseract_gui
@@ -0,0 +1,137 @@
+/**
+ * @file trajectory_player_widget.cpp
+ * @brief Playback controls for a trajectory player
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cmath>
+#include <stdexcept>
+#include <QCheckBox>
+#include <QDoubleSpinBox>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QSignalBlocker>
+#include <QSlider>
+#include <QStyle>
+#include <QToolButton>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/joint_trajectory/trajectory_player.h>
+#include <tesseract_gui/joint_trajectory/trajectory_player_widget.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+QString formatTime(double time) { return QString::number(time, 'f', 3) + " s"; }
+}  // namespace
+
+TrajectoryPlayerWidget::TrajectoryPlayerWidget(TrajectoryPlayer* player, QWidget* parent)
+  : QWidget(parent)
+  , player_(player)
+  , play_button_(new QToolButton(this))
+  , stop_button_(new QToolButton(this))
+  , slider_(new QSlider(Qt::Horizontal, this))
+  , time_label_(new QLabel(this))
+  , speed_spin_box_(new QDoubleSpinBox(this))
+  , loop_check_box_(new QCheckBox("Loop", this))
+  , memory_label_(new QLabel(this))
+{
+  if (player_ == nullptr)
+    throw std::runtime_error("TrajectoryPlayerWidget, player is a nullptr!");
+
+  play_button_->setIcon(style()->standardIcon(QStyle::SP_MediaPlay));
+  stop_button_->setIcon(style()->standardIcon(QStyle::SP_MediaStop));
+  slider_->setRange(0, SLIDER_STEPS);
+  speed_spin_box_->setRange(0.01, 100.0);
+  speed_spin_box_->setSingleStep(0.25);
+  speed_spin_box_->setSuffix("x");
+  speed_spin_box_->setValue(player_->getPlaybackSpeed());
+  loop_check_box_->setChecked(player_->getLoop());
+
+  auto* layout = new QHBoxLayout(this);
+  layout->addWidget(play_button_);
+  layout->addWidget(stop_button_);
+  layout->addWidget(slider_, 1);
+  layout->addWidget(time_label_);
+  layout->addWidget(speed_spin_box_);
+  layout->addWidget(loop_check_box_);
+  layout->addWidget(memory_label_);
+
+  connect(play_button_, &QToolButton::clicked, this, [this]() {
+    if (player_->isPlaying())
+      player_->pause();
+    else
+      player_->play();
+  });
+  connect(stop_button_, &QToolButton::clicked, player_, &TrajectoryPlayer::stop);
+  connect(slider_, &QSlider::valueChanged, this, &TrajectoryPlayerWidget::onSliderValueChanged);
+  connect(speed_spin_box_,
+          QOverload<double>::of(&QDoubleSpinBox::valueChanged),
+          player_,
+          &TrajectoryPlayer::setPlaybackSpeed);
+  connect(loop_check_box_, &QCheckBox::toggled, player_, &TrajectoryPlayer::setLoop);
+  connect(player_, &TrajectoryPlayer::timeChanged, this, &TrajectoryPlayerWidget::onTimeChanged);
+  connect(player_, &TrajectoryPlayer::timelineChanged, this, &TrajectoryPlayerWidget::onTimelineChanged);
+  connect(player_, &TrajectoryPlayer::durationChanged, this, &TrajectoryPlayerWidget::onTimelineChanged);
+  connect(player_, &TrajectoryPlayer::playingChanged, this, &TrajectoryPlayerWidget::onPlayingChanged);
+
+  onTimelineChanged();
+}
+
+TrajectoryPlayer* TrajectoryPlayerWidget::getPlayer() const { return player_; }
+
+void TrajectoryPlayerWidget::onTimeChanged(double time)
+{
+  const double duration = player_->getDuration();
+  const int value = (duration > 0) ? static_cast<int>(std::lround((time / duration) * SLIDER_STEPS)) : 0;
+  {
+    const QSignalBlocker blocker(slider_);
+    slider_->setValue(value);
+  }
+  time_label_->setText(formatTime(time) + " / " + formatTime(duration));
+}
+
+void TrajectoryPlayerWidget::onTimelineChanged()
+{
+  const TrajectoryTimeline::ConstPtr timeline = player_->getTimeline();
+  setEnabled(timeline != nullptr);
+  if (timeline == nullptr)
+  {
+    memory_label_->clear();
+    onTimeChanged(0);
+    return;
+  }
+
+  const double megabytes = static_cast<double>(timeline->getByteSize()) / (1024.0 * 1024.0);
+  memory_label_->setText(QString::number(megabytes, 'f', 1) + " MB");
+  memory_label_->setToolTip(QString("%1 waypoints, %2 links")
+                                .arg(timeline->getWaypointCount())
+                                .arg(timeline->getLinkNames().size()));
+  onTimeChanged(player_->getTime());
+}
+
+void TrajectoryPlayerWidget::onPlayingChanged(bool playing)
+{
+  play_button_->setIcon(style()->standardIcon(playing ? QStyle::SP_MediaPause : QStyle::SP_MediaPlay));
+}
+
+void TrajectoryPlayerWidget::onSliderValueChanged(int value)
+{
+  player_->seek((static_cast<double>(value) / SLIDER_STEPS) * player_->getDuration());
+}
+
+}  // namespace tesseract_gui
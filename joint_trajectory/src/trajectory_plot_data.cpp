@@ -0,0 +1,223 @@
+/**
+ * @file trajectory_plot_data.cpp
+ * @brief The joint channels of a trajectory prepared for plotting at any zoom
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/joint_trajectory/trajectory_file.h>
+#include <tesseract_gui/joint_trajectory/trajectory_plot_data.h>
+#include <tesseract_gui/joint_trajectory/trajectory_timing.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+const Eigen::VectorXd& getValues(const tesseract_common::JointState& waypoint, TrajectoryChannel channel)
+{
+  switch (channel)
+  {
+    case TrajectoryChannel::VELOCITY:
+      return waypoint.velocity;
+    case TrajectoryChannel::ACCELERATION:
+      return waypoint.acceleration;
+    case TrajectoryChannel::EFFORT:
+      return waypoint.effort;
+    default:
+      return waypoint.position;
+  }
+}
+}  // namespace
+
+TrajectoryPlotData::TrajectoryPlotData(const tesseract_common::JointTrajectory& trajectory)
+{
+  if (trajectory.empty())
+    throw std::runtime_error("TrajectoryPlotData, trajectory is empty!");
+
+  joint_names_ = trajectory.front().joint_names;
+  std::unordered_map<std::string, std::size_t> joint_index;
+  for (std::size_t j = 0; j < joint_names_.size(); ++j)
+    joint_index[joint_names_[j]] = j;
+
+  const std::size_t sample_count = trajectory.size();
+  std::array<ChannelSamples, CHANNEL_COUNT> channels;
+  for (std::size_t c = 0; c < CHANNEL_COUNT; ++c)
+  {
+    const auto channel = static_cast<TrajectoryChannel>(c);
+    const bool available = std::any_of(trajectory.begin(), trajectory.end(), [channel](const auto& waypoint) {
+      return getValues(waypoint, channel).size() > 0;
+    });
+    if (available)
+      channels[c].assign(joint_names_.size(),
+                         std::vector<float>(sample_count, std::numeric_limits<float>::quiet_NaN()));
+  }
+
+  // Same timing as TrajectoryTimeline so plot and player times agree
+  times_.reserve(sample_count);
+  TrajectoryTiming timing;
+  for (std::size_t w = 0; w < sample_count; ++w)
+  {
+    const tesseract_common::JointState& waypoint = trajectory[w];
+    times_.push_back(timing.getNextTime(waypoint.time));
+
+    // Waypoints usually have the joint order of the first one, the names are only looked up if not
+    const bool same_layout = (waypoint.joint_names == joint_names_);
+    for (std::size_t i = 0; i < waypoint.joint_names.size(); ++i)
+    {
+      std::size_t j = i;
+      if (!same_layout)
+      {
+        auto it = joint_index.find(waypoint.joint_names[i]);
+        if (it == joint_index.end())
+          continue;
+        j = it->second;
+      }
+
+      for (std::size_t c = 0; c < CHANNEL_COUNT; ++c)
+      {
+        const Eigen::VectorXd& values = getValues(waypoint, static_cast<TrajectoryChannel>(c));
+        if (!channels[c].empty() && static_cast<Eigen::Index>(i) < values.size())
+          channels[c][j][w] = static_cast<float>(values[static_cast<Eigen::Index>(i)]);
+      }
+    }
+  }
+
+  build(std::move(channels));
+}
+
+TrajectoryPlotData::TrajectoryPlotData(const TrajectoryFile& file)
+  : joint_names_(file.getJointNames()), times_(file.getTimes(), file.getTimes() + file.getWaypointCount())
+{
+  const std::size_t sample_count = times_.size();
+  std::array<ChannelSamples, CHANNEL_COUNT> channels;
+  for (std::size_t c = 0; c < CHANNEL_COUNT; ++c)
+  {
+    const float* values = file.getChannel(static_cast<TrajectoryChannel>(c));
+    if (values == nullptr)
+      continue;
+
+    channels[c].reserve(joint_names_.size());
+    for (std::size_t j = 0; j < joint_names_.size(); ++j)
+      channels[c].emplace_back(values + (j * sample_count), values + ((j + 1) * sample_count));
+  }
+
+  build(std::move(channels));
+}
+
+TrajectoryPlotData::TrajectoryPlotData(std::vector<std::string> joint_names,
+                                       std::vector<double> times,
+                                       std::array<ChannelSamples, CHANNEL_COUNT> channels)
+  : joint_names_(std::move(joint_names)), times_(std::move(times))
+{
+  for (const auto& channel : channels)
+  {
+    if (channel.empty())
+      continue;
+
+    if (channel.size() != joint_names_.size())
+      throw std::runtime_error("TrajectoryPlotData, channel does not have values for every joint!");
+
+    for (const auto& values : channel)
+    {
+      if (values.size() != times_.size())
+        throw std::runtime_error("TrajectoryPlotData, joint does not have a value for every time!");
+    }
+  }
+
+  build(std::move(channels));
+}
+
+const std::vector<std::string>& TrajectoryPlotData::getJointNames() const { return joint_names_; }
+
+std::size_t TrajectoryPlotData::getSampleCount() const { return times_.size(); }
+
+const std::vector<double>& TrajectoryPlotData::getTimes() const { return times_; }
+
+double TrajectoryPlotData::getDuration() const { return times_.empty() ? 0 : times_.back(); }
+
+std::size_t TrajectoryPlotData::findSample(double time) const
+{
+  return static_cast<std::size_t>(std::lower_bound(times_.begin(), times_.end(), time) - times_.begin());
+}
+
+bool TrajectoryPlotData::hasChannel(TrajectoryChannel channel) const
+{
+  return !pyramids_[static_cast<std::size_t>(channel)].empty();
+}
+
+const MinMaxPyramid& TrajectoryPlotData::getPyramid(TrajectoryChannel channel, std::size_t joint) const
+{
+  return pyramids_[static_cast<std::size_t>(channel)].at(joint);
+}
+
+std::pair<float, float> TrajectoryPlotData::getRange(TrajectoryChannel channel) const
+{
+  return ranges_[static_cast<std::size_t>(channel)];
+}
+
+std::size_t TrajectoryPlotData::getByteSize() const
+{
+  std::size_t size = times_.size() * sizeof(double);
+  for (const auto& channel : pyramids_)
+  {
+    for (const auto& pyramid : channel)
+      size += pyramid.getByteSize();
+  }
+  return size;
+}
+
+const char* TrajectoryPlotData::getChannelName(TrajectoryChannel channel)
+{
+  switch (channel)
+  {
+    case TrajectoryChannel::POSITION:
+      return "Position";
+    case TrajectoryChannel::VELOCITY:
+      return "Velocity";
+    case TrajectoryChannel::ACCELERATION:
+      return "Acceleration";
+    case TrajectoryChannel::EFFORT:
+      return "Effort";
+  }
+  return "";
+}
+
+void TrajectoryPlotData::build(std::array<ChannelSamples, CHANNEL_COUNT> channels)
+{
+  for (std::size_t c = 0; c < CHANNEL_COUNT; ++c)
+  {
+    float min = std::numeric_limits<float>::quiet_NaN();
+    float max = std::numeric_limits<float>::quiet_NaN();
+    pyramids_[c].clear();
+    pyramids_[c].reserve(channels[c].size());
+    for (auto& values : channels[c])
+    {
+      pyramids_[c].emplace_back(std::move(values));
+      const std::pair<float, float> range = pyramids_[c].back().getRange();
+      min = std::fmin(min, range.first);
+      max = std::fmax(max, range.second);
+    }
+    ranges_[c] = { min, max };
+  }
+}
+
+}  // namespace tesseract_gui
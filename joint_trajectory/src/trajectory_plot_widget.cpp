@@ -0,0 +1,348 @@
+/**
+ * @file trajectory_plot_widget.cpp
+ * @brief Plots the joint channels of long trajectories with a cursor linked to a trajectory player
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <cmath>
+#include <QLineF>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPointF>
+#include <QVector>
+#include <QWheelEvent>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/joint_trajectory/trajectory_player.h>
+#include <tesseract_gui/joint_trajectory/trajectory_plot_widget.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+/** @brief Room for the value labels left of the lanes */
+constexpr int LEFT_MARGIN = 64;
+
+/** @brief Room for the joint legend above the lanes */
+constexpr int TOP_MARGIN = 20;
+
+/** @brief Room for the time labels below the lanes */
+constexpr int BOTTOM_MARGIN = 20;
+
+constexpr int RIGHT_MARGIN = 8;
+
+/** @brief A press moving less than this many pixels is a click */
+constexpr int DRAG_THRESHOLD = 3;
+
+/** @brief The shortest time range shown in seconds */
+constexpr double MIN_VIEW_SPAN = 1e-4;
+
+QColor getJointColor(std::size_t joint, std::size_t joint_count)
+{
+  return QColor::fromHsv(static_cast<int>((joint * 360) / std::max<std::size_t>(joint_count, 1)), 200, 200);
+}
+}  // namespace
+
+TrajectoryPlotWidget::TrajectoryPlotWidget(QWidget* parent) : QWidget(parent)
+{
+  // The wheel zooms around the last mouse position
+  setMouseTracking(true);
+  setFocusPolicy(Qt::WheelFocus);
+}
+
+void TrajectoryPlotWidget::setData(TrajectoryPlotData::ConstPtr data)
+{
+  data_ = std::move(data);
+  resetView();
+}
+
+TrajectoryPlotData::ConstPtr TrajectoryPlotWidget::getData() const { return data_; }
+
+void TrajectoryPlotWidget::setPlayer(TrajectoryPlayer* player)
+{
+  if (player_ != nullptr)
+  {
+    disconnect(player_, nullptr, this, nullptr);
+    disconnect(this, nullptr, player_, nullptr);
+  }
+
+  player_ = player;
+  if (player_ == nullptr)
+    return;
+
+  connect(player_, &TrajectoryPlayer::timeChanged, this, &TrajectoryPlotWidget::setCursorTime);
+  connect(this, &TrajectoryPlotWidget::timeSelected, player_, &TrajectoryPlayer::seek);
+  setCursorTime(player_->getTime());
+}
+
+TrajectoryPlayer* TrajectoryPlotWidget::getPlayer() const { return player_; }
+
+void TrajectoryPlotWidget::setChannelVisible(TrajectoryChannel channel, bool visible)
+{
+  channel_visible_[static_cast<std::size_t>(channel)] = visible;
+  update();
+}
+
+bool TrajectoryPlotWidget::isChannelVisible(TrajectoryChannel channel) const
+{
+  return channel_visible_[static_cast<std::size_t>(channel)];
+}
+
+void TrajectoryPlotWidget::setView(double start, double end)
+{
+  const double duration = (data_ != nullptr) ? data_->getDuration() : 0;
+  if (duration <= 0)
+  {
+    view_start_ = 0;
+    view_end_ = 1;
+  }
+  else
+  {
+    const double span = std::clamp(end - start, std::min(MIN_VIEW_SPAN, duration), duration);
+    view_start_ = std::clamp(start, 0.0, duration - span);
+    view_end_ = view_start_ + span;
+  }
+
+  emit viewChanged(view_start_, view_end_);
+  update();
+}
+
+double TrajectoryPlotWidget::getViewStart() const { return view_start_; }
+
+double TrajectoryPlotWidget::getViewEnd() const { return view_end_; }
+
+double TrajectoryPlotWidget::getCursorTime() const { return cursor_time_; }
+
+QSize TrajectoryPlotWidget::sizeHint() const { return { 640, 480 }; }
+
+void TrajectoryPlotWidget::setCursorTime(double time)
+{
+  cursor_time_ = time;
+  update();
+}
+
+void TrajectoryPlotWidget::resetView() { setView(0, (data_ != nullptr) ? data_->getDuration() : 1); }
+
+void TrajectoryPlotWidget::paintEvent(QPaintEvent* /*event*/)
+{
+  QPainter painter(this);
+  painter.fillRect(rect(), palette().color(QPalette::Base));
+
+  const QRect plot = getPlotRect();
+  std::vector<TrajectoryChannel> channels;
+  if (data_ != nullptr)
+  {
+    for (std::size_t c = 0; c < TrajectoryPlotData::CHANNEL_COUNT; ++c)
+    {
+      const auto channel = static_cast<TrajectoryChannel>(c);
+      if (channel_visible_[c] && data_->hasChannel(channel))
+        channels.push_back(channel);
+    }
+  }
+
+  painter.setPen(palette().color(QPalette::Text));
+  if (channels.empty() || plot.width() <= 0 || plot.height() <= 0)
+  {
+    painter.drawText(rect(), Qt::AlignCenter, "No trajectory");
+    return;
+  }
+
+  // The samples under every pixel column, shared by all lanes and joints
+  column_samples_.resize(static_cast<std::size_t>(plot.width()) + 1);
+  for (std::size_t x = 0; x < column_samples_.size(); ++x)
+    column_samples_[x] = data_->findSample(toTime(plot.left() + static_cast<double>(x)));
+
+  const int lane_height = plot.height() / static_cast<int>(channels.size());
+  for (std::size_t i = 0; i < channels.size(); ++i)
+  {
+    const QRect lane(plot.left(), plot.top() + (static_cast<int>(i) * lane_height), plot.width(), lane_height);
+    drawLane(painter, lane, channels[i]);
+  }
+
+  // Legend
+  const std::vector<std::string>& joint_names = data_->getJointNames();
+  int x = plot.left();
+  for (std::size_t j = 0; j < joint_names.size(); ++j)
+  {
+    const QString name = QString::fromStdString(joint_names[j]);
+    painter.setPen(getJointColor(j, joint_names.size()));
+    painter.drawText(QRect(x, 0, plot.right() - x, TOP_MARGIN), Qt::AlignLeft | Qt::AlignVCenter, name);
+    x += fontMetrics().horizontalAdvance(name) + 12;
+  }
+
+  // Time axis
+  painter.setPen(palette().color(QPalette::Text));
+  const QRect axis(plot.left(), plot.bottom(), plot.width(), BOTTOM_MARGIN);
+  painter.drawText(axis, Qt::AlignLeft | Qt::AlignVCenter, QString("%1 s").arg(view_start_, 0, 'f', 3));
+  painter.drawText(axis, Qt::AlignRight | Qt::AlignVCenter, QString("%1 s").arg(view_end_, 0, 'f', 3));
+
+  // Cursor
+  const double cursor_x = toX(cursor_time_);
+  if (cursor_x >= plot.left() && cursor_x <= plot.right())
+  {
+    painter.setPen(QColor(220, 40, 40));
+    painter.drawLine(QLineF(cursor_x, plot.top(), cursor_x, plot.bottom()));
+    painter.drawText(axis, Qt::AlignHCenter | Qt::AlignVCenter, QString("%1 s").arg(cursor_time_, 0, 'f', 3));
+  }
+}
+
+void TrajectoryPlotWidget::mousePressEvent(QMouseEvent* event)
+{
+  press_position_ = event->pos();
+  last_mouse_position_ = event->pos();
+  dragging_ = false;
+}
+
+void TrajectoryPlotWidget::mouseMoveEvent(QMouseEvent* event)
+{
+  const QPoint delta = event->pos() - last_mouse_position_;
+  last_mouse_position_ = event->pos();
+  if ((event->buttons() & Qt::LeftButton) == 0U)
+    return;
+
+  if (std::abs(event->pos().x() - press_position_.x()) > DRAG_THRESHOLD)
+    dragging_ = true;
+
+  const QRect plot = getPlotRect();
+  if (!dragging_ || plot.width() <= 0)
+    return;
+
+  const double shift = -static_cast<double>(delta.x()) * (view_end_ - view_start_) / plot.width();
+  setView(view_start_ + shift, view_end_ + shift);
+}
+
+void TrajectoryPlotWidget::mouseReleaseEvent(QMouseEvent* event)
+{
+  const bool clicked = !dragging_ && event->button() == Qt::LeftButton;
+  dragging_ = false;
+  if (!clicked || data_ == nullptr)
+    return;
+
+  const double time = std::clamp(toTime(event->pos().x()), 0.0, data_->getDuration());
+  setCursorTime(time);
+  emit timeSelected(time);
+}
+
+void TrajectoryPlotWidget::mouseDoubleClickEvent(QMouseEvent* /*event*/) { resetView(); }
+
+void TrajectoryPlotWidget::wheelEvent(QWheelEvent* event)
+{
+  const double factor = std::pow(0.999, static_cast<double>(event->angleDelta().y()));
+  const double center = toTime(last_mouse_position_.x());
+  setView(center - ((center - view_start_) * factor), center + ((view_end_ - center) * factor));
+}
+
+QRect TrajectoryPlotWidget::getPlotRect() const
+{
+  return { LEFT_MARGIN,
+           TOP_MARGIN,
+           width() - LEFT_MARGIN - RIGHT_MARGIN,
+           height() - TOP_MARGIN - BOTTOM_MARGIN };
+}
+
+double TrajectoryPlotWidget::toTime(double x) const
+{
+  const QRect plot = getPlotRect();
+  return view_start_ + (((x - plot.left()) / std::max(plot.width(), 1)) * (view_end_ - view_start_));
+}
+
+double TrajectoryPlotWidget::toX(double time) const
+{
+  const QRect plot = getPlotRect();
+  return plot.left() + (((time - view_start_) / (view_end_ - view_start_)) * plot.width());
+}
+
+void TrajectoryPlotWidget::drawLane(QPainter& painter, const QRect& lane, TrajectoryChannel channel)
+{
+  const std::pair<float, float> range = data_->getRange(channel);
+  double min = range.first;
+  double max = range.second;
+  const double padding = (max > min) ? 0.05 * (max - min) : 1.0;
+  min -= padding;
+  max += padding;
+  auto to_y = [&](double value) { return lane.bottom() - (((value - min) / (max - min)) * lane.height()); };
+
+  painter.setPen(palette().color(QPalette::Mid));
+  painter.drawRect(lane);
+  painter.setPen(palette().color(QPalette::Text));
+  painter.drawText(
+      lane.adjusted(4, 2, -4, -2), Qt::AlignLeft | Qt::AlignTop, TrajectoryPlotData::getChannelName(channel));
+  const QRect labels(0, lane.top(), LEFT_MARGIN - 4, lane.height());
+  painter.drawText(labels, Qt::AlignRight | Qt::AlignTop, QString::number(max, 'g', 4));
+  painter.drawText(labels, Qt::AlignRight | Qt::AlignBottom, QString::number(min, 'g', 4));
+
+  painter.save();
+  painter.setClipRect(lane);
+
+  const std::vector<double>& times = data_->getTimes();
+  const std::size_t first = column_samples_.front();
+  const std::size_t last = column_samples_.back();
+  const std::size_t column_count = column_samples_.size() - 1;
+  const std::size_t joint_count = data_->getJointNames().size();
+  for (std::size_t j = 0; j < joint_count; ++j)
+  {
+    const MinMaxPyramid& pyramid = data_->getPyramid(channel, j);
+    painter.setPen(getJointColor(j, joint_count));
+
+    if (last - first <= column_count)
+    {
+      // Few samples are visible, draw them as lines including the samples just outside of the view
+      const std::vector<float>& samples = pyramid.getSamples();
+      const std::size_t end = std::min(last + 1, samples.size());
+      QVector<QPointF> points;
+      for (std::size_t i = (first > 0) ? first - 1 : 0; i < end; ++i)
+      {
+        if (std::isnan(samples[i]))
+        {
+          painter.drawPolyline(points.data(), points.size());
+          points.clear();
+          continue;
+        }
+        points.append(QPointF(toX(times[i]), to_y(samples[i])));
+      }
+      painter.drawPolyline(points.data(), points.size());
+      continue;
+    }
+
+    // One vertical line per pixel column from the minimum to the maximum, extended to meet the previous column
+    QVector<QLineF> lines;
+    lines.reserve(static_cast<int>(column_count));
+    float previous_min = std::nanf("");
+    float previous_max = std::nanf("");
+    for (std::size_t x = 0; x < column_count; ++x)
+    {
+      std::pair<float, float> column = pyramid.getRange(column_samples_[x], column_samples_[x + 1]);
+      if (std::isnan(column.first))
+      {
+        previous_min = previous_max = std::nanf("");
+        continue;
+      }
+
+      const float low = std::fmin(column.first, previous_max);
+      const float high = std::fmax(column.second, previous_min);
+      const double px = lane.left() + static_cast<double>(x) + 0.5;
+      lines.append(QLineF(px, to_y(low), px, to_y(high)));
+      previous_min = column.first;
+      previous_max = column.second;
+    }
+    painter.drawLines(lines);
+  }
+
+  painter.restore();
+}
+
+}  // namespace tesseract_gui
@@ -0,0 +1,214 @@
+/**
+ * @file trajectory_stream.cpp
+ * @brief Builds a trajectory timeline from waypoints arriving incrementally
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <stdexcept>
+#include <string>
+#include <QMetaObject>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/common/instrumentation.h>
+#include <tesseract_gui/joint_trajectory/trajectory_stream.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+void checkWaypoint(const tesseract_common::JointState& waypoint)
+{
+  if (waypoint.position.size() != static_cast<Eigen::Index>(waypoint.joint_names.size()))
+    throw std::runtime_error("TrajectoryStream, waypoint does not have a position for every joint name!");
+}
+}  // namespace
+
+struct TrajectoryStream::Batch
+{
+  std::size_t generation{ 0 };
+  std::vector<tesseract_common::JointState> waypoints;
+
+  /** @brief The states of the waypoints, fewer than waypoints if the kinematics of one failed */
+  std::vector<tesseract_scene_graph::SceneState> states;
+  bool finished{ false };
+
+  /** @brief Why the kinematics failed, empty if they did not */
+  std::string error;
+};
+
+TrajectoryStream::TrajectoryStream(QObject* parent) : QObject(parent) {}
+
+TrajectoryStream::~TrajectoryStream() { stop(); }
+
+TrajectoryTimeline::ConstPtr TrajectoryStream::start(const tesseract_environment::Environment& environment,
+                                                     std::vector<std::string> link_names)
+{
+  tesseract_scene_graph::StateSolver::UPtr solver = environment.getStateSolver();
+  if (solver == nullptr)
+    throw std::runtime_error("TrajectoryStream, environment has no state solver!");
+
+  stop();
+
+  std::size_t generation{ 0 };
+  {
+    std::scoped_lock lock(mutex_);
+    queue_.clear();
+    pending_count_ = 0;
+    finish_requested_ = false;
+    stopping_ = false;
+    failed_ = false;
+    generation = ++generation_;
+  }
+
+  timeline_ = std::make_shared<TrajectoryTimeline>(std::move(link_names));
+  worker_ = std::thread(
+      [this, solver = std::move(solver), generation]() mutable { run(std::move(solver), generation); });
+
+  return timeline_;
+}
+
+TrajectoryTimeline::ConstPtr TrajectoryStream::getTimeline() const { return timeline_; }
+
+void TrajectoryStream::push(tesseract_common::JointState waypoint)
+{
+  checkWaypoint(waypoint);
+  {
+    std::scoped_lock lock(mutex_);
+    if (failed_)
+      return;
+
+    queue_.push_back(std::move(waypoint));
+    ++pending_count_;
+  }
+  condition_.notify_one();
+}
+
+void TrajectoryStream::push(const tesseract_common::JointTrajectory& waypoints)
+{
+  for (const auto& waypoint : waypoints)
+    checkWaypoint(waypoint);
+
+  {
+    std::scoped_lock lock(mutex_);
+    if (failed_)
+      return;
+
+    queue_.insert(queue_.end(), waypoints.begin(), waypoints.end());
+    pending_count_ += waypoints.size();
+  }
+  condition_.notify_one();
+}
+
+void TrajectoryStream::finish()
+{
+  {
+    std::scoped_lock lock(mutex_);
+    finish_requested_ = true;
+  }
+  condition_.notify_one();
+}
+
+std::size_t TrajectoryStream::getPendingCount() const
+{
+  std::scoped_lock lock(mutex_);
+  return pending_count_;
+}
+
+void TrajectoryStream::stop()
+{
+  {
+    std::scoped_lock lock(mutex_);
+    stopping_ = true;
+  }
+  condition_.notify_one();
+
+  if (worker_.joinable())
+    worker_.join();
+}
+
+void TrajectoryStream::run(tesseract_scene_graph::StateSolver::UPtr solver, std::size_t generation)
+{
+  while (true)
+  {
+    auto batch = std::make_shared<Batch>();
+    batch->generation = generation;
+    {
+      std::unique_lock lock(mutex_);
+      condition_.wait(lock, [this]() { return stopping_ || finish_requested_ || !queue_.empty(); });
+      if (stopping_)
+        return;
+
+      // Everything pushed before finish() is in the queue, so the batch taken now is the last one
+      batch->waypoints.swap(queue_);
+      batch->finished = finish_requested_;
+    }
+
+    recordCounter("trajectory", "stream batch size", static_cast<std::int64_t>(batch->waypoints.size()));
+    try
+    {
+      const ScopedTimer timer("trajectory", "stream forward kinematics");
+      batch->states.reserve(batch->waypoints.size());
+      for (const auto& waypoint : batch->waypoints)
+        batch->states.push_back(solver->getState(waypoint.joint_names, waypoint.position));
+    }
+    catch (const std::exception& e)
+    {
+      batch->error = e.what();
+    }
+
+    // Waypoints queued after a failed one are dropped, the stream ends with the failed batch
+    if (!batch->error.empty())
+    {
+      std::scoped_lock lock(mutex_);
+      failed_ = true;
+      pending_count_ -= queue_.size();
+      queue_.clear();
+    }
+
+    QMetaObject::invokeMethod(this, [this, batch]() { appendBatch(batch); }, Qt::QueuedConnection);
+
+    if (batch->finished || !batch->error.empty())
+      return;
+  }
+}
+
+void TrajectoryStream::appendBatch(const std::shared_ptr<Batch>& batch)
+{
+  if (batch->generation != generation_)
+    return;
+
+  for (std::size_t i = 0; i < batch->states.size(); ++i)
+    timeline_->append(batch->waypoints[i], batch->states[i]);
+
+  {
+    std::scoped_lock lock(mutex_);
+    pending_count_ -= batch->waypoints.size();
+  }
+
+  if (!batch->states.empty())
+    emit waypointsAppended(timeline_->getWaypointCount());
+
+  if (!batch->error.empty())
+  {
+    emit streamFailed(QString::fromStdString(batch->error));
+    return;
+  }
+
+  if (batch->finished)
+    emit finished();
+}
+
+}  // namespace tesseract_gui
@@ -0,0 +1,427 @@
+/**
+ * @file trajectory_timeline.cpp
+ * @brief Precomputed link transforms of every waypoint of a joint trajectory
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <Eigen/Geometry>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/joint_trajectory/trajectory_file.h>
+#include <tesseract_gui/joint_trajectory/trajectory_timeline.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+/** @brief Split waypoints into one contiguous range per thread and rethrow the first error of a thread */
+void runParallel(std::size_t waypoint_count,
+                 std::size_t thread_count,
+                 const std::function<void(std::size_t, std::size_t)>& function)
+{
+  if (thread_count == 0)
+    thread_count = std::max(1U, std::thread::hardware_concurrency());
+  thread_count = std::min(thread_count, waypoint_count);
+
+  const std::size_t range_size = (waypoint_count + thread_count - 1) / thread_count;
+  std::vector<std::thread> threads;
+  std::vector<std::exception_ptr> errors(thread_count);
+  threads.reserve(thread_count);
+  for (std::size_t t = 0; t < thread_count; ++t)
+  {
+    const std::size_t begin = t * range_size;
+    const std::size_t end = std::min(begin + range_size, waypoint_count);
+    threads.emplace_back([&function, &errors, t, begin, end]() {
+      try
+      {
+        function(begin, end);
+      }
+      catch (...)
+      {
+        errors[t] = std::current_exception();
+      }
+    });
+  }
+
+  for (auto& thread : threads)
+    thread.join();
+
+  for (const auto& error : errors)
+  {
+    if (error)
+      std::rethrow_exception(error);
+  }
+}
+}  // namespace
+
+TrajectoryTimeline::TrajectoryTimeline(std::vector<std::string> link_names) : link_names_(std::move(link_names)) {}
+
+TrajectoryTimeline::TrajectoryTimeline(const tesseract_environment::Environment& environment,
+                                       const tesseract_common::JointTrajectory& trajectory,
+                                       std::vector<std::string> link_names,
+                                       std::size_t thread_count)
+  : link_names_(std::move(link_names))
+{
+  if (trajectory.empty())
+    throw std::runtime_error("TrajectoryTimeline, trajectory is empty!");
+
+  const std::size_t waypoint_count = trajectory.size();
+  setJointNames(trajectory.front().joint_names);
+  reserveWaypoints(waypoint_count);
+
+  // Times and joint positions depend on the previous waypoint and are cheap, fill them first
+  for (std::size_t w = 0; w < waypoint_count; ++w)
+  {
+    chunks_[w / CHUNK_SIZE]->times[w % CHUNK_SIZE] = timing_.getNextTime(trajectory[w].time);
+    setJointPositions(w, trajectory[w]);
+    ++waypoint_count_;
+  }
+
+  // Link transforms, forward kinematics is split into one contiguous range of waypoints per thread
+  runParallel(waypoint_count, thread_count, [this, &environment, &trajectory](std::size_t begin, std::size_t end) {
+    computeTransforms(environment, trajectory, begin, end);
+  });
+}
+
+TrajectoryTimeline::TrajectoryTimeline(const tesseract_environment::Environment& environment,
+                                       const TrajectoryFile& file,
+                                       std::vector<std::string> link_names,
+                                       std::size_t thread_count)
+  : link_names_(std::move(link_names))
+{
+  const float* positions = file.getChannel(TrajectoryChannel::POSITION);
+  if (positions == nullptr)
+    throw std::runtime_error("TrajectoryTimeline, trajectory file has no joint positions!");
+
+  // The file is already timed like a timeline, its columns are copied per chunk
+  const std::size_t waypoint_count = file.getWaypointCount();
+  setJointNames(file.getJointNames());
+  reserveWaypoints(waypoint_count);
+  timing_ = TrajectoryTiming(file.getStartTime(), file.getDuration());
+  for (std::size_t begin = 0; begin < waypoint_count; begin += CHUNK_SIZE)
+  {
+    Chunk& chunk = *chunks_[begin / CHUNK_SIZE];
+    const std::size_t count = std::min(CHUNK_SIZE, waypoint_count - begin);
+    std::copy_n(file.getTimes() + begin, count, chunk.times.data());
+    for (std::size_t j = 0; j < joint_names_.size(); ++j)
+      std::copy_n(positions + (j * waypoint_count) + begin, count, chunk.joint_positions.data() + (j * CHUNK_SIZE));
+  }
+  waypoint_count_ = waypoint_count;
+
+  runParallel(waypoint_count, thread_count, [this, &environment, &file](std::size_t begin, std::size_t end) {
+    computeTransforms(environment, file, begin, end);
+  });
+}
+
+TrajectoryTimeline::TrajectoryTimeline(std::shared_ptr<const TrajectoryFile> file) : file_(std::move(file))
+{
+  if (!file_->hasLinkTransforms())
+    throw std::runtime_error("TrajectoryTimeline, trajectory file has no link transforms!");
+
+  const float* positions = file_->getChannel(TrajectoryChannel::POSITION);
+  if (positions == nullptr)
+    throw std::runtime_error("TrajectoryTimeline, trajectory file has no joint positions!");
+
+  link_names_ = file_->getLinkNames();
+  setJointNames(file_->getJointNames());
+  waypoint_count_ = file_->getWaypointCount();
+  timing_ = TrajectoryTiming(file_->getStartTime(), file_->getDuration());
+
+  // Only pointers are set up, no waypoint is read until it is played
+  const std::size_t link_count = link_names_.size();
+  chunks_.reserve((waypoint_count_ + CHUNK_SIZE - 1) / CHUNK_SIZE);
+  for (std::size_t begin = 0; begin < waypoint_count_; begin += CHUNK_SIZE)
+  {
+    auto chunk = std::make_unique<Chunk>();
+    chunk->time_data = file_->getTimes() + begin;
+    for (std::size_t c = 0; c < TRANSFORM_SIZE; ++c)
+      chunk->transform_data[c] = file_->getLinkTransforms(c) + (begin * link_count);
+    chunk->joint_position_data = positions + begin;
+    chunk->joint_stride = waypoint_count_;
+    chunks_.push_back(std::move(chunk));
+  }
+}
+
+void TrajectoryTimeline::append(const tesseract_common::JointState& waypoint,
+                                const tesseract_scene_graph::SceneState& state)
+{
+  if (file_ != nullptr)
+    throw std::runtime_error("TrajectoryTimeline, a timeline of a trajectory file can not be appended to!");
+
+  if (waypoint_count_ == 0 && joint_names_.empty())
+    setJointNames(waypoint.joint_names);
+
+  reserveWaypoints(1);
+  const std::size_t w = waypoint_count_;
+  chunks_[w / CHUNK_SIZE]->times[w % CHUNK_SIZE] = timing_.getNextTime(waypoint.time);
+  setJointPositions(w, waypoint);
+  setTransforms(w, state.link_transforms);
+  ++waypoint_count_;
+}
+
+void TrajectoryTimeline::setJointNames(const std::vector<std::string>& joint_names)
+{
+  joint_names_ = joint_names;
+  joint_index_.clear();
+  for (std::size_t j = 0; j < joint_names_.size(); ++j)
+    joint_index_[joint_names_[j]] = j;
+}
+
+void TrajectoryTimeline::reserveWaypoints(std::size_t count)
+{
+  while (chunks_.size() * CHUNK_SIZE < waypoint_count_ + count)
+  {
+    auto chunk = std::make_unique<Chunk>();
+    chunk->times.resize(CHUNK_SIZE);
+    for (auto& component : chunk->transforms)
+      component.resize(CHUNK_SIZE * link_names_.size());
+    chunk->joint_positions.assign(CHUNK_SIZE * joint_names_.size(), std::numeric_limits<float>::quiet_NaN());
+
+    // The vectors are never resized, the pointers stay valid
+    chunk->time_data = chunk->times.data();
+    for (std::size_t c = 0; c < TRANSFORM_SIZE; ++c)
+      chunk->transform_data[c] = chunk->transforms[c].data();
+    chunk->joint_position_data = chunk->joint_positions.data();
+    chunks_.push_back(std::move(chunk));
+  }
+}
+
+void TrajectoryTimeline::setJointPositions(std::size_t waypoint, const tesseract_common::JointState& state)
+{
+  Chunk& chunk = *chunks_[waypoint / CHUNK_SIZE];
+  const std::size_t offset = waypoint % CHUNK_SIZE;
+  const bool same_joints = (state.joint_names == joint_names_);
+  for (std::size_t i = 0; i < state.joint_names.size() && static_cast<Eigen::Index>(i) < state.position.size(); ++i)
+  {
+    std::size_t j = i;
+    if (!same_joints)
+    {
+      auto it = joint_index_.find(state.joint_names[i]);
+      if (it == joint_index_.end())
+        continue;
+      j = it->second;
+    }
+    chunk.joint_positions[(j * CHUNK_SIZE) + offset] = static_cast<float>(state.position[static_cast<Eigen::Index>(i)]);
+  }
+}
+
+void TrajectoryTimeline::setTransforms(std::size_t waypoint, const tesseract_common::TransformMap& link_transforms)
+{
+  Chunk& chunk = *chunks_[waypoint / CHUNK_SIZE];
+  const std::size_t link_count = link_names_.size();
+  const std::size_t base = (waypoint % CHUNK_SIZE) * link_count;
+  for (std::size_t l = 0; l < link_count; ++l)
+  {
+    const std::size_t index = base + l;
+    auto it = link_transforms.find(link_names_[l]);
+    if (it == link_transforms.end())
+    {
+      for (std::size_t c = 0; c < TRANSFORM_SIZE; ++c)
+        chunk.transforms[c][index] = (c == TRANSFORM_SIZE - 1) ? 1.0F : 0.0F;
+      continue;
+    }
+
+    const Eigen::Vector3d& translation = it->second.translation();
+    const Eigen::Quaterniond rotation(it->second.linear());
+    chunk.transforms[0][index] = static_cast<float>(translation.x());
+    chunk.transforms[1][index] = static_cast<float>(translation.y());
+    chunk.transforms[2][index] = static_cast<float>(translation.z());
+    chunk.transforms[3][index] = static_cast<float>(rotation.x());
+    chunk.transforms[4][index] = static_cast<float>(rotation.y());
+    chunk.transforms[5][index] = static_cast<float>(rotation.z());
+    chunk.transforms[6][index] = static_cast<float>(rotation.w());
+  }
+}
+
+void TrajectoryTimeline::computeTransforms(const tesseract_environment::Environment& environment,
+                                           const tesseract_common::JointTrajectory& trajectory,
+                                           std::size_t begin,
+                                           std::size_t end)
+{
+  // State solvers are not thread safe, every thread works on its own clone
+  tesseract_scene_graph::StateSolver::UPtr solver = environment.getStateSolver();
+  if (solver == nullptr)
+    throw std::runtime_error("TrajectoryTimeline, environment has no state solver!");
+
+  for (std::size_t w = begin; w < end; ++w)
+  {
+    const tesseract_common::JointState& waypoint = trajectory[w];
+    setTransforms(w, solver->getState(waypoint.joint_names, waypoint.position).link_transforms);
+  }
+}
+
+void TrajectoryTimeline::computeTransforms(const tesseract_environment::Environment& environment,
+                                           const TrajectoryFile& file,
+                                           std::size_t begin,
+                                           std::size_t end)
+{
+  tesseract_scene_graph::StateSolver::UPtr solver = environment.getStateSolver();
+  if (solver == nullptr)
+    throw std::runtime_error("TrajectoryTimeline, environment has no state solver!");
+
+  // Positions are read straight from the columns, joints without a position are left out of the waypoint
+  const std::vector<std::string>& joint_names = file.getJointNames();
+  Eigen::VectorXd positions(static_cast<Eigen::Index>(joint_names.size()));
+  std::vector<std::string> partial_joint_names;
+  for (std::size_t w = begin; w < end; ++w)
+  {
+    Eigen::Index count{ 0 };
+    for (std::size_t j = 0; j < joint_names.size(); ++j)
+    {
+      const float position = file.getValue(TrajectoryChannel::POSITION, j, w);
+      if (!std::isnan(position))
+        positions[count++] = static_cast<double>(position);
+    }
+
+    if (count == positions.size())
+    {
+      setTransforms(w, solver->getState(joint_names, positions).link_transforms);
+      continue;
+    }
+
+    partial_joint_names.clear();
+    for (std::size_t j = 0; j < joint_names.size(); ++j)
+    {
+      if (!std::isnan(file.getValue(TrajectoryChannel::POSITION, j, w)))
+        partial_joint_names.push_back(joint_names[j]);
+    }
+    setTransforms(w, solver->getState(partial_joint_names, positions.head(count)).link_transforms);
+  }
+}
+
+const std::vector<std::string>& TrajectoryTimeline::getLinkNames() const { return link_names_; }
+
+const std::vector<std::string>& TrajectoryTimeline::getJointNames() const { return joint_names_; }
+
+std::size_t TrajectoryTimeline::getWaypointCount() const { return waypoint_count_; }
+
+double TrajectoryTimeline::getTime(std::size_t waypoint) const
+{
+  return chunks_[waypoint / CHUNK_SIZE]->time_data[waypoint % CHUNK_SIZE];
+}
+
+double TrajectoryTimeline::getDuration() const { return (waypoint_count_ > 0) ? getTime(waypoint_count_ - 1) : 0.0; }
+
+std::pair<std::size_t, float> TrajectoryTimeline::locate(double time) const
+{
+  if (waypoint_count_ <= 1 || time <= 0)
+    return { 0, 0.0F };
+
+  if (time >= getDuration())
+    return { waypoint_count_ - 1, 0.0F };
+
+  // Find the first waypoint after the time
+  std::size_t low = 0;
+  std::size_t high = waypoint_count_;
+  while (low < high)
+  {
+    const std::size_t mid = low + ((high - low) / 2);
+    if (getTime(mid) <= time)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+
+  const std::size_t previous = low - 1;
+  const double t0 = getTime(previous);
+  const double interval = getTime(low) - t0;
+  if (interval <= 0)
+    return { previous, 0.0F };
+
+  return { previous, static_cast<float>((time - t0) / interval) };
+}
+
+void TrajectoryTimeline::interpolateLinkTransforms(double time, float* data) const
+{
+  if (waypoint_count_ == 0)
+    return;
+
+  const auto [w, t] = locate(time);
+  const std::size_t next = (t > 0.0F) ? w + 1 : w;
+  const Chunk& chunk_a = *chunks_[w / CHUNK_SIZE];
+  const Chunk& chunk_b = *chunks_[next / CHUNK_SIZE];
+  const std::size_t link_count = link_names_.size();
+  const std::size_t a = (w % CHUNK_SIZE) * link_count;
+  const std::size_t b = (next % CHUNK_SIZE) * link_count;
+
+  const auto& ta = chunk_a.transform_data;
+  const auto& tb = chunk_b.transform_data;
+  for (std::size_t l = 0; l < link_count; ++l)
+  {
+    const Eigen::Vector3f p0(ta[0][a + l], ta[1][a + l], ta[2][a + l]);
+    const Eigen::Vector3f p1(tb[0][b + l], tb[1][b + l], tb[2][b + l]);
+    const Eigen::Vector4f q0(ta[3][a + l], ta[4][a + l], ta[5][a + l], ta[6][a + l]);
+    Eigen::Vector4f q1(tb[3][b + l], tb[4][b + l], tb[5][b + l], tb[6][b + l]);
+
+    // q and -q are the same rotation, interpolate along the shorter arc
+    if (q0.dot(q1) < 0)
+      q1 = -q1;
+
+    const Eigen::Vector4f q = (q0 + (t * (q1 - q0))).normalized();
+    Eigen::Map<Eigen::Matrix4f> matrix(data + (l * MATRIX_SIZE));
+    matrix.setIdentity();
+    matrix.topLeftCorner<3, 3>() = Eigen::Quaternionf(q.w(), q.x(), q.y(), q.z()).toRotationMatrix();
+    matrix.topRightCorner<3, 1>() = p0 + (t * (p1 - p0));
+  }
+}
+
+void TrajectoryTimeline::interpolateJointPositions(double time, Eigen::VectorXd& positions) const
+{
+  positions.setConstant(static_cast<Eigen::Index>(joint_names_.size()), std::numeric_limits<double>::quiet_NaN());
+  if (waypoint_count_ == 0)
+    return;
+
+  const auto [w, t] = locate(time);
+  const std::size_t next = (t > 0.0F) ? w + 1 : w;
+  for (std::size_t j = 0; j < joint_names_.size(); ++j)
+  {
+    const float p0 = getJointPosition(j, w);
+    const float p1 = getJointPosition(j, next);
+    positions[static_cast<Eigen::Index>(j)] = static_cast<double>(p0 + (t * (p1 - p0)));
+  }
+}
+
+float TrajectoryTimeline::getJointPosition(std::size_t joint_index, std::size_t waypoint) const
+{
+  const Chunk& chunk = *chunks_[waypoint / CHUNK_SIZE];
+  return chunk.joint_position_data[(joint_index * chunk.joint_stride) + (waypoint % CHUNK_SIZE)];
+}
+
+const float* TrajectoryTimeline::getLinkTransformComponent(std::size_t component, std::size_t waypoint) const
+{
+  return chunks_[waypoint / CHUNK_SIZE]->transform_data[component] + ((waypoint % CHUNK_SIZE) * link_names_.size());
+}
+
+std::size_t TrajectoryTimeline::getByteSize() const
+{
+  std::size_t bytes = 0;
+  for (const auto& chunk : chunks_)
+  {
+    bytes += (chunk->times.capacity() * sizeof(double)) + (chunk->joint_positions.capacity() * sizeof(float));
+    for (const auto& component : chunk->transforms)
+      bytes += component.capacity() * sizeof(float);
+  }
+  return bytes;
+}
+
+}  // namespace tesseract_gui
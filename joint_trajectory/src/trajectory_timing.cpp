@@ -0,0 +1,51 @@
+/**
+ * @file trajectory_timing.cpp
+ * @brief The timing rule shared by trajectory playback, plots and files
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/joint_trajectory/trajectory_timing.h>
+
+namespace tesseract_gui
+{
+TrajectoryTiming::TrajectoryTiming(double start_time, double last_time)
+  : start_time_(start_time), last_time_(last_time), started_(true), timed_(last_time > 0)
+{
+}
+
+double TrajectoryTiming::getNextTime(double waypoint_time)
+{
+  if (!started_)
+  {
+    start_time_ = waypoint_time;
+    started_ = true;
+    return 0;
+  }
+
+  const double time = waypoint_time - start_time_;
+  if (time > 0)
+    timed_ = true;
+
+  last_time_ = timed_ ? std::max(time, last_time_) : last_time_ + DEFAULT_WAYPOINT_INTERVAL;
+  return last_time_;
+}
+
+double TrajectoryTiming::getStartTime() const { return start_time_; }
+
+}  // namespace tesseract_gui
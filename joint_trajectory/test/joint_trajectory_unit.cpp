@@ -0,0 +1,451 @@
+/**
+ * @file joint_trajectory_unit.cpp
+ * @brief Tests of the trajectory file and plot data
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include <Eigen/Geometry>
+#include <tesseract_common/joint_state.h>
+#include <tesseract_scene_graph/scene_state.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/joint_trajectory/min_max_pyramid.h>
+#include <tesseract_gui/joint_trajectory/trajectory_file.h>
+#include <tesseract_gui/joint_trajectory/trajectory_timeline.h>
+#include <tesseract_gui/joint_trajectory/trajectory_timing.h>
+
+using namespace tesseract_gui;
+
+namespace
+{
+constexpr std::size_t WAYPOINT_COUNT = 37;
+constexpr std::size_t JOINT_COUNT = 3;
+constexpr std::size_t LINK_COUNT = 2;
+
+/** @brief The offset of the times column in the file header */
+constexpr std::size_t TIMES_OFFSET_POSITION = 56;
+
+std::string getTempFile(const std::string& name)
+{
+  return (std::filesystem::temp_directory_path() / ("tesseract_gui_joint_trajectory_unit_" + name)).string();
+}
+
+std::vector<char> readFile(const std::string& path)
+{
+  std::ifstream file(path, std::ios::binary);
+  return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+}
+
+void writeFile(const std::string& path, const std::vector<char>& data)
+{
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
+
+double getPosition(std::size_t joint, std::size_t waypoint)
+{
+  return std::sin(0.1 * static_cast<double>(waypoint) + static_cast<double>(joint));
+}
+
+/** @brief Timed waypoints with positions and velocities, one waypoint has no velocities */
+tesseract_common::JointTrajectory createTrajectory()
+{
+  tesseract_common::JointTrajectory trajectory;
+  for (std::size_t w = 0; w < WAYPOINT_COUNT; ++w)
+  {
+    tesseract_common::JointState waypoint;
+    waypoint.joint_names = { "joint_a", "joint_b", "joint_c" };
+    waypoint.time = 2 + (0.1 * static_cast<double>(w));
+    waypoint.position.resize(static_cast<Eigen::Index>(JOINT_COUNT));
+    for (std::size_t j = 0; j < JOINT_COUNT; ++j)
+      waypoint.position[static_cast<Eigen::Index>(j)] = getPosition(j, w);
+    if (w != 5)
+      waypoint.velocity = Eigen::VectorXd::Constant(static_cast<Eigen::Index>(JOINT_COUNT), static_cast<double>(w));
+    trajectory.push_back(waypoint);
+  }
+  return trajectory;
+}
+
+/** @brief The link transforms of the trajectory, link l is translated by (waypoint, l, 0) */
+TrajectoryTimeline createTimeline(const tesseract_common::JointTrajectory& trajectory)
+{
+  TrajectoryTimeline timeline({ "link_a", "link_b" });
+  tesseract_scene_graph::SceneState state;
+  for (std::size_t w = 0; w < trajectory.size(); ++w)
+  {
+    state.link_transforms["link_a"] = Eigen::Isometry3d(Eigen::Translation3d(static_cast<double>(w), 0, 0));
+    state.link_transforms["link_b"] = Eigen::Isometry3d(Eigen::Translation3d(static_cast<double>(w), 1, 0));
+    timeline.append(trajectory[w], state);
+  }
+  return timeline;
+}
+
+/** @brief A waypoint of one joint at a time */
+tesseract_common::JointState createWaypoint(double time, double position)
+{
+  tesseract_common::JointState waypoint;
+  waypoint.joint_names = { "joint_a" };
+  waypoint.position = Eigen::VectorXd::Constant(1, position);
+  waypoint.time = time;
+  return waypoint;
+}
+
+/** @brief A scene state with the transform of link_a */
+tesseract_scene_graph::SceneState createState(const Eigen::Isometry3d& transform)
+{
+  tesseract_scene_graph::SceneState state;
+  state.link_transforms["link_a"] = transform;
+  return state;
+}
+
+/** @brief The transform of a link written by TrajectoryTimeline::interpolateLinkTransforms() */
+Eigen::Isometry3d getTransform(const std::vector<float>& data, std::size_t link)
+{
+  const Eigen::Map<const Eigen::Matrix4f> matrix(data.data() + (link * TrajectoryTimeline::MATRIX_SIZE));
+  return Eigen::Isometry3d(matrix.cast<double>());
+}
+
+/** @brief Overwrite a value of a file at an offset */
+template <typename T>
+void patchFile(const std::string& path, const std::vector<char>& data, std::size_t offset, T value)
+{
+  std::vector<char> patched = data;
+  std::memcpy(patched.data() + offset, &value, sizeof(value));
+  writeFile(path, patched);
+}
+
+std::pair<float, float> getBruteForceRange(const std::vector<float>& samples, std::size_t begin, std::size_t end)
+{
+  float min = std::numeric_limits<float>::infinity();
+  float max = -std::numeric_limits<float>::infinity();
+  for (std::size_t i = begin; i < end; ++i)
+  {
+    if (std::isnan(samples[i]))
+      continue;
+    min = std::min(min, samples[i]);
+    max = std::max(max, samples[i]);
+  }
+
+  if (min > max)
+    return { std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::quiet_NaN() };
+  return { min, max };
+}
+
+void expectSameRange(const std::pair<float, float>& range, const std::pair<float, float>& expected)
+{
+  if (std::isnan(expected.first))
+  {
+    EXPECT_TRUE(std::isnan(range.first));
+    EXPECT_TRUE(std::isnan(range.second));
+    return;
+  }
+  EXPECT_EQ(range.first, expected.first);
+  EXPECT_EQ(range.second, expected.second);
+}
+}  // namespace
+
+TEST(TesseractGuiJointTrajectoryUnit, MinMaxPyramidMatchesBruteForce)  // NOLINT
+{
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<float> distribution(-10, 10);
+  std::uniform_int_distribution<int> missing(0, 9);
+
+  // Odd sizes leave an incomplete block at the end of every level
+  for (const std::size_t size : { 1U, 3U, 7U, 13U, 33U, 101U, 1023U, 1025U })
+  {
+    std::vector<float> samples(size);
+    for (float& sample : samples)
+      sample = (missing(generator) == 0) ? std::numeric_limits<float>::quiet_NaN() : distribution(generator);
+
+    const MinMaxPyramid pyramid(samples);
+    ASSERT_EQ(pyramid.size(), size);
+    expectSameRange(pyramid.getRange(), getBruteForceRange(samples, 0, size));
+
+    if (size <= 101)
+    {
+      for (std::size_t begin = 0; begin <= size; ++begin)
+      {
+        for (std::size_t end = begin; end <= size; ++end)
+          expectSameRange(pyramid.getRange(begin, end), getBruteForceRange(samples, begin, end));
+      }
+    }
+    else
+    {
+      std::uniform_int_distribution<std::size_t> index(0, size);
+      for (int i = 0; i < 2000; ++i)
+      {
+        std::size_t begin = index(generator);
+        std::size_t end = index(generator);
+        if (begin > end)
+          std::swap(begin, end);
+        expectSameRange(pyramid.getRange(begin, end), getBruteForceRange(samples, begin, end));
+      }
+    }
+  }
+}
+
+TEST(TesseractGuiJointTrajectoryUnit, MinMaxPyramidMissingValues)  // NOLINT
+{
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const MinMaxPyramid pyramid({ nan, nan, nan, 4, nan, -2, nan });
+  expectSameRange(pyramid.getRange(0, 3), { nan, nan });
+  expectSameRange(pyramid.getRange(2, 2), { nan, nan });
+  expectSameRange(pyramid.getRange(), { -2, 4 });
+  expectSameRange(MinMaxPyramid().getRange(), { nan, nan });
+}
+
+TEST(TesseractGuiJointTrajectoryUnit, TrajectoryTiming)  // NOLINT
+{
+  // Without timing the waypoints are spread out, once timed the times are kept but never decrease
+  TrajectoryTiming timing;
+  EXPECT_DOUBLE_EQ(timing.getNextTime(5), 0);
+  EXPECT_DOUBLE_EQ(timing.getStartTime(), 5);
+  EXPECT_DOUBLE_EQ(timing.getNextTime(5), TrajectoryTiming::DEFAULT_WAYPOINT_INTERVAL);
+  EXPECT_DOUBLE_EQ(timing.getNextTime(5), 2 * TrajectoryTiming::DEFAULT_WAYPOINT_INTERVAL);
+  EXPECT_DOUBLE_EQ(timing.getNextTime(6), 1);
+  EXPECT_DOUBLE_EQ(timing.getNextTime(5.5), 1);
+  EXPECT_DOUBLE_EQ(timing.getNextTime(5), 1);
+  EXPECT_DOUBLE_EQ(timing.getNextTime(7), 2);
+
+  // A timed trajectory stays timed when it is continued
+  TrajectoryTiming timed(10, 2);
+  EXPECT_DOUBLE_EQ(timed.getNextTime(11), 2);
+  EXPECT_DOUBLE_EQ(timed.getNextTime(13), 3);
+
+  TrajectoryTiming untimed(10, 0);
+  EXPECT_DOUBLE_EQ(untimed.getNextTime(10), TrajectoryTiming::DEFAULT_WAYPOINT_INTERVAL);
+}
+
+TEST(TesseractGuiJointTrajectoryUnit, TrajectoryTimelineLocate)  // NOLINT
+{
+  TrajectoryTimeline timeline({ "link_a" });
+  EXPECT_EQ(timeline.locate(1), std::make_pair(std::size_t{ 0 }, 0.0F));
+
+  const tesseract_scene_graph::SceneState state = createState(Eigen::Isometry3d::Identity());
+  for (const double time : { 1.0, 2.0, 2.0, 4.0 })
+    timeline.append(createWaypoint(time, 0), state);
+  ASSERT_EQ(timeline.getWaypointCount(), 4U);
+  EXPECT_DOUBLE_EQ(timeline.getDuration(), 3);
+
+  // Clamped to the first and last waypoint
+  EXPECT_EQ(timeline.locate(-1), std::make_pair(std::size_t{ 0 }, 0.0F));
+  EXPECT_EQ(timeline.locate(10), std::make_pair(std::size_t{ 3 }, 0.0F));
+
+  auto [waypoint, factor] = timeline.locate(0.25);
+  EXPECT_EQ(waypoint, 0U);
+  EXPECT_FLOAT_EQ(factor, 0.25F);
+
+  // Waypoints with equal times are passed without interpolating between them
+  std::tie(waypoint, factor) = timeline.locate(1);
+  EXPECT_EQ(waypoint, 2U);
+  EXPECT_FLOAT_EQ(factor, 0);
+
+  std::tie(waypoint, factor) = timeline.locate(2.5);
+  EXPECT_EQ(waypoint, 2U);
+  EXPECT_FLOAT_EQ(factor, 0.75F);
+}
+
+TEST(TesseractGuiJointTrajectoryUnit, TrajectoryTimelineInterpolation)  // NOLINT
+{
+  // Rotations of 100 and -100 degrees about z are stored with quaternions on opposite hemispheres, the shorter arc
+  // between them passes 180 degrees and not the identity
+  TrajectoryTimeline timeline({ "link_a", "link_missing" });
+  const double angle = 100 * M_PI / 180;
+  timeline.append(createWaypoint(0, 0),
+                  createState(Eigen::Translation3d(0, 0, 0) * Eigen::AngleAxisd(angle, Eigen::Vector3d::UnitZ())));
+  timeline.append(createWaypoint(1, 1),
+                  createState(Eigen::Translation3d(2, 4, 0) * Eigen::AngleAxisd(-angle, Eigen::Vector3d::UnitZ())));
+
+  std::vector<float> data(2 * TrajectoryTimeline::MATRIX_SIZE);
+  timeline.interpolateLinkTransforms(0.5, data.data());
+  const Eigen::Isometry3d transform = getTransform(data, 0);
+  EXPECT_TRUE(transform.translation().isApprox(Eigen::Vector3d(1, 2, 0), 1e-6));
+  EXPECT_TRUE(transform.linear().isApprox(Eigen::AngleAxisd(M_PI, Eigen::Vector3d::UnitZ()).toRotationMatrix(), 1e-5));
+
+  // Links missing from the scene state are at the identity
+  EXPECT_TRUE(getTransform(data, 1).isApprox(Eigen::Isometry3d::Identity()));
+
+  Eigen::VectorXd positions;
+  timeline.interpolateJointPositions(0.25, positions);
+  ASSERT_EQ(positions.size(), 1);
+  EXPECT_NEAR(positions[0], 0.25, 1e-6);
+}
+
+TEST(TesseractGuiJointTrajectoryUnit, TrajectoryTimelineChunkBoundary)  // NOLINT
+{
+  // Waypoint w is at time w and x = w, the last waypoint of the first chunk is interpolated towards the first of the
+  // second chunk
+  TrajectoryTimeline timeline({ "link_a" });
+  const std::size_t waypoint_count = TrajectoryTimeline::CHUNK_SIZE + 2;
+  for (std::size_t w = 0; w < waypoint_count; ++w)
+  {
+    const auto value = static_cast<double>(w);
+    timeline.append(createWaypoint(value, value), createState(Eigen::Isometry3d(Eigen::Translation3d(value, 0, 0))));
+  }
+  ASSERT_EQ(timeline.getWaypointCount(), waypoint_count);
+
+  const double time = static_cast<double>(TrajectoryTimeline::CHUNK_SIZE) - 0.5;
+  auto [waypoint, factor] = timeline.locate(time);
+  EXPECT_EQ(waypoint, TrajectoryTimeline::CHUNK_SIZE - 1);
+  EXPECT_FLOAT_EQ(factor, 0.5F);
+
+  std::vector<float> data(TrajectoryTimeline::MATRIX_SIZE);
+  timeline.interpolateLinkTransforms(time, data.data());
+  EXPECT_NEAR(getTransform(data, 0).translation().x(), time, 1e-3);
+
+  Eigen::VectorXd positions;
+  timeline.interpolateJointPositions(time, positions);
+  EXPECT_NEAR(positions[0], time, 1e-3);
+
+  // Exactly on the first waypoint of the second chunk and at the end
+  timeline.interpolateLinkTransforms(static_cast<double>(TrajectoryTimeline::CHUNK_SIZE), data.data());
+  EXPECT_NEAR(getTransform(data, 0).translation().x(), static_cast<double>(TrajectoryTimeline::CHUNK_SIZE), 1e-3);
+  timeline.interpolateLinkTransforms(1e9, data.data());
+  EXPECT_NEAR(getTransform(data, 0).translation().x(), static_cast<double>(waypoint_count - 1), 1e-3);
+  EXPECT_FLOAT_EQ(timeline.getJointPosition(0, TrajectoryTimeline::CHUNK_SIZE),
+                  static_cast<float>(TrajectoryTimeline::CHUNK_SIZE));
+}
+
+TEST(TesseractGuiJointTrajectoryUnit, TrajectoryFileRoundTrip)  // NOLINT
+{
+  const std::string path = getTempFile("round_trip.traj");
+  const tesseract_common::JointTrajectory trajectory = createTrajectory();
+  const TrajectoryTimeline timeline = createTimeline(trajectory);
+  TrajectoryFile::write(path, trajectory, &timeline);
+
+  {
+    const TrajectoryFile file(path);
+    ASSERT_EQ(file.getWaypointCount(), WAYPOINT_COUNT);
+    EXPECT_EQ(file.getJointNames(), trajectory.front().joint_names);
+    EXPECT_DOUBLE_EQ(file.getStartTime(), 2);
+    EXPECT_NEAR(file.getDuration(), 0.1 * static_cast<double>(WAYPOINT_COUNT - 1), 1e-9);
+
+    EXPECT_TRUE(file.hasChannel(TrajectoryChannel::POSITION));
+    EXPECT_TRUE(file.hasChannel(TrajectoryChannel::VELOCITY));
+    EXPECT_FALSE(file.hasChannel(TrajectoryChannel::ACCELERATION));
+    EXPECT_FALSE(file.hasChannel(TrajectoryChannel::EFFORT));
+    EXPECT_EQ(file.getChannel(TrajectoryChannel::EFFORT), nullptr);
+
+    for (std::size_t w = 0; w < WAYPOINT_COUNT; ++w)
+    {
+      EXPECT_NEAR(file.getTimes()[w], 0.1 * static_cast<double>(w), 1e-9);
+      for (std::size_t j = 0; j < JOINT_COUNT; ++j)
+      {
+        EXPECT_FLOAT_EQ(file.getValue(TrajectoryChannel::POSITION, j, w), static_cast<float>(getPosition(j, w)));
+        const float velocity = file.getValue(TrajectoryChannel::VELOCITY, j, w);
+        if (w == 5)
+          EXPECT_TRUE(std::isnan(velocity));
+        else
+          EXPECT_FLOAT_EQ(velocity, static_cast<float>(w));
+      }
+    }
+
+    ASSERT_TRUE(file.hasLinkTransforms());
+    EXPECT_EQ(file.getLinkNames(), std::vector<std::string>({ "link_a", "link_b" }));
+    for (std::size_t w = 0; w < WAYPOINT_COUNT; ++w)
+    {
+      for (std::size_t l = 0; l < LINK_COUNT; ++l)
+      {
+        const std::size_t index = (w * LINK_COUNT) + l;
+        EXPECT_FLOAT_EQ(file.getLinkTransforms(0)[index], static_cast<float>(w));
+        EXPECT_FLOAT_EQ(file.getLinkTransforms(1)[index], static_cast<float>(l));
+        EXPECT_FLOAT_EQ(file.getLinkTransforms(2)[index], 0);
+        EXPECT_FLOAT_EQ(file.getLinkTransforms(6)[index], 1);
+      }
+    }
+  }
+
+  // Without link transforms
+  TrajectoryFile::write(path, trajectory);
+  {
+    const TrajectoryFile file(path);
+    EXPECT_EQ(file.getWaypointCount(), WAYPOINT_COUNT);
+    EXPECT_FALSE(file.hasLinkTransforms());
+    EXPECT_TRUE(file.getLinkNames().empty());
+  }
+
+  std::filesystem::remove(path);
+}
+
+TEST(TesseractGuiJointTrajectoryUnit, TrajectoryFileInvalidFiles)  // NOLINT
+{
+  const std::string path = getTempFile("invalid.traj");
+  EXPECT_THROW(TrajectoryFile(getTempFile("missing.traj")), std::runtime_error);  // NOLINT
+  EXPECT_THROW(TrajectoryFile::write(path, tesseract_common::JointTrajectory()), std::runtime_error);  // NOLINT
+
+  TrajectoryFile::write(path, createTrajectory());
+  const std::vector<char> data = readFile(path);
+  ASSERT_GT(data.size(), 128U);
+
+  // Smaller than the header
+  writeFile(path, std::vector<char>(data.begin(), data.begin() + 32));
+  EXPECT_THROW(TrajectoryFile{ path }, std::runtime_error);  // NOLINT
+
+  // Truncated inside of the last column
+  writeFile(path, std::vector<char>(data.begin(), data.end() - 4));
+  EXPECT_THROW(TrajectoryFile{ path }, std::runtime_error);  // NOLINT
+
+  // Bad magic
+  patchFile(path, data, 0, 'X');
+  EXPECT_THROW(TrajectoryFile{ path }, std::runtime_error);  // NOLINT
+
+  // Unsupported version
+  patchFile(path, data, 8, TrajectoryFile::VERSION + 1);
+  EXPECT_THROW(TrajectoryFile{ path }, std::runtime_error);  // NOLINT
+
+  // Column offsets which are misaligned, inside of the header or past the end of the file
+  for (const std::uint64_t offset : { std::uint64_t{ 65 },
+                                      std::uint64_t{ 0 },
+                                      std::uint64_t{ 8 },
+                                      static_cast<std::uint64_t>(data.size()) * 64,
+                                      std::numeric_limits<std::uint64_t>::max() - 63 })
+  {
+    patchFile(path, data, TIMES_OFFSET_POSITION, offset);
+    EXPECT_THROW(TrajectoryFile{ path }, std::runtime_error) << "offset " << offset;  // NOLINT
+  }
+
+  // A waypoint count whose columns overflow the file
+  patchFile(path, data, 24, std::numeric_limits<std::uint64_t>::max() / 2);
+  EXPECT_THROW(TrajectoryFile{ path }, std::runtime_error);  // NOLINT
+
+  // The unmodified file still opens
+  writeFile(path, data);
+  EXPECT_NO_THROW(TrajectoryFile{ path });  // NOLINT
+
+  std::filesystem::remove(path);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
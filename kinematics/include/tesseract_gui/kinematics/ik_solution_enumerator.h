@@ -0,0 +1,205 @@
+/**
+ * @file ik_solution_enumerator.h
+ * @brief Enumerates the inverse kinematics solutions of a kinematic group in parallel
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_KINEMATICS_IK_SOLUTION_ENUMERATOR_H
+#define TESSERACT_GUI_KINEMATICS_IK_SOLUTION_ENUMERATOR_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <Eigen/Core>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_environment/environment.h>
+#include <tesseract_kinematics/core/kinematic_group.h>
+
+namespace tesseract_gui
+{
+/** @brief A joint configuration reaching the target with the values it can be ranked by */
+struct IkSolution
+{
+  Eigen::VectorXd joint_values;
+
+  /** @brief The Euclidean joint space distance to the current joint values */
+  double distance{ 0 };
+
+  /** @brief The smallest distance to a joint limit relative to the joint range, 0 at a limit and 0.5 centered */
+  double limit_margin{ 0 };
+
+  /** @brief The manipulability of the tip link of the first target, see getManipulability() */
+  double manipulability{ 0 };
+
+  /** @brief The packed world transforms of the requested links in this configuration, for RenderScene::setGhosts() */
+  std::vector<float> link_transforms;
+};
+
+enum class IkRankMetric
+{
+  /** @brief Closest to the current joint values first */
+  DISTANCE,
+
+  /** @brief Farthest from the joint limits first */
+  LIMIT_MARGIN,
+
+  /** @brief Highest manipulability first */
+  MANIPULABILITY
+};
+
+/** @brief The value a solution is ranked by, larger is better */
+double getRankScore(const IkSolution& solution, IkRankMetric metric);
+
+/**
+ * @brief Solves the inverse kinematics of a kinematic group from many random seeds in parallel
+ *
+ * Numeric solvers converge to the solution nearest to their seed and analytic solvers of redundant groups only
+ * return a subset, so restarting from seeds spread over the joint limits finds the other solutions. The restarts are
+ * taken in turn by the threads of a pool, every thread owns its own kinematic group and state solver. The seed of a
+ * restart only depends on the seed of the settings and the restart index.
+ *
+ * Solutions within the tolerance of an already found solution in every joint are dropped. New solutions are
+ * reported once per frame, so they appear while the remaining restarts are still running. The order in which they
+ * are found depends on the thread timing, rank them with getRankScore() instead.
+ */
+class IkSolutionEnumerator : public QObject
+{
+  Q_OBJECT
+
+public:
+  struct Settings
+  {
+    /** @brief The number of inverse kinematics calls, each from a different random seed */
+    std::size_t restart_count{ 256 };
+
+    /** @brief The seed of the random restarts */
+    std::uint64_t seed{ 0 };
+
+    /** @brief The number of threads, zero for the hardware concurrency */
+    std::size_t thread_count{ 0 };
+
+    /** @brief Solutions closer than this in every joint are duplicates, in radians or meters */
+    double tolerance{ 1e-3 };
+
+    /** @brief Links to compute IkSolution::link_transforms for, e.g. RenderScene::getLinkNames() */
+    std::vector<std::string> link_names;
+  };
+
+  explicit IkSolutionEnumerator(QObject* parent = nullptr);
+
+  /** @brief Cancels and waits for a running enumeration */
+  ~IkSolutionEnumerator() override;
+  IkSolutionEnumerator(const IkSolutionEnumerator&) = delete;
+  IkSolutionEnumerator& operator=(const IkSolutionEnumerator&) = delete;
+  IkSolutionEnumerator(IkSolutionEnumerator&&) = delete;
+  IkSolutionEnumerator& operator=(IkSolutionEnumerator&&) = delete;
+
+  /**
+   * @brief Start enumerating the solutions for the targets, a running enumeration is cancelled first
+   *
+   * The kinematic group and state solver are created from the environment for every thread, the environment is not
+   * referenced afterwards. Joints outside the group keep their values in the environment.
+   * @param environment The environment of the group
+   * @param group_name The kinematic group
+   * @param targets One target per tip link, several for e.g. dual arm groups
+   * @param current_joint_values The current values of the group joints, solutions are ranked by their distance to it
+   * @param settings The restarts and threads
+   */
+  void start(const tesseract_environment::Environment& environment,
+             const std::string& group_name,
+             const tesseract_kinematics::KinGroupIKInputs& targets,
+             const Eigen::VectorXd& current_joint_values,
+             const Settings& settings);
+
+  bool isRunning() const;
+
+  /** @brief The joint names of the group of the last enumeration, in the order of IkSolution::joint_values */
+  const std::vector<std::string>& getJointNames() const;
+
+  /** @brief The links moved by the joints of the group of the last start(), e.g. the links to draw as ghosts */
+  const std::vector<std::string>& getActiveLinkNames() const;
+
+  /** @brief The number of distinct solutions reported so far */
+  std::size_t getSolutionCount() const;
+
+  /** @brief Set the interval in which new solutions are reported, defaults to the primary screen refresh rate */
+  void setFrameInterval(int msec);
+  int getFrameInterval() const;
+
+public Q_SLOTS:
+  /** @brief Stop the threads after their running restarts, the solutions reported so far are kept */
+  void cancel();
+
+Q_SIGNALS:
+  void progressChanged(std::size_t completed, std::size_t total);
+
+  /** @brief The solutions found since the previous report */
+  void solutionsFound(const std::vector<tesseract_gui::IkSolution>& solutions);
+
+  /** @brief All threads stopped, cancelled is false when all restarts were completed */
+  void finished(bool cancelled);
+
+  /** @brief Solving threw, the enumeration is stopped */
+  void enumerationFailed(const QString& message);
+
+private:
+  struct Context
+  {
+    tesseract_kinematics::KinGroupIKInputs targets;
+    Eigen::VectorXd current_joint_values;
+    Eigen::MatrixX2d joint_limits;
+    Settings settings;
+  };
+
+  std::vector<std::string> joint_names_;
+  std::vector<std::string> active_link_names_;
+  Context context_;
+
+  std::atomic<std::size_t> next_restart_{ 0 };
+  std::atomic<bool> cancelled_{ false };
+
+  mutable std::mutex mutex_;
+
+  /** @brief The joint values of every distinct solution found, compared against by new solutions */
+  std::vector<Eigen::VectorXd> found_;
+
+  /** @brief Solutions found since the last report */
+  std::vector<IkSolution> pending_;
+  std::size_t completed_restarts_{ 0 };
+  std::size_t finished_threads_{ 0 };
+  std::string error_;
+
+  std::vector<std::thread> workers_;
+  QTimer frame_timer_;
+  std::size_t reported_restarts_{ 0 };
+  std::size_t reported_solutions_{ 0 };
+
+  void stop();
+  void run(tesseract_kinematics::KinematicGroup::UPtr group, tesseract_scene_graph::StateSolver::UPtr solver);
+  bool insertSolution(const Eigen::VectorXd& joint_values);
+  void report();
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_KINEMATICS_IK_SOLUTION_ENUMERATOR_H
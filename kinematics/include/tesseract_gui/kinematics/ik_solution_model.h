@@ -0,0 +1,85 @@
+/**
+ * @file ik_solution_model.h
+ * @brief Table of inverse kinematics solutions ranked by a metric
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_KINEMATICS_IK_SOLUTION_MODEL_H
+#define TESSERACT_GUI_KINEMATICS_IK_SOLUTION_MODEL_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <string>
+#include <vector>
+#include <QAbstractTableModel>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/kinematics/ik_solution_enumerator.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief One row per solution with its rank values and joint values, best ranked first
+ *
+ * Solutions streamed in by IkSolutionEnumerator are inserted at their rank, so rows already shown only move down and
+ * selections are kept. Changing the metric reorders the rows as a layout change.
+ */
+class IkSolutionModel : public QAbstractTableModel
+{
+  Q_OBJECT
+
+public:
+  enum Column
+  {
+    DISTANCE_COLUMN = 0,
+    LIMIT_MARGIN_COLUMN,
+    MANIPULABILITY_COLUMN,
+
+    /** @brief The first of one column per joint */
+    JOINT_COLUMN
+  };
+
+  explicit IkSolutionModel(QObject* parent = nullptr);
+
+  /** @brief Remove all solutions and set the joint columns */
+  void setJointNames(const std::vector<std::string>& joint_names);
+  const std::vector<std::string>& getJointNames() const;
+
+  void clear();
+
+  void setRankMetric(IkRankMetric metric);
+  IkRankMetric getRankMetric() const;
+
+  const IkSolution& getSolution(int row) const;
+
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+  int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+  QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+public Q_SLOTS:
+  /** @brief Insert solutions at their rank */
+  void addSolutions(const std::vector<tesseract_gui::IkSolution>& solutions);
+
+private:
+  std::vector<std::string> joint_names_;
+  std::vector<IkSolution> solutions_;
+  IkRankMetric metric_{ IkRankMetric::DISTANCE };
+
+  bool isBetter(const IkSolution& a, const IkSolution& b) const;
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_KINEMATICS_IK_SOLUTION_MODEL_H
@@ -0,0 +1,118 @@
+/**
+ * @file ik_solutions_widget.h
+ * @brief Enumerates, ranks and shows the inverse kinematics solutions of a kinematic group
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_KINEMATICS_IK_SOLUTIONS_WIDGET_H
+#define TESSERACT_GUI_KINEMATICS_IK_SOLUTIONS_WIDGET_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <string>
+#include <vector>
+#include <Eigen/Core>
+#include <QWidget>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_environment/environment.h>
+#include <tesseract_kinematics/core/kinematic_group.h>
+#include <tesseract_gui/render/render_scene.h>
+
+class QComboBox;
+class QLabel;
+class QProgressBar;
+class QPushButton;
+class QSpinBox;
+class QTableView;
+
+namespace tesseract_gui
+{
+class IkSolutionEnumerator;
+class IkSolutionModel;
+
+/**
+ * @brief A ranked table of the inverse kinematics solutions for a target, shown as ghost robots in a render scene
+ *
+ * solve() starts an IkSolutionEnumerator with the restart count and seed of the widget and streams the solutions it
+ * finds into the table, ranked by the selected metric. The best ranked solutions are drawn as translucent ghosts of
+ * the scene (RenderScene::setGhosts()) which share the mesh buffers of the scene, from green for the best to red, and
+ * the selected solution in yellow. Call update() of the render widget on sceneChanged().
+ */
+class IkSolutionsWidget : public QWidget
+{
+  Q_OBJECT
+
+public:
+  explicit IkSolutionsWidget(QWidget* parent = nullptr);
+
+  /** @brief The environment of the kinematic groups, a running enumeration is cancelled */
+  void setEnvironment(tesseract_environment::Environment::ConstPtr environment);
+  tesseract_environment::Environment::ConstPtr getEnvironment() const;
+
+  /** @brief The scene to draw ghosts in, loaded from the same environment */
+  void setScene(RenderScene::Ptr scene);
+  RenderScene::Ptr getScene() const;
+
+  IkSolutionModel* getModel() const;
+  IkSolutionEnumerator* getEnumerator() const;
+
+public Q_SLOTS:
+  /**
+   * @brief Enumerate the solutions of a kinematic group for the targets, replacing the current solutions
+   * @param group_name The kinematic group
+   * @param targets One target per tip link of the group
+   * @param current_joint_values The current values of the group joints, e.g. to rank by distance
+   */
+  void solve(const std::string& group_name,
+             const tesseract_kinematics::KinGroupIKInputs& targets,
+             const Eigen::VectorXd& current_joint_values);
+
+  /** @brief Remove the solutions and ghosts */
+  void clear();
+
+Q_SIGNALS:
+  /** @brief A solution was selected, e.g. to apply it to the environment */
+  void solutionSelected(const std::vector<std::string>& joint_names, const Eigen::VectorXd& joint_values);
+
+  /** @brief The ghosts of the scene changed */
+  void sceneChanged();
+
+private:
+  tesseract_environment::Environment::ConstPtr environment_;
+  RenderScene::Ptr scene_;
+  IkSolutionModel* model_;
+  IkSolutionEnumerator* enumerator_;
+  QTableView* table_view_;
+  QComboBox* metric_combo_box_;
+  QSpinBox* ghost_count_spin_box_;
+  QSpinBox* restart_count_spin_box_;
+  QSpinBox* seed_spin_box_;
+  QProgressBar* progress_bar_;
+  QPushButton* cancel_button_;
+  QLabel* status_label_;
+
+  /** @brief The ghosts of the last update which did not fit the renderer, shown in the status */
+  std::size_t dropped_ghost_count_{ 0 };
+
+  int getSelectedRow() const;
+  void updateGhosts();
+  void updateStatus();
+  void onSelectionChanged();
+  void onFinished(bool cancelled);
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_KINEMATICS_IK_SOLUTIONS_WIDGET_H
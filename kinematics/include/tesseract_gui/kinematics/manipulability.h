@@ -0,0 +1,38 @@
+/**
+ * @file manipulability.h
+ * @brief The manipulability measure of a Jacobian
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_KINEMATICS_MANIPULABILITY_H
+#define TESSERACT_GUI_KINEMATICS_MANIPULABILITY_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <Eigen/Core>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+namespace tesseract_gui
+{
+/**
+ * @brief The manipulability of a Jacobian, the volume of its manipulability ellipsoid, 0 in a singularity
+ *
+ * This is sqrt(det(J J^T)) for at least as many joints as task space dimensions. Groups with fewer joints have a
+ * singular J J^T in every configuration, for them the square Gram matrix J^T J of the joint space is used instead.
+ */
+double getManipulability(const Eigen::MatrixXd& jacobian);
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_KINEMATICS_MANIPULABILITY_H
@@ -0,0 +1,128 @@
+/**
+ * @file reachability_map.h
+ * @brief Per voxel reachability and orientation coverage of a kinematic group with a binary file format
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_KINEMATICS_REACHABILITY_MAP_H
+#define TESSERACT_GUI_KINEMATICS_REACHABILITY_MAP_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <Eigen/Core>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+namespace tesseract_gui
+{
+/**
+ * @brief A voxel grid of the positions a tip link reaches and the fraction of the sampled orientations reached there
+ *
+ * Reachability is stored as one bit per voxel and the orientation coverage as one float per voxel, both indexed by
+ * x + size_x * (y + size_y * z). A grid of 100 x 100 x 100 voxels takes 4 MB.
+ *
+ * The binary file starts with a fixed size header followed by the frame names, the bits and the coverage, all in
+ * native byte order. Loading validates the header and reads the two arrays with one read each.
+ */
+class ReachabilityMap
+{
+public:
+  using Ptr = std::shared_ptr<ReachabilityMap>;
+  using ConstPtr = std::shared_ptr<const ReachabilityMap>;
+
+  /** @brief The version written by save(), load() rejects other versions */
+  static constexpr std::uint32_t FILE_VERSION = 1;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  ReachabilityMap() = default;
+
+  /**
+   * @brief An empty grid, nothing reachable
+   * @param origin The minimum corner of the grid in the working frame
+   * @param resolution The edge length of a voxel in meters
+   * @param size The number of voxels along each axis
+   * @param orientation_count The number of orientations sampled per voxel
+   */
+  ReachabilityMap(const Eigen::Vector3d& origin,
+                  double resolution,
+                  const Eigen::Vector3i& size,
+                  std::size_t orientation_count);
+
+  /** @brief The frame the grid is defined in, e.g. the base link of the kinematic group */
+  void setWorkingFrame(std::string working_frame);
+  const std::string& getWorkingFrame() const;
+
+  /** @brief The link whose poses were sampled */
+  void setTipLinkName(std::string tip_link_name);
+  const std::string& getTipLinkName() const;
+
+  const Eigen::Vector3d& getOrigin() const;
+  double getResolution() const;
+  const Eigen::Vector3i& getSize() const;
+  std::size_t getOrientationCount() const;
+  std::size_t getVoxelCount() const;
+
+  /** @brief The index of a voxel, the coordinates must be within getSize() */
+  std::size_t getIndex(int x, int y, int z) const;
+
+  /** @brief The center of a voxel in the working frame */
+  Eigen::Vector3d getVoxelCenter(std::size_t index) const;
+
+  /**
+   * @brief Set the fraction of orientations reached in a voxel, a voxel is reachable when it is above zero
+   * @param index The voxel index
+   * @param coverage The fraction in [0, 1]
+   */
+  void setCoverage(std::size_t index, float coverage);
+  float getCoverage(std::size_t index) const;
+  bool isReachable(std::size_t index) const;
+
+  /** @brief The number of reachable voxels */
+  std::size_t getReachableCount() const;
+
+  /** @brief The reachability bits, bit i % 64 of word i / 64 is voxel i */
+  const std::vector<std::uint64_t>& getReachableBits() const;
+  const std::vector<float>& getCoverage() const;
+
+  /** @brief Incremented by every change, e.g. to upload the map again */
+  std::uint64_t getRevision() const;
+
+  /** @brief Write the map to a binary file, throws if it can not be written */
+  void save(const std::string& path) const;
+
+  /** @brief Read a map written by save(), throws if the file can not be read or is not a valid map */
+  static ReachabilityMap load(const std::string& path);
+
+private:
+  Eigen::Vector3d origin_{ Eigen::Vector3d::Zero() };
+  double resolution_{ 0 };
+  Eigen::Vector3i size_{ Eigen::Vector3i::Zero() };
+  std::size_t orientation_count_{ 0 };
+  std::string working_frame_;
+  std::string tip_link_name_;
+
+  std::vector<std::uint64_t> reachable_;
+  std::vector<float> coverage_;
+  std::size_t reachable_count_{ 0 };
+  std::uint64_t revision_{ 0 };
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_KINEMATICS_REACHABILITY_MAP_H
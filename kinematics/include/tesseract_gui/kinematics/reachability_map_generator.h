@@ -0,0 +1,177 @@
+/**
+ * @file reachability_map_generator.h
+ * @brief Generates the reachability map of a kinematic group on worker threads
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_KINEMATICS_REACHABILITY_MAP_GENERATOR_H
+#define TESSERACT_GUI_KINEMATICS_REACHABILITY_MAP_GENERATOR_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <Eigen/Geometry>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_common/types.h>
+#include <tesseract_environment/environment.h>
+#include <tesseract_gui/kinematics/reachability_map.h>
+#include <tesseract_kinematics/core/kinematic_group.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief Fills a ReachabilityMap by solving the inverse kinematics of a kinematic group at every voxel in parallel
+ *
+ * Every voxel center is combined with the same set of orientations, see getOrientations(). An orientation is reached
+ * when the inverse kinematics succeeds from one of the seeds: the solution of the previous orientation of the voxel
+ * first, the center of the joint limits for the first orientation, then random seeds within the joint limits which
+ * only depend on the seed of the settings and the voxel. The voxels are taken in turn by the threads of a pool, every
+ * thread owns its own kinematic group.
+ *
+ * The voxels computed since the last frame are written into the map on the thread of the generator, so the map can
+ * be drawn while it is generated.
+ */
+class ReachabilityMapGenerator : public QObject
+{
+  Q_OBJECT
+
+public:
+  struct Settings
+  {
+    /** @brief The frame of the grid, empty for the base link of the group */
+    std::string working_frame;
+
+    /** @brief The link whose poses are sampled, empty for the first tip link of the group */
+    std::string tip_link_name;
+
+    /** @brief The region sampled in the working frame, rounded up to whole voxels */
+    Eigen::AlignedBox3d bounds{ Eigen::Vector3d::Constant(-1), Eigen::Vector3d::Constant(1) };
+
+    /** @brief The edge length of a voxel in meters */
+    double resolution{ 0.05 };
+
+    /** @brief The number of orientations sampled per voxel */
+    std::size_t orientation_count{ 32 };
+
+    /** @brief The number of random seeds tried per orientation after the previous solution failed */
+    std::size_t seed_count{ 2 };
+
+    /** @brief The seed of the random seeds */
+    std::uint64_t seed{ 0 };
+
+    /** @brief The number of threads, zero for the hardware concurrency */
+    std::size_t thread_count{ 0 };
+  };
+
+  explicit ReachabilityMapGenerator(QObject* parent = nullptr);
+
+  /** @brief Cancels and waits for a running generation */
+  ~ReachabilityMapGenerator() override;
+  ReachabilityMapGenerator(const ReachabilityMapGenerator&) = delete;
+  ReachabilityMapGenerator& operator=(const ReachabilityMapGenerator&) = delete;
+  ReachabilityMapGenerator(ReachabilityMapGenerator&&) = delete;
+  ReachabilityMapGenerator& operator=(ReachabilityMapGenerator&&) = delete;
+
+  /**
+   * @brief Start generating a new map, a running generation is cancelled first
+   *
+   * The kinematic groups are created from the environment for every thread, the environment is not referenced
+   * afterwards. A new map is created, overlays drawing the previous one have to be given getMap() again.
+   * @param environment The environment of the group
+   * @param group_name The kinematic group
+   * @param settings The grid, samples and threads
+   */
+  void start(const tesseract_environment::Environment& environment,
+             const std::string& group_name,
+             const Settings& settings);
+
+  bool isRunning() const;
+
+  /** @brief The map of the last generation, complete once finished() was emitted without cancelling */
+  ReachabilityMap::ConstPtr getMap() const;
+
+  /** @brief Set the interval in which computed voxels are written into the map, defaults to the screen refresh rate */
+  void setFrameInterval(int msec);
+  int getFrameInterval() const;
+
+  /**
+   * @brief The orientations of the tip link sampled in every voxel
+   *
+   * The z axes point to points evenly spread over the sphere by a Fibonacci lattice, so the coverage of a voxel is
+   * the fraction of approach directions it is reachable from.
+   */
+  static tesseract_common::VectorIsometry3d getOrientations(std::size_t count);
+
+public Q_SLOTS:
+  /** @brief Stop the threads after their running voxels, the voxels computed so far are kept */
+  void cancel();
+
+Q_SIGNALS:
+  void progressChanged(std::size_t completed, std::size_t total);
+
+  /** @brief Voxels of the map were computed */
+  void mapChanged();
+
+  /** @brief All threads stopped, cancelled is false when all voxels were computed */
+  void finished(bool cancelled);
+
+  /** @brief Solving threw, the generation is stopped */
+  void generationFailed(const QString& message);
+
+private:
+  struct Context
+  {
+    std::string working_frame;
+    std::string tip_link_name;
+    tesseract_common::VectorIsometry3d orientations;
+    Eigen::MatrixX2d joint_limits;
+    Settings settings;
+  };
+
+  ReachabilityMap::Ptr map_;
+  Context context_;
+
+  std::atomic<std::size_t> next_voxel_{ 0 };
+  std::atomic<bool> cancelled_{ false };
+
+  std::mutex mutex_;
+
+  /** @brief The coverage of the voxels computed since the last report */
+  std::vector<std::pair<std::size_t, float>> pending_;
+  std::size_t completed_voxels_{ 0 };
+  std::size_t finished_threads_{ 0 };
+  std::string error_;
+
+  std::vector<std::thread> workers_;
+  QTimer frame_timer_;
+  std::size_t reported_voxels_{ 0 };
+
+  void stop();
+  void run(tesseract_kinematics::KinematicGroup::UPtr group);
+  void report();
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_KINEMATICS_REACHABILITY_MAP_GENERATOR_H
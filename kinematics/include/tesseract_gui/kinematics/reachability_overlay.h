@@ -0,0 +1,117 @@
+/**
+ * @file reachability_overlay.h
+ * @brief Draws the reachable voxels of a reachability map colored by orientation coverage
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_KINEMATICS_REACHABILITY_OVERLAY_H
+#define TESSERACT_GUI_KINEMATICS_REACHABILITY_OVERLAY_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <Eigen/Geometry>
+#include <QOpenGLShaderProgram>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/kinematics/reachability_map.h>
+#include <tesseract_gui/render/render_overlay.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief Draws the reachable voxels of a ReachabilityMap as cubes with a single instanced draw call
+ *
+ * Voxels are colored from red for a single reached orientation over yellow to green for all orientations. The
+ * instances are rebuilt from the reachability bits when the revision of the map changed, skipping empty words of 64
+ * voxels at a time, so a map being generated is redrawn at most once per frame.
+ *
+ * Setters may be called without the context current, changes are uploaded by the next render(). The map must only be
+ * changed on the thread rendering the overlay.
+ */
+class ReachabilityOverlay : public RenderOverlay
+{
+public:
+  using Ptr = std::shared_ptr<ReachabilityOverlay>;
+  using ConstPtr = std::shared_ptr<const ReachabilityOverlay>;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  ReachabilityOverlay() = default;
+
+  /** @brief The map to draw, nullptr to draw nothing */
+  void setMap(ReachabilityMap::ConstPtr map);
+  ReachabilityMap::ConstPtr getMap() const;
+
+  /** @brief The transform from the working frame of the map to the world */
+  void setOrigin(const Eigen::Isometry3d& origin);
+  const Eigen::Isometry3d& getOrigin() const;
+
+  /** @brief Only draw voxels reached in at least this fraction of orientations */
+  void setMinCoverage(float min_coverage);
+  float getMinCoverage() const;
+
+  /** @brief The edge length of the cubes relative to the resolution of the map, below one to see inside the cloud */
+  void setVoxelScale(float scale);
+  float getVoxelScale() const;
+
+  void setVisible(bool visible);
+  bool isVisible() const;
+
+  void initialize(QOpenGLExtraFunctions& gl) override;
+  void cleanup(QOpenGLExtraFunctions& gl) override;
+  void render(QOpenGLExtraFunctions& gl, const Eigen::Matrix4f& view_projection, const Camera& camera) override;
+
+private:
+  /** @brief A voxel center in the working frame and its coverage */
+  struct Instance
+  {
+    std::array<float, 3> center;
+    float coverage;
+  };
+
+  ReachabilityMap::ConstPtr map_;
+  Eigen::Isometry3d origin_{ Eigen::Isometry3d::Identity() };
+  float min_coverage_{ 0 };
+  float voxel_scale_{ 0.6F };
+  bool visible_{ true };
+
+  std::vector<Instance> instances_;
+
+  /** @brief Set when the instances no longer match the map */
+  bool instances_dirty_{ true };
+  std::uint64_t map_revision_{ 0 };
+
+  std::unique_ptr<QOpenGLShaderProgram> program_;
+  int model_view_projection_location_{ -1 };
+  int voxel_size_location_{ -1 };
+
+  GLuint vao_{ 0 };
+  GLuint vertex_buffer_{ 0 };
+  GLuint instance_buffer_{ 0 };
+  GLsizei instance_count_{ 0 };
+
+  /** @brief Set when the instance buffer does not contain instances_ */
+  bool upload_pending_{ true };
+
+  void updateInstances();
+  void uploadInstances(QOpenGLExtraFunctions& gl);
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_KINEMATICS_REACHABILITY_OVERLAY_H
@@ -0,0 +1,170 @@
+/**
+ * @file trajectory_metrics_calculator.h
+ * @brief Computes the manipulability and joint limit margins of every waypoint of a trajectory on a worker thread
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_KINEMATICS_TRAJECTORY_METRICS_CALCULATOR_H
+#define TESSERACT_GUI_KINEMATICS_TRAJECTORY_METRICS_CALCULATOR_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <Eigen/Core>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_common/joint_state.h>
+#include <tesseract_environment/environment.h>
+#include <tesseract_kinematics/core/joint_group.h>
+
+namespace tesseract_gui
+{
+enum class TrajectoryMetric
+{
+  /** @brief The manipulability of the tool center point relative to the highest of the trajectory */
+  MANIPULABILITY,
+
+  /** @brief The distance to the closest joint limit relative to the joint range */
+  LIMIT_MARGIN
+};
+
+/** @brief The kinematic quality of every waypoint of a trajectory, indexed like the waypoints */
+struct TrajectoryMetrics
+{
+  using Ptr = std::shared_ptr<TrajectoryMetrics>;
+  using ConstPtr = std::shared_ptr<const TrajectoryMetrics>;
+
+  /** @brief The joints of the group, the rows of joint_limit_margins */
+  std::vector<std::string> joint_names;
+
+  /** @brief The child link of every joint, colored by the margin of its joint */
+  std::vector<std::string> joint_child_link_names;
+
+  /** @brief The links moved by the joints of the group, colored by the manipulability */
+  std::vector<std::string> active_link_names;
+
+  /** @brief The world position of the tool center point, three floats per waypoint */
+  std::vector<float> tcp_positions;
+
+  /** @brief The manipulability of the tool center point, see getManipulability() */
+  std::vector<float> manipulability;
+  float max_manipulability{ 0 };
+
+  /** @brief The distance of every joint to its closest limit relative to its range, 0 at a limit and 0.5 centered */
+  Eigen::MatrixXf joint_limit_margins;
+
+  /** @brief The smallest joint limit margin of every waypoint */
+  std::vector<float> limit_margin;
+
+  std::size_t getWaypointCount() const;
+
+  /** @brief The value of a metric at a waypoint scaled to [0, 1], 1 being the best */
+  float getValue(TrajectoryMetric metric, std::size_t waypoint) const;
+
+  /** @brief The limit margin of a joint at a waypoint scaled to [0, 1], 1 being centered */
+  float getJointValue(std::size_t joint, std::size_t waypoint) const;
+};
+
+/**
+ * @brief Computes TrajectoryMetrics for all waypoints of a trajectory in one pass on a worker thread
+ *
+ * The joint values of all waypoints are gathered into one matrix first, the joint limit margins of all waypoints are
+ * then computed with array expressions over the whole matrix. Jacobians and the tool center point are computed per
+ * waypoint with a joint group owned by the worker. Nothing is evaluated on the thread of the calculator, it only
+ * polls the progress once per frame.
+ */
+class TrajectoryMetricsCalculator : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit TrajectoryMetricsCalculator(QObject* parent = nullptr);
+
+  /** @brief Cancels and waits for a running calculation */
+  ~TrajectoryMetricsCalculator() override;
+  TrajectoryMetricsCalculator(const TrajectoryMetricsCalculator&) = delete;
+  TrajectoryMetricsCalculator& operator=(const TrajectoryMetricsCalculator&) = delete;
+  TrajectoryMetricsCalculator(TrajectoryMetricsCalculator&&) = delete;
+  TrajectoryMetricsCalculator& operator=(TrajectoryMetricsCalculator&&) = delete;
+
+  /**
+   * @brief Start calculating the metrics of a trajectory, a running calculation is cancelled first
+   * @param environment The environment of the group, not referenced after start() returns
+   * @param group_name The joint group
+   * @param tcp_link_name The link whose Jacobian and position are evaluated
+   * @param trajectory The trajectory, copied. Joints missing from a waypoint keep their value in the environment.
+   */
+  void start(const tesseract_environment::Environment& environment,
+             const std::string& group_name,
+             const std::string& tcp_link_name,
+             const tesseract_common::JointTrajectory& trajectory);
+
+  bool isRunning() const;
+
+  /** @brief The metrics of the last completed calculation, nullptr until one completed */
+  TrajectoryMetrics::ConstPtr getMetrics() const;
+
+  /** @brief Set the interval in which the progress is polled, defaults to the primary screen refresh rate */
+  void setFrameInterval(int msec);
+  int getFrameInterval() const;
+
+public Q_SLOTS:
+  /** @brief Stop the calculation, no metrics are delivered */
+  void cancel();
+
+Q_SIGNALS:
+  void progressChanged(std::size_t completed, std::size_t total);
+
+  /** @brief The worker stopped, getMetrics() holds the new metrics unless cancelled */
+  void finished(bool cancelled);
+
+  /** @brief The calculation threw, it is stopped */
+  void calculationFailed(const QString& message);
+
+private:
+  TrajectoryMetrics::ConstPtr metrics_;
+
+  std::thread worker_;
+  std::atomic<std::size_t> completed_{ 0 };
+  std::atomic<bool> cancelled_{ false };
+  std::atomic<bool> done_{ false };
+  std::size_t total_{ 0 };
+
+  std::mutex mutex_;
+  TrajectoryMetrics::Ptr result_;
+  std::string error_;
+
+  QTimer frame_timer_;
+  std::size_t reported_{ 0 };
+
+  void stop();
+  void run(tesseract_kinematics::JointGroup::UPtr group,
+           const std::string& tcp_link_name,
+           const tesseract_common::JointTrajectory& trajectory,
+           const Eigen::VectorXd& current_joint_values,
+           TrajectoryMetrics::Ptr metrics);
+  void report();
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_KINEMATICS_TRAJECTORY_METRICS_CALCULATOR_H
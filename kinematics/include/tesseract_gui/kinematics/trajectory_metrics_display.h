@@ -0,0 +1,108 @@
+/**
+ * @file trajectory_metrics_display.h
+ * @brief Colors the tool center point path and the robot of a played trajectory by a trajectory metric
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_KINEMATICS_TRAJECTORY_METRICS_DISPLAY_H
+#define TESSERACT_GUI_KINEMATICS_TRAJECTORY_METRICS_DISPLAY_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <vector>
+#include <QObject>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/joint_trajectory/trajectory_player.h>
+#include <tesseract_gui/kinematics/trajectory_metrics_calculator.h>
+#include <tesseract_gui/kinematics/trajectory_path_overlay.h>
+#include <tesseract_gui/render/render_scene.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief Shows the metrics of a trajectory played by a TrajectoryPlayer
+ *
+ * The tool center point path is drawn by getOverlay(), add it to the renderer of the scene. While enabled, every time
+ * change of the player tints the robot by the metric at the nearest waypoint: all links moved by the group by the
+ * manipulability, or the child link of every joint by the limit margin of that joint. The metrics are computed by
+ * getCalculator() from the trajectory the player was loaded with, no kinematics are evaluated during playback.
+ */
+class TrajectoryMetricsDisplay : public QObject
+{
+  Q_OBJECT
+
+public:
+  /** @brief How much the robot is tinted by the metric colors */
+  static constexpr float TINT = 0.8F;
+
+  explicit TrajectoryMetricsDisplay(QObject* parent = nullptr);
+
+  /** @brief The scene whose link colors are set, the scene played by the player */
+  void setScene(RenderScene::Ptr scene);
+  RenderScene::Ptr getScene() const;
+
+  /** @brief The player whose time selects the waypoint, may be nullptr, must outlive the display or be unset */
+  void setPlayer(TrajectoryPlayer* player);
+  TrajectoryPlayer* getPlayer() const;
+
+  TrajectoryMetric getMetric() const;
+  bool isEnabled() const;
+
+  TrajectoryPathOverlay::Ptr getOverlay() const;
+  TrajectoryMetricsCalculator* getCalculator() const;
+
+public Q_SLOTS:
+  /**
+   * @brief Compute the metrics of the trajectory the player was loaded with, see TrajectoryMetricsCalculator::start()
+   * @throws std::runtime_error if the calculation can not be started
+   */
+  void calculate(const tesseract_environment::Environment& environment,
+                 const std::string& group_name,
+                 const std::string& tcp_link_name,
+                 const tesseract_common::JointTrajectory& trajectory);
+
+  void setMetric(tesseract_gui::TrajectoryMetric metric);
+
+  /** @brief Show or hide the path and the link colors */
+  void setEnabled(bool enabled);
+
+Q_SIGNALS:
+  /** @brief The link colors or the path changed, the scene needs to be redrawn */
+  void sceneChanged();
+
+private:
+  RenderScene::Ptr scene_;
+  TrajectoryPlayer* player_{ nullptr };
+  TrajectoryMetricsCalculator* calculator_;
+  TrajectoryPathOverlay::Ptr overlay_;
+  TrajectoryMetric metric_{ TrajectoryMetric::MANIPULABILITY };
+  bool enabled_{ true };
+
+  /** @brief The scene index of every active link of the metrics, -1 if not in the scene */
+  std::vector<int> active_link_indices_;
+
+  /** @brief The scene index of the child link of every joint of the metrics, -1 if not in the scene */
+  std::vector<int> joint_link_indices_;
+
+  tesseract_common::AlignedVector<Eigen::Vector4f> link_colors_;
+
+  void onFinished(bool cancelled);
+  void updateLinkIndices();
+  void updateLinkColors();
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_KINEMATICS_TRAJECTORY_METRICS_DISPLAY_H
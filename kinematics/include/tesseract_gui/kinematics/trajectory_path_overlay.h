@@ -0,0 +1,84 @@
+/**
+ * @file trajectory_path_overlay.h
+ * @brief Draws the tool center point path of a trajectory colored by a trajectory metric
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_KINEMATICS_TRAJECTORY_PATH_OVERLAY_H
+#define TESSERACT_GUI_KINEMATICS_TRAJECTORY_PATH_OVERLAY_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <memory>
+#include <vector>
+#include <QOpenGLShaderProgram>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/kinematics/trajectory_metrics_calculator.h>
+#include <tesseract_gui/render/render_overlay.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief Draws the tool center point path of TrajectoryMetrics as one line strip colored by a metric
+ *
+ * The positions are uploaded once per metrics, changing the metric only uploads one float per waypoint. Waypoints are
+ * colored from red for the worst value over yellow to green for the best.
+ *
+ * Setters may be called without the context current, changes are uploaded by the next render().
+ */
+class TrajectoryPathOverlay : public RenderOverlay
+{
+public:
+  using Ptr = std::shared_ptr<TrajectoryPathOverlay>;
+  using ConstPtr = std::shared_ptr<const TrajectoryPathOverlay>;
+
+  TrajectoryPathOverlay() = default;
+
+  /** @brief The path to draw, nullptr to draw nothing */
+  void setMetrics(TrajectoryMetrics::ConstPtr metrics);
+  TrajectoryMetrics::ConstPtr getMetrics() const;
+
+  void setMetric(TrajectoryMetric metric);
+  TrajectoryMetric getMetric() const;
+
+  void setVisible(bool visible);
+  bool isVisible() const;
+
+  void initialize(QOpenGLExtraFunctions& gl) override;
+  void cleanup(QOpenGLExtraFunctions& gl) override;
+  void render(QOpenGLExtraFunctions& gl, const Eigen::Matrix4f& view_projection, const Camera& camera) override;
+
+private:
+  TrajectoryMetrics::ConstPtr metrics_;
+  TrajectoryMetric metric_{ TrajectoryMetric::MANIPULABILITY };
+  bool visible_{ true };
+  bool positions_dirty_{ true };
+  bool values_dirty_{ true };
+
+  /** @brief The scaled metric value of every waypoint */
+  std::vector<float> values_;
+
+  std::unique_ptr<QOpenGLShaderProgram> program_;
+  int view_projection_location_{ -1 };
+
+  GLuint vao_{ 0 };
+  GLuint position_buffer_{ 0 };
+  GLuint value_buffer_{ 0 };
+  GLsizei vertex_count_{ 0 };
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_KINEMATICS_TRAJECTORY_PATH_OVERLAY_H
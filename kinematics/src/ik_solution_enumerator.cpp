@@ -0,0 +1,275 @@
+/**
+ * @file ik_solution_enumerator.cpp
+ * @brief Enumerates the inverse kinematics solutions of a kinematic group in parallel
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <stdexcept>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/common/frame_interval.h>
+#include <tesseract_gui/common/instrumentation.h>
+#include <tesseract_gui/common/splitmix_random.h>
+#include <tesseract_gui/kinematics/ik_solution_enumerator.h>
+#include <tesseract_gui/kinematics/manipulability.h>
+#include <tesseract_gui/render/link_transform_batch.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+double getLimitMargin(const Eigen::VectorXd& joint_values, const Eigen::MatrixX2d& joint_limits)
+{
+  double margin{ 0.5 };
+  for (Eigen::Index j = 0; j < joint_values.size(); ++j)
+  {
+    const double range = joint_limits(j, 1) - joint_limits(j, 0);
+    if (range <= 0)
+      continue;
+
+    const double distance = std::min(joint_values[j] - joint_limits(j, 0), joint_limits(j, 1) - joint_values[j]);
+    margin = std::min(margin, std::max(0.0, distance / range));
+  }
+  return margin;
+}
+}  // namespace
+
+double getRankScore(const IkSolution& solution, IkRankMetric metric)
+{
+  switch (metric)
+  {
+    case IkRankMetric::DISTANCE:
+      return -solution.distance;
+    case IkRankMetric::LIMIT_MARGIN:
+      return solution.limit_margin;
+    case IkRankMetric::MANIPULABILITY:
+      return solution.manipulability;
+  }
+  return 0;
+}
+
+IkSolutionEnumerator::IkSolutionEnumerator(QObject* parent) : QObject(parent)
+{
+  frame_timer_.setTimerType(Qt::PreciseTimer);
+  frame_timer_.setInterval(getDefaultFrameInterval());
+  connect(&frame_timer_, &QTimer::timeout, this, &IkSolutionEnumerator::report);
+}
+
+IkSolutionEnumerator::~IkSolutionEnumerator() { stop(); }
+
+void IkSolutionEnumerator::start(const tesseract_environment::Environment& environment,
+                                 const std::string& group_name,
+                                 const tesseract_kinematics::KinGroupIKInputs& targets,
+                                 const Eigen::VectorXd& current_joint_values,
+                                 const Settings& settings)
+{
+  if (targets.empty())
+    throw std::runtime_error("IkSolutionEnumerator, no targets!");
+
+  stop();
+  frame_timer_.stop();
+
+  std::size_t thread_count = settings.thread_count;
+  if (thread_count == 0)
+    thread_count = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+  thread_count = std::max<std::size_t>(1, std::min(thread_count, settings.restart_count));
+
+  // Kinematic groups and state solvers keep internal state while solving, so every thread gets its own
+  std::vector<std::pair<tesseract_kinematics::KinematicGroup::UPtr, tesseract_scene_graph::StateSolver::UPtr>> clones;
+  clones.reserve(thread_count);
+  for (std::size_t i = 0; i < thread_count; ++i)
+  {
+    clones.emplace_back(environment.getKinematicGroup(group_name), environment.getStateSolver());
+    if (clones.back().first == nullptr || clones.back().second == nullptr)
+      throw std::runtime_error("IkSolutionEnumerator, failed to create the kinematic group or state solver!");
+  }
+
+  const tesseract_kinematics::KinematicGroup& group = *clones.front().first;
+  joint_names_ = group.getJointNames();
+  active_link_names_ = group.getActiveLinkNames();
+  if (current_joint_values.size() != static_cast<Eigen::Index>(joint_names_.size()))
+    throw std::runtime_error("IkSolutionEnumerator, current joint values do not match the group!");
+
+  context_.targets = targets;
+  context_.current_joint_values = current_joint_values;
+  context_.joint_limits = group.getLimits().joint_limits;
+  context_.settings = settings;
+
+  reported_restarts_ = 0;
+  reported_solutions_ = 0;
+  next_restart_ = 0;
+  cancelled_ = false;
+  {
+    std::scoped_lock lock(mutex_);
+    found_.clear();
+    pending_.clear();
+    completed_restarts_ = 0;
+    finished_threads_ = 0;
+    error_.clear();
+  }
+
+  workers_.reserve(thread_count);
+  for (auto& clone : clones)
+  {
+    workers_.emplace_back([this, group = std::move(clone.first), solver = std::move(clone.second)]() mutable {
+      run(std::move(group), std::move(solver));
+    });
+  }
+
+  frame_timer_.start();
+  emit progressChanged(0, settings.restart_count);
+}
+
+bool IkSolutionEnumerator::isRunning() const { return !workers_.empty(); }
+
+const std::vector<std::string>& IkSolutionEnumerator::getJointNames() const { return joint_names_; }
+
+const std::vector<std::string>& IkSolutionEnumerator::getActiveLinkNames() const { return active_link_names_; }
+
+std::size_t IkSolutionEnumerator::getSolutionCount() const { return reported_solutions_; }
+
+void IkSolutionEnumerator::setFrameInterval(int msec) { frame_timer_.setInterval(msec); }
+
+int IkSolutionEnumerator::getFrameInterval() const { return frame_timer_.interval(); }
+
+void IkSolutionEnumerator::cancel() { cancelled_ = true; }
+
+void IkSolutionEnumerator::stop()
+{
+  cancelled_ = true;
+  for (auto& worker : workers_)
+    worker.join();
+  workers_.clear();
+}
+
+void IkSolutionEnumerator::run(tesseract_kinematics::KinematicGroup::UPtr group,
+                               tesseract_scene_graph::StateSolver::UPtr solver)
+{
+  const Settings& settings = context_.settings;
+  const Eigen::MatrixX2d& limits = context_.joint_limits;
+  const std::string& tip_link = context_.targets.front().tip_link_name;
+  const std::vector<std::string> joint_names = group->getJointNames();
+  const LinkTransformBatch batch(settings.link_names);
+
+  Eigen::VectorXd seed(limits.rows());
+  try
+  {
+    while (!cancelled_)
+    {
+      const std::size_t restart = next_restart_++;
+      if (restart >= settings.restart_count)
+        break;
+
+      const ScopedTimer timer("kinematics", "ik restart");
+      SplitMixRandom random(settings.seed, restart);
+      for (Eigen::Index j = 0; j < seed.size(); ++j)
+        seed[j] = limits(j, 0) + (random.next() * (limits(j, 1) - limits(j, 0)));
+
+      // The group only returns solutions within the joint limits, including the redundant ones of revolute joints
+      std::vector<IkSolution> solutions;
+      for (const auto& joint_values : group->calcInvKin(context_.targets, seed))
+      {
+        if (!insertSolution(joint_values))
+          continue;
+
+        IkSolution solution;
+        solution.joint_values = joint_values;
+        solution.distance = (joint_values - context_.current_joint_values).norm();
+        solution.limit_margin = getLimitMargin(joint_values, limits);
+        solution.manipulability = getManipulability(group->calcJacobian(joint_values, tip_link));
+        if (batch.size() > 0)
+        {
+          solution.link_transforms = batch.getTransforms();
+          batch.pack(solver->getState(joint_names, joint_values).link_transforms,
+                     solution.link_transforms.data());
+        }
+        solutions.push_back(std::move(solution));
+      }
+
+      std::scoped_lock lock(mutex_);
+      std::move(solutions.begin(), solutions.end(), std::back_inserter(pending_));
+      ++completed_restarts_;
+    }
+  }
+  catch (const std::exception& e)
+  {
+    cancelled_ = true;
+    std::scoped_lock lock(mutex_);
+    if (error_.empty())
+      error_ = e.what();
+  }
+
+  std::scoped_lock lock(mutex_);
+  ++finished_threads_;
+}
+
+bool IkSolutionEnumerator::insertSolution(const Eigen::VectorXd& joint_values)
+{
+  std::scoped_lock lock(mutex_);
+  const double tolerance = context_.settings.tolerance;
+  for (const auto& found : found_)
+  {
+    if ((found - joint_values).lpNorm<Eigen::Infinity>() <= tolerance)
+      return false;
+  }
+
+  found_.push_back(joint_values);
+  return true;
+}
+
+void IkSolutionEnumerator::report()
+{
+  std::vector<IkSolution> solutions;
+  std::size_t completed_restarts{ 0 };
+  bool all_finished{ false };
+  std::string error;
+  {
+    std::scoped_lock lock(mutex_);
+    solutions.swap(pending_);
+    completed_restarts = completed_restarts_;
+    all_finished = (finished_threads_ == workers_.size());
+    error = error_;
+  }
+
+  if (!solutions.empty())
+  {
+    reported_solutions_ += solutions.size();
+    recordCounter("kinematics", "ik solutions", static_cast<std::int64_t>(reported_solutions_));
+    emit solutionsFound(solutions);
+  }
+
+  if (completed_restarts != reported_restarts_)
+  {
+    reported_restarts_ = completed_restarts;
+    emit progressChanged(completed_restarts, context_.settings.restart_count);
+  }
+
+  if (!all_finished)
+    return;
+
+  frame_timer_.stop();
+  stop();
+
+  if (!error.empty())
+    emit enumerationFailed(QString::fromStdString(error));
+
+  emit finished(reported_restarts_ < context_.settings.restart_count);
+}
+
+}  // namespace tesseract_gui
@@ -0,0 +1,185 @@
+/**
+ * @file ik_solution_model.cpp
+ * @brief Table of inverse kinematics solutions ranked by a metric
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/kinematics/ik_solution_model.h>
+
+namespace tesseract_gui
+{
+IkSolutionModel::IkSolutionModel(QObject* parent) : QAbstractTableModel(parent) {}
+
+void IkSolutionModel::setJointNames(const std::vector<std::string>& joint_names)
+{
+  beginResetModel();
+  joint_names_ = joint_names;
+  solutions_.clear();
+  endResetModel();
+}
+
+const std::vector<std::string>& IkSolutionModel::getJointNames() const { return joint_names_; }
+
+void IkSolutionModel::clear()
+{
+  beginResetModel();
+  solutions_.clear();
+  endResetModel();
+}
+
+void IkSolutionModel::setRankMetric(IkRankMetric metric)
+{
+  if (metric == metric_)
+    return;
+
+  metric_ = metric;
+  if (solutions_.empty())
+    return;
+
+  emit layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+
+  std::vector<int> order(solutions_.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [this](int a, int b) {
+    return isBetter(solutions_[static_cast<std::size_t>(a)], solutions_[static_cast<std::size_t>(b)]);
+  });
+
+  std::vector<int> new_rows(order.size());
+  std::vector<IkSolution> solutions;
+  solutions.reserve(solutions_.size());
+  for (std::size_t i = 0; i < order.size(); ++i)
+  {
+    new_rows[static_cast<std::size_t>(order[i])] = static_cast<int>(i);
+    solutions.push_back(std::move(solutions_[static_cast<std::size_t>(order[i])]));
+  }
+  solutions_ = std::move(solutions);
+
+  const QModelIndexList from = persistentIndexList();
+  QModelIndexList to;
+  to.reserve(from.size());
+  for (const QModelIndex& index : from)
+    to.append(this->index(new_rows[static_cast<std::size_t>(index.row())], index.column()));
+  changePersistentIndexList(from, to);
+
+  emit layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+}
+
+IkRankMetric IkSolutionModel::getRankMetric() const { return metric_; }
+
+const IkSolution& IkSolutionModel::getSolution(int row) const
+{
+  if (row < 0 || row >= rowCount())
+    throw std::runtime_error("IkSolutionModel, row is out of range!");
+
+  return solutions_[static_cast<std::size_t>(row)];
+}
+
+int IkSolutionModel::rowCount(const QModelIndex& parent) const
+{
+  if (parent.isValid())
+    return 0;
+
+  return static_cast<int>(solutions_.size());
+}
+
+int IkSolutionModel::columnCount(const QModelIndex& parent) const
+{
+  if (parent.isValid())
+    return 0;
+
+  return JOINT_COLUMN + static_cast<int>(joint_names_.size());
+}
+
+QVariant IkSolutionModel::data(const QModelIndex& index, int role) const
+{
+  if (!index.isValid() || role != Qt::DisplayRole)
+    return {};
+
+  const IkSolution& solution = solutions_[static_cast<std::size_t>(index.row())];
+  switch (index.column())
+  {
+    case DISTANCE_COLUMN:
+      return solution.distance;
+    case LIMIT_MARGIN_COLUMN:
+      return solution.limit_margin;
+    case MANIPULABILITY_COLUMN:
+      return solution.manipulability;
+    default:
+    {
+      const Eigen::Index joint = index.column() - JOINT_COLUMN;
+      if (joint >= solution.joint_values.size())
+        return {};
+
+      return solution.joint_values[joint];
+    }
+  }
+}
+
+QVariant IkSolutionModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+  if (role != Qt::DisplayRole)
+    return {};
+
+  // The vertical header shows the rank
+  if (orientation == Qt::Vertical)
+    return section + 1;
+
+  switch (section)
+  {
+    case DISTANCE_COLUMN:
+      return "Distance";
+    case LIMIT_MARGIN_COLUMN:
+      return "Limit margin";
+    case MANIPULABILITY_COLUMN:
+      return "Manipulability";
+    default:
+    {
+      const auto joint = static_cast<std::size_t>(section - JOINT_COLUMN);
+      if (section < JOINT_COLUMN || joint >= joint_names_.size())
+        return {};
+
+      return QString::fromStdString(joint_names_[joint]);
+    }
+  }
+}
+
+void IkSolutionModel::addSolutions(const std::vector<IkSolution>& solutions)
+{
+  for (const auto& solution : solutions)
+  {
+    // After all solutions of equal rank, so streamed solutions keep the order they were found in
+    auto it = std::upper_bound(solutions_.begin(),
+                               solutions_.end(),
+                               solution,
+                               [this](const IkSolution& a, const IkSolution& b) { return isBetter(a, b); });
+    const auto row = static_cast<int>(std::distance(solutions_.begin(), it));
+    beginInsertRows(QModelIndex(), row, row);
+    solutions_.insert(it, solution);
+    endInsertRows();
+  }
+}
+
+bool IkSolutionModel::isBetter(const IkSolution& a, const IkSolution& b) const
+{
+  return getRankScore(a, metric_) > getRankScore(b, metric_);
+}
+
+}  // namespace tesseract_gui
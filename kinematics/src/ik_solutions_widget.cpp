@@ -0,0 +1,275 @@
+/**
+ * @file ik_solutions_widget.cpp
+ * @brief Enumerates, ranks and shows the inverse kinematics solutions of a kinematic group
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <limits>
+#include <QComboBox>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QItemSelectionModel>
+#include <QLabel>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QSignalBlocker>
+#include <QSpinBox>
+#include <QTableView>
+#include <QVBoxLayout>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/kinematics/ik_solution_enumerator.h>
+#include <tesseract_gui/kinematics/ik_solution_model.h>
+#include <tesseract_gui/kinematics/ik_solutions_widget.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+const Eigen::Vector4f BEST_GHOST_COLOR{ 0.2F, 0.9F, 0.2F, 0.25F };
+const Eigen::Vector4f WORST_GHOST_COLOR{ 0.9F, 0.2F, 0.2F, 0.25F };
+const Eigen::Vector4f SELECTED_GHOST_COLOR{ 1.0F, 0.85F, 0.1F, 0.5F };
+
+/** @brief The most ghosts shown besides the selected solution */
+constexpr int MAX_GHOST_COUNT = 64;
+}  // namespace
+
+IkSolutionsWidget::IkSolutionsWidget(QWidget* parent)
+  : QWidget(parent)
+  , model_(new IkSolutionModel(this))
+  , enumerator_(new IkSolutionEnumerator(this))
+  , table_view_(new QTableView(this))
+  , metric_combo_box_(new QComboBox(this))
+  , ghost_count_spin_box_(new QSpinBox(this))
+  , restart_count_spin_box_(new QSpinBox(this))
+  , seed_spin_box_(new QSpinBox(this))
+  , progress_bar_(new QProgressBar(this))
+  , cancel_button_(new QPushButton("Cancel", this))
+  , status_label_(new QLabel(this))
+{
+  table_view_->setModel(model_);
+  table_view_->setSelectionBehavior(QAbstractItemView::SelectRows);
+  table_view_->setSelectionMode(QAbstractItemView::SingleSelection);
+  table_view_->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+  table_view_->verticalHeader()->setDefaultSectionSize(table_view_->fontMetrics().height() + 6);
+
+  // Same order as IkRankMetric
+  metric_combo_box_->addItems({ "Rank by distance", "Rank by limit margin", "Rank by manipulability" });
+  ghost_count_spin_box_->setRange(0, MAX_GHOST_COUNT);
+  ghost_count_spin_box_->setValue(8);
+  ghost_count_spin_box_->setSuffix(" ghosts");
+  restart_count_spin_box_->setRange(1, 1000000);
+  restart_count_spin_box_->setValue(256);
+  restart_count_spin_box_->setSuffix(" restarts");
+  seed_spin_box_->setRange(0, std::numeric_limits<int>::max());
+  seed_spin_box_->setPrefix("Seed ");
+  cancel_button_->setEnabled(false);
+  progress_bar_->setRange(0, 100);
+  progress_bar_->setValue(0);
+
+  auto* settings_layout = new QHBoxLayout();
+  settings_layout->addWidget(metric_combo_box_);
+  settings_layout->addWidget(ghost_count_spin_box_);
+  settings_layout->addWidget(restart_count_spin_box_);
+  settings_layout->addWidget(seed_spin_box_);
+
+  auto* progress_layout = new QHBoxLayout();
+  progress_layout->addWidget(status_label_, 1);
+  progress_layout->addWidget(progress_bar_, 1);
+  progress_layout->addWidget(cancel_button_);
+
+  auto* layout = new QVBoxLayout(this);
+  layout->addLayout(settings_layout);
+  layout->addWidget(table_view_, 1);
+  layout->addLayout(progress_layout);
+
+  connect(enumerator_, &IkSolutionEnumerator::solutionsFound, model_, &IkSolutionModel::addSolutions);
+  connect(enumerator_, &IkSolutionEnumerator::progressChanged, this, [this](std::size_t completed, std::size_t total) {
+    progress_bar_->setValue((total == 0) ? 100 : static_cast<int>((100 * completed) / total));
+  });
+  connect(enumerator_, &IkSolutionEnumerator::finished, this, &IkSolutionsWidget::onFinished);
+  connect(enumerator_, &IkSolutionEnumerator::enumerationFailed, this, [this](const QString& message) {
+    status_label_->setText(QString("Solving failed: %1").arg(message));
+  });
+  connect(cancel_button_, &QPushButton::clicked, enumerator_, &IkSolutionEnumerator::cancel);
+
+  connect(metric_combo_box_, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this](int index) {
+    model_->setRankMetric(static_cast<IkRankMetric>(index));
+  });
+  connect(ghost_count_spin_box_, QOverload<int>::of(&QSpinBox::valueChanged), this, &IkSolutionsWidget::updateGhosts);
+
+  // Streamed solutions are inserted one row at a time, the model emits layoutChanged() once per metric change
+  connect(model_, &IkSolutionModel::rowsInserted, this, &IkSolutionsWidget::updateGhosts);
+  connect(model_, &IkSolutionModel::rowsInserted, this, &IkSolutionsWidget::updateStatus);
+  connect(model_, &IkSolutionModel::layoutChanged, this, &IkSolutionsWidget::updateGhosts);
+  connect(model_, &IkSolutionModel::modelReset, this, &IkSolutionsWidget::updateGhosts);
+  connect(model_, &IkSolutionModel::modelReset, this, &IkSolutionsWidget::updateStatus);
+  connect(table_view_->selectionModel(),
+          &QItemSelectionModel::selectionChanged,
+          this,
+          &IkSolutionsWidget::onSelectionChanged);
+
+  setEnabled(false);
+  updateStatus();
+}
+
+void IkSolutionsWidget::setEnvironment(tesseract_environment::Environment::ConstPtr environment)
+{
+  enumerator_->cancel();
+  environment_ = std::move(environment);
+  setEnabled(environment_ != nullptr);
+}
+
+tesseract_environment::Environment::ConstPtr IkSolutionsWidget::getEnvironment() const { return environment_; }
+
+void IkSolutionsWidget::setScene(RenderScene::Ptr scene)
+{
+  if (scene_ != nullptr)
+    scene_->clearGhosts();
+
+  scene_ = std::move(scene);
+  updateGhosts();
+}
+
+RenderScene::Ptr IkSolutionsWidget::getScene() const { return scene_; }
+
+IkSolutionModel* IkSolutionsWidget::getModel() const { return model_; }
+
+IkSolutionEnumerator* IkSolutionsWidget::getEnumerator() const { return enumerator_; }
+
+void IkSolutionsWidget::solve(const std::string& group_name,
+                              const tesseract_kinematics::KinGroupIKInputs& targets,
+                              const Eigen::VectorXd& current_joint_values)
+{
+  if (environment_ == nullptr)
+    return;
+
+  IkSolutionEnumerator::Settings settings;
+  settings.restart_count = static_cast<std::size_t>(restart_count_spin_box_->value());
+  settings.seed = static_cast<std::uint64_t>(seed_spin_box_->value());
+  if (scene_ != nullptr)
+    settings.link_names = scene_->getLinkNames();
+
+  try
+  {
+    enumerator_->start(*environment_, group_name, targets, current_joint_values, settings);
+  }
+  catch (const std::exception& e)
+  {
+    model_->clear();
+    status_label_->setText(QString("Solving failed: %1").arg(e.what()));
+    return;
+  }
+
+  model_->setJointNames(enumerator_->getJointNames());
+  cancel_button_->setEnabled(true);
+}
+
+void IkSolutionsWidget::clear()
+{
+  enumerator_->cancel();
+  model_->clear();
+}
+
+int IkSolutionsWidget::getSelectedRow() const
+{
+  const QModelIndexList rows = table_view_->selectionModel()->selectedRows();
+  return rows.empty() ? -1 : rows.front().row();
+}
+
+void IkSolutionsWidget::updateGhosts()
+{
+  if (scene_ == nullptr)
+    return;
+
+  // Large scenes fit fewer ghosts into the link transforms of the renderer, one is kept for the selected solution
+  const auto max_ghost_count = static_cast<int>(
+      std::min<std::size_t>(MAX_GHOST_COUNT, std::max<std::size_t>(scene_->getMaxGhostCount(), 1) - 1));
+  if (ghost_count_spin_box_->maximum() != max_ghost_count)
+  {
+    const QSignalBlocker blocker(ghost_count_spin_box_);
+    ghost_count_spin_box_->setMaximum(max_ghost_count);
+  }
+
+  // Solutions of a scene whose links changed since solving can not be drawn
+  const std::size_t size = scene_->getLinkNames().size() * LinkTransformBatch::MATRIX_SIZE;
+  const int selected_row = getSelectedRow();
+  const int count = std::min(model_->rowCount(), ghost_count_spin_box_->value());
+
+  std::vector<float> link_transforms;
+  tesseract_common::AlignedVector<Eigen::Vector4f> colors;
+  auto add_ghost = [&](int row, const Eigen::Vector4f& color) {
+    const IkSolution& solution = model_->getSolution(row);
+    if (solution.link_transforms.size() != size)
+      return;
+
+    link_transforms.insert(link_transforms.end(), solution.link_transforms.begin(), solution.link_transforms.end());
+    colors.push_back(color);
+  };
+
+  for (int row = 0; row < count; ++row)
+  {
+    if (row == selected_row)
+      continue;
+
+    const float t = (count > 1) ? static_cast<float>(row) / static_cast<float>(count - 1) : 0.0F;
+    add_ghost(row, ((1.0F - t) * BEST_GHOST_COLOR) + (t * WORST_GHOST_COLOR));
+  }
+
+  // Drawn last so it blends over the others
+  if (selected_row >= 0)
+    add_ghost(selected_row, SELECTED_GHOST_COLOR);
+
+  const std::size_t previous_dropped_ghost_count = dropped_ghost_count_;
+  dropped_ghost_count_ = 0;
+  if (colors.empty())
+    scene_->clearGhosts();
+  else
+    dropped_ghost_count_ =
+        colors.size() - scene_->setGhosts(link_transforms.data(), colors, enumerator_->getActiveLinkNames());
+
+  if (dropped_ghost_count_ != previous_dropped_ghost_count)
+    updateStatus();
+
+  emit sceneChanged();
+}
+
+void IkSolutionsWidget::updateStatus()
+{
+  QString text = QString("%1 solutions").arg(model_->rowCount());
+  if (dropped_ghost_count_ > 0)
+    text += QString(", %1 ghosts dropped, the scene has too many links").arg(dropped_ghost_count_);
+  status_label_->setText(text);
+}
+
+void IkSolutionsWidget::onSelectionChanged()
+{
+  updateGhosts();
+
+  const int row = getSelectedRow();
+  if (row >= 0)
+    emit solutionSelected(model_->getJointNames(), model_->getSolution(row).joint_values);
+}
+
+void IkSolutionsWidget::onFinished(bool cancelled)
+{
+  cancel_button_->setEnabled(false);
+  if (cancelled)
+    progress_bar_->setValue(0);
+}
+
+}  // namespace tesseract_gui
@@ -0,0 +1,38 @@
+/**
+ * @file manipulability.cpp
+ * @brief The manipulability measure of a Jacobian
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <cmath>
+#include <Eigen/LU>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/kinematics/manipulability.h>
+
+namespace tesseract_gui
+{
+double getManipulability(const Eigen::MatrixXd& jacobian)
+{
+  const double determinant = (jacobian.cols() < jacobian.rows()) ? (jacobian.transpose() * jacobian).determinant() :
+                                                                    (jacobian * jacobian.transpose()).determinant();
+
+  // Clamped, rounding makes the determinant slightly negative in singularities
+  return std::sqrt(std::max(0.0, determinant));
+}
+
+}  // namespace tesseract_gui
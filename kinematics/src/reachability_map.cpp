@@ -0,0 +1,227 @@
+/**
+ * @file reachability_map.cpp
+ * @brief Per voxel reachability and orientation coverage of a kinematic group with a binary file format
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/kinematics/reachability_map.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+constexpr std::array<char, 8> FILE_MAGIC{ 'T', 'G', 'U', 'I', 'R', 'M', 'A', 'P' };
+
+/** @brief The fixed size part of the file, followed by the two frame names and the arrays */
+struct FileHeader
+{
+  std::array<char, 8> magic;
+  std::uint32_t version;
+  std::uint32_t orientation_count;
+  std::array<std::int32_t, 3> size;
+  std::uint32_t working_frame_length;
+  std::uint32_t tip_link_name_length;
+  std::uint32_t reserved;
+  double resolution;
+  std::array<double, 3> origin;
+};
+
+std::size_t getWordCount(std::size_t voxel_count) { return (voxel_count + 63) / 64; }
+
+template <typename T>
+void write(std::ofstream& file, const T* data, std::size_t count)
+{
+  file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+}
+
+template <typename T>
+void read(std::ifstream& file, T* data, std::size_t count)
+{
+  file.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+}
+}  // namespace
+
+ReachabilityMap::ReachabilityMap(const Eigen::Vector3d& origin,
+                                 double resolution,
+                                 const Eigen::Vector3i& size,
+                                 std::size_t orientation_count)
+  : origin_(origin), resolution_(resolution), size_(size), orientation_count_(orientation_count)
+{
+  if (resolution <= 0 || (size.array() <= 0).any() || orientation_count == 0)
+    throw std::runtime_error("ReachabilityMap, resolution, size and orientation count must be positive!");
+
+  reachable_.resize(getWordCount(getVoxelCount()), 0);
+  coverage_.resize(getVoxelCount(), 0);
+}
+
+void ReachabilityMap::setWorkingFrame(std::string working_frame) { working_frame_ = std::move(working_frame); }
+
+const std::string& ReachabilityMap::getWorkingFrame() const { return working_frame_; }
+
+void ReachabilityMap::setTipLinkName(std::string tip_link_name) { tip_link_name_ = std::move(tip_link_name); }
+
+const std::string& ReachabilityMap::getTipLinkName() const { return tip_link_name_; }
+
+const Eigen::Vector3d& ReachabilityMap::getOrigin() const { return origin_; }
+
+double ReachabilityMap::getResolution() const { return resolution_; }
+
+const Eigen::Vector3i& ReachabilityMap::getSize() const { return size_; }
+
+std::size_t ReachabilityMap::getOrientationCount() const { return orientation_count_; }
+
+std::size_t ReachabilityMap::getVoxelCount() const
+{
+  return static_cast<std::size_t>(size_.x()) * static_cast<std::size_t>(size_.y()) *
+         static_cast<std::size_t>(size_.z());
+}
+
+std::size_t ReachabilityMap::getIndex(int x, int y, int z) const
+{
+  const auto size_x = static_cast<std::size_t>(size_.x());
+  const auto size_y = static_cast<std::size_t>(size_.y());
+  const std::size_t slice = static_cast<std::size_t>(y) + (size_y * static_cast<std::size_t>(z));
+  return static_cast<std::size_t>(x) + (size_x * slice);
+}
+
+Eigen::Vector3d ReachabilityMap::getVoxelCenter(std::size_t index) const
+{
+  const auto size_x = static_cast<std::size_t>(size_.x());
+  const auto size_y = static_cast<std::size_t>(size_.y());
+  const Eigen::Vector3d voxel(static_cast<double>(index % size_x),
+                              static_cast<double>((index / size_x) % size_y),
+                              static_cast<double>(index / (size_x * size_y)));
+  return origin_ + ((voxel.array() + 0.5) * resolution_).matrix();
+}
+
+void ReachabilityMap::setCoverage(std::size_t index, float coverage)
+{
+  const bool was_reachable = isReachable(index);
+  const bool reachable = (coverage > 0);
+  const std::uint64_t bit = std::uint64_t{ 1 } << (index % 64);
+  if (reachable)
+    reachable_[index / 64] |= bit;
+  else
+    reachable_[index / 64] &= ~bit;
+
+  if (reachable != was_reachable)
+    reachable_count_ = reachable ? reachable_count_ + 1 : reachable_count_ - 1;
+
+  coverage_[index] = coverage;
+  ++revision_;
+}
+
+float ReachabilityMap::getCoverage(std::size_t index) const { return coverage_[index]; }
+
+bool ReachabilityMap::isReachable(std::size_t index) const
+{
+  return ((reachable_[index / 64] >> (index % 64)) & 1U) != 0;
+}
+
+std::size_t ReachabilityMap::getReachableCount() const { return reachable_count_; }
+
+const std::vector<std::uint64_t>& ReachabilityMap::getReachableBits() const { return reachable_; }
+
+const std::vector<float>& ReachabilityMap::getCoverage() const { return coverage_; }
+
+std::uint64_t ReachabilityMap::getRevision() const { return revision_; }
+
+void ReachabilityMap::save(const std::string& path) const
+{
+  std::ofstream file(path, std::ios::binary);
+  if (!file)
+    throw std::runtime_error("ReachabilityMap, failed to open '" + path + "'!");
+
+  FileHeader header{};
+  header.magic = FILE_MAGIC;
+  header.version = FILE_VERSION;
+  header.orientation_count = static_cast<std::uint32_t>(orientation_count_);
+  header.size = { size_.x(), size_.y(), size_.z() };
+  header.working_frame_length = static_cast<std::uint32_t>(working_frame_.size());
+  header.tip_link_name_length = static_cast<std::uint32_t>(tip_link_name_.size());
+  header.resolution = resolution_;
+  header.origin = { origin_.x(), origin_.y(), origin_.z() };
+
+  write(file, &header, 1);
+  write(file, working_frame_.data(), working_frame_.size());
+  write(file, tip_link_name_.data(), tip_link_name_.size());
+  write(file, reachable_.data(), reachable_.size());
+  write(file, coverage_.data(), coverage_.size());
+  if (!file)
+    throw std::runtime_error("ReachabilityMap, failed to write '" + path + "'!");
+}
+
+ReachabilityMap ReachabilityMap::load(const std::string& path)
+{
+  std::ifstream file(path, std::ios::binary);
+  if (!file)
+    throw std::runtime_error("ReachabilityMap, failed to open '" + path + "'!");
+
+  FileHeader header{};
+  read(file, &header, 1);
+  if (!file || header.magic != FILE_MAGIC)
+    throw std::runtime_error("ReachabilityMap, '" + path + "' is not a reachability map!");
+
+  if (header.version != FILE_VERSION)
+    throw std::runtime_error("ReachabilityMap, '" + path + "' has unsupported version " +
+                             std::to_string(header.version) + "!");
+
+  // Checked before allocating, a corrupt size would otherwise allocate arbitrary amounts of memory
+  const auto header_end = static_cast<std::size_t>(file.tellg());
+  file.seekg(0, std::ios::end);
+  const auto file_size = static_cast<std::size_t>(file.tellg());
+  file.seekg(static_cast<std::streamoff>(header_end));
+
+  std::size_t voxel_count{ 1 };
+  for (const std::int32_t size : header.size)
+    voxel_count *= static_cast<std::size_t>(std::max(size, 0));
+
+  const std::size_t expected_size = header_end + header.working_frame_length + header.tip_link_name_length +
+                                    (getWordCount(voxel_count) * sizeof(std::uint64_t)) +
+                                    (voxel_count * sizeof(float));
+  if (file_size != expected_size)
+    throw std::runtime_error("ReachabilityMap, '" + path + "' does not match the size of its grid!");
+
+  ReachabilityMap map(Eigen::Vector3d(header.origin[0], header.origin[1], header.origin[2]),
+                      header.resolution,
+                      Eigen::Vector3i(header.size[0], header.size[1], header.size[2]),
+                      header.orientation_count);
+
+  map.working_frame_.resize(header.working_frame_length);
+  map.tip_link_name_.resize(header.tip_link_name_length);
+  read(file, &map.working_frame_[0], map.working_frame_.size());
+  read(file, &map.tip_link_name_[0], map.tip_link_name_.size());
+  read(file, map.reachable_.data(), map.reachable_.size());
+  read(file, map.coverage_.data(), map.coverage_.size());
+  if (!file)
+    throw std::runtime_error("ReachabilityMap, '" + path + "' is truncated!");
+
+  // Padding bits past the last voxel are not counted, they are never set by setCoverage()
+  for (const std::uint64_t word : map.reachable_)
+    map.reachable_count_ += std::bitset<64>(word).count();
+
+  return map;
+}
+
+}  // namespace tesseract_gui
@@ -0,0 +1,253 @@
+/**
+ * @file reachability_map_generator.cpp
+ * @brief Generates the reachability map of a kinematic group on worker threads
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/common/frame_interval.h>
+#include <tesseract_gui/common/instrumentation.h>
+#include <tesseract_gui/common/splitmix_random.h>
+#include <tesseract_gui/kinematics/reachability_map_generator.h>
+
+namespace tesseract_gui
+{
+ReachabilityMapGenerator::ReachabilityMapGenerator(QObject* parent) : QObject(parent)
+{
+  frame_timer_.setTimerType(Qt::PreciseTimer);
+  frame_timer_.setInterval(getDefaultFrameInterval());
+  connect(&frame_timer_, &QTimer::timeout, this, &ReachabilityMapGenerator::report);
+}
+
+ReachabilityMapGenerator::~ReachabilityMapGenerator() { stop(); }
+
+void ReachabilityMapGenerator::start(const tesseract_environment::Environment& environment,
+                                     const std::string& group_name,
+                                     const Settings& settings)
+{
+  if (settings.bounds.isEmpty() || settings.resolution <= 0 || settings.orientation_count == 0)
+    throw std::runtime_error("ReachabilityMapGenerator, bounds, resolution and orientation count must not be empty!");
+
+  stop();
+  frame_timer_.stop();
+
+  const Eigen::Vector3d sizes = settings.bounds.sizes() / settings.resolution;
+  auto map = std::make_shared<ReachabilityMap>(
+      settings.bounds.min(), settings.resolution, sizes.array().ceil().max(1).cast<int>(), settings.orientation_count);
+
+  std::size_t thread_count = settings.thread_count;
+  if (thread_count == 0)
+    thread_count = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+  thread_count = std::max<std::size_t>(1, std::min(thread_count, map->getVoxelCount()));
+
+  // Kinematic groups keep internal state while solving, so every thread gets its own
+  std::vector<tesseract_kinematics::KinematicGroup::UPtr> groups;
+  groups.reserve(thread_count);
+  for (std::size_t i = 0; i < thread_count; ++i)
+  {
+    groups.push_back(environment.getKinematicGroup(group_name));
+    if (groups.back() == nullptr)
+      throw std::runtime_error("ReachabilityMapGenerator, failed to create kinematic group '" + group_name + "'!");
+  }
+
+  const tesseract_kinematics::KinematicGroup& group = *groups.front();
+  context_.working_frame = settings.working_frame.empty() ? group.getBaseLinkName() : settings.working_frame;
+  context_.tip_link_name = settings.tip_link_name;
+  if (context_.tip_link_name.empty())
+  {
+    const std::vector<std::string> tip_link_names = group.getAllPossibleTipLinkNames();
+    if (tip_link_names.empty())
+      throw std::runtime_error("ReachabilityMapGenerator, kinematic group '" + group_name + "' has no tip link!");
+
+    context_.tip_link_name = tip_link_names.front();
+  }
+  context_.orientations = getOrientations(settings.orientation_count);
+  context_.joint_limits = group.getLimits().joint_limits;
+  context_.settings = settings;
+
+  map->setWorkingFrame(context_.working_frame);
+  map->setTipLinkName(context_.tip_link_name);
+  map_ = std::move(map);
+
+  reported_voxels_ = 0;
+  next_voxel_ = 0;
+  cancelled_ = false;
+  {
+    std::scoped_lock lock(mutex_);
+    pending_.clear();
+    completed_voxels_ = 0;
+    finished_threads_ = 0;
+    error_.clear();
+  }
+
+  workers_.reserve(thread_count);
+  for (auto& group : groups)
+    workers_.emplace_back([this, group = std::move(group)]() mutable { run(std::move(group)); });
+
+  frame_timer_.start();
+  emit progressChanged(0, map_->getVoxelCount());
+}
+
+bool ReachabilityMapGenerator::isRunning() const { return !workers_.empty(); }
+
+ReachabilityMap::ConstPtr ReachabilityMapGenerator::getMap() const { return map_; }
+
+void ReachabilityMapGenerator::setFrameInterval(int msec) { frame_timer_.setInterval(msec); }
+
+int ReachabilityMapGenerator::getFrameInterval() const { return frame_timer_.interval(); }
+
+tesseract_common::VectorIsometry3d ReachabilityMapGenerator::getOrientations(std::size_t count)
+{
+  tesseract_common::VectorIsometry3d orientations;
+  orientations.reserve(count);
+
+  const double golden_angle = M_PI * (3.0 - std::sqrt(5.0));
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const double z = 1.0 - ((2.0 * (static_cast<double>(i) + 0.5)) / static_cast<double>(count));
+    const double radius = std::sqrt(1.0 - (z * z));
+    const double angle = golden_angle * static_cast<double>(i);
+    const Eigen::Vector3d direction(radius * std::cos(angle), radius * std::sin(angle), z);
+
+    Eigen::Isometry3d orientation = Eigen::Isometry3d::Identity();
+    orientation.linear() = Eigen::Quaterniond::FromTwoVectors(Eigen::Vector3d::UnitZ(), direction).toRotationMatrix();
+    orientations.push_back(orientation);
+  }
+
+  return orientations;
+}
+
+void ReachabilityMapGenerator::cancel() { cancelled_ = true; }
+
+void ReachabilityMapGenerator::stop()
+{
+  cancelled_ = true;
+  for (auto& worker : workers_)
+    worker.join();
+  workers_.clear();
+}
+
+void ReachabilityMapGenerator::run(tesseract_kinematics::KinematicGroup::UPtr group)
+{
+  const Settings& settings = context_.settings;
+  const Eigen::MatrixX2d& limits = context_.joint_limits;
+  const std::size_t orientation_count = context_.orientations.size();
+
+  // Only the grid of the map is read here, it does not change while the threads run
+  const ReachabilityMap& map = *map_;
+  const std::size_t voxel_count = map.getVoxelCount();
+
+  tesseract_kinematics::KinGroupIKInputs targets{ tesseract_kinematics::KinGroupIKInput(
+      Eigen::Isometry3d::Identity(), context_.working_frame, context_.tip_link_name) };
+  Eigen::VectorXd seed(limits.rows());
+  try
+  {
+    while (!cancelled_)
+    {
+      const std::size_t voxel = next_voxel_++;
+      if (voxel >= voxel_count)
+        break;
+
+      const ScopedTimer timer("kinematics", "reachability voxel");
+      const Eigen::Vector3d center = map.getVoxelCenter(voxel);
+      Eigen::VectorXd previous = limits.rowwise().mean();
+      SplitMixRandom random(settings.seed, voxel);
+      std::size_t reached{ 0 };
+      for (const auto& orientation : context_.orientations)
+      {
+        targets.front().pose = orientation;
+        targets.front().pose.translation() = center;
+
+        // Neighboring orientations usually have neighboring solutions, so the previous one converges fastest
+        tesseract_kinematics::IKSolutions solutions = group->calcInvKin(targets, previous);
+        for (std::size_t s = 0; s < settings.seed_count && solutions.empty(); ++s)
+        {
+          for (Eigen::Index j = 0; j < seed.size(); ++j)
+            seed[j] = limits(j, 0) + (random.next() * (limits(j, 1) - limits(j, 0)));
+          solutions = group->calcInvKin(targets, seed);
+        }
+
+        if (solutions.empty())
+          continue;
+
+        previous = solutions.front();
+        ++reached;
+      }
+
+      const float coverage = static_cast<float>(reached) / static_cast<float>(orientation_count);
+      std::scoped_lock lock(mutex_);
+      pending_.emplace_back(voxel, coverage);
+      ++completed_voxels_;
+    }
+  }
+  catch (const std::exception& e)
+  {
+    cancelled_ = true;
+    std::scoped_lock lock(mutex_);
+    if (error_.empty())
+      error_ = e.what();
+  }
+
+  std::scoped_lock lock(mutex_);
+  ++finished_threads_;
+}
+
+void ReachabilityMapGenerator::report()
+{
+  std::vector<std::pair<std::size_t, float>> voxels;
+  std::size_t completed_voxels{ 0 };
+  bool all_finished{ false };
+  std::string error;
+  {
+    std::scoped_lock lock(mutex_);
+    voxels.swap(pending_);
+    completed_voxels = completed_voxels_;
+    all_finished = (finished_threads_ == workers_.size());
+    error = error_;
+  }
+
+  if (!voxels.empty())
+  {
+    for (const auto& voxel : voxels)
+      map_->setCoverage(voxel.first, voxel.second);
+
+    recordCounter("kinematics", "reachable voxels", static_cast<std::int64_t>(map_->getReachableCount()));
+    emit mapChanged();
+  }
+
+  if (completed_voxels != reported_voxels_)
+  {
+    reported_voxels_ = completed_voxels;
+    emit progressChanged(completed_voxels, map_->getVoxelCount());
+  }
+
+  if (!all_finished)
+    return;
+
+  frame_timer_.stop();
+  stop();
+
+  if (!error.empty())
+    emit generationFailed(QString::fromStdString(error));
+
+  emit finished(reported_voxels_ < map_->getVoxelCount());
+}
+
+}  // namespace tesseract_gui
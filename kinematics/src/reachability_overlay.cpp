@@ -0,0 +1,261 @@
+/**
+ * @file reachability_overlay.cpp
+ * @brief Draws the reachable voxels of a reachability map colored by orientation coverage
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cstddef>
+#include <stdexcept>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/common/instrumentation.h>
+#include <tesseract_gui/kinematics/reachability_overlay.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+const char* VERTEX_SHADER = R"(
+#version 330 core
+layout(location = 0) in vec3 vertex;
+layout(location = 1) in vec3 normal;
+layout(location = 2) in vec3 center;
+layout(location = 3) in float coverage;
+
+uniform mat4 model_view_projection;
+uniform float voxel_size;
+
+out vec3 frag_normal;
+out vec3 frag_color;
+
+void main()
+{
+  frag_normal = normal;
+
+  // Red over yellow to green
+  frag_color = vec3(clamp(2.0 - (2.0 * coverage), 0.0, 1.0), clamp(2.0 * coverage, 0.0, 1.0), 0.1);
+  gl_Position = model_view_projection * vec4(center + (vertex * voxel_size), 1.0);
+}
+)";
+
+const char* FRAGMENT_SHADER = R"(
+#version 330 core
+in vec3 frag_normal;
+in vec3 frag_color;
+
+out vec4 fragment_color;
+
+void main()
+{
+  float shade = 0.55 + (0.45 * abs(dot(normalize(frag_normal), normalize(vec3(0.3, 0.5, 0.8)))));
+  fragment_color = vec4(frag_color * shade, 1.0);
+}
+)";
+
+/** @brief The triangles of the unit cube centered at the origin, position and normal per vertex */
+std::vector<float> createUnitCube()
+{
+  std::vector<float> vertices;
+  vertices.reserve(36 * 6);
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    for (const float side : { -0.5F, 0.5F })
+    {
+      const int u = (axis + 1) % 3;
+      const int v = (axis + 2) % 3;
+      const float corners[4][2] = { { -0.5F, -0.5F }, { 0.5F, -0.5F }, { 0.5F, 0.5F }, { -0.5F, 0.5F } };
+
+      // Counter clockwise seen from outside of the face
+      const int order[2][6] = { { 0, 2, 1, 0, 3, 2 }, { 0, 1, 2, 0, 2, 3 } };
+      for (const int corner : order[(side > 0) ? 1 : 0])
+      {
+        float position[3];
+        position[axis] = side;
+        position[u] = corners[corner][0];
+        position[v] = corners[corner][1];
+
+        float normal[3] = { 0, 0, 0 };
+        normal[axis] = (side > 0) ? 1.0F : -1.0F;
+
+        vertices.insert(vertices.end(), position, position + 3);
+        vertices.insert(vertices.end(), normal, normal + 3);
+      }
+    }
+  }
+  return vertices;
+}
+}  // namespace
+
+void ReachabilityOverlay::setMap(ReachabilityMap::ConstPtr map)
+{
+  map_ = std::move(map);
+  instances_dirty_ = true;
+}
+
+ReachabilityMap::ConstPtr ReachabilityOverlay::getMap() const { return map_; }
+
+void ReachabilityOverlay::setOrigin(const Eigen::Isometry3d& origin) { origin_ = origin; }
+
+const Eigen::Isometry3d& ReachabilityOverlay::getOrigin() const { return origin_; }
+
+void ReachabilityOverlay::setMinCoverage(float min_coverage)
+{
+  min_coverage_ = min_coverage;
+  instances_dirty_ = true;
+}
+
+float ReachabilityOverlay::getMinCoverage() const { return min_coverage_; }
+
+void ReachabilityOverlay::setVoxelScale(float scale) { voxel_scale_ = scale; }
+
+float ReachabilityOverlay::getVoxelScale() const { return voxel_scale_; }
+
+void ReachabilityOverlay::setVisible(bool visible) { visible_ = visible; }
+
+bool ReachabilityOverlay::isVisible() const { return visible_; }
+
+void ReachabilityOverlay::initialize(QOpenGLExtraFunctions& gl)
+{
+  program_ = std::make_unique<QOpenGLShaderProgram>();
+  if (!program_->addShaderFromSourceCode(QOpenGLShader::Vertex, VERTEX_SHADER) ||
+      !program_->addShaderFromSourceCode(QOpenGLShader::Fragment, FRAGMENT_SHADER) || !program_->link())
+    throw std::runtime_error("ReachabilityOverlay, failed to build shader program: " + program_->log().toStdString());
+
+  model_view_projection_location_ = program_->uniformLocation("model_view_projection");
+  voxel_size_location_ = program_->uniformLocation("voxel_size");
+
+  gl.glGenVertexArrays(1, &vao_);
+  gl.glBindVertexArray(vao_);
+
+  const std::vector<float> cube = createUnitCube();
+  gl.glGenBuffers(1, &vertex_buffer_);
+  gl.glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_);
+  gl.glBufferData(
+      GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(cube.size() * sizeof(float)), cube.data(), GL_STATIC_DRAW);
+  gl.glEnableVertexAttribArray(0);
+  gl.glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), nullptr);
+  gl.glEnableVertexAttribArray(1);
+  gl.glVertexAttribPointer(
+      1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), reinterpret_cast<const void*>(3 * sizeof(float)));
+
+  const auto stride = static_cast<GLsizei>(sizeof(Instance));
+  gl.glGenBuffers(1, &instance_buffer_);
+  gl.glBindBuffer(GL_ARRAY_BUFFER, instance_buffer_);
+  gl.glEnableVertexAttribArray(2);
+  gl.glVertexAttribPointer(
+      2, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const void*>(offsetof(Instance, center)));
+  gl.glVertexAttribDivisor(2, 1);
+  gl.glEnableVertexAttribArray(3);
+  gl.glVertexAttribPointer(
+      3, 1, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const void*>(offsetof(Instance, coverage)));
+  gl.glVertexAttribDivisor(3, 1);
+
+  gl.glBindVertexArray(0);
+  gl.glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  // The new buffer is empty
+  instance_count_ = 0;
+  upload_pending_ = true;
+}
+
+void ReachabilityOverlay::cleanup(QOpenGLExtraFunctions& gl)
+{
+  gl.glDeleteBuffers(1, &instance_buffer_);
+  gl.glDeleteBuffers(1, &vertex_buffer_);
+  gl.glDeleteVertexArrays(1, &vao_);
+  instance_buffer_ = 0;
+  vertex_buffer_ = 0;
+  vao_ = 0;
+  instance_count_ = 0;
+  program_.reset();
+}
+
+void ReachabilityOverlay::render(QOpenGLExtraFunctions& gl,
+                                 const Eigen::Matrix4f& view_projection,
+                                 const Camera& /*camera*/)
+{
+  if (instances_dirty_ || (map_ != nullptr && map_->getRevision() != map_revision_))
+    updateInstances();
+
+  uploadInstances(gl);
+
+  if (!visible_ || instance_count_ == 0)
+    return;
+
+  const Eigen::Matrix4f model_view_projection = view_projection * origin_.matrix().cast<float>();
+
+  program_->bind();
+  gl.glUniformMatrix4fv(model_view_projection_location_, 1, GL_FALSE, model_view_projection.data());
+  gl.glUniform1f(voxel_size_location_, voxel_scale_ * static_cast<float>(map_->getResolution()));
+
+  gl.glBindVertexArray(vao_);
+  gl.glDrawArraysInstanced(GL_TRIANGLES, 0, 36, instance_count_);
+
+  gl.glBindVertexArray(0);
+  program_->release();
+}
+
+void ReachabilityOverlay::updateInstances()
+{
+  const ScopedTimer timer("kinematics", "reachability instances");
+  instances_.clear();
+  instances_dirty_ = false;
+  upload_pending_ = true;
+  if (map_ == nullptr)
+    return;
+
+  map_revision_ = map_->getRevision();
+  instances_.reserve(map_->getReachableCount());
+
+  const std::vector<std::uint64_t>& bits = map_->getReachableBits();
+  const std::vector<float>& coverage = map_->getCoverage();
+  for (std::size_t w = 0; w < bits.size(); ++w)
+  {
+    for (std::uint64_t word = bits[w]; word != 0; word &= word - 1)
+    {
+      // Lowest set bit first
+      std::size_t bit{ 0 };
+      while (((word >> bit) & 1U) == 0)
+        ++bit;
+
+      const std::size_t index = (w * 64) + bit;
+      if (coverage[index] < min_coverage_)
+        continue;
+
+      const Eigen::Vector3f center = map_->getVoxelCenter(index).cast<float>();
+      instances_.push_back({ { center.x(), center.y(), center.z() }, coverage[index] });
+    }
+  }
+}
+
+void ReachabilityOverlay::uploadInstances(QOpenGLExtraFunctions& gl)
+{
+  if (!upload_pending_)
+    return;
+
+  // Rebuilt instances are uploaded in one piece into a new buffer, the driver keeps the old one until drawn
+  gl.glBindBuffer(GL_ARRAY_BUFFER, instance_buffer_);
+  gl.glBufferData(GL_ARRAY_BUFFER,
+                  static_cast<GLsizeiptr>(instances_.size() * sizeof(Instance)),
+                  instances_.empty() ? nullptr : instances_.data(),
+                  GL_DYNAMIC_DRAW);
+  gl.glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  instance_count_ = static_cast<GLsizei>(instances_.size());
+  upload_pending_ = false;
+}
+
+}  // namespace tesseract_gui
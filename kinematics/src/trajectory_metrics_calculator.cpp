@@ -0,0 +1,259 @@
+/**
+ * @file trajectory_metrics_calculator.cpp
+ * @brief Computes the manipulability and joint limit margins of every waypoint of a trajectory on a worker thread
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/common/frame_interval.h>
+#include <tesseract_gui/common/instrumentation.h>
+#include <tesseract_gui/kinematics/manipulability.h>
+#include <tesseract_gui/kinematics/trajectory_metrics_calculator.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+/** @brief The number of waypoints between cancellation checks and progress updates */
+constexpr Eigen::Index BLOCK_SIZE = 1024;
+}  // namespace
+
+std::size_t TrajectoryMetrics::getWaypointCount() const { return manipulability.size(); }
+
+float TrajectoryMetrics::getValue(TrajectoryMetric metric, std::size_t waypoint) const
+{
+  switch (metric)
+  {
+    case TrajectoryMetric::MANIPULABILITY:
+      return (max_manipulability > 0) ? manipulability[waypoint] / max_manipulability : 0.0F;
+    case TrajectoryMetric::LIMIT_MARGIN:
+      return 2.0F * limit_margin[waypoint];
+  }
+  return 0;
+}
+
+float TrajectoryMetrics::getJointValue(std::size_t joint, std::size_t waypoint) const
+{
+  return 2.0F * joint_limit_margins(static_cast<Eigen::Index>(joint), static_cast<Eigen::Index>(waypoint));
+}
+
+TrajectoryMetricsCalculator::TrajectoryMetricsCalculator(QObject* parent) : QObject(parent)
+{
+  frame_timer_.setTimerType(Qt::PreciseTimer);
+  frame_timer_.setInterval(getDefaultFrameInterval());
+  connect(&frame_timer_, &QTimer::timeout, this, &TrajectoryMetricsCalculator::report);
+}
+
+TrajectoryMetricsCalculator::~TrajectoryMetricsCalculator() { stop(); }
+
+void TrajectoryMetricsCalculator::start(const tesseract_environment::Environment& environment,
+                                        const std::string& group_name,
+                                        const std::string& tcp_link_name,
+                                        const tesseract_common::JointTrajectory& trajectory)
+{
+  if (trajectory.empty())
+    throw std::runtime_error("TrajectoryMetricsCalculator, trajectory is empty!");
+
+  stop();
+  frame_timer_.stop();
+
+  tesseract_kinematics::JointGroup::UPtr group = environment.getJointGroup(group_name);
+  if (group == nullptr)
+    throw std::runtime_error("TrajectoryMetricsCalculator, failed to create joint group '" + group_name + "'!");
+
+  auto metrics = std::make_shared<TrajectoryMetrics>();
+  metrics->joint_names = group->getJointNames();
+  metrics->active_link_names = group->getActiveLinkNames();
+  if (std::find(metrics->active_link_names.begin(), metrics->active_link_names.end(), tcp_link_name) ==
+      metrics->active_link_names.end())
+    throw std::runtime_error("TrajectoryMetricsCalculator, '" + tcp_link_name + "' is not moved by the group!");
+
+  const tesseract_scene_graph::SceneGraph::ConstPtr scene_graph = environment.getSceneGraph();
+  for (const auto& joint_name : metrics->joint_names)
+  {
+    const tesseract_scene_graph::Joint::ConstPtr joint = scene_graph->getJoint(joint_name);
+    metrics->joint_child_link_names.push_back((joint != nullptr) ? joint->child_link_name : std::string());
+  }
+
+  const Eigen::VectorXd current_joint_values = environment.getCurrentJointValues(metrics->joint_names);
+
+  total_ = trajectory.size();
+  reported_ = 0;
+  completed_ = 0;
+  cancelled_ = false;
+  done_ = false;
+  {
+    std::scoped_lock lock(mutex_);
+    result_.reset();
+    error_.clear();
+  }
+
+  worker_ = std::thread([this,
+                         group = std::move(group),
+                         tcp_link_name,
+                         trajectory,
+                         current_joint_values,
+                         metrics = std::move(metrics)]() mutable {
+    run(std::move(group), tcp_link_name, trajectory, current_joint_values, std::move(metrics));
+  });
+
+  frame_timer_.start();
+  emit progressChanged(0, total_);
+}
+
+bool TrajectoryMetricsCalculator::isRunning() const { return worker_.joinable(); }
+
+TrajectoryMetrics::ConstPtr TrajectoryMetricsCalculator::getMetrics() const { return metrics_; }
+
+void TrajectoryMetricsCalculator::setFrameInterval(int msec) { frame_timer_.setInterval(msec); }
+
+int TrajectoryMetricsCalculator::getFrameInterval() const { return frame_timer_.interval(); }
+
+void TrajectoryMetricsCalculator::cancel() { cancelled_ = true; }
+
+void TrajectoryMetricsCalculator::stop()
+{
+  cancelled_ = true;
+  if (worker_.joinable())
+    worker_.join();
+}
+
+void TrajectoryMetricsCalculator::run(tesseract_kinematics::JointGroup::UPtr group,
+                                      const std::string& tcp_link_name,
+                                      const tesseract_common::JointTrajectory& trajectory,
+                                      const Eigen::VectorXd& current_joint_values,
+                                      TrajectoryMetrics::Ptr metrics)
+{
+  try
+  {
+    const ScopedTimer timer("kinematics", "trajectory metrics");
+    const auto joint_count = static_cast<Eigen::Index>(metrics->joint_names.size());
+    const auto waypoint_count = static_cast<Eigen::Index>(trajectory.size());
+
+    // Gather the joint values of all waypoints in group order, joints of a waypoint are looked up once per layout
+    Eigen::MatrixXd joint_values = current_joint_values.replicate(1, waypoint_count);
+    std::unordered_map<std::string, Eigen::Index> joint_index;
+    for (Eigen::Index j = 0; j < joint_count; ++j)
+      joint_index[metrics->joint_names[static_cast<std::size_t>(j)]] = j;
+
+    const std::vector<std::string>* layout{ nullptr };
+    std::vector<std::pair<Eigen::Index, Eigen::Index>> mapping;
+    for (Eigen::Index w = 0; w < waypoint_count; ++w)
+    {
+      const tesseract_common::JointState& waypoint = trajectory[static_cast<std::size_t>(w)];
+      if (layout == nullptr || waypoint.joint_names != *layout)
+      {
+        layout = &waypoint.joint_names;
+        mapping.clear();
+        for (std::size_t i = 0; i < layout->size(); ++i)
+        {
+          auto it = joint_index.find((*layout)[i]);
+          if (it != joint_index.end() && static_cast<Eigen::Index>(i) < waypoint.position.size())
+            mapping.emplace_back(it->second, static_cast<Eigen::Index>(i));
+        }
+      }
+
+      for (const auto& m : mapping)
+        joint_values(m.first, w) = waypoint.position[m.second];
+    }
+
+    // The limit margins of all waypoints at once
+    const Eigen::MatrixX2d limits = group->getLimits().joint_limits;
+    const Eigen::ArrayXd lower = limits.col(0);
+    const Eigen::ArrayXd upper = limits.col(1);
+    const Eigen::ArrayXd range = (upper - lower).max(std::numeric_limits<double>::epsilon());
+    const Eigen::ArrayXXd to_lower = joint_values.array().colwise() - lower;
+    const Eigen::ArrayXXd to_upper = (-joint_values.array()).colwise() + upper;
+    metrics->joint_limit_margins = (to_lower.min(to_upper).colwise() / range).max(0.0).min(0.5).cast<float>();
+
+    const Eigen::RowVectorXf limit_margin = metrics->joint_limit_margins.colwise().minCoeff();
+    metrics->limit_margin.assign(limit_margin.data(), limit_margin.data() + limit_margin.size());
+
+    // Jacobians and tool center points depend on the configuration, they are evaluated per waypoint
+    metrics->tcp_positions.resize(3 * static_cast<std::size_t>(waypoint_count));
+    metrics->manipulability.resize(static_cast<std::size_t>(waypoint_count));
+    for (Eigen::Index begin = 0; begin < waypoint_count && !cancelled_; begin += BLOCK_SIZE)
+    {
+      const Eigen::Index end = std::min<Eigen::Index>(begin + BLOCK_SIZE, waypoint_count);
+      for (Eigen::Index w = begin; w < end; ++w)
+      {
+        const auto i = static_cast<std::size_t>(w);
+        const Eigen::MatrixXd jacobian = group->calcJacobian(joint_values.col(w), tcp_link_name);
+        metrics->manipulability[i] = static_cast<float>(getManipulability(jacobian));
+
+        const Eigen::Vector3d tcp = group->calcFwdKin(joint_values.col(w)).at(tcp_link_name).translation();
+        metrics->tcp_positions[3 * i] = static_cast<float>(tcp.x());
+        metrics->tcp_positions[(3 * i) + 1] = static_cast<float>(tcp.y());
+        metrics->tcp_positions[(3 * i) + 2] = static_cast<float>(tcp.z());
+      }
+      completed_ = static_cast<std::size_t>(end);
+    }
+
+    metrics->max_manipulability = *std::max_element(metrics->manipulability.begin(), metrics->manipulability.end());
+
+    std::scoped_lock lock(mutex_);
+    if (!cancelled_)
+      result_ = std::move(metrics);
+  }
+  catch (const std::exception& e)
+  {
+    std::scoped_lock lock(mutex_);
+    error_ = e.what();
+  }
+
+  done_ = true;
+}
+
+void TrajectoryMetricsCalculator::report()
+{
+  const std::size_t completed = completed_;
+  if (completed != reported_)
+  {
+    reported_ = completed;
+    emit progressChanged(completed, total_);
+  }
+
+  if (!done_)
+    return;
+
+  frame_timer_.stop();
+  stop();
+
+  std::string error;
+  TrajectoryMetrics::Ptr result;
+  {
+    std::scoped_lock lock(mutex_);
+    error = error_;
+    result = std::move(result_);
+  }
+
+  if (!error.empty())
+    emit calculationFailed(QString::fromStdString(error));
+
+  const bool cancelled = (result == nullptr);
+  if (!cancelled)
+    metrics_ = std::move(result);
+
+  emit finished(cancelled);
+}
+
+}  // namespace tesseract_gui
@@ -0,0 +1,181 @@
+/**
+ * @file trajectory_metrics_display.cpp
+ * @brief Colors the tool center point path and the robot of a played trajectory by a trajectory metric
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/kinematics/trajectory_metrics_display.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+/** @brief Red over yellow to green like the path, tinting by TrajectoryMetricsDisplay::TINT */
+Eigen::Vector4f getColor(float value)
+{
+  return { std::clamp(2.0F - (2.0F * value), 0.0F, 1.0F),
+           std::clamp(2.0F * value, 0.0F, 1.0F),
+           0.1F,
+           TrajectoryMetricsDisplay::TINT };
+}
+
+std::vector<int> getLinkIndices(const RenderScene& scene, const std::vector<std::string>& link_names)
+{
+  std::vector<int> indices;
+  indices.reserve(link_names.size());
+  for (const auto& link_name : link_names)
+    indices.push_back(scene.getLinkIndex(link_name));
+  return indices;
+}
+}  // namespace
+
+TrajectoryMetricsDisplay::TrajectoryMetricsDisplay(QObject* parent)
+  : QObject(parent)
+  , calculator_(new TrajectoryMetricsCalculator(this))
+  , overlay_(std::make_shared<TrajectoryPathOverlay>())
+{
+  connect(calculator_, &TrajectoryMetricsCalculator::finished, this, &TrajectoryMetricsDisplay::onFinished);
+}
+
+void TrajectoryMetricsDisplay::setScene(RenderScene::Ptr scene)
+{
+  if (scene_ != nullptr)
+    scene_->clearLinkColors();
+
+  scene_ = std::move(scene);
+  updateLinkIndices();
+  updateLinkColors();
+}
+
+RenderScene::Ptr TrajectoryMetricsDisplay::getScene() const { return scene_; }
+
+void TrajectoryMetricsDisplay::setPlayer(TrajectoryPlayer* player)
+{
+  if (player_ != nullptr)
+    disconnect(player_, nullptr, this, nullptr);
+
+  player_ = player;
+  if (player_ != nullptr)
+  {
+    connect(player_, &TrajectoryPlayer::timeChanged, this, &TrajectoryMetricsDisplay::updateLinkColors);
+    connect(player_, &TrajectoryPlayer::timelineChanged, this, &TrajectoryMetricsDisplay::updateLinkColors);
+  }
+  updateLinkColors();
+}
+
+TrajectoryPlayer* TrajectoryMetricsDisplay::getPlayer() const { return player_; }
+
+TrajectoryMetric TrajectoryMetricsDisplay::getMetric() const { return metric_; }
+
+bool TrajectoryMetricsDisplay::isEnabled() const { return enabled_; }
+
+TrajectoryPathOverlay::Ptr TrajectoryMetricsDisplay::getOverlay() const { return overlay_; }
+
+TrajectoryMetricsCalculator* TrajectoryMetricsDisplay::getCalculator() const { return calculator_; }
+
+void TrajectoryMetricsDisplay::calculate(const tesseract_environment::Environment& environment,
+                                         const std::string& group_name,
+                                         const std::string& tcp_link_name,
+                                         const tesseract_common::JointTrajectory& trajectory)
+{
+  calculator_->start(environment, group_name, tcp_link_name, trajectory);
+}
+
+void TrajectoryMetricsDisplay::setMetric(TrajectoryMetric metric)
+{
+  metric_ = metric;
+  overlay_->setMetric(metric);
+  updateLinkColors();
+}
+
+void TrajectoryMetricsDisplay::setEnabled(bool enabled)
+{
+  enabled_ = enabled;
+  overlay_->setVisible(enabled);
+  updateLinkColors();
+}
+
+void TrajectoryMetricsDisplay::onFinished(bool cancelled)
+{
+  if (cancelled)
+    return;
+
+  overlay_->setMetrics(calculator_->getMetrics());
+  updateLinkIndices();
+  updateLinkColors();
+}
+
+void TrajectoryMetricsDisplay::updateLinkIndices()
+{
+  const TrajectoryMetrics::ConstPtr metrics = calculator_->getMetrics();
+  if (scene_ == nullptr || metrics == nullptr)
+  {
+    active_link_indices_.clear();
+    joint_link_indices_.clear();
+    return;
+  }
+
+  active_link_indices_ = getLinkIndices(*scene_, metrics->active_link_names);
+  joint_link_indices_ = getLinkIndices(*scene_, metrics->joint_child_link_names);
+}
+
+void TrajectoryMetricsDisplay::updateLinkColors()
+{
+  if (scene_ == nullptr)
+    return;
+
+  const TrajectoryMetrics::ConstPtr metrics = calculator_->getMetrics();
+  const TrajectoryTimeline::ConstPtr timeline = (player_ != nullptr) ? player_->getTimeline() : nullptr;
+  if (!enabled_ || metrics == nullptr || timeline == nullptr || timeline->getWaypointCount() == 0 ||
+      timeline->getWaypointCount() != metrics->getWaypointCount())
+  {
+    scene_->clearLinkColors();
+    emit sceneChanged();
+    return;
+  }
+
+  const std::pair<std::size_t, float> location = timeline->locate(player_->getTime());
+  const std::size_t waypoint =
+      std::min(location.first + ((location.second < 0.5F) ? 0 : 1), metrics->getWaypointCount() - 1);
+
+  // Links not colored by the metric keep their own color
+  link_colors_.assign(scene_->getLinkNames().size(), Eigen::Vector4f::Zero());
+  if (metric_ == TrajectoryMetric::MANIPULABILITY)
+  {
+    const Eigen::Vector4f color = getColor(metrics->getValue(metric_, waypoint));
+    for (const int index : active_link_indices_)
+    {
+      if (index >= 0)
+        link_colors_[static_cast<std::size_t>(index)] = color;
+    }
+  }
+  else
+  {
+    for (std::size_t j = 0; j < joint_link_indices_.size(); ++j)
+    {
+      if (joint_link_indices_[j] >= 0)
+        link_colors_[static_cast<std::size_t>(joint_link_indices_[j])] = getColor(metrics->getJointValue(j, waypoint));
+    }
+  }
+
+  scene_->setLinkColors(link_colors_);
+  emit sceneChanged();
+}
+
+}  // namespace tesseract_gui
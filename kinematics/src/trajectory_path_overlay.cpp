@@ -0,0 +1,169 @@
+/**
+ * @file trajectory_path_overlay.cpp
+ * @brief Draws the tool center point path of a trajectory colored by a trajectory metric
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <stdexcept>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/kinematics/trajectory_path_overlay.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+const char* VERTEX_SHADER = R"(
+#version 330 core
+layout(location = 0) in vec3 position;
+layout(location = 1) in float value;
+
+uniform mat4 view_projection;
+
+out vec3 frag_color;
+
+void main()
+{
+  // Red over yellow to green
+  frag_color = vec3(clamp(2.0 - (2.0 * value), 0.0, 1.0), clamp(2.0 * value, 0.0, 1.0), 0.1);
+  gl_Position = view_projection * vec4(position, 1.0);
+}
+)";
+
+const char* FRAGMENT_SHADER = R"(
+#version 330 core
+in vec3 frag_color;
+
+out vec4 fragment_color;
+
+void main()
+{
+  fragment_color = vec4(frag_color, 1.0);
+}
+)";
+}  // namespace
+
+void TrajectoryPathOverlay::setMetrics(TrajectoryMetrics::ConstPtr metrics)
+{
+  metrics_ = std::move(metrics);
+  positions_dirty_ = true;
+  values_dirty_ = true;
+}
+
+TrajectoryMetrics::ConstPtr TrajectoryPathOverlay::getMetrics() const { return metrics_; }
+
+void TrajectoryPathOverlay::setMetric(TrajectoryMetric metric)
+{
+  if (metric == metric_)
+    return;
+
+  metric_ = metric;
+  values_dirty_ = true;
+}
+
+TrajectoryMetric TrajectoryPathOverlay::getMetric() const { return metric_; }
+
+void TrajectoryPathOverlay::setVisible(bool visible) { visible_ = visible; }
+
+bool TrajectoryPathOverlay::isVisible() const { return visible_; }
+
+void TrajectoryPathOverlay::initialize(QOpenGLExtraFunctions& gl)
+{
+  program_ = std::make_unique<QOpenGLShaderProgram>();
+  if (!program_->addShaderFromSourceCode(QOpenGLShader::Vertex, VERTEX_SHADER) ||
+      !program_->addShaderFromSourceCode(QOpenGLShader::Fragment, FRAGMENT_SHADER) || !program_->link())
+    throw std::runtime_error("TrajectoryPathOverlay, failed to build shader program: " +
+                             program_->log().toStdString());
+
+  view_projection_location_ = program_->uniformLocation("view_projection");
+
+  gl.glGenVertexArrays(1, &vao_);
+  gl.glBindVertexArray(vao_);
+
+  gl.glGenBuffers(1, &position_buffer_);
+  gl.glBindBuffer(GL_ARRAY_BUFFER, position_buffer_);
+  gl.glEnableVertexAttribArray(0);
+  gl.glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), nullptr);
+
+  gl.glGenBuffers(1, &value_buffer_);
+  gl.glBindBuffer(GL_ARRAY_BUFFER, value_buffer_);
+  gl.glEnableVertexAttribArray(1);
+  gl.glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, sizeof(float), nullptr);
+
+  gl.glBindVertexArray(0);
+  gl.glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  // The new buffers are empty
+  positions_dirty_ = true;
+  values_dirty_ = true;
+  vertex_count_ = 0;
+}
+
+void TrajectoryPathOverlay::cleanup(QOpenGLExtraFunctions& gl)
+{
+  gl.glDeleteBuffers(1, &value_buffer_);
+  gl.glDeleteBuffers(1, &position_buffer_);
+  gl.glDeleteVertexArrays(1, &vao_);
+  value_buffer_ = 0;
+  position_buffer_ = 0;
+  vao_ = 0;
+  vertex_count_ = 0;
+  program_.reset();
+}
+
+void TrajectoryPathOverlay::render(QOpenGLExtraFunctions& gl,
+                                   const Eigen::Matrix4f& view_projection,
+                                   const Camera& /*camera*/)
+{
+  const std::size_t waypoint_count = (metrics_ != nullptr) ? metrics_->getWaypointCount() : 0;
+  if (positions_dirty_)
+  {
+    gl.glBindBuffer(GL_ARRAY_BUFFER, position_buffer_);
+    gl.glBufferData(GL_ARRAY_BUFFER,
+                    static_cast<GLsizeiptr>(3 * waypoint_count * sizeof(float)),
+                    (waypoint_count > 0) ? metrics_->tcp_positions.data() : nullptr,
+                    GL_STATIC_DRAW);
+    vertex_count_ = static_cast<GLsizei>(waypoint_count);
+    positions_dirty_ = false;
+  }
+
+  if (values_dirty_)
+  {
+    values_.resize(waypoint_count);
+    for (std::size_t w = 0; w < waypoint_count; ++w)
+      values_[w] = metrics_->getValue(metric_, w);
+
+    gl.glBindBuffer(GL_ARRAY_BUFFER, value_buffer_);
+    gl.glBufferData(GL_ARRAY_BUFFER,
+                    static_cast<GLsizeiptr>(values_.size() * sizeof(float)),
+                    values_.empty() ? nullptr : values_.data(),
+                    GL_STATIC_DRAW);
+    values_dirty_ = false;
+  }
+  gl.glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  if (!visible_ || vertex_count_ < 2)
+    return;
+
+  program_->bind();
+  gl.glUniformMatrix4fv(view_projection_location_, 1, GL_FALSE, view_projection.data());
+  gl.glBindVertexArray(vao_);
+  gl.glDrawArrays(GL_LINE_STRIP, 0, vertex_count_);
+  gl.glBindVertexArray(0);
+  program_->release();
+}
+
+}  // namespace tesseract_gui
@@ -0,0 +1,190 @@
+/**
+ * @file kinematics_unit.cpp
+ * @brief Tests of the kinematics utilities
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/kinematics/manipulability.h>
+#include <tesseract_gui/kinematics/reachability_map.h>
+
+using namespace tesseract_gui;
+
+namespace
+{
+std::string getTempFile(const std::string& name)
+{
+  return (std::filesystem::temp_directory_path() / ("tesseract_gui_kinematics_unit_" + name)).string();
+}
+
+std::vector<char> readFile(const std::string& path)
+{
+  std::ifstream file(path, std::ios::binary);
+  return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+}
+
+void writeFile(const std::string& path, const std::vector<char>& data)
+{
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
+
+/** @brief A 5 x 4 x 3 grid, its voxel count is not a multiple of the 64 bits of a word */
+ReachabilityMap createMap()
+{
+  ReachabilityMap map(Eigen::Vector3d(-1, -0.5, 0.25), 0.05, Eigen::Vector3i(5, 4, 3), 12);
+  map.setWorkingFrame("base_link");
+  map.setTipLinkName("tool0");
+  for (std::size_t i = 0; i < map.getVoxelCount(); i += 3)
+    map.setCoverage(i, static_cast<float>(i + 1) / static_cast<float>(map.getVoxelCount()));
+  return map;
+}
+}  // namespace
+
+TEST(TesseractGuiKinematicsUnit, ReachabilityMapConstruction)  // NOLINT
+{
+  EXPECT_THROW(ReachabilityMap(Eigen::Vector3d::Zero(), 0, Eigen::Vector3i(1, 1, 1), 1), std::runtime_error);
+  EXPECT_THROW(ReachabilityMap(Eigen::Vector3d::Zero(), 0.1, Eigen::Vector3i(1, 0, 1), 1), std::runtime_error);
+  EXPECT_THROW(ReachabilityMap(Eigen::Vector3d::Zero(), 0.1, Eigen::Vector3i(1, 1, 1), 0), std::runtime_error);
+
+  ReachabilityMap map(Eigen::Vector3d::Zero(), 0.1, Eigen::Vector3i(2, 3, 4), 1);
+  EXPECT_EQ(map.getVoxelCount(), 24U);
+  EXPECT_EQ(map.getIndex(1, 2, 3), 23U);
+  EXPECT_EQ(map.getReachableCount(), 0U);
+
+  map.setCoverage(5, 0.5F);
+  map.setCoverage(5, 0.25F);
+  EXPECT_TRUE(map.isReachable(5));
+  EXPECT_EQ(map.getReachableCount(), 1U);
+  map.setCoverage(5, 0);
+  EXPECT_FALSE(map.isReachable(5));
+  EXPECT_EQ(map.getReachableCount(), 0U);
+}
+
+TEST(TesseractGuiKinematicsUnit, ReachabilityMapRoundTrip)  // NOLINT
+{
+  const std::string path = getTempFile("round_trip.rmap");
+  const ReachabilityMap map = createMap();
+  map.save(path);
+
+  const ReachabilityMap loaded = ReachabilityMap::load(path);
+  EXPECT_EQ(loaded.getWorkingFrame(), "base_link");
+  EXPECT_EQ(loaded.getTipLinkName(), "tool0");
+  EXPECT_TRUE(loaded.getOrigin().isApprox(map.getOrigin()));
+  EXPECT_DOUBLE_EQ(loaded.getResolution(), map.getResolution());
+  EXPECT_EQ(loaded.getSize(), map.getSize());
+  EXPECT_EQ(loaded.getOrientationCount(), map.getOrientationCount());
+  EXPECT_EQ(loaded.getReachableCount(), map.getReachableCount());
+  EXPECT_EQ(loaded.getReachableBits(), map.getReachableBits());
+  EXPECT_EQ(loaded.getCoverage(), map.getCoverage());
+  for (std::size_t i = 0; i < map.getVoxelCount(); ++i)
+    EXPECT_EQ(loaded.isReachable(i), map.isReachable(i));
+
+  std::filesystem::remove(path);
+}
+
+TEST(TesseractGuiKinematicsUnit, ReachabilityMapInvalidFiles)  // NOLINT
+{
+  const std::string path = getTempFile("invalid.rmap");
+  EXPECT_THROW(ReachabilityMap::load(getTempFile("missing.rmap")), std::runtime_error);
+
+  createMap().save(path);
+  const std::vector<char> data = readFile(path);
+  ASSERT_GT(data.size(), 64U);
+
+  // Truncated, both inside of the header and inside of the arrays
+  writeFile(path, std::vector<char>(data.begin(), data.begin() + 16));
+  EXPECT_THROW(ReachabilityMap::load(path), std::runtime_error);
+  writeFile(path, std::vector<char>(data.begin(), data.end() - 1));
+  EXPECT_THROW(ReachabilityMap::load(path), std::runtime_error);
+
+  // Bad magic
+  std::vector<char> corrupt = data;
+  corrupt[0] = 'X';
+  writeFile(path, corrupt);
+  EXPECT_THROW(ReachabilityMap::load(path), std::runtime_error);
+
+  // Unsupported version
+  corrupt = data;
+  const std::uint32_t version = ReachabilityMap::FILE_VERSION + 1;
+  std::memcpy(corrupt.data() + 8, &version, sizeof(version));
+  writeFile(path, corrupt);
+  EXPECT_THROW(ReachabilityMap::load(path), std::runtime_error);
+
+  // A grid size which does not match the arrays, the loader must not read or allocate according to it
+  corrupt = data;
+  const std::int32_t size_x = 1 << 20;
+  std::memcpy(corrupt.data() + 16, &size_x, sizeof(size_x));
+  writeFile(path, corrupt);
+  EXPECT_THROW(ReachabilityMap::load(path), std::runtime_error);
+
+  // Frame name lengths pointing past the end of the file
+  corrupt = data;
+  const std::uint32_t name_length = 1U << 30U;
+  std::memcpy(corrupt.data() + 28, &name_length, sizeof(name_length));
+  writeFile(path, corrupt);
+  EXPECT_THROW(ReachabilityMap::load(path), std::runtime_error);
+
+  // The unmodified file still loads
+  writeFile(path, data);
+  EXPECT_NO_THROW(ReachabilityMap::load(path));  // NOLINT
+
+  std::filesystem::remove(path);
+}
+
+TEST(TesseractGuiKinematicsUnit, Manipulability)  // NOLINT
+{
+  // A square Jacobian, the manipulability is the absolute value of its determinant
+  Eigen::MatrixXd jacobian = Eigen::MatrixXd::Zero(6, 6);
+  jacobian.diagonal() << 1, 2, 3, 0.5, 0.5, 1;
+  EXPECT_NEAR(getManipulability(jacobian), 1.5, 1e-9);
+
+  // A singular configuration
+  jacobian(1, 1) = 0;
+  EXPECT_NEAR(getManipulability(jacobian), 0, 1e-9);
+
+  // Fewer joints than task space dimensions use J^T J, which is not singular everywhere
+  Eigen::MatrixXd planar = Eigen::MatrixXd::Zero(6, 3);
+  planar(0, 0) = 2;
+  planar(1, 1) = 3;
+  planar(5, 2) = 1;
+  EXPECT_NEAR(getManipulability(planar), 6, 1e-9);
+
+  // More joints than task space dimensions
+  Eigen::MatrixXd redundant = Eigen::MatrixXd::Zero(2, 3);
+  redundant(0, 0) = 1;
+  redundant(1, 1) = 1;
+  redundant(1, 2) = 1;
+  EXPECT_NEAR(getManipulability(redundant), std::sqrt(2.0), 1e-9);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,118 @@
+/**
+ * @file octree_mesh.h
+ * @brief Greedy meshed boxes of an octree voxel map, rebuilt per changed chunk
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_OCTREE_OCTREE_MESH_H
+#define TESSERACT_GUI_OCTREE_OCTREE_MESH_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/octree/octree_voxel_map.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief The occupied voxels of an OctreeVoxelMap merged into boxes, stored as one instance array for drawing
+ *
+ * Each chunk is greedy meshed on its own: runs of voxels along x are grown along y and then z as long as the whole
+ * rectangle is occupied, which turns the large flat and solid regions of occupancy maps into a few boxes. Boxes never
+ * cross chunk borders, so a changed chunk is meshed again without touching its neighbors.
+ *
+ * Every chunk owns a slot of the instance array with some room to grow. A chunk whose boxes still fit is rewritten in
+ * place and unused entries are zero sized boxes which rasterize nothing, otherwise it moves to a new slot at the end.
+ * The array is compacted once more than half of it is unused. The changed parts are reported by takeDirtyRanges() so
+ * renderers upload only those.
+ */
+class OctreeMesh
+{
+public:
+  /** @brief A box in the frame of the octree in meters */
+  struct Box
+  {
+    std::array<float, 3> min;
+    std::array<float, 3> size;
+  };
+
+  /** @brief A box of a chunk in voxels relative to the chunk origin */
+  struct VoxelBox
+  {
+    std::array<std::uint8_t, 3> min;
+    std::array<std::uint8_t, 3> size;
+  };
+
+  /** @brief A range of instances */
+  struct Range
+  {
+    std::size_t offset;
+    std::size_t count;
+  };
+
+  OctreeMesh() = default;
+
+  /** @brief Remove all boxes */
+  void clear();
+
+  /** @brief Mesh the dirty chunks of a voxel map, which are taken from the map */
+  void update(OctreeVoxelMap& map);
+
+  /** @brief The boxes of all chunks including unused zero sized entries */
+  const std::vector<Box>& getInstances() const;
+
+  /** @brief The number of boxes without unused entries */
+  std::size_t getBoxCount() const;
+
+  /** @brief The sorted, merged ranges of getInstances() changed since the last call */
+  std::vector<Range> takeDirtyRanges();
+
+  /**
+   * @brief Merge the occupied voxels of a chunk into boxes
+   * @param chunk The chunk bits
+   * @param boxes Receives the boxes, cleared first
+   */
+  static void greedyMesh(const OctreeVoxelMap::Chunk& chunk, std::vector<VoxelBox>& boxes);
+
+private:
+  struct Slot
+  {
+    std::size_t offset;
+    std::size_t capacity;
+    std::size_t count;
+  };
+
+  std::vector<Box> instances_;
+  std::unordered_map<std::uint64_t, Slot> slots_;
+  std::vector<Range> dirty_ranges_;
+  std::size_t box_count_{ 0 };
+
+  /** @brief The number of instances in slots no chunk owns anymore */
+  std::size_t unused_count_{ 0 };
+
+  std::vector<VoxelBox> voxel_boxes_;
+
+  void releaseSlot(const Slot& slot);
+  void compact();
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_OCTREE_OCTREE_MESH_H
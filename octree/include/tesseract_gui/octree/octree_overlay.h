@@ -0,0 +1,111 @@
+/**
+ * @file octree_overlay.h
+ * @brief Draws the occupied voxels of an octree as instanced boxes
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_OCTREE_OCTREE_OVERLAY_H
+#define TESSERACT_GUI_OCTREE_OCTREE_OVERLAY_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <memory>
+#include <Eigen/Geometry>
+#include <QOpenGLShaderProgram>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/octree/octree_mesh.h>
+#include <tesseract_gui/octree/octree_voxel_map.h>
+#include <tesseract_gui/render/render_overlay.h>
+
+namespace tesseract_geometry
+{
+class Octree;
+}
+
+namespace tesseract_gui
+{
+/**
+ * @brief Draws the occupied voxels of an octree as greedy meshed boxes with a single instanced draw call
+ *
+ * Updates go into an OctreeVoxelMap, the next render() meshes only the chunks that changed (see OctreeMesh) and
+ * uploads only the changed instance ranges. The instance buffer grows by half when the boxes no longer fit and is
+ * otherwise updated in place. All boxes are drawn regardless of the octree sub type.
+ *
+ * Setters may be called without the context current, changes are uploaded by the next render().
+ */
+class OctreeOverlay : public RenderOverlay
+{
+public:
+  using Ptr = std::shared_ptr<OctreeOverlay>;
+  using ConstPtr = std::shared_ptr<const OctreeOverlay>;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  OctreeOverlay() = default;
+
+  /** @brief Show the occupied leaves of an octree, see OctreeVoxelMap::setOctree() */
+  void setOctree(const octomap::OcTree& octree);
+  void setOctree(const tesseract_geometry::Octree& octree);
+
+  /** @brief Apply the changes recorded by the change detection of an octree, see OctreeVoxelMap::applyChanges() */
+  void applyChanges(const octomap::OcTree& octree);
+
+  /** @brief The voxels, e.g. to set individual voxels */
+  OctreeVoxelMap& getVoxelMap();
+  const OctreeVoxelMap& getVoxelMap() const;
+
+  /** @brief The boxes as of the last render() */
+  const OctreeMesh& getMesh() const;
+
+  /** @brief The transform from the octree to the world, e.g. the transform of the link it is attached to */
+  void setOrigin(const Eigen::Isometry3d& origin);
+  const Eigen::Isometry3d& getOrigin() const;
+
+  /** @brief RGBA color of the boxes */
+  void setColor(const Eigen::Vector4f& color);
+  const Eigen::Vector4f& getColor() const;
+
+  void setVisible(bool visible);
+  bool isVisible() const;
+
+  void initialize(QOpenGLExtraFunctions& gl) override;
+  void cleanup(QOpenGLExtraFunctions& gl) override;
+  void render(QOpenGLExtraFunctions& gl, const Eigen::Matrix4f& view_projection, const Camera& camera) override;
+
+private:
+  OctreeVoxelMap voxel_map_;
+  OctreeMesh mesh_;
+  Eigen::Isometry3d origin_{ Eigen::Isometry3d::Identity() };
+  Eigen::Vector4f color_{ 0.3F, 0.6F, 0.9F, 1.0F };
+  bool visible_{ true };
+
+  std::unique_ptr<QOpenGLShaderProgram> program_;
+  int model_view_projection_location_{ -1 };
+  int color_location_{ -1 };
+
+  GLuint vao_{ 0 };
+  GLuint vertex_buffer_{ 0 };
+  GLuint instance_buffer_{ 0 };
+
+  /** @brief The number of boxes the instance buffer has room for */
+  std::size_t capacity_{ 0 };
+  GLsizei instance_count_{ 0 };
+
+  void uploadInstances(QOpenGLExtraFunctions& gl);
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_OCTREE_OCTREE_OVERLAY_H
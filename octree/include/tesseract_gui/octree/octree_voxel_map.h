@@ -0,0 +1,113 @@
+/**
+ * @file octree_voxel_map.h
+ * @brief Occupied octree leaves as chunked bit sets with change tracking
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_OCTREE_OCTREE_VOXEL_MAP_H
+#define TESSERACT_GUI_OCTREE_OCTREE_VOXEL_MAP_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <Eigen/Core>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+namespace octomap
+{
+class OcTree;
+}
+
+namespace tesseract_gui
+{
+/**
+ * @brief The occupied leaves of an octree at its finest resolution, stored as bit sets of 16^3 voxel chunks
+ *
+ * Every change records the chunks it touched, so consumers (see OctreeMesh) only rebuild what changed. Pruned octree
+ * leaves covering several voxels set all of them. There are two ways to follow an octree:
+ *  - setOctree() compares all occupied leaves with the map and marks the chunks whose bits differ. It visits every
+ *    leaf, but nothing downstream of the map is redone for unchanged chunks.
+ *  - applyChanges() only visits the keys recorded by OctoMap change detection, which is what keeps a large map at
+ *    sensor rate. The owner of the octree enables change detection and resets it after each call.
+ */
+class OctreeVoxelMap
+{
+public:
+  using Ptr = std::shared_ptr<OctreeVoxelMap>;
+  using ConstPtr = std::shared_ptr<const OctreeVoxelMap>;
+
+  /** @brief The number of voxels along each edge of a chunk */
+  static constexpr int CHUNK_SIZE = 16;
+
+  /** @brief One bit per voxel, voxel (x, y, z) is bit x + 16 * y + 256 * z */
+  using Chunk = std::array<std::uint64_t, (CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE) / 64>;
+
+  OctreeVoxelMap() = default;
+
+  /** @brief Remove all voxels, every chunk becomes dirty */
+  void clear();
+
+  /** @brief The voxel edge length in meters, 0 before an octree was set */
+  double getResolution() const;
+
+  /** @brief Replace the voxels with the occupied leaves of an octree, marking only chunks that differ as dirty */
+  void setOctree(const octomap::OcTree& octree);
+
+  /**
+   * @brief Update the voxels at the keys recorded by the change detection of an octree
+   *
+   * Falls back to setOctree() if change detection is disabled or the resolution differs from the map.
+   */
+  void applyChanges(const octomap::OcTree& octree);
+
+  /** @brief Set a single voxel, voxel (0, 0, 0) has its minimum corner at the origin of the octree */
+  void setOccupied(const Eigen::Vector3i& voxel, bool occupied);
+  bool isOccupied(const Eigen::Vector3i& voxel) const;
+
+  /** @brief The number of occupied voxels */
+  std::size_t getOccupiedCount() const;
+
+  /** @brief The chunks with at least one occupied voxel by chunk key */
+  const std::unordered_map<std::uint64_t, Chunk>& getChunks() const;
+
+  /** @brief The chunks changed since the last takeDirtyChunks(), including chunks which became empty */
+  std::vector<std::uint64_t> takeDirtyChunks();
+
+  /** @brief Whether any chunk changed since the last takeDirtyChunks() */
+  bool hasDirtyChunks() const;
+
+  /** @brief The key of the chunk with the given chunk coordinates */
+  static std::uint64_t getChunkKey(const Eigen::Vector3i& chunk);
+
+  /** @brief The chunk coordinates of a chunk key, voxel coordinates of the chunk origin are 16 times larger */
+  static Eigen::Vector3i getChunkCoordinates(std::uint64_t key);
+
+private:
+  double resolution_{ 0 };
+  std::unordered_map<std::uint64_t, Chunk> chunks_;
+  std::unordered_set<std::uint64_t> dirty_chunks_;
+  std::size_t occupied_count_{ 0 };
+
+  /** @brief Set a cube of voxels in chunks, without counting or dirty tracking */
+  static void fill(std::unordered_map<std::uint64_t, Chunk>& chunks, const Eigen::Vector3i& min, int size);
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_OCTREE_OCTREE_VOXEL_MAP_H
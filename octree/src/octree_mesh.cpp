@@ -0,0 +1,227 @@
+/**
+ * @file octree_mesh.cpp
+ * @brief Greedy meshed boxes of an octree voxel map, rebuilt per changed chunk
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/octree/octree_mesh.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+constexpr int CHUNK_SIZE = OctreeVoxelMap::CHUNK_SIZE;
+
+/** @brief Compaction is skipped for small arrays, uploading them is cheap either way */
+constexpr std::size_t MIN_COMPACT_SIZE = 4096;
+
+int countTrailingZeros(std::uint32_t value)
+{
+  int count{ 0 };
+  while ((value & 1U) == 0 && count < 32)
+  {
+    value >>= 1U;
+    ++count;
+  }
+  return count;
+}
+}  // namespace
+
+void OctreeMesh::clear()
+{
+  instances_.clear();
+  slots_.clear();
+  box_count_ = 0;
+  unused_count_ = 0;
+  dirty_ranges_.clear();
+}
+
+void OctreeMesh::update(OctreeVoxelMap& map)
+{
+  const float resolution = static_cast<float>(map.getResolution());
+  const std::vector<std::uint64_t> dirty_chunks = map.takeDirtyChunks();
+  for (const std::uint64_t key : dirty_chunks)
+  {
+    auto chunk = map.getChunks().find(key);
+    if (chunk != map.getChunks().end())
+      greedyMesh(chunk->second, voxel_boxes_);
+    else
+      voxel_boxes_.clear();
+
+    const std::size_t count = voxel_boxes_.size();
+    auto slot = slots_.find(key);
+    std::size_t previous_count{ 0 };
+    if (slot != slots_.end())
+    {
+      previous_count = slot->second.count;
+      if (count > slot->second.capacity || count == 0)
+      {
+        releaseSlot(slot->second);
+        slots_.erase(slot);
+        slot = slots_.end();
+      }
+    }
+
+    box_count_ = box_count_ + count - previous_count;
+    if (count == 0)
+      continue;
+
+    if (slot == slots_.end())
+    {
+      // A quarter more room lets a chunk gain a few boxes, e.g. from new sensor readings, without moving
+      Slot new_slot{ instances_.size(), count + (count / 4) + 1, 0 };
+      instances_.resize(new_slot.offset + new_slot.capacity, Box{});
+      dirty_ranges_.push_back({ new_slot.offset, new_slot.capacity });
+      slot = slots_.emplace(key, new_slot).first;
+    }
+
+    const Eigen::Vector3i origin = OctreeVoxelMap::getChunkCoordinates(key) * CHUNK_SIZE;
+    Slot& target = slot->second;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      const VoxelBox& voxel_box = voxel_boxes_[i];
+      Box& box = instances_[target.offset + i];
+      for (Eigen::Index axis = 0; axis < 3; ++axis)
+      {
+        const auto a = static_cast<std::size_t>(axis);
+        box.min[a] = static_cast<float>(origin[axis] + voxel_box.min[a]) * resolution;
+        box.size[a] = static_cast<float>(voxel_box.size[a]) * resolution;
+      }
+    }
+
+    for (std::size_t i = count; i < target.count; ++i)
+      instances_[target.offset + i] = Box{};
+
+    dirty_ranges_.push_back({ target.offset, std::max(count, target.count) });
+    target.count = count;
+  }
+
+  if (instances_.size() >= MIN_COMPACT_SIZE && unused_count_ > instances_.size() / 2)
+    compact();
+}
+
+const std::vector<OctreeMesh::Box>& OctreeMesh::getInstances() const { return instances_; }
+
+std::size_t OctreeMesh::getBoxCount() const { return box_count_; }
+
+std::vector<OctreeMesh::Range> OctreeMesh::takeDirtyRanges()
+{
+  std::sort(dirty_ranges_.begin(), dirty_ranges_.end(), [](const Range& a, const Range& b) {
+    return a.offset < b.offset;
+  });
+
+  std::vector<Range> ranges;
+  for (const Range& range : dirty_ranges_)
+  {
+    if (!ranges.empty() && range.offset <= ranges.back().offset + ranges.back().count)
+    {
+      const std::size_t end = std::max(ranges.back().offset + ranges.back().count, range.offset + range.count);
+      ranges.back().count = end - ranges.back().offset;
+      continue;
+    }
+    ranges.push_back(range);
+  }
+
+  dirty_ranges_.clear();
+  return ranges;
+}
+
+void OctreeMesh::greedyMesh(const OctreeVoxelMap::Chunk& chunk, std::vector<VoxelBox>& boxes)
+{
+  boxes.clear();
+
+  // One 16 bit row along x per (y, z), four rows share a 64 bit word of the chunk
+  std::array<std::uint32_t, CHUNK_SIZE * CHUNK_SIZE> rows{};
+  for (std::size_t i = 0; i < rows.size(); ++i)
+    rows[i] = static_cast<std::uint32_t>((chunk[i / 4] >> (16U * (i % 4))) & 0xFFFFU);
+
+  const auto row = [&rows](int y, int z) -> std::uint32_t& {
+    return rows[static_cast<std::size_t>(y + (CHUNK_SIZE * z))];
+  };
+
+  for (int z = 0; z < CHUNK_SIZE; ++z)
+  {
+    for (int y = 0; y < CHUNK_SIZE; ++y)
+    {
+      while (row(y, z) != 0)
+      {
+        // The first run of voxels along x
+        const int x = countTrailingZeros(row(y, z));
+        const int width = countTrailingZeros(~(row(y, z) >> static_cast<unsigned>(x)));
+        const std::uint32_t mask = ((1U << static_cast<unsigned>(width)) - 1U) << static_cast<unsigned>(x);
+
+        int height{ 1 };
+        while (y + height < CHUNK_SIZE && (row(y + height, z) & mask) == mask)
+          ++height;
+
+        int depth{ 1 };
+        while (z + depth < CHUNK_SIZE)
+        {
+          bool filled{ true };
+          for (int j = 0; j < height && filled; ++j)
+            filled = (row(y + j, z + depth) & mask) == mask;
+
+          if (!filled)
+            break;
+          ++depth;
+        }
+
+        for (int k = 0; k < depth; ++k)
+        {
+          for (int j = 0; j < height; ++j)
+            row(y + j, z + k) &= ~mask;
+        }
+
+        boxes.push_back({ { static_cast<std::uint8_t>(x), static_cast<std::uint8_t>(y), static_cast<std::uint8_t>(z) },
+                          { static_cast<std::uint8_t>(width),
+                            static_cast<std::uint8_t>(height),
+                            static_cast<std::uint8_t>(depth) } });
+      }
+    }
+  }
+}
+
+void OctreeMesh::releaseSlot(const Slot& slot)
+{
+  std::fill(instances_.begin() + static_cast<std::ptrdiff_t>(slot.offset),
+            instances_.begin() + static_cast<std::ptrdiff_t>(slot.offset + slot.count),
+            Box{});
+  dirty_ranges_.push_back({ slot.offset, slot.count });
+  unused_count_ += slot.capacity;
+}
+
+void OctreeMesh::compact()
+{
+  std::vector<Box> instances;
+  instances.reserve(instances_.size() - unused_count_);
+  for (auto& slot : slots_)
+  {
+    const auto begin = instances_.begin() + static_cast<std::ptrdiff_t>(slot.second.offset);
+    const std::size_t offset = instances.size();
+    instances.insert(instances.end(), begin, begin + static_cast<std::ptrdiff_t>(slot.second.capacity));
+    slot.second.offset = offset;
+  }
+
+  instances_.swap(instances);
+  unused_count_ = 0;
+  dirty_ranges_.clear();
+  dirty_ranges_.push_back({ 0, instances_.size() });
+}
+
+}  // namespace tesseract_gui
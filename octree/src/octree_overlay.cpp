@@ -0,0 +1,245 @@
+/**
+ * @file octree_overlay.cpp
+ * @brief Draws the occupied voxels of an octree as instanced boxes
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_geometry/geometries.h>
+#include <tesseract_gui/common/instrumentation.h>
+#include <tesseract_gui/octree/octree_overlay.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+const char* VERTEX_SHADER = R"(
+#version 330 core
+layout(location = 0) in vec3 vertex;
+layout(location = 1) in vec3 normal;
+layout(location = 2) in vec3 box_min;
+layout(location = 3) in vec3 box_size;
+
+uniform mat4 model_view_projection;
+
+out vec3 frag_normal;
+
+void main()
+{
+  frag_normal = normal;
+  gl_Position = model_view_projection * vec4(box_min + (vertex * box_size), 1.0);
+}
+)";
+
+const char* FRAGMENT_SHADER = R"(
+#version 330 core
+in vec3 frag_normal;
+
+uniform vec4 color;
+
+out vec4 fragment_color;
+
+void main()
+{
+  // A fixed light in the octree frame keeps the faces of adjacent boxes distinguishable
+  float shade = 0.55 + (0.45 * abs(dot(normalize(frag_normal), normalize(vec3(0.3, 0.5, 0.8)))));
+  fragment_color = vec4(color.rgb * shade, color.a);
+}
+)";
+
+/** @brief The triangles of the unit cube from the origin to (1, 1, 1), position and normal per vertex */
+std::vector<float> createUnitCube()
+{
+  std::vector<float> vertices;
+  vertices.reserve(36 * 6);
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    for (const float side : { 0.0F, 1.0F })
+    {
+      const int u = (axis + 1) % 3;
+      const int v = (axis + 2) % 3;
+      const float corners[4][2] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
+
+      // Counter clockwise seen from outside of the face
+      const int order[2][6] = { { 0, 2, 1, 0, 3, 2 }, { 0, 1, 2, 0, 2, 3 } };
+      for (const int corner : order[(side > 0) ? 1 : 0])
+      {
+        float position[3];
+        position[axis] = side;
+        position[u] = corners[corner][0];
+        position[v] = corners[corner][1];
+
+        float normal[3] = { 0, 0, 0 };
+        normal[axis] = (side > 0) ? 1.0F : -1.0F;
+
+        vertices.insert(vertices.end(), position, position + 3);
+        vertices.insert(vertices.end(), normal, normal + 3);
+      }
+    }
+  }
+  return vertices;
+}
+}  // namespace
+
+void OctreeOverlay::setOctree(const octomap::OcTree& octree) { voxel_map_.setOctree(octree); }
+
+void OctreeOverlay::setOctree(const tesseract_geometry::Octree& octree)
+{
+  if (octree.getOctree() == nullptr)
+    throw std::runtime_error("OctreeOverlay, octree geometry has no octree!");
+
+  voxel_map_.setOctree(*octree.getOctree());
+}
+
+void OctreeOverlay::applyChanges(const octomap::OcTree& octree) { voxel_map_.applyChanges(octree); }
+
+OctreeVoxelMap& OctreeOverlay::getVoxelMap() { return voxel_map_; }
+
+const OctreeVoxelMap& OctreeOverlay::getVoxelMap() const { return voxel_map_; }
+
+const OctreeMesh& OctreeOverlay::getMesh() const { return mesh_; }
+
+void OctreeOverlay::setOrigin(const Eigen::Isometry3d& origin) { origin_ = origin; }
+
+const Eigen::Isometry3d& OctreeOverlay::getOrigin() const { return origin_; }
+
+void OctreeOverlay::setColor(const Eigen::Vector4f& color) { color_ = color; }
+
+const Eigen::Vector4f& OctreeOverlay::getColor() const { return color_; }
+
+void OctreeOverlay::setVisible(bool visible) { visible_ = visible; }
+
+bool OctreeOverlay::isVisible() const { return visible_; }
+
+void OctreeOverlay::initialize(QOpenGLExtraFunctions& gl)
+{
+  program_ = std::make_unique<QOpenGLShaderProgram>();
+  if (!program_->addShaderFromSourceCode(QOpenGLShader::Vertex, VERTEX_SHADER) ||
+      !program_->addShaderFromSourceCode(QOpenGLShader::Fragment, FRAGMENT_SHADER) || !program_->link())
+    throw std::runtime_error("OctreeOverlay, failed to build shader program: " + program_->log().toStdString());
+
+  model_view_projection_location_ = program_->uniformLocation("model_view_projection");
+  color_location_ = program_->uniformLocation("color");
+
+  gl.glGenVertexArrays(1, &vao_);
+  gl.glBindVertexArray(vao_);
+
+  const std::vector<float> cube = createUnitCube();
+  gl.glGenBuffers(1, &vertex_buffer_);
+  gl.glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_);
+  gl.glBufferData(
+      GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(cube.size() * sizeof(float)), cube.data(), GL_STATIC_DRAW);
+  gl.glEnableVertexAttribArray(0);
+  gl.glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), nullptr);
+  gl.glEnableVertexAttribArray(1);
+  gl.glVertexAttribPointer(
+      1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), reinterpret_cast<const void*>(3 * sizeof(float)));
+
+  using Box = OctreeMesh::Box;
+  const auto stride = static_cast<GLsizei>(sizeof(Box));
+  gl.glGenBuffers(1, &instance_buffer_);
+  gl.glBindBuffer(GL_ARRAY_BUFFER, instance_buffer_);
+  gl.glEnableVertexAttribArray(2);
+  gl.glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const void*>(offsetof(Box, min)));
+  gl.glVertexAttribDivisor(2, 1);
+  gl.glEnableVertexAttribArray(3);
+  gl.glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const void*>(offsetof(Box, size)));
+  gl.glVertexAttribDivisor(3, 1);
+
+  gl.glBindVertexArray(0);
+  gl.glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  // The new buffer is empty, the next upload sends all instances
+  capacity_ = 0;
+  instance_count_ = 0;
+}
+
+void OctreeOverlay::cleanup(QOpenGLExtraFunctions& gl)
+{
+  gl.glDeleteBuffers(1, &instance_buffer_);
+  gl.glDeleteBuffers(1, &vertex_buffer_);
+  gl.glDeleteVertexArrays(1, &vao_);
+  instance_buffer_ = 0;
+  vertex_buffer_ = 0;
+  vao_ = 0;
+  capacity_ = 0;
+  instance_count_ = 0;
+  program_.reset();
+}
+
+void OctreeOverlay::render(QOpenGLExtraFunctions& gl, const Eigen::Matrix4f& view_projection, const Camera& /*camera*/)
+{
+  if (voxel_map_.hasDirtyChunks())
+  {
+    const ScopedTimer timer("octree", "mesh");
+    mesh_.update(voxel_map_);
+    recordCounter("octree", "boxes", static_cast<std::int64_t>(mesh_.getBoxCount()));
+  }
+
+  uploadInstances(gl);
+
+  if (!visible_ || instance_count_ == 0)
+    return;
+
+  const Eigen::Matrix4f model_view_projection = view_projection * origin_.matrix().cast<float>();
+
+  program_->bind();
+  gl.glUniformMatrix4fv(model_view_projection_location_, 1, GL_FALSE, model_view_projection.data());
+  gl.glUniform4fv(color_location_, 1, color_.data());
+
+  gl.glBindVertexArray(vao_);
+  gl.glDrawArraysInstanced(GL_TRIANGLES, 0, 36, instance_count_);
+
+  gl.glBindVertexArray(0);
+  program_->release();
+}
+
+void OctreeOverlay::uploadInstances(QOpenGLExtraFunctions& gl)
+{
+  const std::vector<OctreeMesh::Box>& instances = mesh_.getInstances();
+  std::vector<OctreeMesh::Range> ranges = mesh_.takeDirtyRanges();
+  if (ranges.empty() && instances.size() <= capacity_)
+    return;
+
+  gl.glBindBuffer(GL_ARRAY_BUFFER, instance_buffer_);
+  if (instances.size() > capacity_)
+  {
+    capacity_ = instances.size() + (instances.size() / 2);
+    gl.glBufferData(
+        GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(capacity_ * sizeof(OctreeMesh::Box)), nullptr, GL_DYNAMIC_DRAW);
+    ranges.assign(1, { 0, instances.size() });
+  }
+
+  for (const auto& range : ranges)
+  {
+    if (range.count == 0)
+      continue;
+
+    gl.glBufferSubData(GL_ARRAY_BUFFER,
+                       static_cast<GLintptr>(range.offset * sizeof(OctreeMesh::Box)),
+                       static_cast<GLsizeiptr>(range.count * sizeof(OctreeMesh::Box)),
+                       instances.data() + range.offset);
+  }
+
+  gl.glBindBuffer(GL_ARRAY_BUFFER, 0);
+  instance_count_ = static_cast<GLsizei>(instances.size());
+}
+
+}  // namespace tesseract_gui
@@ -0,0 +1,236 @@
+/**
+ * @file octree_voxel_map.cpp
+ * @brief Occupied octree leaves as chunked bit sets with change tracking
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <bitset>
+#include <octomap/OcTree.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/octree/octree_voxel_map.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+/** @brief Each chunk coordinate is stored in 21 bits of the key, offset to be positive */
+constexpr int KEY_BITS = 21;
+constexpr std::int64_t KEY_OFFSET = std::int64_t{ 1 } << (KEY_BITS - 1);
+constexpr std::uint64_t KEY_MASK = (std::uint64_t{ 1 } << KEY_BITS) - 1;
+
+int floorDivide(int value, int divisor) { return (value >= 0) ? value / divisor : ((value + 1) / divisor) - 1; }
+
+int floorModulo(int value, int divisor) { return value - (floorDivide(value, divisor) * divisor); }
+
+Eigen::Vector3i getChunk(const Eigen::Vector3i& voxel)
+{
+  return { floorDivide(voxel.x(), OctreeVoxelMap::CHUNK_SIZE),
+           floorDivide(voxel.y(), OctreeVoxelMap::CHUNK_SIZE),
+           floorDivide(voxel.z(), OctreeVoxelMap::CHUNK_SIZE) };
+}
+
+std::size_t getBit(const Eigen::Vector3i& voxel)
+{
+  constexpr int size = OctreeVoxelMap::CHUNK_SIZE;
+  const int x = floorModulo(voxel.x(), size);
+  const int y = floorModulo(voxel.y(), size);
+  const int z = floorModulo(voxel.z(), size);
+  return static_cast<std::size_t>(x + (size * y) + (size * size * z));
+}
+
+/** @brief The voxel of an octree key, keys are offset by half of the key range so the root is centered on the origin */
+Eigen::Vector3i getVoxel(const octomap::OcTreeKey& key, unsigned tree_depth)
+{
+  const int offset = 1 << (tree_depth - 1);
+  return { static_cast<int>(key[0]) - offset, static_cast<int>(key[1]) - offset, static_cast<int>(key[2]) - offset };
+}
+
+std::size_t countOccupied(const OctreeVoxelMap::Chunk& chunk)
+{
+  std::size_t count{ 0 };
+  for (const std::uint64_t word : chunk)
+    count += std::bitset<64>(word).count();
+  return count;
+}
+}  // namespace
+
+void OctreeVoxelMap::clear()
+{
+  for (const auto& chunk : chunks_)
+    dirty_chunks_.insert(chunk.first);
+
+  chunks_.clear();
+  occupied_count_ = 0;
+}
+
+double OctreeVoxelMap::getResolution() const { return resolution_; }
+
+void OctreeVoxelMap::setOctree(const octomap::OcTree& octree)
+{
+  if (octree.getResolution() != resolution_)
+  {
+    clear();
+    resolution_ = octree.getResolution();
+  }
+
+  const unsigned tree_depth = octree.getTreeDepth();
+  std::unordered_map<std::uint64_t, Chunk> chunks;
+  chunks.reserve(chunks_.size());
+  for (auto it = octree.begin_leafs(), end = octree.end_leafs(); it != end; ++it)
+  {
+    if (!octree.isNodeOccupied(*it))
+      continue;
+
+    // The index key is the minimum corner of the leaf, pruned leaves above the finest depth cover several voxels
+    fill(chunks, getVoxel(it.getIndexKey(), tree_depth), 1 << (tree_depth - it.getDepth()));
+  }
+
+  for (const auto& chunk : chunks)
+  {
+    auto it = chunks_.find(chunk.first);
+    if (it == chunks_.end() || it->second != chunk.second)
+      dirty_chunks_.insert(chunk.first);
+  }
+
+  for (const auto& chunk : chunks_)
+  {
+    if (chunks.count(chunk.first) == 0)
+      dirty_chunks_.insert(chunk.first);
+  }
+
+  chunks_.swap(chunks);
+  occupied_count_ = 0;
+  for (const auto& chunk : chunks_)
+    occupied_count_ += countOccupied(chunk.second);
+}
+
+void OctreeVoxelMap::applyChanges(const octomap::OcTree& octree)
+{
+  if (!octree.isChangeDetectionEnabled() || octree.getResolution() != resolution_)
+  {
+    setOctree(octree);
+    return;
+  }
+
+  // Changed keys are at the finest depth, a search returning a pruned parent has the same state for all its voxels
+  const unsigned tree_depth = octree.getTreeDepth();
+  for (auto it = octree.changedKeysBegin(), end = octree.changedKeysEnd(); it != end; ++it)
+  {
+    const octomap::OcTreeNode* node = octree.search(it->first);
+    setOccupied(getVoxel(it->first, tree_depth), node != nullptr && octree.isNodeOccupied(node));
+  }
+}
+
+void OctreeVoxelMap::setOccupied(const Eigen::Vector3i& voxel, bool occupied)
+{
+  const std::uint64_t key = getChunkKey(getChunk(voxel));
+  const std::size_t bit = getBit(voxel);
+  const std::uint64_t mask = std::uint64_t{ 1 } << (bit % 64);
+
+  auto it = chunks_.find(key);
+  if (it == chunks_.end())
+  {
+    if (!occupied)
+      return;
+
+    it = chunks_.emplace(key, Chunk{}).first;
+  }
+
+  std::uint64_t& word = it->second[bit / 64];
+  if (((word & mask) != 0) == occupied)
+    return;
+
+  if (occupied)
+  {
+    word |= mask;
+    ++occupied_count_;
+  }
+  else
+  {
+    word &= ~mask;
+    --occupied_count_;
+    if (countOccupied(it->second) == 0)
+      chunks_.erase(it);
+  }
+
+  dirty_chunks_.insert(key);
+}
+
+bool OctreeVoxelMap::isOccupied(const Eigen::Vector3i& voxel) const
+{
+  auto it = chunks_.find(getChunkKey(getChunk(voxel)));
+  if (it == chunks_.end())
+    return false;
+
+  const std::size_t bit = getBit(voxel);
+  return (it->second[bit / 64] & (std::uint64_t{ 1 } << (bit % 64))) != 0;
+}
+
+std::size_t OctreeVoxelMap::getOccupiedCount() const { return occupied_count_; }
+
+const std::unordered_map<std::uint64_t, OctreeVoxelMap::Chunk>& OctreeVoxelMap::getChunks() const { return chunks_; }
+
+std::vector<std::uint64_t> OctreeVoxelMap::takeDirtyChunks()
+{
+  std::vector<std::uint64_t> dirty_chunks(dirty_chunks_.begin(), dirty_chunks_.end());
+  dirty_chunks_.clear();
+  return dirty_chunks;
+}
+
+bool OctreeVoxelMap::hasDirtyChunks() const { return !dirty_chunks_.empty(); }
+
+std::uint64_t OctreeVoxelMap::getChunkKey(const Eigen::Vector3i& chunk)
+{
+  const auto coordinate = [](int value) { return static_cast<std::uint64_t>(value + KEY_OFFSET) & KEY_MASK; };
+  return (coordinate(chunk.x()) << (2 * KEY_BITS)) | (coordinate(chunk.y()) << KEY_BITS) | coordinate(chunk.z());
+}
+
+Eigen::Vector3i OctreeVoxelMap::getChunkCoordinates(std::uint64_t key)
+{
+  const auto coordinate = [](std::uint64_t value) {
+    return static_cast<int>(static_cast<std::int64_t>(value & KEY_MASK) - KEY_OFFSET);
+  };
+  return { coordinate(key >> (2 * KEY_BITS)), coordinate(key >> KEY_BITS), coordinate(key) };
+}
+
+void OctreeVoxelMap::fill(std::unordered_map<std::uint64_t, Chunk>& chunks, const Eigen::Vector3i& min, int size)
+{
+  for (int z = min.z(); z < min.z() + size; ++z)
+  {
+    for (int y = min.y(); y < min.y() + size; ++y)
+    {
+      // A row crosses a chunk border at most every 16 voxels, look the chunk up once per run
+      Chunk* chunk{ nullptr };
+      std::uint64_t chunk_key{ 0 };
+      for (int x = min.x(); x < min.x() + size; ++x)
+      {
+        const Eigen::Vector3i voxel(x, y, z);
+        const std::uint64_t key = getChunkKey(getChunk(voxel));
+        if (chunk == nullptr || key != chunk_key)
+        {
+          chunk = &chunks[key];
+          chunk_key = key;
+        }
+
+        const std::size_t bit = getBit(voxel);
+        (*chunk)[bit / 64] |= std::uint64_t{ 1 } << (bit % 64);
+      }
+    }
+  }
+}
+
+}  // namespace tesseract_gui
@@ -0,0 +1,159 @@
+/**
+ * @file octree_unit.cpp
+ * @brief Tests of the octree component
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/octree/octree_mesh.h>
+
+using namespace tesseract_gui;
+
+namespace
+{
+constexpr int CHUNK_SIZE = OctreeVoxelMap::CHUNK_SIZE;
+
+void setVoxel(OctreeVoxelMap::Chunk& chunk, int x, int y, int z)
+{
+  const auto bit = static_cast<std::size_t>(x + (CHUNK_SIZE * y) + (CHUNK_SIZE * CHUNK_SIZE * z));
+  chunk[bit / 64] |= std::uint64_t{ 1 } << (bit % 64);
+}
+
+bool isVoxelSet(const OctreeVoxelMap::Chunk& chunk, int x, int y, int z)
+{
+  const auto bit = static_cast<std::size_t>(x + (CHUNK_SIZE * y) + (CHUNK_SIZE * CHUNK_SIZE * z));
+  return ((chunk[bit / 64] >> (bit % 64)) & 1U) != 0;
+}
+
+/** @brief Every occupied voxel is covered by exactly one box and no box covers a free voxel */
+void checkCover(const OctreeVoxelMap::Chunk& chunk, const std::vector<OctreeMesh::VoxelBox>& boxes)
+{
+  std::vector<int> cover(CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE, 0);
+  for (const auto& box : boxes)
+  {
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+      ASSERT_GT(box.size[axis], 0);
+      ASSERT_LE(box.min[axis] + box.size[axis], CHUNK_SIZE);
+    }
+
+    for (int z = box.min[2]; z < box.min[2] + box.size[2]; ++z)
+      for (int y = box.min[1]; y < box.min[1] + box.size[1]; ++y)
+        for (int x = box.min[0]; x < box.min[0] + box.size[0]; ++x)
+          ++cover[static_cast<std::size_t>(x + (CHUNK_SIZE * y) + (CHUNK_SIZE * CHUNK_SIZE * z))];
+  }
+
+  for (int z = 0; z < CHUNK_SIZE; ++z)
+    for (int y = 0; y < CHUNK_SIZE; ++y)
+      for (int x = 0; x < CHUNK_SIZE; ++x)
+        ASSERT_EQ(cover[static_cast<std::size_t>(x + (CHUNK_SIZE * y) + (CHUNK_SIZE * CHUNK_SIZE * z))],
+                  isVoxelSet(chunk, x, y, z) ? 1 : 0)
+            << "voxel " << x << " " << y << " " << z;
+}
+}  // namespace
+
+TEST(TesseractGuiOctreeUnit, GreedyMeshSolid)  // NOLINT
+{
+  std::vector<OctreeMesh::VoxelBox> boxes;
+  OctreeVoxelMap::Chunk chunk{};
+  OctreeMesh::greedyMesh(chunk, boxes);
+  EXPECT_TRUE(boxes.empty());
+
+  // A full chunk is one box, including the runs of the full row width
+  for (auto& word : chunk)
+    word = ~std::uint64_t{ 0 };
+  OctreeMesh::greedyMesh(chunk, boxes);
+  ASSERT_EQ(boxes.size(), 1U);
+  EXPECT_EQ(boxes[0].min, (std::array<std::uint8_t, 3>{ 0, 0, 0 }));
+  EXPECT_EQ(boxes[0].size, (std::array<std::uint8_t, 3>{ 16, 16, 16 }));
+
+  // A slab is grown along y and z
+  chunk.fill(0);
+  for (int z = 3; z < 5; ++z)
+    for (int y = 0; y < CHUNK_SIZE; ++y)
+      for (int x = 2; x < 5; ++x)
+        setVoxel(chunk, x, y, z);
+  OctreeMesh::greedyMesh(chunk, boxes);
+  ASSERT_EQ(boxes.size(), 1U);
+  EXPECT_EQ(boxes[0].min, (std::array<std::uint8_t, 3>{ 2, 0, 3 }));
+  EXPECT_EQ(boxes[0].size, (std::array<std::uint8_t, 3>{ 3, 16, 2 }));
+
+  // Two runs of a row and a voxel in the last corner
+  chunk.fill(0);
+  setVoxel(chunk, 0, 0, 0);
+  setVoxel(chunk, 2, 0, 0);
+  setVoxel(chunk, 15, 15, 15);
+  OctreeMesh::greedyMesh(chunk, boxes);
+  EXPECT_EQ(boxes.size(), 3U);
+  checkCover(chunk, boxes);
+}
+
+TEST(TesseractGuiOctreeUnit, GreedyMeshRandom)  // NOLINT
+{
+  std::mt19937 random(42);
+  std::vector<OctreeMesh::VoxelBox> boxes;
+  for (const double density : { 0.05, 0.5, 0.95 })
+  {
+    std::bernoulli_distribution occupied(density);
+    OctreeVoxelMap::Chunk chunk{};
+    for (int z = 0; z < CHUNK_SIZE; ++z)
+      for (int y = 0; y < CHUNK_SIZE; ++y)
+        for (int x = 0; x < CHUNK_SIZE; ++x)
+          if (occupied(random))
+            setVoxel(chunk, x, y, z);
+
+    OctreeMesh::greedyMesh(chunk, boxes);
+    checkCover(chunk, boxes);
+  }
+}
+
+TEST(TesseractGuiOctreeUnit, OctreeMeshUpdate)  // NOLINT
+{
+  OctreeVoxelMap map;
+  for (int z = 0; z < 2; ++z)
+    for (int y = 0; y < 2; ++y)
+      for (int x = 0; x < 2; ++x)
+        map.setOccupied(Eigen::Vector3i(x, y, z), true);
+  map.setOccupied(Eigen::Vector3i(20, 0, 0), true);
+
+  OctreeMesh mesh;
+  mesh.update(map);
+  EXPECT_FALSE(map.hasDirtyChunks());
+  EXPECT_EQ(mesh.getBoxCount(), 2U);
+  EXPECT_GE(mesh.getInstances().size(), 2U);
+  EXPECT_FALSE(mesh.takeDirtyRanges().empty());
+  EXPECT_TRUE(mesh.takeDirtyRanges().empty());
+
+  // Only the changed chunk is meshed again
+  map.setOccupied(Eigen::Vector3i(20, 0, 0), false);
+  mesh.update(map);
+  EXPECT_EQ(mesh.getBoxCount(), 1U);
+  EXPECT_FALSE(mesh.takeDirtyRanges().empty());
+
+  mesh.clear();
+  EXPECT_EQ(mesh.getBoxCount(), 0U);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,98 @@
+/**
+ * @file point_cloud.h
+ * @brief Point clouds stored as packed position and color records
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_POINT_CLOUD_POINT_CLOUD_H
+#define TESSERACT_GUI_POINT_CLOUD_POINT_CLOUD_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <Eigen/Geometry>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+namespace tesseract_gui
+{
+/**
+ * @brief The points of one sensor frame as an array of fixed size records
+ *
+ * Points are not objects: a cloud is a single vector of 16 byte records which renderers upload as a vertex buffer
+ * without repacking. assign() copies packed sensor buffers into the existing storage, so a cloud reused for every frame
+ * stops allocating once it has held the largest frame.
+ */
+class PointCloud
+{
+public:
+  using Ptr = std::shared_ptr<PointCloud>;
+  using ConstPtr = std::shared_ptr<const PointCloud>;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  struct Point
+  {
+    /** @brief The position in the sensor frame */
+    std::array<float, 3> position;
+
+    /** @brief The color packed as 0x00RRGGBB, the PCL and ROS convention */
+    std::uint32_t rgb;
+  };
+
+  /** @brief Where position and color are found in the records of a packed buffer, e.g. a ROS PointCloud2 */
+  struct Layout
+  {
+    /** @brief The size of one record in bytes */
+    std::size_t stride{ sizeof(Point) };
+
+    /** @brief The offset of three consecutive floats x, y and z */
+    std::size_t position_offset{ 0 };
+
+    /** @brief The offset of the packed 0x00RRGGBB color */
+    std::size_t rgb_offset{ 3 * sizeof(float) };
+  };
+
+  PointCloud() = default;
+
+  /**
+   * @brief Replace the points with the records of a packed buffer, throws if the layout does not fit its stride
+   * @param data The first record
+   * @param count The number of records
+   * @param layout The layout of a record, a default constructed layout describes packed Point records
+   */
+  void assign(const void* data, std::size_t count, const Layout& layout);
+  void clear();
+
+  std::size_t size() const;
+  bool empty() const;
+
+  std::vector<Point>& getPoints();
+  const std::vector<Point>& getPoints() const;
+
+  /** @brief The transform from the sensor frame to the world */
+  void setOrigin(const Eigen::Isometry3d& origin);
+  const Eigen::Isometry3d& getOrigin() const;
+
+private:
+  std::vector<Point> points_;
+  Eigen::Isometry3d origin_{ Eigen::Isometry3d::Identity() };
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_POINT_CLOUD_POINT_CLOUD_H
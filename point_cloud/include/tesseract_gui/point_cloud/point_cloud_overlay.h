@@ -0,0 +1,93 @@
+/**
+ * @file point_cloud_overlay.h
+ * @brief Draws a point cloud in the render scene
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_POINT_CLOUD_POINT_CLOUD_OVERLAY_H
+#define TESSERACT_GUI_POINT_CLOUD_POINT_CLOUD_OVERLAY_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <memory>
+#include <QOpenGLShaderProgram>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/point_cloud/point_cloud.h>
+#include <tesseract_gui/render/render_overlay.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief Draws the points of a cloud with their color in a single point draw call
+ *
+ * The points are uploaded unchanged as the vertex buffer and the origin of the cloud is applied in the vertex shader.
+ * The vertex buffer is kept between clouds: it is orphaned and refilled while a cloud fits its capacity and only grows
+ * when a larger cloud arrives, so streaming clouds of a steady size never reallocates GPU memory.
+ *
+ * The cloud is released after the upload so a PointCloudStream can decimate into it again. Setters may be called
+ * without the context current, changes are uploaded by the next render().
+ */
+class PointCloudOverlay : public RenderOverlay
+{
+public:
+  using Ptr = std::shared_ptr<PointCloudOverlay>;
+  using ConstPtr = std::shared_ptr<const PointCloudOverlay>;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  PointCloudOverlay() = default;
+
+  /** @brief Set the cloud to draw, e.g. connected to PointCloudStream::pointCloudChanged() */
+  void setPointCloud(PointCloud::ConstPtr cloud);
+
+  /** @brief The number of points of the last set cloud */
+  std::size_t getPointCount() const;
+
+  /** @brief The point size in pixels */
+  void setPointSize(float size);
+  float getPointSize() const;
+
+  void setVisible(bool visible);
+  bool isVisible() const;
+
+  void initialize(QOpenGLExtraFunctions& gl) override;
+  void cleanup(QOpenGLExtraFunctions& gl) override;
+  void render(QOpenGLExtraFunctions& gl, const Eigen::Matrix4f& view_projection, const Camera& camera) override;
+
+private:
+  /** @brief The cloud waiting for the upload */
+  PointCloud::ConstPtr cloud_;
+  std::size_t point_count_{ 0 };
+  Eigen::Matrix4f origin_{ Eigen::Matrix4f::Identity() };
+  float point_size_{ 2.0F };
+  bool visible_{ true };
+
+  std::unique_ptr<QOpenGLShaderProgram> program_;
+  int model_view_projection_location_{ -1 };
+  int point_size_location_{ -1 };
+
+  GLuint vao_{ 0 };
+  GLuint vertex_buffer_{ 0 };
+
+  /** @brief The number of points the vertex buffer has room for */
+  std::size_t capacity_{ 0 };
+  GLsizei vertex_count_{ 0 };
+
+  void uploadPoints(QOpenGLExtraFunctions& gl);
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_POINT_CLOUD_POINT_CLOUD_OVERLAY_H
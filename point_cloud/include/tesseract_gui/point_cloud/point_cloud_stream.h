@@ -0,0 +1,174 @@
+/**
+ * @file point_cloud_stream.h
+ * @brief Decimates streamed point clouds on a worker thread and delivers them once per frame
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_POINT_CLOUD_POINT_CLOUD_STREAM_H
+#define TESSERACT_GUI_POINT_CLOUD_POINT_CLOUD_STREAM_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <QObject>
+#include <QTimer>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/point_cloud/point_cloud.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief Accepts sensor clouds from any thread, decimates them with a VoxelDecimator on a worker thread and delivers
+ * the result once per frame
+ *
+ * Nothing queues up: a submitted cloud waits in a single slot, a cloud submitted before the worker took the previous one
+ * replaces it. Likewise only the latest decimated cloud is delivered per frame. Both cases are counted as dropped
+ * frames, so a sensor faster than the decimation or the display shows up in getDroppedFrameCount() instead of as a
+ * growing delay.
+ *
+ * Buffers are reused: submit() copies into one of two input clouds owned by the stream and the worker decimates into a
+ * pool of output clouds. The delivered pointers return their cloud to the pool when the last reference is released,
+ * on whichever thread that happens, or delete it if the stream is gone. With the GUI releasing the clouds it was
+ * given, a stream allocates only while frames grow.
+ */
+class PointCloudStream : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit PointCloudStream(QObject* parent = nullptr);
+
+  /** @brief Stops the worker, a running decimation is completed first */
+  ~PointCloudStream() override;
+  PointCloudStream(const PointCloudStream&) = delete;
+  PointCloudStream& operator=(const PointCloudStream&) = delete;
+  PointCloudStream(PointCloudStream&&) = delete;
+  PointCloudStream& operator=(PointCloudStream&&) = delete;
+
+  /** @brief The maximum number of delivered points, applied from the next decimated cloud */
+  void setPointBudget(std::size_t budget);
+  std::size_t getPointBudget() const;
+
+  /** @brief The smallest voxel edge length in meters, applied from the next decimated cloud */
+  void setMinVoxelSize(double size);
+  double getMinVoxelSize() const;
+
+  /**
+   * @brief Submit a cloud from a packed buffer, may be called from any thread
+   *
+   * The records are copied before returning, the buffer can be reused immediately.
+   * @param data The first record
+   * @param count The number of records
+   * @param layout The layout of a record
+   * @param origin The transform from the sensor frame to the world
+   */
+  void submit(const void* data, std::size_t count, const PointCloud::Layout& layout, const Eigen::Isometry3d& origin);
+
+  /** @brief Submit a copy of a cloud, may be called from any thread */
+  void submit(const PointCloud& cloud);
+
+  /** @brief The last delivered cloud */
+  PointCloud::ConstPtr getPointCloud() const;
+
+  /** @brief The number of submitted clouds */
+  std::uint64_t getReceivedFrameCount() const;
+
+  /** @brief The number of submitted clouds which were replaced before being decimated or delivered */
+  std::uint64_t getDroppedFrameCount() const;
+
+  /** @brief The voxel size of the last delivered cloud, 0 if it was within the budget */
+  double getVoxelSize() const;
+
+  /** @brief The duration of the decimation of the last delivered cloud in milliseconds */
+  double getLastDecimationDuration() const;
+
+  /** @brief Set the interval in which clouds are delivered, defaults to the primary screen refresh rate */
+  void setFrameInterval(int msec);
+  int getFrameInterval() const;
+
+public Q_SLOTS:
+  /** @brief Drop pending clouds and deliver an empty cloud */
+  void clear();
+
+Q_SIGNALS:
+  /** @brief A cloud decimated since the previous frame */
+  void pointCloudChanged(const tesseract_gui::PointCloud::ConstPtr& cloud);
+
+  /** @brief Emitted with a delivered cloud when frames were dropped since the previous delivery */
+  void framesDropped(quint64 dropped_frame_count);
+
+private:
+  /** @brief Output clouds no longer referenced, shared with the deleters of the delivered clouds */
+  struct OutputPool
+  {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<PointCloud>> clouds;
+  };
+
+  struct Result
+  {
+    PointCloud::ConstPtr cloud;
+    double voxel_size{ 0 };
+    double duration{ 0 };
+  };
+
+  mutable std::mutex mutex_;
+  std::condition_variable condition_;
+
+  /** @brief Serializes producers, they fill the spare input outside of mutex_ */
+  std::mutex submit_mutex_;
+
+  /** @brief The cloud waiting for the worker */
+  std::unique_ptr<PointCloud> pending_;
+
+  /** @brief An input cloud not in use, filled by the next submit() */
+  std::unique_ptr<PointCloud> spare_;
+
+  std::size_t budget_{ 200000 };
+  double min_voxel_size_{ 0.005 };
+  bool stopping_{ false };
+
+  /** @brief Incremented by clear(), clouds decimated from earlier submissions are dropped */
+  std::uint64_t generation_{ 0 };
+
+  std::uint64_t received_frame_count_{ 0 };
+  std::uint64_t dropped_frame_count_{ 0 };
+
+  /** @brief The latest decimated cloud not yet delivered */
+  Result completed_;
+  bool has_completed_{ false };
+
+  std::shared_ptr<OutputPool> output_pool_;
+
+  std::thread worker_;
+  QTimer frame_timer_;
+
+  PointCloud::ConstPtr cloud_;
+  double voxel_size_{ 0 };
+  double last_decimation_duration_{ 0 };
+  std::uint64_t reported_dropped_frame_count_{ 0 };
+
+  void run();
+  void deliverPointCloud();
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_POINT_CLOUD_POINT_CLOUD_STREAM_H
@@ -0,0 +1,59 @@
+/**
+ * @file point_cloud_widget.h
+ * @brief Point budget control and streaming statistics of a point cloud stream
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_POINT_CLOUD_POINT_CLOUD_WIDGET_H
+#define TESSERACT_GUI_POINT_CLOUD_POINT_CLOUD_WIDGET_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <QWidget>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/point_cloud/point_cloud.h>
+
+class QLabel;
+class QSpinBox;
+
+namespace tesseract_gui
+{
+class PointCloudStream;
+
+/**
+ * @brief A point budget spin box with the number of points, the voxel size, the decimation duration and the dropped
+ * frames of a stream
+ */
+class PointCloudWidget : public QWidget
+{
+  Q_OBJECT
+
+public:
+  explicit PointCloudWidget(PointCloudStream* stream, QWidget* parent = nullptr);
+
+  PointCloudStream* getStream() const;
+
+private:
+  PointCloudStream* stream_;
+  QSpinBox* budget_spin_box_;
+  QLabel* status_label_;
+
+  void onBudgetChanged(int budget);
+  void onPointCloudChanged(const PointCloud::ConstPtr& cloud);
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_POINT_CLOUD_POINT_CLOUD_WIDGET_H
@@ -0,0 +1,107 @@
+/**
+ * @file voxel_decimator.h
+ * @brief Reduces point clouds to a point budget by averaging the points of each voxel
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_POINT_CLOUD_VOXEL_DECIMATOR_H
+#define TESSERACT_GUI_POINT_CLOUD_VOXEL_DECIMATOR_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/point_cloud/point_cloud.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief Replaces the points of each voxel by their centroid and mean color, choosing the voxel size so the result fits
+ * a point budget
+ *
+ * The voxels are accumulated in an open addressing hash table with room for twice the budget which is allocated once.
+ * A pass is abandoned as soon as it fills more voxels than the budget, the voxel size is then enlarged by the estimated
+ * factor and the pass repeated. Sensors see similar scenes from frame to frame, so the voxel size of the previous frame
+ * is the starting point and usually succeeds in a single pass; when a frame uses less than half of the budget the next
+ * frame starts with a smaller voxel size.
+ *
+ * Points with a non finite coordinate (e.g. invalid depth readings) or more than 2^20 voxels away from the sensor are
+ * dropped. Clouds within the budget are copied without averaging. Not thread safe, use one decimator per thread.
+ */
+class VoxelDecimator
+{
+public:
+  VoxelDecimator() = default;
+
+  /** @brief The maximum number of output points, defaults to 200000 */
+  void setPointBudget(std::size_t budget);
+  std::size_t getPointBudget() const;
+
+  /** @brief The smallest voxel edge length in meters, defaults to 0.005 */
+  void setMinVoxelSize(double size);
+  double getMinVoxelSize() const;
+
+  /** @brief The voxel edge length used for the last decimated cloud, 0 if it was copied */
+  double getVoxelSize() const;
+
+  /** @brief The number of passes over the input needed for the last cloud */
+  int getPassCount() const;
+
+  /**
+   * @brief Decimate a cloud into another one, the output storage is reused
+   * @param input The cloud to decimate
+   * @param output Receives the decimated points and the origin of the input, must not be the input
+   */
+  void decimate(const PointCloud& input, PointCloud& output);
+
+private:
+  struct Voxel
+  {
+    std::uint64_t key;
+    std::array<float, 3> position_sum;
+    std::array<std::uint32_t, 3> color_sum;
+    std::uint32_t count;
+  };
+
+  std::size_t budget_{ 200000 };
+  double min_voxel_size_{ 0.005 };
+
+  /** @brief The voxel size the next pass starts with, 0 until it has been estimated from the bounds of a cloud */
+  double next_voxel_size_{ 0 };
+  double voxel_size_{ 0 };
+  int pass_count_{ 0 };
+
+  std::vector<Voxel> table_;
+  int table_bits_{ 0 };
+
+  /** @brief The table slots in use in the order they were filled */
+  std::vector<std::uint32_t> used_slots_;
+
+  void copyFinite(const PointCloud& input, PointCloud& output);
+  double estimateVoxelSize(const PointCloud& input) const;
+
+  /**
+   * @brief Accumulate the points into the voxels of a size
+   * @return The number of points processed, less than the size of the input if the budget was exceeded
+   */
+  std::size_t accumulate(const PointCloud& input, double voxel_size);
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_POINT_CLOUD_VOXEL_DECIMATOR_H
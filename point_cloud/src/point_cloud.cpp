@@ -0,0 +1,75 @@
+/**
+ * @file point_cloud.cpp
+ * @brief Point clouds stored as packed position and color records
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/point_cloud/point_cloud.h>
+
+namespace tesseract_gui
+{
+static_assert(sizeof(PointCloud::Point) == 16, "PointCloud::Point must be packed");
+
+void PointCloud::assign(const void* data, std::size_t count, const Layout& layout)
+{
+  if (layout.position_offset + (3 * sizeof(float)) > layout.stride ||
+      layout.rgb_offset + sizeof(std::uint32_t) > layout.stride)
+    throw std::runtime_error("PointCloud, layout does not fit into its stride!");
+
+  if (count > 0 && data == nullptr)
+    throw std::runtime_error("PointCloud, data is a nullptr!");
+
+  // resize() keeps the capacity, the storage is only reallocated when a frame is larger than all before
+  points_.resize(count);
+  if (count == 0)
+    return;
+
+  const auto* bytes = static_cast<const unsigned char*>(data);
+  if (layout.stride == sizeof(Point) && layout.position_offset == offsetof(Point, position) &&
+      layout.rgb_offset == offsetof(Point, rgb))
+  {
+    std::memcpy(points_.data(), bytes, count * sizeof(Point));
+    return;
+  }
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const unsigned char* record = bytes + (i * layout.stride);
+    std::memcpy(points_[i].position.data(), record + layout.position_offset, 3 * sizeof(float));
+    std::memcpy(&points_[i].rgb, record + layout.rgb_offset, sizeof(std::uint32_t));
+  }
+}
+
+void PointCloud::clear() { points_.clear(); }
+
+std::size_t PointCloud::size() const { return points_.size(); }
+
+bool PointCloud::empty() const { return points_.empty(); }
+
+std::vector<PointCloud::Point>& PointCloud::getPoints() { return points_; }
+
+const std::vector<PointCloud::Point>& PointCloud::getPoints() const { return points_; }
+
+void PointCloud::setOrigin(const Eigen::Isometry3d& origin) { origin_ = origin; }
+
+const Eigen::Isometry3d& PointCloud::getOrigin() const { return origin_; }
+
+}  // namespace tesseract_gui
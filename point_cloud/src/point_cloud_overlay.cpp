@@ -0,0 +1,171 @@
+/**
+ * @file point_cloud_overlay.cpp
+ * @brief Draws a point cloud in the render scene
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/point_cloud/point_cloud_overlay.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+const char* VERTEX_SHADER = R"(
+#version 330 core
+layout(location = 0) in vec3 position;
+layout(location = 1) in uint rgb;
+
+uniform mat4 model_view_projection;
+uniform float point_size;
+
+out vec4 color;
+
+void main()
+{
+  color = vec4(float((rgb >> 16u) & 255u), float((rgb >> 8u) & 255u), float(rgb & 255u), 255.0) / 255.0;
+  gl_PointSize = point_size;
+  gl_Position = model_view_projection * vec4(position, 1.0);
+}
+)";
+
+const char* FRAGMENT_SHADER = R"(
+#version 330 core
+in vec4 color;
+
+out vec4 fragment_color;
+
+void main()
+{
+  fragment_color = color;
+}
+)";
+}  // namespace
+
+void PointCloudOverlay::setPointCloud(PointCloud::ConstPtr cloud)
+{
+  cloud_ = std::move(cloud);
+  point_count_ = (cloud_ == nullptr) ? 0 : cloud_->size();
+  if (cloud_ != nullptr)
+    origin_ = cloud_->getOrigin().matrix().cast<float>();
+}
+
+std::size_t PointCloudOverlay::getPointCount() const { return point_count_; }
+
+void PointCloudOverlay::setPointSize(float size) { point_size_ = std::max(size, 1.0F); }
+
+float PointCloudOverlay::getPointSize() const { return point_size_; }
+
+void PointCloudOverlay::setVisible(bool visible) { visible_ = visible; }
+
+bool PointCloudOverlay::isVisible() const { return visible_; }
+
+void PointCloudOverlay::initialize(QOpenGLExtraFunctions& gl)
+{
+  program_ = std::make_unique<QOpenGLShaderProgram>();
+  if (!program_->addShaderFromSourceCode(QOpenGLShader::Vertex, VERTEX_SHADER) ||
+      !program_->addShaderFromSourceCode(QOpenGLShader::Fragment, FRAGMENT_SHADER) || !program_->link())
+    throw std::runtime_error("PointCloudOverlay, failed to build shader program: " + program_->log().toStdString());
+
+  model_view_projection_location_ = program_->uniformLocation("model_view_projection");
+  point_size_location_ = program_->uniformLocation("point_size");
+
+  gl.glGenVertexArrays(1, &vao_);
+  gl.glBindVertexArray(vao_);
+
+  using Point = PointCloud::Point;
+  const auto stride = static_cast<GLsizei>(sizeof(Point));
+  gl.glGenBuffers(1, &vertex_buffer_);
+  gl.glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_);
+  gl.glEnableVertexAttribArray(0);
+  gl.glVertexAttribPointer(
+      0, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const void*>(offsetof(Point, position)));
+  gl.glEnableVertexAttribArray(1);
+  gl.glVertexAttribIPointer(1, 1, GL_UNSIGNED_INT, stride, reinterpret_cast<const void*>(offsetof(Point, rgb)));
+
+  gl.glBindVertexArray(0);
+  gl.glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  capacity_ = 0;
+  vertex_count_ = 0;
+}
+
+void PointCloudOverlay::cleanup(QOpenGLExtraFunctions& gl)
+{
+  gl.glDeleteBuffers(1, &vertex_buffer_);
+  gl.glDeleteVertexArrays(1, &vao_);
+  vertex_buffer_ = 0;
+  vao_ = 0;
+  capacity_ = 0;
+  vertex_count_ = 0;
+  program_.reset();
+}
+
+void PointCloudOverlay::render(QOpenGLExtraFunctions& gl,
+                               const Eigen::Matrix4f& view_projection,
+                               const Camera& /*camera*/)
+{
+  if (cloud_ != nullptr)
+    uploadPoints(gl);
+
+  if (!visible_ || vertex_count_ == 0)
+    return;
+
+  const Eigen::Matrix4f model_view_projection = view_projection * origin_;
+
+  program_->bind();
+  gl.glUniformMatrix4fv(model_view_projection_location_, 1, GL_FALSE, model_view_projection.data());
+  gl.glUniform1f(point_size_location_, point_size_);
+  gl.glEnable(GL_PROGRAM_POINT_SIZE);
+
+  gl.glBindVertexArray(vao_);
+  gl.glDrawArrays(GL_POINTS, 0, vertex_count_);
+
+  gl.glBindVertexArray(0);
+  gl.glDisable(GL_PROGRAM_POINT_SIZE);
+  program_->release();
+}
+
+void PointCloudOverlay::uploadPoints(QOpenGLExtraFunctions& gl)
+{
+  const std::size_t count = cloud_->size();
+  gl.glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_);
+
+  // Growing by half avoids reallocating for every slightly larger cloud, refilling an orphaned buffer of the same size
+  // lets the driver hand out new storage instead of waiting for draws still reading the previous cloud
+  if (count > capacity_)
+    capacity_ = count + (count / 2);
+
+  gl.glBufferData(GL_ARRAY_BUFFER,
+                  static_cast<GLsizeiptr>(capacity_ * sizeof(PointCloud::Point)),
+                  nullptr,
+                  GL_STREAM_DRAW);
+  if (count > 0)
+    gl.glBufferSubData(GL_ARRAY_BUFFER,
+                       0,
+                       static_cast<GLsizeiptr>(count * sizeof(PointCloud::Point)),
+                       cloud_->getPoints().data());
+
+  gl.glBindBuffer(GL_ARRAY_BUFFER, 0);
+  vertex_count_ = static_cast<GLsizei>(count);
+  cloud_ = nullptr;
+}
+
+}  // namespace tesseract_gui
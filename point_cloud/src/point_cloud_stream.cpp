@@ -0,0 +1,257 @@
+/**
+ * @file point_cloud_stream.cpp
+ * @brief Decimates streamed point clouds on a worker thread and delivers them once per frame
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <chrono>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/common/frame_interval.h>
+#include <tesseract_gui/common/instrumentation.h>
+#include <tesseract_gui/point_cloud/point_cloud_stream.h>
+#include <tesseract_gui/point_cloud/voxel_decimator.h>
+
+namespace tesseract_gui
+{
+PointCloudStream::PointCloudStream(QObject* parent)
+  : QObject(parent), output_pool_(std::make_shared<OutputPool>()), cloud_(std::make_shared<PointCloud>())
+{
+  frame_timer_.setTimerType(Qt::PreciseTimer);
+  frame_timer_.setInterval(getDefaultFrameInterval());
+  connect(&frame_timer_, &QTimer::timeout, this, &PointCloudStream::deliverPointCloud);
+  frame_timer_.start();
+
+  worker_ = std::thread([this]() { run(); });
+}
+
+PointCloudStream::~PointCloudStream()
+{
+  {
+    std::scoped_lock lock(mutex_);
+    stopping_ = true;
+  }
+  condition_.notify_one();
+
+  if (worker_.joinable())
+    worker_.join();
+}
+
+void PointCloudStream::setPointBudget(std::size_t budget)
+{
+  std::scoped_lock lock(mutex_);
+  budget_ = std::max<std::size_t>(budget, 1);
+}
+
+std::size_t PointCloudStream::getPointBudget() const
+{
+  std::scoped_lock lock(mutex_);
+  return budget_;
+}
+
+void PointCloudStream::setMinVoxelSize(double size)
+{
+  std::scoped_lock lock(mutex_);
+  min_voxel_size_ = size;
+}
+
+double PointCloudStream::getMinVoxelSize() const
+{
+  std::scoped_lock lock(mutex_);
+  return min_voxel_size_;
+}
+
+void PointCloudStream::submit(const void* data,
+                              std::size_t count,
+                              const PointCloud::Layout& layout,
+                              const Eigen::Isometry3d& origin)
+{
+  std::scoped_lock submit_lock(submit_mutex_);
+
+  std::unique_ptr<PointCloud> input;
+  {
+    std::scoped_lock lock(mutex_);
+    input = std::move(spare_);
+  }
+
+  if (input == nullptr)
+    input = std::make_unique<PointCloud>();
+
+  // Copied without holding mutex_, the worker keeps decimating meanwhile
+  input->assign(data, count, layout);
+  input->setOrigin(origin);
+
+  {
+    std::scoped_lock lock(mutex_);
+    ++received_frame_count_;
+    if (pending_ != nullptr)
+    {
+      ++dropped_frame_count_;
+      if (spare_ == nullptr)
+        spare_ = std::move(pending_);
+    }
+    pending_ = std::move(input);
+  }
+  condition_.notify_one();
+}
+
+void PointCloudStream::submit(const PointCloud& cloud)
+{
+  submit(cloud.getPoints().data(), cloud.size(), PointCloud::Layout(), cloud.getOrigin());
+}
+
+PointCloud::ConstPtr PointCloudStream::getPointCloud() const { return cloud_; }
+
+std::uint64_t PointCloudStream::getReceivedFrameCount() const
+{
+  std::scoped_lock lock(mutex_);
+  return received_frame_count_;
+}
+
+std::uint64_t PointCloudStream::getDroppedFrameCount() const
+{
+  std::scoped_lock lock(mutex_);
+  return dropped_frame_count_;
+}
+
+double PointCloudStream::getVoxelSize() const { return voxel_size_; }
+
+double PointCloudStream::getLastDecimationDuration() const { return last_decimation_duration_; }
+
+void PointCloudStream::setFrameInterval(int msec) { frame_timer_.setInterval(msec); }
+
+int PointCloudStream::getFrameInterval() const { return frame_timer_.interval(); }
+
+void PointCloudStream::clear()
+{
+  {
+    std::scoped_lock lock(mutex_);
+    if (pending_ != nullptr && spare_ == nullptr)
+      spare_ = std::move(pending_);
+    pending_ = nullptr;
+    has_completed_ = false;
+    completed_ = Result();
+    ++generation_;
+  }
+
+  cloud_ = std::make_shared<PointCloud>();
+  voxel_size_ = 0;
+  last_decimation_duration_ = 0;
+  emit pointCloudChanged(cloud_);
+}
+
+void PointCloudStream::run()
+{
+  VoxelDecimator decimator;
+
+  // Released output clouds are returned to the pool and decimated into again
+  auto release = [pool = std::weak_ptr<OutputPool>(output_pool_)](PointCloud* cloud) {
+    std::unique_ptr<PointCloud> released(cloud);
+    if (auto output_pool = pool.lock())
+    {
+      std::scoped_lock lock(output_pool->mutex);
+      output_pool->clouds.push_back(std::move(released));
+    }
+  };
+
+  while (true)
+  {
+    std::unique_ptr<PointCloud> input;
+    std::uint64_t generation{ 0 };
+    {
+      std::unique_lock lock(mutex_);
+      condition_.wait(lock, [this]() { return stopping_ || pending_ != nullptr; });
+      if (stopping_)
+        return;
+
+      input = std::move(pending_);
+      generation = generation_;
+      decimator.setPointBudget(budget_);
+      decimator.setMinVoxelSize(min_voxel_size_);
+    }
+
+    std::unique_ptr<PointCloud> output;
+    {
+      std::scoped_lock lock(output_pool_->mutex);
+      if (!output_pool_->clouds.empty())
+      {
+        output = std::move(output_pool_->clouds.back());
+        output_pool_->clouds.pop_back();
+      }
+    }
+
+    if (output == nullptr)
+      output = std::make_unique<PointCloud>();
+
+    const auto start = std::chrono::steady_clock::now();
+    decimator.decimate(*input, *output);
+    const auto end = std::chrono::steady_clock::now();
+    if (Instrumentation::instance().isEnabled())
+    {
+      Instrumentation::instance().recordTimer("point_cloud", "decimate", start, end);
+      recordCounter("point_cloud", "input points", static_cast<std::int64_t>(input->size()));
+      recordCounter("point_cloud", "output points", static_cast<std::int64_t>(output->size()));
+    }
+
+    Result result;
+    result.cloud = PointCloud::Ptr(output.release(), release);
+    result.voxel_size = decimator.getVoxelSize();
+    result.duration = std::chrono::duration<double, std::milli>(end - start).count();
+
+    std::scoped_lock lock(mutex_);
+    if (spare_ == nullptr)
+      spare_ = std::move(input);
+
+    if (generation == generation_)
+    {
+      if (has_completed_)
+        ++dropped_frame_count_;
+
+      completed_ = std::move(result);
+      has_completed_ = true;
+    }
+  }
+}
+
+void PointCloudStream::deliverPointCloud()
+{
+  Result result;
+  std::uint64_t dropped_frame_count{ 0 };
+  {
+    std::scoped_lock lock(mutex_);
+    if (!has_completed_)
+      return;
+
+    result = std::move(completed_);
+    has_completed_ = false;
+    dropped_frame_count = dropped_frame_count_;
+  }
+
+  cloud_ = std::move(result.cloud);
+  voxel_size_ = result.voxel_size;
+  last_decimation_duration_ = result.duration;
+  emit pointCloudChanged(cloud_);
+
+  recordCounter("point_cloud", "dropped frames", static_cast<std::int64_t>(dropped_frame_count));
+  if (dropped_frame_count != reported_dropped_frame_count_)
+  {
+    reported_dropped_frame_count_ = dropped_frame_count;
+    emit framesDropped(dropped_frame_count);
+  }
+}
+
+}  // namespace tesseract_gui
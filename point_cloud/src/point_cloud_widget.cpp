@@ -0,0 +1,79 @@
+/**
+ * @file point_cloud_widget.cpp
+ * @brief Point budget control and streaming statistics of a point cloud stream
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QSpinBox>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/point_cloud/point_cloud_stream.h>
+#include <tesseract_gui/point_cloud/point_cloud_widget.h>
+
+namespace tesseract_gui
+{
+PointCloudWidget::PointCloudWidget(PointCloudStream* stream, QWidget* parent)
+  : QWidget(parent), stream_(stream), budget_spin_box_(new QSpinBox(this)), status_label_(new QLabel(this))
+{
+  if (stream_ == nullptr)
+    throw std::runtime_error("PointCloudWidget, stream is a nullptr!");
+
+  const auto budget = std::min<std::size_t>(stream_->getPointBudget(), std::numeric_limits<int>::max());
+  budget_spin_box_->setRange(1000, std::numeric_limits<int>::max());
+  budget_spin_box_->setSingleStep(10000);
+  budget_spin_box_->setSuffix(" points");
+  budget_spin_box_->setValue(static_cast<int>(budget));
+
+  auto* layout = new QHBoxLayout(this);
+  layout->addWidget(budget_spin_box_);
+  layout->addWidget(status_label_, 1);
+
+  connect(budget_spin_box_, QOverload<int>::of(&QSpinBox::valueChanged), this, &PointCloudWidget::onBudgetChanged);
+  connect(stream_, &PointCloudStream::pointCloudChanged, this, &PointCloudWidget::onPointCloudChanged);
+
+  onPointCloudChanged(stream_->getPointCloud());
+}
+
+PointCloudStream* PointCloudWidget::getStream() const { return stream_; }
+
+void PointCloudWidget::onBudgetChanged(int budget) { stream_->setPointBudget(static_cast<std::size_t>(budget)); }
+
+void PointCloudWidget::onPointCloudChanged(const PointCloud::ConstPtr& cloud)
+{
+  if (cloud == nullptr || stream_->getReceivedFrameCount() == 0)
+  {
+    status_label_->clear();
+    return;
+  }
+
+  const QString voxel_size = (stream_->getVoxelSize() > 0) ?
+                                 QString("%1 mm voxels").arg(stream_->getVoxelSize() * 1000.0, 0, 'f', 1) :
+                                 QString("not decimated");
+
+  status_label_->setText(QString("%1 points, %2, %3 ms, %4 of %5 frames dropped")
+                             .arg(cloud->size())
+                             .arg(voxel_size)
+                             .arg(stream_->getLastDecimationDuration(), 0, 'f', 1)
+                             .arg(stream_->getDroppedFrameCount())
+                             .arg(stream_->getReceivedFrameCount()));
+}
+
+}  // namespace tesseract_gui
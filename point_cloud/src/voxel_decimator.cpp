@@ -0,0 +1,227 @@
+/**
+ * @file voxel_decimator.cpp
+ * @brief Reduces point clouds to a point budget by averaging the points of each voxel
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <cmath>
+#include <limits>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/point_cloud/voxel_decimator.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+constexpr std::uint64_t EMPTY_KEY = std::numeric_limits<std::uint64_t>::max();
+
+/** @brief Each voxel coordinate is stored in 21 bits of the key, offset to be positive */
+constexpr int KEY_BITS = 21;
+constexpr std::int64_t KEY_OFFSET = std::int64_t{ 1 } << (KEY_BITS - 1);
+constexpr float KEY_LIMIT = static_cast<float>(KEY_OFFSET);
+
+bool isFinite(const PointCloud::Point& point)
+{
+  return std::isfinite(point.position[0]) && std::isfinite(point.position[1]) && std::isfinite(point.position[2]);
+}
+}  // namespace
+
+void VoxelDecimator::setPointBudget(std::size_t budget)
+{
+  budget = std::max<std::size_t>(budget, 1);
+  if (budget == budget_)
+    return;
+
+  budget_ = budget;
+  next_voxel_size_ = 0;
+  table_.clear();
+  table_.shrink_to_fit();
+  used_slots_.clear();
+}
+
+std::size_t VoxelDecimator::getPointBudget() const { return budget_; }
+
+void VoxelDecimator::setMinVoxelSize(double size)
+{
+  min_voxel_size_ = std::max(size, 1e-6);
+  next_voxel_size_ = std::max(next_voxel_size_, min_voxel_size_);
+}
+
+double VoxelDecimator::getMinVoxelSize() const { return min_voxel_size_; }
+
+double VoxelDecimator::getVoxelSize() const { return voxel_size_; }
+
+int VoxelDecimator::getPassCount() const { return pass_count_; }
+
+void VoxelDecimator::decimate(const PointCloud& input, PointCloud& output)
+{
+  output.setOrigin(input.getOrigin());
+  if (input.size() <= budget_)
+  {
+    copyFinite(input, output);
+    voxel_size_ = 0;
+    pass_count_ = 1;
+    return;
+  }
+
+  if (table_.empty())
+  {
+    table_bits_ = 1;
+    while ((std::size_t{ 1 } << table_bits_) < 2 * budget_)
+      ++table_bits_;
+
+    table_.assign(std::size_t{ 1 } << table_bits_, Voxel{ EMPTY_KEY, {}, {}, 0 });
+    used_slots_.reserve(budget_);
+  }
+
+  double voxel_size = std::max((next_voxel_size_ > 0) ? next_voxel_size_ : estimateVoxelSize(input), min_voxel_size_);
+  pass_count_ = 0;
+  while (true)
+  {
+    ++pass_count_;
+    const std::size_t processed = accumulate(input, voxel_size);
+    if (processed == input.size())
+      break;
+
+    // The voxels filled so far came from a fraction of the points, the whole cloud fills about budget / fraction
+    const double fraction = std::max(static_cast<double>(processed) / static_cast<double>(input.size()), 1e-3);
+    voxel_size *= std::max(1.25, 1.1 * std::cbrt(1.0 / fraction));
+  }
+
+  voxel_size_ = voxel_size;
+
+  const std::size_t count = used_slots_.size();
+  const double usage = static_cast<double>(count) / static_cast<double>(budget_);
+  next_voxel_size_ = (usage < 0.5) ? std::max(voxel_size * std::max(std::cbrt(usage / 0.8), 0.8), min_voxel_size_) :
+                                     voxel_size;
+
+  std::vector<PointCloud::Point>& points = output.getPoints();
+  points.resize(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const Voxel& voxel = table_[used_slots_[i]];
+    const float scale = 1.0F / static_cast<float>(voxel.count);
+    PointCloud::Point& point = points[i];
+    point.position = { voxel.position_sum[0] * scale, voxel.position_sum[1] * scale, voxel.position_sum[2] * scale };
+    point.rgb = ((voxel.color_sum[0] / voxel.count) << 16U) | ((voxel.color_sum[1] / voxel.count) << 8U) |
+                (voxel.color_sum[2] / voxel.count);
+  }
+}
+
+void VoxelDecimator::copyFinite(const PointCloud& input, PointCloud& output)
+{
+  const std::vector<PointCloud::Point>& input_points = input.getPoints();
+  std::vector<PointCloud::Point>& points = output.getPoints();
+  points.resize(input_points.size());
+
+  std::size_t count{ 0 };
+  for (const auto& point : input_points)
+  {
+    if (isFinite(point))
+      points[count++] = point;
+  }
+  points.resize(count);
+}
+
+double VoxelDecimator::estimateVoxelSize(const PointCloud& input) const
+{
+  Eigen::Array3f min = Eigen::Array3f::Constant(std::numeric_limits<float>::max());
+  Eigen::Array3f max = Eigen::Array3f::Constant(std::numeric_limits<float>::lowest());
+  for (const auto& point : input.getPoints())
+  {
+    if (!isFinite(point))
+      continue;
+
+    const Eigen::Array3f position(point.position[0], point.position[1], point.position[2]);
+    min = min.min(position);
+    max = max.max(position);
+  }
+
+  if ((max < min).any())
+    return min_voxel_size_;
+
+  // Sensors sample surfaces, so the points spread over about the area of the two largest extents rather than the volume
+  Eigen::Array3f extents = (max - min).max(static_cast<float>(min_voxel_size_));
+  std::sort(extents.data(), extents.data() + 3);
+  const double area = static_cast<double>(extents[1]) * static_cast<double>(extents[2]);
+  return std::sqrt(area / static_cast<double>(budget_));
+}
+
+std::size_t VoxelDecimator::accumulate(const PointCloud& input, double voxel_size)
+{
+  for (const std::uint32_t slot : used_slots_)
+    table_[slot].key = EMPTY_KEY;
+  used_slots_.clear();
+
+  const float scale = static_cast<float>(1.0 / voxel_size);
+  const int shift = 64 - table_bits_;
+  const std::uint64_t mask = table_.size() - 1;
+
+  const std::vector<PointCloud::Point>& points = input.getPoints();
+  for (std::size_t i = 0; i < points.size(); ++i)
+  {
+    const PointCloud::Point& point = points[i];
+    const float x = std::floor(point.position[0] * scale);
+    const float y = std::floor(point.position[1] * scale);
+    const float z = std::floor(point.position[2] * scale);
+
+    // Also false for NaN
+    if (!(std::abs(x) < KEY_LIMIT && std::abs(y) < KEY_LIMIT && std::abs(z) < KEY_LIMIT))
+      continue;
+
+    const auto coordinate = [](float value) {
+      return static_cast<std::uint64_t>(static_cast<std::int64_t>(value) + KEY_OFFSET);
+    };
+    const std::uint64_t key = (coordinate(x) << (2 * KEY_BITS)) | (coordinate(y) << KEY_BITS) | coordinate(z);
+
+    // Fibonacci hashing spreads neighboring voxels over the table, collisions are resolved by linear probing
+    std::uint64_t slot = (key * 0x9E3779B97F4A7C15ULL) >> shift;
+    while (table_[slot].key != EMPTY_KEY && table_[slot].key != key)
+      slot = (slot + 1) & mask;
+
+    const std::uint32_t red = (point.rgb >> 16U) & 0xFFU;
+    const std::uint32_t green = (point.rgb >> 8U) & 0xFFU;
+    const std::uint32_t blue = point.rgb & 0xFFU;
+
+    Voxel& voxel = table_[slot];
+    if (voxel.key == EMPTY_KEY)
+    {
+      if (used_slots_.size() == budget_)
+        return i;
+
+      voxel.key = key;
+      voxel.position_sum = point.position;
+      voxel.color_sum = { red, green, blue };
+      voxel.count = 1;
+      used_slots_.push_back(static_cast<std::uint32_t>(slot));
+      continue;
+    }
+
+    voxel.position_sum[0] += point.position[0];
+    voxel.position_sum[1] += point.position[1];
+    voxel.position_sum[2] += point.position[2];
+    voxel.color_sum[0] += red;
+    voxel.color_sum[1] += green;
+    voxel.color_sum[2] += blue;
+    ++voxel.count;
+  }
+
+  return points.size();
+}
+
+}  // namespace tesseract_gui
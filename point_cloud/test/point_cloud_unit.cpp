@@ -0,0 +1,140 @@
+/**
+ * @file point_cloud_unit.cpp
+ * @brief Tests of the point cloud utilities
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <gtest/gtest.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/point_cloud/point_cloud.h>
+#include <tesseract_gui/point_cloud/voxel_decimator.h>
+
+using namespace tesseract_gui;
+
+namespace
+{
+constexpr std::uint32_t COLOR = 0x102030;
+
+/** @brief Points spread over a box of a size plus a dense cluster, every hundredth point is an invalid reading */
+void createCloud(PointCloud& cloud, std::size_t count, float box_size, std::mt19937& generator)
+{
+  std::uniform_real_distribution<float> box(-box_size, box_size);
+  std::normal_distribution<float> cluster(0.5F, 0.01F);
+  cloud.clear();
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    PointCloud::Point point{};
+    if (i % 100 == 0)
+      point.position = { std::numeric_limits<float>::quiet_NaN(), 0, 0 };
+    else if (i % 2 == 0)
+      point.position = { cluster(generator), cluster(generator), cluster(generator) };
+    else
+      point.position = { box(generator), box(generator), box(generator) };
+    point.rgb = COLOR;
+    cloud.getPoints().push_back(point);
+  }
+}
+
+bool isFinite(const PointCloud::Point& point)
+{
+  return std::isfinite(point.position[0]) && std::isfinite(point.position[1]) && std::isfinite(point.position[2]);
+}
+}  // namespace
+
+TEST(TesseractGuiPointCloudUnit, VoxelDecimatorCopiesCloudsWithinBudget)  // NOLINT
+{
+  std::mt19937 generator(42);
+  PointCloud input;
+  createCloud(input, 500, 1, generator);
+
+  VoxelDecimator decimator;
+  decimator.setPointBudget(1000);
+  PointCloud output;
+  decimator.decimate(input, output);
+
+  // Only the invalid readings are dropped
+  EXPECT_EQ(output.size(), 495U);
+  EXPECT_DOUBLE_EQ(decimator.getVoxelSize(), 0);
+  for (const PointCloud::Point& point : output.getPoints())
+    EXPECT_TRUE(isFinite(point));
+}
+
+TEST(TesseractGuiPointCloudUnit, VoxelDecimatorStaysWithinBudget)  // NOLINT
+{
+  std::mt19937 generator(42);
+  PointCloud input;
+  PointCloud output;
+  for (const std::size_t budget : { 1U, 10U, 1000U, 5000U })
+  {
+    VoxelDecimator decimator;
+    decimator.setPointBudget(budget);
+    decimator.setMinVoxelSize(0.001);
+
+    // The scene grows and shrinks from frame to frame, the voxel size of the previous frame is a poor estimate then
+    for (const float box_size : { 1.0F, 4.0F, 0.25F, 8.0F, 1.0F, 1.0F })
+    {
+      createCloud(input, 50000, box_size, generator);
+      decimator.decimate(input, output);
+
+      ASSERT_LE(output.size(), budget) << "box size " << box_size;
+      EXPECT_GT(output.size(), 0U);
+      EXPECT_GE(decimator.getVoxelSize(), decimator.getMinVoxelSize());
+      EXPECT_GE(decimator.getPassCount(), 1);
+
+      // Centroids lie within the bounds of the box and the cluster around 0.5
+      const float bound = std::max(box_size, 0.6F);
+      for (const PointCloud::Point& point : output.getPoints())
+      {
+        ASSERT_TRUE(isFinite(point));
+        for (const float coordinate : point.position)
+          EXPECT_LE(std::abs(coordinate), bound);
+        EXPECT_EQ(point.rgb, COLOR);
+      }
+    }
+  }
+}
+
+TEST(TesseractGuiPointCloudUnit, VoxelDecimatorMinVoxelSize)  // NOLINT
+{
+  // Points 1 mm apart merge into one voxel of the minimum size even though the budget would allow all of them
+  PointCloud input;
+  for (int i = 0; i < 10; ++i)
+    input.getPoints().push_back({ { 0.0001F * static_cast<float>(i), 0, 0 }, COLOR });
+  for (int i = 0; i < 10; ++i)
+    input.getPoints().push_back({ { 5, 0.0001F * static_cast<float>(i), 0 }, COLOR });
+
+  VoxelDecimator decimator;
+  decimator.setPointBudget(15);
+  decimator.setMinVoxelSize(0.01);
+  PointCloud output;
+  decimator.decimate(input, output);
+
+  EXPECT_EQ(output.size(), 2U);
+  EXPECT_GE(decimator.getVoxelSize(), 0.01);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
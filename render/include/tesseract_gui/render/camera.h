@@ -0,0 +1,77 @@
+/**
+ * @file camera.h
+ * @brief An orbit camera for the render scene
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_RENDER_CAMERA_H
+#define TESSERACT_GUI_RENDER_CAMERA_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <Eigen/Core>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+namespace tesseract_gui
+{
+/**
+ * @brief A perspective camera orbiting a target point with z up
+ *
+ * The eye position is defined by the distance to the target and the yaw and pitch angles around it.
+ */
+class Camera
+{
+public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  Camera() = default;
+
+  /** @brief Place the camera at eye looking at target */
+  void lookAt(const Eigen::Vector3f& eye, const Eigen::Vector3f& target);
+
+  /** @brief Rotate around the target by the provided angles in radians */
+  void orbit(float delta_yaw, float delta_pitch);
+
+  /** @brief Move the target and eye in the view plane, deltas are fractions of the distance to the target */
+  void pan(float delta_x, float delta_y);
+
+  /** @brief Scale the distance to the target */
+  void zoom(float factor);
+
+  Eigen::Vector3f getEye() const;
+  const Eigen::Vector3f& getTarget() const;
+  float getDistance() const;
+
+  /** @brief The vertical field of view in radians */
+  void setFieldOfView(float fov_y);
+  float getFieldOfView() const;
+
+  void setClipPlanes(float near_plane, float far_plane);
+
+  Eigen::Matrix4f getViewMatrix() const;
+  Eigen::Matrix4f getProjectionMatrix(float aspect_ratio) const;
+
+private:
+  Eigen::Vector3f target_{ Eigen::Vector3f::Zero() };
+  float distance_{ 5.0F };
+  float yaw_{ 0.785F };
+  float pitch_{ 0.5F };
+  float fov_y_{ 0.785F };
+  float near_{ 0.01F };
+  float far_{ 1000.0F };
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_RENDER_CAMERA_H
@@ -0,0 +1,42 @@
+/**
+ * @file geometry_conversion.h
+ * @brief Tessellation of tesseract geometries into mesh buffers
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_RENDER_GEOMETRY_CONVERSION_H
+#define TESSERACT_GUI_RENDER_GEOMETRY_CONVERSION_H
+
+#include <tesseract_geometry/geometry.h>
+#include <tesseract_gui/render/mesh_buffers.h>
+
+namespace tesseract_gui
+{
+/** @brief The number of segments around the axis of tessellated spheres, cylinders, capsules and cones */
+static constexpr int DEFAULT_TESSELLATION_SEGMENTS = 32;
+
+/**
+ * @brief Convert a geometry into triangle buffers
+ *
+ * Primitives are tessellated and meshes are triangulated with their scale applied. Planes and octrees are not
+ * supported.
+ *
+ * @param geometry The geometry to convert
+ * @return The buffers, nullptr if the geometry type is not supported
+ */
+MeshBuffers::Ptr createMeshBuffers(const tesseract_geometry::Geometry& geometry);
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_RENDER_GEOMETRY_CONVERSION_H
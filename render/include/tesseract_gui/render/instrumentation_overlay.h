@@ -0,0 +1,72 @@
+/**
+ * @file instrumentation_overlay.h
+ * @brief Shows the instrumentation timers and counters on top of a widget
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_RENDER_INSTRUMENTATION_OVERLAY_H
+#define TESSERACT_GUI_RENDER_INSTRUMENTATION_OVERLAY_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <QStringList>
+#include <QTimer>
+#include <QWidget>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+namespace tesseract_gui
+{
+/**
+ * @brief A translucent panel listing the statistics of Instrumentation::instance(), placed over its parent widget
+ *
+ * Each timer shows its last duration, the mean over the last refresh interval, its maximum and count, each counter
+ * (e.g. a queue depth) its last and maximum value. Showing the overlay enables instrumentation, hiding it does not
+ * disable it so a trace can still be exported with Instrumentation::saveChromeTrace(). The overlay ignores mouse
+ * events and only refreshes while visible.
+ */
+class InstrumentationOverlay : public QWidget
+{
+  Q_OBJECT
+
+public:
+  explicit InstrumentationOverlay(QWidget* parent = nullptr);
+
+  /** @brief Set the refresh interval, defaults to 500 ms */
+  void setRefreshInterval(int msec);
+  int getRefreshInterval() const;
+
+public Q_SLOTS:
+  /** @brief Read the statistics and repaint */
+  void refresh();
+
+protected:
+  void showEvent(QShowEvent* event) override;
+  void hideEvent(QHideEvent* event) override;
+  void paintEvent(QPaintEvent* event) override;
+
+private:
+  QTimer refresh_timer_;
+  QStringList lines_;
+
+  /** @brief The count and total of each timer at the previous refresh */
+  std::map<std::pair<std::string, std::string>, std::pair<std::uint64_t, double>> previous_;
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_RENDER_INSTRUMENTATION_OVERLAY_H
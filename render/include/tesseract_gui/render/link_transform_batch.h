@@ -0,0 +1,87 @@
+/**
+ * @file link_transform_batch.h
+ * @brief Packs link world transforms into a contiguous float array
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_RENDER_LINK_TRANSFORM_BATCH_H
+#define TESSERACT_GUI_RENDER_LINK_TRANSFORM_BATCH_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <string>
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_common/types.h>
+#include <tesseract_scene_graph/scene_state.h>
+
+namespace tesseract_environment
+{
+class Environment;
+}
+
+namespace tesseract_gui
+{
+/**
+ * @brief Converts the link transforms of a scene state into one packed array of column major 4x4 float matrices
+ *
+ * The order of the matrices is the order of the link names the batch was created with, which lets a renderer
+ * upload all link transforms of a frame with a single copy instead of walking the scene graph per link. Links
+ * missing from a scene state keep their previous transform (identity initially).
+ */
+class LinkTransformBatch
+{
+public:
+  /** @brief The number of floats per link */
+  static constexpr std::size_t MATRIX_SIZE = 16;
+
+  LinkTransformBatch() = default;
+  explicit LinkTransformBatch(std::vector<std::string> link_names);
+
+  /** @brief Set the link order, all transforms are reset to identity */
+  void setLinkNames(std::vector<std::string> link_names);
+  const std::vector<std::string>& getLinkNames() const;
+
+  /** @brief Update from a single Environment::getState() call */
+  void update(const tesseract_environment::Environment& environment);
+
+  /** @brief Update from the link transforms of a scene state */
+  void update(const tesseract_scene_graph::SceneState& state);
+
+  /** @brief Update from a map of link transforms */
+  void update(const tesseract_common::TransformMap& link_transforms);
+
+  /**
+   * @brief Write the link transforms into an external buffer using the link order of this batch
+   * @param link_transforms The link transforms
+   * @param data Buffer of at least size() * MATRIX_SIZE floats
+   */
+  void pack(const tesseract_common::TransformMap& link_transforms, float* data) const;
+
+  /** @brief The packed transforms, MATRIX_SIZE floats per link */
+  const std::vector<float>& getTransforms() const;
+  const float* data() const;
+
+  /** @brief The number of links */
+  std::size_t size() const;
+
+private:
+  std::vector<std::string> link_names_;
+  std::vector<float> transforms_;
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_RENDER_LINK_TRANSFORM_BATCH_H
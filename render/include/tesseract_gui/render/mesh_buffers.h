@@ -0,0 +1,67 @@
+/**
+ * @file mesh_buffers.h
+ * @brief Triangle buffers of a geometry ready to be uploaded to the GPU
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_RENDER_MESH_BUFFERS_H
+#define TESSERACT_GUI_RENDER_MESH_BUFFERS_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <Eigen/Core>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+namespace tesseract_gui
+{
+/**
+ * @brief Interleaved vertex and triangle index buffers independent of any graphics context
+ *
+ * Each vertex is a position followed by a normal (six floats). Buffers are shared between render objects through
+ * ConstPtr and must not be modified once handed to a RenderScene.
+ */
+struct MeshBuffers
+{
+  using Ptr = std::shared_ptr<MeshBuffers>;
+  using ConstPtr = std::shared_ptr<const MeshBuffers>;
+
+  /** @brief The number of floats per vertex */
+  static constexpr std::size_t VERTEX_STRIDE = 6;
+
+  std::vector<float> vertices;
+  std::vector<std::uint32_t> indices;
+
+  void addVertex(const Eigen::Vector3f& position, const Eigen::Vector3f& normal)
+  {
+    vertices.insert(vertices.end(), { position.x(), position.y(), position.z(), normal.x(), normal.y(), normal.z() });
+  }
+
+  void addTriangle(std::uint32_t a, std::uint32_t b, std::uint32_t c) { indices.insert(indices.end(), { a, b, c }); }
+
+  std::size_t getVertexCount() const { return vertices.size() / VERTEX_STRIDE; }
+  std::size_t getTriangleCount() const { return indices.size() / 3; }
+
+  /** @brief The memory used by the vertex and index data in bytes */
+  std::size_t getByteSize() const
+  {
+    return (vertices.size() * sizeof(float)) + (indices.size() * sizeof(std::uint32_t));
+  }
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_RENDER_MESH_BUFFERS_H
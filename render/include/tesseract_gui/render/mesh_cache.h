@@ -0,0 +1,139 @@
+/**
+ * @file mesh_cache.h
+ * @brief Process wide cache sharing mesh buffers between render objects
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_RENDER_MESH_CACHE_H
+#define TESSERACT_GUI_RENDER_MESH_CACHE_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_geometry/geometry.h>
+#include <tesseract_gui/render/mesh_buffers.h>
+#include <tesseract_gui/render/mesh_lod.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief Shares the converted buffers of identical meshes across all render objects of the process
+ *
+ * Mesh, convex mesh and SDF mesh geometries are keyed by their resource URL plus a hash of their vertex, face,
+ * normal and scale data, so every link referencing the same file at the same scale receives the same MeshBuffers and
+ * the renderer uploads them once. The cache only holds weak references, buffers are released as soon as the last
+ * render object using them is gone. Primitives are cheap to tessellate and are not cached.
+ *
+ * The cache only sees geometries which were already decoded. Reading and decoding mesh files is done by the URDF
+ * parser of tesseract before, once per reference, so duplicate files still cost a decode each. What is shared is the
+ * conversion to render buffers, the memory of the buffers and the GPU upload.
+ *
+ * Levels of detail of meshes are shared the same way through getLod(), their decimated levels are generated one
+ * mesh at a time on a background thread owned by the cache.
+ *
+ * All methods are thread safe, conversion runs outside of the cache lock.
+ */
+class MeshCache
+{
+public:
+  /** @brief The process wide instance */
+  static MeshCache& instance();
+
+  MeshCache() = default;
+  ~MeshCache();
+  MeshCache(const MeshCache&) = delete;
+  MeshCache& operator=(const MeshCache&) = delete;
+  MeshCache(MeshCache&&) = delete;
+  MeshCache& operator=(MeshCache&&) = delete;
+
+  /**
+   * @brief Get the buffers of a geometry, converting it only if no identical mesh is alive
+   * @return The buffers, nullptr if the geometry type can not be converted
+   */
+  MeshBuffers::ConstPtr get(const tesseract_geometry::Geometry& geometry);
+
+  /**
+   * @brief Get the levels of detail of a mesh geometry
+   *
+   * The returned object initially only holds the full detail mesh, decimated levels are added in the background.
+   * @return The levels of detail, nullptr if the geometry is not a tesseract_geometry::Mesh
+   */
+  MeshLod::ConstPtr getLod(const tesseract_geometry::Geometry& geometry);
+
+  /** @brief The number of buffers currently alive */
+  std::size_t size() const;
+
+  /** @brief The memory used by all buffers currently alive in bytes */
+  std::size_t getByteSize() const;
+
+  /** @brief The number of get() calls served from the cache */
+  std::size_t getHitCount() const;
+
+  /** @brief The number of get() calls which converted a mesh */
+  std::size_t getMissCount() const;
+
+  /** @brief The number of meshes waiting for their levels of detail to be generated */
+  std::size_t getPendingLodCount() const;
+
+  /** @brief Drop entries whose buffers have been released */
+  void purge();
+
+private:
+  struct Key
+  {
+    std::string url;
+    std::uint64_t content_hash{ 0 };
+
+    bool operator==(const Key& other) const { return content_hash == other.content_hash && url == other.url; }
+  };
+
+  struct KeyHash
+  {
+    std::size_t operator()(const Key& key) const;
+  };
+
+  mutable std::mutex mutex_;
+  std::unordered_map<Key, std::weak_ptr<const MeshBuffers>, KeyHash> entries_;
+  std::unordered_map<Key, std::weak_ptr<MeshLod>, KeyHash> lods_;
+  std::atomic<std::size_t> hits_{ 0 };
+  std::atomic<std::size_t> misses_{ 0 };
+
+  /** @brief Expired entries are purged when the map grows past this size */
+  std::size_t next_purge_size_{ 64 };
+
+  /** @brief Levels of detail waiting to be generated, processed in order by lod_thread_ */
+  std::deque<std::weak_ptr<MeshLod>> lod_queue_;
+  std::condition_variable lod_condition_;
+  std::thread lod_thread_;
+  bool stopping_{ false };
+
+  /** @brief Compute the key of mesh geometries, false for all other types */
+  static bool getKey(const tesseract_geometry::Geometry& geometry, Key& key);
+
+  void purgeLocked();
+  void generateLods();
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_RENDER_MESH_CACHE_H
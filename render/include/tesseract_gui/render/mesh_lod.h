@@ -0,0 +1,103 @@
+/**
+ * @file mesh_lod.h
+ * @brief Decimated levels of detail of a mesh
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_RENDER_MESH_LOD_H
+#define TESSERACT_GUI_RENDER_MESH_LOD_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <array>
+#include <atomic>
+#include <memory>
+#include <Eigen/Core>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/render/mesh_buffers.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief Decimate a mesh by clustering its vertices on a uniform grid
+ *
+ * Vertices falling into the same cell are merged at their mean position with their averaged normal, triangles which
+ * collapse or become duplicates are dropped. The grid resolution is refined until the result is close to the target.
+ * Clustering does not preserve topology, which is fine for meshes only looked at from a distance.
+ *
+ * @param mesh The mesh to decimate
+ * @param target_triangle_count The approximate number of triangles of the result
+ * @return The decimated mesh, a copy of the input if it already has fewer triangles
+ */
+MeshBuffers::Ptr decimateMesh(const MeshBuffers& mesh, std::size_t target_triangle_count);
+
+/**
+ * @brief A mesh with up to MAX_LEVEL_COUNT - 1 decimated versions of it
+ *
+ * Level zero is the full detail mesh and always available, coarser levels are added by generateLevels(), which is
+ * typically called once on a background thread (see MeshCache::getLod()). Levels are published atomically, readers
+ * never block and see either the previous or the new level count.
+ */
+class MeshLod
+{
+public:
+  using Ptr = std::shared_ptr<MeshLod>;
+  using ConstPtr = std::shared_ptr<const MeshLod>;
+
+  /** @brief The maximum number of levels including the full detail mesh */
+  static constexpr std::size_t MAX_LEVEL_COUNT = 4;
+
+  /** @brief Meshes with fewer triangles are not decimated */
+  static constexpr std::size_t MIN_DECIMATION_TRIANGLE_COUNT = 10000;
+
+  /** @brief Levels are not decimated below this number of triangles */
+  static constexpr std::size_t MIN_LEVEL_TRIANGLE_COUNT = 500;
+
+  explicit MeshLod(MeshBuffers::ConstPtr mesh);
+
+  /** @brief The number of levels currently available */
+  std::size_t getLevelCount() const;
+
+  /** @brief Get a level, zero is the full detail mesh, must be less than getLevelCount() */
+  const MeshBuffers::ConstPtr& getLevel(std::size_t level) const;
+
+  /**
+   * @brief Select the coarsest available level with enough triangles for the size of the mesh on screen
+   * @param screen_diameter The projected diameter of the bounding sphere in pixels
+   * @param pixels_per_triangle The desired triangle edge length in pixels
+   */
+  std::size_t selectLevel(float screen_diameter, float pixels_per_triangle) const;
+
+  /** @brief The bounding sphere of the mesh */
+  const Eigen::Vector3f& getCenter() const;
+  float getRadius() const;
+
+  /** @brief Generate the decimated levels, must be called at most once */
+  void generateLevels();
+
+  /** @brief Check if generateLevels() finished */
+  bool isComplete() const;
+
+private:
+  std::array<MeshBuffers::ConstPtr, MAX_LEVEL_COUNT> levels_;
+  std::atomic<std::size_t> level_count_{ 1 };
+  std::atomic<bool> complete_{ false };
+  Eigen::Vector3f center_{ Eigen::Vector3f::Zero() };
+  float radius_{ 0 };
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_RENDER_MESH_LOD_H
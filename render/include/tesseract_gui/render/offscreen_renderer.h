@@ -0,0 +1,93 @@
+/**
+ * @file offscreen_renderer.h
+ * @brief Renders scenes into images without a window
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_RENDER_OFFSCREEN_RENDERER_H
+#define TESSERACT_GUI_RENDER_OFFSCREEN_RENDERER_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <memory>
+#include <vector>
+#include <QImage>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_common/types.h>
+#include <tesseract_environment/environment.h>
+#include <tesseract_gui/render/camera.h>
+#include <tesseract_gui/render/render_scene.h>
+#include <tesseract_gui/render/scene_renderer.h>
+
+class QOffscreenSurface;
+class QOpenGLContext;
+class QOpenGLFramebufferObject;
+
+namespace tesseract_gui
+{
+/**
+ * @brief Draws scenes with a SceneRenderer into a framebuffer object of an offscreen surface and reads them back
+ *
+ * No window or display is needed when the application runs with the offscreen platform plugin
+ * (QT_QPA_PLATFORM=offscreen). Without a GPU, Mesa renders on the CPU when LIBGL_ALWAYS_SOFTWARE=1 is set (llvmpipe);
+ * if the offscreen plugin of the Qt build provides no OpenGL, run under a virtual X server (e.g. xvfb-run) instead.
+ *
+ * The framebuffer has no multisampling and dithering is disabled, so the same scene, camera and size render the same
+ * pixels with the same driver, which is what pixel-diff tests need. Different drivers may still differ slightly.
+ *
+ * The renderer must be created, used and destroyed on the GUI thread of a QGuiApplication.
+ */
+class OffscreenRenderer
+{
+public:
+  /** @brief Create the context and framebuffer, throws if no OpenGL 3.3 core context is available */
+  OffscreenRenderer(int width, int height);
+  ~OffscreenRenderer();
+  OffscreenRenderer(const OffscreenRenderer&) = delete;
+  OffscreenRenderer& operator=(const OffscreenRenderer&) = delete;
+  OffscreenRenderer(OffscreenRenderer&&) = delete;
+  OffscreenRenderer& operator=(OffscreenRenderer&&) = delete;
+
+  /** @brief Resize the framebuffer */
+  void setSize(int width, int height);
+  int getWidth() const;
+  int getHeight() const;
+
+  /** @brief The renderer, e.g. to set the background color or add overlays */
+  SceneRenderer& getRenderer();
+
+  QImage render(const RenderScene& scene, const Camera& camera);
+
+  /** @brief Render a scene from several cameras, the scene is uploaded once */
+  std::vector<QImage> render(const RenderScene& scene, const tesseract_common::AlignedVector<Camera>& cameras);
+
+  /** @brief Render the visual geometry of an environment in its current state, the scene is rebuilt every call */
+  QImage render(const tesseract_environment::Environment& environment, const Camera& camera);
+
+private:
+  std::unique_ptr<QOffscreenSurface> surface_;
+  std::unique_ptr<QOpenGLContext> context_;
+  std::unique_ptr<QOpenGLFramebufferObject> framebuffer_;
+  SceneRenderer renderer_;
+  RenderScene environment_scene_;
+  int width_{ 0 };
+  int height_{ 0 };
+
+  void makeCurrent();
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_RENDER_OFFSCREEN_RENDERER_H
@@ -0,0 +1,68 @@
+/**
+ * @file render_overlay.h
+ * @brief Interface for additional geometry drawn on top of a render scene
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_RENDER_RENDER_OVERLAY_H
+#define TESSERACT_GUI_RENDER_RENDER_OVERLAY_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <memory>
+#include <Eigen/Core>
+#include <QOpenGLExtraFunctions>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/render/camera.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief Geometry drawn by a SceneRenderer after the objects of the scene, e.g. contact points or reachability voxels
+ *
+ * Overlays own their GPU resources and draw them with the functions of the renderer they were added to, all methods
+ * are called with the context of that renderer current. An overlay must only be added to one renderer.
+ */
+class RenderOverlay
+{
+public:
+  using Ptr = std::shared_ptr<RenderOverlay>;
+  using ConstPtr = std::shared_ptr<const RenderOverlay>;
+
+  RenderOverlay() = default;
+  virtual ~RenderOverlay() = default;
+  RenderOverlay(const RenderOverlay&) = delete;
+  RenderOverlay& operator=(const RenderOverlay&) = delete;
+  RenderOverlay(RenderOverlay&&) = delete;
+  RenderOverlay& operator=(RenderOverlay&&) = delete;
+
+  /** @brief Create the GPU resources, called before the first render() */
+  virtual void initialize(QOpenGLExtraFunctions& gl) = 0;
+
+  /** @brief Release all GPU resources, initialize() is called again before the overlay is drawn next */
+  virtual void cleanup(QOpenGLExtraFunctions& gl) = 0;
+
+  /**
+   * @brief Draw the overlay, depth testing is enabled and the depth buffer contains the scene objects
+   * @param gl The functions of the current context
+   * @param view_projection The view projection matrix of the frame
+   * @param camera The camera of the frame
+   */
+  virtual void render(QOpenGLExtraFunctions& gl, const Eigen::Matrix4f& view_projection, const Camera& camera) = 0;
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_RENDER_RENDER_OVERLAY_H
@@ -0,0 +1,201 @@
+/**
+ * @file render_scene.h
+ * @brief The graphics context independent description of what the renderer draws
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_RENDER_RENDER_SCENE_H
+#define TESSERACT_GUI_RENDER_RENDER_SCENE_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <Eigen/Core>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_common/types.h>
+#include <tesseract_scene_graph/graph.h>
+#include <tesseract_gui/render/link_transform_batch.h>
+#include <tesseract_gui/render/mesh_buffers.h>
+#include <tesseract_gui/render/mesh_lod.h>
+
+namespace tesseract_gui
+{
+enum class RenderObjectType
+{
+  VISUAL = 0,
+  COLLISION = 1
+};
+
+/** @brief A mesh attached to a link */
+struct RenderObject
+{
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  RenderObjectType type{ RenderObjectType::VISUAL };
+
+  /** @brief The index of the link in RenderScene::getLinkNames() */
+  int link_index{ 0 };
+
+  /** @brief The transform from the link to the mesh */
+  Eigen::Matrix4f local_transform{ Eigen::Matrix4f::Identity() };
+
+  /** @brief RGBA color, objects with alpha less than one are drawn after all opaque objects */
+  Eigen::Vector4f color{ 0.7F, 0.7F, 0.7F, 1.0F };
+
+  /** @brief The full detail mesh */
+  MeshBuffers::ConstPtr mesh;
+
+  /** @brief Optional levels of detail of mesh, the renderer picks a level by the size of the object on screen */
+  MeshLod::ConstPtr lod;
+};
+
+/**
+ * @brief Links, the meshes attached to them and the current link world transforms
+ *
+ * The scene does not own any graphics resources so it can be built and updated without a current context. Link
+ * world transforms are stored as one packed array (see LinkTransformBatch) which the renderer uploads once per frame.
+ * Structural changes increment getRevision(), transform updates increment getTransformRevision(), which is all the
+ * renderer checks to decide what needs uploading. A scene is not thread safe, it is updated and drawn on the GUI
+ * thread.
+ */
+class RenderScene
+{
+public:
+  using Ptr = std::shared_ptr<RenderScene>;
+  using ConstPtr = std::shared_ptr<const RenderScene>;
+
+  /**
+   * @brief The number of link transforms of the scene and its ghosts every renderer can store
+   *
+   * OpenGL 3.3 guarantees textures of 1024 x 1024 texels, which hold rows of 256 links of four texels each.
+   */
+  static constexpr std::size_t MAX_LINK_TRANSFORM_COUNT = 256 * 1024;
+
+  RenderScene() = default;
+
+  /** @brief Remove all links and objects */
+  void clear();
+
+  /** @brief Replace the scene with the links, visuals and collisions of a scene graph */
+  void loadSceneGraph(const tesseract_scene_graph::SceneGraph& scene_graph);
+
+  /**
+   * @brief Add a link with an identity transform, removes all ghosts and link colors
+   * @return The index of the link, the existing index if a link with the name exists
+   */
+  int addLink(const std::string& name);
+
+  /** @brief Get the index of a link, -1 if it does not exist */
+  int getLinkIndex(const std::string& name) const;
+  const std::vector<std::string>& getLinkNames() const;
+
+  void addObject(const RenderObject& object);
+  const tesseract_common::AlignedVector<RenderObject>& getObjects() const;
+
+  /**
+   * @brief Replace all link transforms
+   * @param data Column major 4x4 matrices, LinkTransformBatch::MATRIX_SIZE floats per link in link index order
+   * @param link_count The number of links in data, must match the number of links in the scene
+   */
+  void setLinkTransforms(const float* data, std::size_t link_count);
+
+  /** @brief Update all link transforms from the scene state in one pass */
+  void updateLinkTransforms(const tesseract_scene_graph::SceneState& state);
+
+  /** @brief Update all link transforms from a single Environment::getState() call */
+  void updateLinkTransforms(const tesseract_environment::Environment& environment);
+
+  /** @brief The packed link world transforms, LinkTransformBatch::MATRIX_SIZE floats per link */
+  const std::vector<float>& getLinkTransforms() const;
+
+  /**
+   * @brief Show translucent copies of the visual objects at other link transforms, e.g. alternative robot states
+   *
+   * Ghosts draw the visual objects of their links again with the same mesh buffers, so each ghost only costs its
+   * link transforms and the objects of its links. The renderer stores the transforms of the scene and all ghosts in
+   * one texture, ghosts beyond getMaxGhostCount() do not fit and are dropped.
+   * @param data Packed link transforms like getLinkTransforms() for every ghost, one ghost after the other
+   * @param colors The color of every ghost, their size is the number of ghosts
+   * @param link_names The links drawn by the ghosts, e.g. the active links of a kinematic group so the static parts
+   * of a workcell are not drawn again, all links if empty
+   * @return The number of ghosts shown
+   */
+  std::size_t setGhosts(const float* data,
+                        const tesseract_common::AlignedVector<Eigen::Vector4f>& colors,
+                        const std::vector<std::string>& link_names = {});
+  void clearGhosts();
+
+  /** @brief The number of ghosts whose link transforms fit MAX_LINK_TRANSFORM_COUNT with those of the scene */
+  std::size_t getMaxGhostCount() const;
+
+  std::size_t getGhostCount() const;
+  const std::vector<float>& getGhostLinkTransforms() const;
+  const tesseract_common::AlignedVector<Eigen::Vector4f>& getGhostColors() const;
+
+  /** @brief Whether ghosts draw the objects of a link */
+  bool isGhostLink(int link_index) const;
+
+  /**
+   * @brief Tint the visual objects of links, e.g. to color a robot by a value per link
+   *
+   * The color of an object is blended towards the RGB of its link color by the alpha of the link color, an alpha of
+   * zero keeps the color of the object. The alpha of the objects is not changed.
+   * @param colors One color per link in link index order
+   */
+  void setLinkColors(const tesseract_common::AlignedVector<Eigen::Vector4f>& colors);
+  void clearLinkColors();
+
+  /** @brief The link colors, empty if none are set */
+  const tesseract_common::AlignedVector<Eigen::Vector4f>& getLinkColors() const;
+
+  void setVisible(RenderObjectType type, bool visible);
+  bool isVisible(RenderObjectType type) const;
+
+  /** @brief Incremented whenever links or objects are added or removed or visibility changes */
+  std::uint64_t getRevision() const;
+
+  /** @brief Incremented whenever the link transforms, ghosts or link colors change */
+  std::uint64_t getTransformRevision() const;
+
+private:
+  std::vector<std::string> link_names_;
+  std::unordered_map<std::string, int> link_index_;
+  tesseract_common::AlignedVector<RenderObject> objects_;
+  std::vector<float> link_transforms_;
+  std::vector<float> ghost_link_transforms_;
+  tesseract_common::AlignedVector<Eigen::Vector4f> ghost_colors_;
+
+  /** @brief The links drawn by ghosts by link index, all if empty */
+  std::vector<bool> ghost_link_mask_;
+  tesseract_common::AlignedVector<Eigen::Vector4f> link_colors_;
+  std::array<bool, 2> visible_{ true, false };
+  std::uint64_t revision_{ 0 };
+  std::uint64_t transform_revision_{ 0 };
+
+  /** @brief Maps scene states onto link_transforms_, rebuilt lazily after links were added */
+  LinkTransformBatch transform_batch_;
+  bool transform_batch_dirty_{ false };
+
+  void packLinkTransforms(const tesseract_common::TransformMap& link_transforms);
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_RENDER_RENDER_SCENE_H
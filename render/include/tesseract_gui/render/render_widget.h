@@ -0,0 +1,90 @@
+/**
+ * @file render_widget.h
+ * @brief A widget displaying a render scene with an orbit camera
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_RENDER_RENDER_WIDGET_H
+#define TESSERACT_GUI_RENDER_RENDER_WIDGET_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <QOpenGLWidget>
+#include <QPoint>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/render/camera.h>
+#include <tesseract_gui/render/render_scene.h>
+#include <tesseract_gui/render/scene_renderer.h>
+
+namespace tesseract_gui
+{
+class InstrumentationOverlay;
+
+/**
+ * @brief Displays a RenderScene
+ *
+ * Left drag orbits, middle drag pans and the wheel zooms. The widget does not watch the scene, call update() after
+ * changing it (e.g. once per frame after RenderScene::updateLinkTransforms()). F3 toggles an InstrumentationOverlay
+ * in the top left corner and Shift+F3 saves the recorded trace events as Chrome trace JSON.
+ */
+class RenderWidget : public QOpenGLWidget
+{
+  Q_OBJECT
+
+public:
+  explicit RenderWidget(QWidget* parent = nullptr);
+  ~RenderWidget() override;
+  RenderWidget(const RenderWidget&) = delete;
+  RenderWidget& operator=(const RenderWidget&) = delete;
+  RenderWidget(RenderWidget&&) = delete;
+  RenderWidget& operator=(RenderWidget&&) = delete;
+
+  void setScene(RenderScene::Ptr scene);
+  RenderScene::Ptr getScene() const;
+
+  Camera& getCamera();
+  const Camera& getCamera() const;
+
+  /** @brief The renderer of the widget, e.g. to add overlays */
+  SceneRenderer& getRenderer();
+
+  bool isInstrumentationOverlayVisible() const;
+
+public Q_SLOTS:
+  /** @brief Show or hide the instrumentation overlay, showing it enables instrumentation */
+  void setInstrumentationOverlayVisible(bool visible);
+
+  /** @brief Ask for a file and save the recorded trace events as Chrome trace JSON (chrome://tracing, Perfetto) */
+  void saveInstrumentationTrace();
+
+protected:
+  void initializeGL() override;
+  void paintGL() override;
+  void mousePressEvent(QMouseEvent* event) override;
+  void mouseMoveEvent(QMouseEvent* event) override;
+  void wheelEvent(QWheelEvent* event) override;
+  void keyPressEvent(QKeyEvent* event) override;
+
+private:
+  RenderScene::Ptr scene_;
+  SceneRenderer renderer_;
+  Camera camera_;
+  QPoint last_mouse_position_;
+  InstrumentationOverlay* instrumentation_overlay_;
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_RENDER_RENDER_WIDGET_H
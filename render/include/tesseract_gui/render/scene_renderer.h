@@ -0,0 +1,173 @@
+/**
+ * @file scene_renderer.h
+ * @brief Draws a render scene with OpenGL
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_RENDER_SCENE_RENDERER_H
+#define TESSERACT_GUI_RENDER_SCENE_RENDERER_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <QOpenGLExtraFunctions>
+#include <QOpenGLShaderProgram>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/render/camera.h>
+#include <tesseract_gui/render/render_overlay.h>
+#include <tesseract_gui/render/render_scene.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief Draws a RenderScene into the currently bound framebuffer of a current OpenGL 3.3 core context
+ *
+ * Mesh buffers are uploaded once per MeshBuffers instance, so objects sharing buffers share the GPU copy. The link
+ * world transforms of the scene are uploaded as a single float texture per frame (four RGBA texels per link, wrapped
+ * into rows within GL_MAX_TEXTURE_SIZE) which the vertex shader indexes with the link index of the object, so
+ * changing joint values costs one texture upload regardless of the number of links. Ghosts which do not fit the
+ * texture are not drawn and counted as "dropped ghosts" in the render instrumentation.
+ *
+ * Objects with levels of detail are drawn with the coarsest level that still has about one triangle per
+ * getLodPixelsPerTriangle() pixels along the projected diameter of their bounding sphere, the full detail mesh is used
+ * when the camera is close or inside the bounding sphere.
+ *
+ * Overlays are drawn after the scene objects in the order they were added.
+ *
+ * All methods except the constructor, addOverlay() and getOverlays() must be called with the same context current.
+ */
+class SceneRenderer : protected QOpenGLExtraFunctions
+{
+public:
+  SceneRenderer() = default;
+  ~SceneRenderer();
+  SceneRenderer(const SceneRenderer&) = delete;
+  SceneRenderer& operator=(const SceneRenderer&) = delete;
+  SceneRenderer(SceneRenderer&&) = delete;
+  SceneRenderer& operator=(SceneRenderer&&) = delete;
+
+  /** @brief Create the shaders and textures */
+  void initialize();
+
+  /** @brief Release all GPU resources, including those of the overlays */
+  void cleanup();
+
+  bool isInitialized() const;
+
+  void setBackgroundColor(const Eigen::Vector4f& color);
+
+  /** @brief Enable level of detail selection, when disabled the full detail meshes are always drawn */
+  void setLodEnabled(bool enabled);
+  bool isLodEnabled() const;
+
+  /** @brief The desired triangle edge length on screen in pixels, larger values select coarser levels */
+  void setLodPixelsPerTriangle(float pixels);
+  float getLodPixelsPerTriangle() const;
+
+  /** @brief Add an overlay, it is initialized with the context current the next time it is drawn */
+  void addOverlay(RenderOverlay::Ptr overlay);
+
+  /** @brief Remove an overlay and release its GPU resources */
+  void removeOverlay(const RenderOverlay::Ptr& overlay);
+
+  std::vector<RenderOverlay::Ptr> getOverlays() const;
+
+  /**
+   * @brief Draw the scene
+   * @param scene The scene to draw
+   * @param camera The camera to draw it from
+   * @param width The viewport width in pixels
+   * @param height The viewport height in pixels
+   */
+  void render(const RenderScene& scene, const Camera& camera, int width, int height);
+
+  /** @brief The number of meshes currently resident on the GPU */
+  std::size_t getMeshCount() const;
+
+private:
+  struct GpuMesh
+  {
+    GLuint vao{ 0 };
+    GLuint vbo{ 0 };
+    GLuint ibo{ 0 };
+    GLsizei index_count{ 0 };
+
+    /** @brief Keeps the key of meshes_ alive while the GPU copy exists */
+    MeshBuffers::ConstPtr source;
+  };
+
+  bool initialized_{ false };
+  std::unique_ptr<QOpenGLShaderProgram> program_;
+  int view_projection_location_{ -1 };
+  int local_transform_location_{ -1 };
+  int link_index_location_{ -1 };
+  int link_transforms_location_{ -1 };
+  int links_per_row_location_{ -1 };
+  int color_location_{ -1 };
+  int light_direction_location_{ -1 };
+
+  std::unordered_map<const MeshBuffers*, GpuMesh> meshes_;
+
+  struct Overlay
+  {
+    RenderOverlay::Ptr overlay;
+    bool initialized{ false };
+  };
+  std::vector<Overlay> overlays_;
+
+  GLuint link_texture_{ 0 };
+  GLint max_texture_size_{ 0 };
+
+  /** @brief The number of links per texture row and the number of rows */
+  std::size_t link_texture_width_{ 0 };
+  std::size_t link_texture_rows_{ 0 };
+
+  /** @brief The ghosts of the uploaded scene which fit the texture */
+  std::size_t drawn_ghost_count_{ 0 };
+
+  const RenderScene* uploaded_scene_{ nullptr };
+  std::uint64_t uploaded_revision_{ 0 };
+  std::uint64_t uploaded_transform_revision_{ 0 };
+
+  Eigen::Vector4f background_color_{ 0.2F, 0.2F, 0.25F, 1.0F };
+
+  bool lod_enabled_{ true };
+  float lod_pixels_per_triangle_{ 2.0F };
+
+  /** @brief The camera state of the current frame used for level of detail selection */
+  Eigen::Vector3f eye_{ Eigen::Vector3f::Zero() };
+  float pixels_per_unit_at_unit_distance_{ 1.0F };
+
+  const GpuMesh& getGpuMesh(const MeshBuffers::ConstPtr& mesh);
+  void releaseMesh(GpuMesh& mesh);
+  void releaseUnusedMeshes(const RenderScene& scene);
+  void uploadLinkTransforms(const RenderScene& scene);
+
+  /** @brief Upload the packed transforms of count links starting at link index first, the texture must be bound */
+  void uploadLinkRange(std::size_t first, std::size_t count, const float* data);
+  void drawObjects(const RenderScene& scene, bool transparent);
+  void drawGhosts(const RenderScene& scene);
+  void drawOverlays(const Eigen::Matrix4f& view_projection, const Camera& camera);
+
+  /** @brief Select the mesh of an object to draw, the level of detail matching its size on screen if it has any */
+  const MeshBuffers::ConstPtr& selectMesh(const RenderScene& scene, const RenderObject& object) const;
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_RENDER_SCENE_RENDERER_H
@@ -0,0 +1,79 @@
+/**
+ * @file scene_state_updater.h
+ * @brief Applies joint values to the link transforms of a render scene
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_RENDER_SCENE_STATE_UPDATER_H
+#define TESSERACT_GUI_RENDER_SCENE_STATE_UPDATER_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <QObject>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_environment/environment.h>
+#include <tesseract_gui/render/render_scene.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief Moves the links of a RenderScene to joint values, e.g. those of JointStateIngest::jointValuesChanged()
+ *
+ * A clone of the state solver of an environment keeps the last value of every joint, so updates may contain only
+ * the joints which changed. Every update computes the link transforms once and replaces all transforms of the scene
+ * in one pass. Joints unknown to the environment are ignored.
+ */
+class SceneStateUpdater : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit SceneStateUpdater(QObject* parent = nullptr);
+
+  /** @brief The scene whose link transforms are set, loaded from the scene graph of the environment */
+  void setScene(RenderScene::Ptr scene);
+  RenderScene::Ptr getScene() const;
+
+  /**
+   * @brief Clone the state solver and the current joint values of an environment and apply them to the scene
+   * @throws std::runtime_error if the environment has no state solver
+   */
+  void setEnvironment(const tesseract_environment::Environment& environment);
+
+public Q_SLOTS:
+  /** @brief Update the joint values and the link transforms of the scene */
+  void setJointValues(const std::unordered_map<std::string, double>& joint_values);
+
+Q_SIGNALS:
+  /** @brief The link transforms changed, the scene needs to be redrawn */
+  void sceneChanged();
+
+private:
+  RenderScene::Ptr scene_;
+  tesseract_scene_graph::StateSolver::UPtr solver_;
+  std::unordered_set<std::string> joint_names_;
+
+  /** @brief The known joints of an update, reused between updates */
+  std::unordered_map<std::string, double> known_values_;
+
+  void updateScene();
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_RENDER_SCENE_STATE_UPDATER_H
@@ -0,0 +1,110 @@
+/**
+ * @file camera.cpp
+ * @brief An orbit camera for the render scene
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <cmath>
+#include <Eigen/Geometry>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/render/camera.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+/** @brief Keep the pitch away from the poles where the view direction is parallel to up */
+constexpr float MAX_PITCH = 1.55F;
+}  // namespace
+
+void Camera::lookAt(const Eigen::Vector3f& eye, const Eigen::Vector3f& target)
+{
+  target_ = target;
+  const Eigen::Vector3f offset = eye - target;
+  distance_ = std::max(offset.norm(), 1e-4F);
+  yaw_ = std::atan2(offset.y(), offset.x());
+  pitch_ = std::clamp(std::asin(offset.z() / distance_), -MAX_PITCH, MAX_PITCH);
+}
+
+void Camera::orbit(float delta_yaw, float delta_pitch)
+{
+  yaw_ += delta_yaw;
+  pitch_ = std::clamp(pitch_ + delta_pitch, -MAX_PITCH, MAX_PITCH);
+}
+
+void Camera::pan(float delta_x, float delta_y)
+{
+  const Eigen::Matrix4f view = getViewMatrix();
+  const Eigen::Vector3f right = view.block<1, 3>(0, 0).transpose();
+  const Eigen::Vector3f up = view.block<1, 3>(1, 0).transpose();
+  target_ += distance_ * ((delta_x * right) + (delta_y * up));
+}
+
+void Camera::zoom(float factor) { distance_ = std::max(distance_ * factor, 1e-4F); }
+
+Eigen::Vector3f Camera::getEye() const
+{
+  const Eigen::Vector3f direction(
+      std::cos(pitch_) * std::cos(yaw_), std::cos(pitch_) * std::sin(yaw_), std::sin(pitch_));
+  return target_ + (distance_ * direction);
+}
+
+const Eigen::Vector3f& Camera::getTarget() const { return target_; }
+
+float Camera::getDistance() const { return distance_; }
+
+void Camera::setFieldOfView(float fov_y) { fov_y_ = fov_y; }
+
+float Camera::getFieldOfView() const { return fov_y_; }
+
+void Camera::setClipPlanes(float near_plane, float far_plane)
+{
+  near_ = near_plane;
+  far_ = far_plane;
+}
+
+Eigen::Matrix4f Camera::getViewMatrix() const
+{
+  const Eigen::Vector3f eye = getEye();
+  const Eigen::Vector3f forward = (target_ - eye).normalized();
+  const Eigen::Vector3f right = forward.cross(Eigen::Vector3f::UnitZ()).normalized();
+  const Eigen::Vector3f up = right.cross(forward);
+
+  Eigen::Matrix4f view = Eigen::Matrix4f::Identity();
+  view.block<1, 3>(0, 0) = right.transpose();
+  view.block<1, 3>(1, 0) = up.transpose();
+  view.block<1, 3>(2, 0) = -forward.transpose();
+  view(0, 3) = -right.dot(eye);
+  view(1, 3) = -up.dot(eye);
+  view(2, 3) = forward.dot(eye);
+  return view;
+}
+
+Eigen::Matrix4f Camera::getProjectionMatrix(float aspect_ratio) const
+{
+  const float f = 1.0F / std::tan(fov_y_ / 2.0F);
+  Eigen::Matrix4f projection = Eigen::Matrix4f::Zero();
+  projection(0, 0) = f / aspect_ratio;
+  projection(1, 1) = f;
+  projection(2, 2) = (far_ + near_) / (near_ - far_);
+  projection(2, 3) = (2.0F * far_ * near_) / (near_ - far_);
+  projection(3, 2) = -1.0F;
+  return projection;
+}
+
+}  // namespace tesseract_gui
@@ -0,0 +1,299 @@
+/**
+ * @file geometry_conversion.cpp
+ * @brief Tessellation of tesseract geometries into mesh buffers
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cmath>
+#include <Eigen/Geometry>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_geometry/geometries.h>
+#include <tesseract_gui/render/geometry_conversion.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+constexpr float PI = 3.14159265358979323846F;
+
+MeshBuffers::Ptr createBox(float x, float y, float z)
+{
+  auto mesh = std::make_shared<MeshBuffers>();
+  const Eigen::Vector3f half(x / 2.0F, y / 2.0F, z / 2.0F);
+
+  // One quad per face so every face gets its own normal
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    for (float sign : { -1.0F, 1.0F })
+    {
+      Eigen::Vector3f normal = Eigen::Vector3f::Zero();
+      normal[axis] = sign;
+      const int u = (axis + 1) % 3;
+      const int v = (axis + 2) % 3;
+
+      const auto first = static_cast<std::uint32_t>(mesh->getVertexCount());
+      for (const auto& corner : { Eigen::Vector2f(-1, -1), Eigen::Vector2f(1, -1), Eigen::Vector2f(1, 1), Eigen::Vector2f(-1, 1) })
+      {
+        Eigen::Vector3f p;
+        p[axis] = sign * half[axis];
+        p[u] = corner.x() * half[u];
+        p[v] = corner.y() * half[v];
+        mesh->addVertex(p, normal);
+      }
+
+      // Keep counter clockwise winding when looking at the face from outside
+      if (sign > 0)
+      {
+        mesh->addTriangle(first, first + 1, first + 2);
+        mesh->addTriangle(first, first + 2, first + 3);
+      }
+      else
+      {
+        mesh->addTriangle(first, first + 2, first + 1);
+        mesh->addTriangle(first, first + 3, first + 2);
+      }
+    }
+  }
+  return mesh;
+}
+
+/**
+ * @brief Append latitude/longitude rings of a sphere split at the equator by length
+ *
+ * With length zero this is a sphere, otherwise a capsule along z.
+ */
+void appendRoundedShape(MeshBuffers& mesh, float radius, float length, int segments)
+{
+  const int rings = segments / 2;
+  const int half_rings = rings / 2;
+  const float half_length = length / 2.0F;
+  const auto first = static_cast<std::uint32_t>(mesh.getVertexCount());
+
+  std::uint32_t ring_count = 0;
+  auto add_ring = [&](int i, float z_offset) {
+    const float theta = PI * static_cast<float>(i) / static_cast<float>(rings);
+    for (int j = 0; j <= segments; ++j)
+    {
+      const float phi = 2.0F * PI * static_cast<float>(j) / static_cast<float>(segments);
+      const Eigen::Vector3f n(std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta));
+      mesh.addVertex((radius * n) + Eigen::Vector3f(0, 0, z_offset), n);
+    }
+    ++ring_count;
+  };
+
+  for (int i = 0; i <= half_rings; ++i)
+    add_ring(i, half_length);
+
+  // The equator is repeated at the lower offset which forms the cylindrical section of a capsule
+  for (int i = (length > 0) ? half_rings : half_rings + 1; i <= rings; ++i)
+    add_ring(i, -half_length);
+
+  const auto stride = static_cast<std::uint32_t>(segments + 1);
+  for (std::uint32_t r = 0; r + 1 < ring_count; ++r)
+  {
+    for (std::uint32_t s = 0; s < static_cast<std::uint32_t>(segments); ++s)
+    {
+      const std::uint32_t a = first + (r * stride) + s;
+      const std::uint32_t b = a + stride;
+      mesh.addTriangle(a, b, a + 1);
+      mesh.addTriangle(a + 1, b, b + 1);
+    }
+  }
+}
+
+/** @brief Append a disk at height z facing up (+z) or down (-z) */
+void appendDisk(MeshBuffers& mesh, float radius, float z, bool up, int segments)
+{
+  const Eigen::Vector3f normal(0, 0, up ? 1.0F : -1.0F);
+  const auto center = static_cast<std::uint32_t>(mesh.getVertexCount());
+  mesh.addVertex(Eigen::Vector3f(0, 0, z), normal);
+  for (int j = 0; j <= segments; ++j)
+  {
+    const float phi = 2.0F * PI * static_cast<float>(j) / static_cast<float>(segments);
+    mesh.addVertex(Eigen::Vector3f(radius * std::cos(phi), radius * std::sin(phi), z), normal);
+  }
+
+  for (std::uint32_t s = 1; s <= static_cast<std::uint32_t>(segments); ++s)
+  {
+    if (up)
+      mesh.addTriangle(center, center + s, center + s + 1);
+    else
+      mesh.addTriangle(center, center + s + 1, center + s);
+  }
+}
+
+MeshBuffers::Ptr createCylinder(float radius, float length, int segments)
+{
+  auto mesh = std::make_shared<MeshBuffers>();
+  const float half_length = length / 2.0F;
+  for (int j = 0; j <= segments; ++j)
+  {
+    const float phi = 2.0F * PI * static_cast<float>(j) / static_cast<float>(segments);
+    const Eigen::Vector3f n(std::cos(phi), std::sin(phi), 0);
+    mesh->addVertex(Eigen::Vector3f(radius * n.x(), radius * n.y(), -half_length), n);
+    mesh->addVertex(Eigen::Vector3f(radius * n.x(), radius * n.y(), half_length), n);
+  }
+
+  for (std::uint32_t s = 0; s < static_cast<std::uint32_t>(segments); ++s)
+  {
+    const std::uint32_t a = 2 * s;
+    mesh->addTriangle(a, a + 2, a + 1);
+    mesh->addTriangle(a + 1, a + 2, a + 3);
+  }
+
+  appendDisk(*mesh, radius, half_length, true, segments);
+  appendDisk(*mesh, radius, -half_length, false, segments);
+  return mesh;
+}
+
+MeshBuffers::Ptr createCone(float radius, float length, int segments)
+{
+  auto mesh = std::make_shared<MeshBuffers>();
+  const float half_length = length / 2.0F;
+  const float slant = std::sqrt((length * length) + (radius * radius));
+  for (int j = 0; j <= segments; ++j)
+  {
+    const float phi = 2.0F * PI * static_cast<float>(j) / static_cast<float>(segments);
+    const Eigen::Vector3f n(std::cos(phi) * length / slant, std::sin(phi) * length / slant, radius / slant);
+    mesh->addVertex(Eigen::Vector3f(radius * std::cos(phi), radius * std::sin(phi), -half_length), n);
+    mesh->addVertex(Eigen::Vector3f(0, 0, half_length), n);
+  }
+
+  for (std::uint32_t s = 0; s < static_cast<std::uint32_t>(segments); ++s)
+    mesh->addTriangle(2 * s, (2 * s) + 2, (2 * s) + 1);
+
+  appendDisk(*mesh, radius, -half_length, false, segments);
+  return mesh;
+}
+
+MeshBuffers::Ptr createPolygonMesh(const tesseract_common::VectorVector3d& vertices,
+                                   const Eigen::VectorXi& faces,
+                                   const Eigen::Vector3d& scale,
+                                   const tesseract_common::VectorVector3d* normals)
+{
+  auto mesh = std::make_shared<MeshBuffers>();
+  mesh->vertices.reserve(vertices.size() * MeshBuffers::VERTEX_STRIDE);
+
+  // Faces are stored as the number of vertices followed by the vertex indices, polygons are triangulated as fans
+  mesh->indices.reserve(static_cast<std::size_t>(faces.size()));
+  for (Eigen::Index i = 0; i < faces.size(); i += faces[i] + 1)
+  {
+    const int n = faces[i];
+    for (int k = 1; k + 1 < n; ++k)
+      mesh->addTriangle(static_cast<std::uint32_t>(faces[i + 1]),
+                        static_cast<std::uint32_t>(faces[i + 1 + k]),
+                        static_cast<std::uint32_t>(faces[i + 2 + k]));
+  }
+
+  const Eigen::Vector3f s = scale.cast<float>();
+  std::vector<Eigen::Vector3f> positions;
+  positions.reserve(vertices.size());
+  for (const auto& v : vertices)
+    positions.emplace_back(v.cast<float>().cwiseProduct(s));
+
+  std::vector<Eigen::Vector3f> vertex_normals(vertices.size(), Eigen::Vector3f::Zero());
+  if (normals != nullptr && normals->size() == vertices.size())
+  {
+    // Normals transform with the inverse scale
+    for (std::size_t i = 0; i < normals->size(); ++i)
+      vertex_normals[i] = (*normals)[i].cast<float>().cwiseQuotient(s).normalized();
+  }
+  else
+  {
+    // Area weighted average of the adjacent face normals
+    for (std::size_t t = 0; t < mesh->indices.size(); t += 3)
+    {
+      const std::uint32_t a = mesh->indices[t];
+      const std::uint32_t b = mesh->indices[t + 1];
+      const std::uint32_t c = mesh->indices[t + 2];
+      const Eigen::Vector3f n = (positions[b] - positions[a]).cross(positions[c] - positions[a]);
+      vertex_normals[a] += n;
+      vertex_normals[b] += n;
+      vertex_normals[c] += n;
+    }
+
+    for (auto& n : vertex_normals)
+      n.normalize();
+  }
+
+  for (std::size_t i = 0; i < positions.size(); ++i)
+    mesh->addVertex(positions[i], vertex_normals[i]);
+
+  return mesh;
+}
+
+template <typename T>
+MeshBuffers::Ptr createPolygonMesh(const T& geometry, const tesseract_common::VectorVector3d* normals = nullptr)
+{
+  return createPolygonMesh(*geometry.getVertices(), *geometry.getFaces(), geometry.getScale(), normals);
+}
+}  // namespace
+
+MeshBuffers::Ptr createMeshBuffers(const tesseract_geometry::Geometry& geometry)
+{
+  switch (geometry.getType())
+  {
+    case tesseract_geometry::GeometryType::BOX:
+    {
+      const auto& box = static_cast<const tesseract_geometry::Box&>(geometry);
+      return createBox(static_cast<float>(box.getX()), static_cast<float>(box.getY()), static_cast<float>(box.getZ()));
+    }
+    case tesseract_geometry::GeometryType::SPHERE:
+    {
+      const auto& sphere = static_cast<const tesseract_geometry::Sphere&>(geometry);
+      auto mesh = std::make_shared<MeshBuffers>();
+      appendRoundedShape(*mesh, static_cast<float>(sphere.getRadius()), 0, DEFAULT_TESSELLATION_SEGMENTS);
+      return mesh;
+    }
+    case tesseract_geometry::GeometryType::CAPSULE:
+    {
+      const auto& capsule = static_cast<const tesseract_geometry::Capsule&>(geometry);
+      auto mesh = std::make_shared<MeshBuffers>();
+      appendRoundedShape(*mesh,
+                         static_cast<float>(capsule.getRadius()),
+                         static_cast<float>(capsule.getLength()),
+                         DEFAULT_TESSELLATION_SEGMENTS);
+      return mesh;
+    }
+    case tesseract_geometry::GeometryType::CYLINDER:
+    {
+      const auto& cylinder = static_cast<const tesseract_geometry::Cylinder&>(geometry);
+      return createCylinder(static_cast<float>(cylinder.getRadius()),
+                            static_cast<float>(cylinder.getLength()),
+                            DEFAULT_TESSELLATION_SEGMENTS);
+    }
+    case tesseract_geometry::GeometryType::CONE:
+    {
+      const auto& cone = static_cast<const tesseract_geometry::Cone&>(geometry);
+      return createCone(
+          static_cast<float>(cone.getRadius()), static_cast<float>(cone.getLength()), DEFAULT_TESSELLATION_SEGMENTS);
+    }
+    case tesseract_geometry::GeometryType::MESH:
+    {
+      const auto& mesh = static_cast<const tesseract_geometry::Mesh&>(geometry);
+      return createPolygonMesh(mesh, mesh.getNormals().get());
+    }
+    case tesseract_geometry::GeometryType::CONVEX_MESH:
+      return createPolygonMesh(static_cast<const tesseract_geometry::ConvexMesh&>(geometry));
+    case tesseract_geometry::GeometryType::SDF_MESH:
+      return createPolygonMesh(static_cast<const tesseract_geometry::SDFMesh&>(geometry));
+    default:
+      return nullptr;
+  }
+}
+
+}  // namespace tesseract_gui
@@ -0,0 +1,130 @@
+/**
+ * @file instrumentation_overlay.cpp
+ * @brief Shows the instrumentation timers and counters on top of a widget
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <QFontDatabase>
+#include <QFontMetrics>
+#include <QPainter>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/common/instrumentation.h>
+#include <tesseract_gui/render/instrumentation_overlay.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+constexpr int MARGIN = 6;
+}  // namespace
+
+InstrumentationOverlay::InstrumentationOverlay(QWidget* parent) : QWidget(parent)
+{
+  setAttribute(Qt::WA_TransparentForMouseEvents);
+  setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+
+  refresh_timer_.setInterval(500);
+  connect(&refresh_timer_, &QTimer::timeout, this, &InstrumentationOverlay::refresh);
+}
+
+void InstrumentationOverlay::setRefreshInterval(int msec) { refresh_timer_.setInterval(msec); }
+
+int InstrumentationOverlay::getRefreshInterval() const { return refresh_timer_.interval(); }
+
+void InstrumentationOverlay::refresh()
+{
+  const Instrumentation& instrumentation = Instrumentation::instance();
+
+  lines_.clear();
+  lines_.append(QString("%1 %2 %3 %4 %5")
+                    .arg("timer", -32)
+                    .arg("last ms", 9)
+                    .arg("mean ms", 9)
+                    .arg("max ms", 9)
+                    .arg("count", 9));
+
+  for (const auto& timer : instrumentation.getTimerStatistics())
+  {
+    const auto key = std::make_pair(timer.category, timer.name);
+    const std::pair<std::uint64_t, double>& previous = previous_[key];
+    const std::uint64_t count = timer.count - std::min(previous.first, timer.count);
+    const double mean = (count > 0) ? (timer.total - previous.second) / static_cast<double>(count) : 0.0;
+    previous_[key] = std::make_pair(timer.count, timer.total);
+
+    lines_.append(QString("%1 %2 %3 %4 %5")
+                      .arg(QString::fromStdString(timer.category + "/" + timer.name), -32)
+                      .arg(timer.last, 9, 'f', 2)
+                      .arg(mean, 9, 'f', 2)
+                      .arg(timer.max, 9, 'f', 2)
+                      .arg(timer.count, 9));
+  }
+
+  const std::vector<Instrumentation::CounterStatistics> counters = instrumentation.getCounterStatistics();
+  if (!counters.empty())
+  {
+    lines_.append(QString());
+    lines_.append(QString("%1 %2 %3").arg("counter", -32).arg("last", 9).arg("max", 9));
+    for (const auto& counter : counters)
+    {
+      lines_.append(QString("%1 %2 %3")
+                        .arg(QString::fromStdString(counter.category + "/" + counter.name), -32)
+                        .arg(counter.last, 9)
+                        .arg(counter.max, 9));
+    }
+  }
+
+  const QFontMetrics metrics(font());
+  int width{ 0 };
+  for (const QString& line : lines_)
+    width = std::max(width, metrics.horizontalAdvance(line));
+
+  resize(width + (2 * MARGIN), (lines_.size() * metrics.height()) + (2 * MARGIN));
+  update();
+}
+
+void InstrumentationOverlay::showEvent(QShowEvent* event)
+{
+  QWidget::showEvent(event);
+  Instrumentation::instance().setEnabled(true);
+  raise();
+  refresh();
+  refresh_timer_.start();
+}
+
+void InstrumentationOverlay::hideEvent(QHideEvent* event)
+{
+  QWidget::hideEvent(event);
+  refresh_timer_.stop();
+}
+
+void InstrumentationOverlay::paintEvent(QPaintEvent* /*event*/)
+{
+  QPainter painter(this);
+  painter.fillRect(rect(), QColor(0, 0, 0, 160));
+  painter.setPen(Qt::white);
+
+  const QFontMetrics metrics(font());
+  int y = MARGIN + metrics.ascent();
+  for (const QString& line : lines_)
+  {
+    painter.drawText(MARGIN, y, line);
+    y += metrics.height();
+  }
+}
+
+}  // namespace tesseract_gui
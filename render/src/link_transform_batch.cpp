@@ -0,0 +1,72 @@
+/**
+ * @file link_transform_batch.cpp
+ * @brief Packs link world transforms into a contiguous float array
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_gui/render/link_transform_batch.h>
+#include <tesseract_environment/environment.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+void setIdentity(std::vector<float>& transforms)
+{
+  const std::size_t count = transforms.size() / LinkTransformBatch::MATRIX_SIZE;
+  for (std::size_t i = 0; i < count; ++i)
+    Eigen::Map<Eigen::Matrix4f>(transforms.data() + (i * LinkTransformBatch::MATRIX_SIZE)).setIdentity();
+}
+}  // namespace
+
+LinkTransformBatch::LinkTransformBatch(std::vector<std::string> link_names) { setLinkNames(std::move(link_names)); }
+
+void LinkTransformBatch::setLinkNames(std::vector<std::string> link_names)
+{
+  link_names_ = std::move(link_names);
+  transforms_.resize(link_names_.size() * MATRIX_SIZE);
+  setIdentity(transforms_);
+}
+
+const std::vector<std::string>& LinkTransformBatch::getLinkNames() const { return link_names_; }
+
+void LinkTransformBatch::update(const tesseract_environment::Environment& environment)
+{
+  update(environment.getState());
+}
+
+void LinkTransformBatch::update(const tesseract_scene_graph::SceneState& state) { update(state.link_transforms); }
+
+void LinkTransformBatch::update(const tesseract_common::TransformMap& link_transforms)
+{
+  pack(link_transforms, transforms_.data());
+}
+
+void LinkTransformBatch::pack(const tesseract_common::TransformMap& link_transforms, float* data) const
+{
+  for (std::size_t i = 0; i < link_names_.size(); ++i)
+  {
+    auto it = link_transforms.find(link_names_[i]);
+    if (it != link_transforms.end())
+      Eigen::Map<Eigen::Matrix4f>(data + (i * MATRIX_SIZE)) = it->second.matrix().cast<float>();
+  }
+}
+
+const std::vector<float>& LinkTransformBatch::getTransforms() const { return transforms_; }
+
+const float* LinkTransformBatch::data() const { return transforms_.data(); }
+
+std::size_t LinkTransformBatch::size() const { return link_names_.size(); }
+
+}  // namespace tesseract_gui
@@ -0,0 +1,294 @@
+/**
+ * @file mesh_cache.cpp
+ * @brief Process wide cache sharing mesh buffers between render objects
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <tuple>
+#include <utility>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_geometry/geometries.h>
+#include <tesseract_gui/render/mesh_cache.h>
+#include <tesseract_gui/render/geometry_conversion.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+/** @brief MurmurHash64A, hashes eight bytes per step which keeps hashing large meshes far cheaper than converting */
+std::uint64_t hashBytes(const void* data, std::size_t size, std::uint64_t seed)
+{
+  constexpr std::uint64_t m = 0xc6a4a7935bd1e995ULL;
+  constexpr int r = 47;
+
+  std::uint64_t h = seed ^ (size * m);
+  const auto* bytes = static_cast<const unsigned char*>(data);
+  const std::size_t words = size / 8;
+  for (std::size_t i = 0; i < words; ++i)
+  {
+    std::uint64_t k{ 0 };
+    std::memcpy(&k, bytes + (i * 8), 8);
+    k *= m;
+    k ^= k >> r;
+    k *= m;
+    h ^= k;
+    h *= m;
+  }
+
+  const std::size_t remaining = size % 8;
+  if (remaining > 0)
+  {
+    std::uint64_t k{ 0 };
+    std::memcpy(&k, bytes + (words * 8), remaining);
+    h ^= k;
+    h *= m;
+  }
+
+  h ^= h >> r;
+  h *= m;
+  h ^= h >> r;
+  return h;
+}
+
+std::uint64_t hashPolygonMesh(const tesseract_geometry::Geometry& geometry,
+                              const tesseract_common::VectorVector3d& vertices,
+                              const Eigen::VectorXi& faces,
+                              const Eigen::Vector3d& scale,
+                              const tesseract_common::VectorVector3d* normals)
+{
+  auto h = static_cast<std::uint64_t>(geometry.getType());
+  h = hashBytes(vertices.data(), vertices.size() * sizeof(Eigen::Vector3d), h);
+  h = hashBytes(faces.data(), static_cast<std::size_t>(faces.size()) * sizeof(int), h);
+  h = hashBytes(scale.data(), sizeof(double) * 3, h);
+  if (normals != nullptr)
+    h = hashBytes(normals->data(), normals->size() * sizeof(Eigen::Vector3d), h);
+  return h;
+}
+
+template <typename T>
+std::pair<std::string, std::uint64_t> getPolygonMeshKey(const T& mesh,
+                                                        const tesseract_common::VectorVector3d* normals = nullptr)
+{
+  std::string url = (mesh.getResource() != nullptr) ? mesh.getResource()->getUrl() : std::string();
+  return { std::move(url), hashPolygonMesh(mesh, *mesh.getVertices(), *mesh.getFaces(), mesh.getScale(), normals) };
+}
+}  // namespace
+
+MeshCache& MeshCache::instance()
+{
+  static MeshCache cache;
+  return cache;
+}
+
+std::size_t MeshCache::KeyHash::operator()(const Key& key) const
+{
+  return std::hash<std::string>()(key.url) ^ static_cast<std::size_t>(key.content_hash);
+}
+
+MeshCache::~MeshCache()
+{
+  {
+    std::scoped_lock lock(mutex_);
+    stopping_ = true;
+  }
+  lod_condition_.notify_all();
+
+  if (lod_thread_.joinable())
+    lod_thread_.join();
+}
+
+bool MeshCache::getKey(const tesseract_geometry::Geometry& geometry, Key& key)
+{
+  switch (geometry.getType())
+  {
+    case tesseract_geometry::GeometryType::MESH:
+    {
+      const auto& mesh = static_cast<const tesseract_geometry::Mesh&>(geometry);
+      std::tie(key.url, key.content_hash) = getPolygonMeshKey(mesh, mesh.getNormals().get());
+      return true;
+    }
+    case tesseract_geometry::GeometryType::CONVEX_MESH:
+      std::tie(key.url, key.content_hash) =
+          getPolygonMeshKey(static_cast<const tesseract_geometry::ConvexMesh&>(geometry));
+      return true;
+    case tesseract_geometry::GeometryType::SDF_MESH:
+      std::tie(key.url, key.content_hash) = getPolygonMeshKey(static_cast<const tesseract_geometry::SDFMesh&>(geometry));
+      return true;
+    default:
+      return false;
+  }
+}
+
+MeshBuffers::ConstPtr MeshCache::get(const tesseract_geometry::Geometry& geometry)
+{
+  Key key;
+  if (!getKey(geometry, key))
+    return createMeshBuffers(geometry);
+
+  {
+    std::scoped_lock lock(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end())
+    {
+      if (MeshBuffers::ConstPtr buffers = it->second.lock())
+      {
+        ++hits_;
+        return buffers;
+      }
+    }
+  }
+
+  MeshBuffers::ConstPtr buffers = createMeshBuffers(geometry);
+  ++misses_;
+
+  std::scoped_lock lock(mutex_);
+  std::weak_ptr<const MeshBuffers>& entry = entries_[key];
+
+  // Another thread may have converted the same mesh while the lock was released
+  if (MeshBuffers::ConstPtr existing = entry.lock())
+    return existing;
+
+  entry = buffers;
+  if (entries_.size() >= next_purge_size_)
+  {
+    purgeLocked();
+    next_purge_size_ = std::max<std::size_t>(64, 2 * entries_.size());
+  }
+
+  return buffers;
+}
+
+MeshLod::ConstPtr MeshCache::getLod(const tesseract_geometry::Geometry& geometry)
+{
+  Key key;
+  if (geometry.getType() != tesseract_geometry::GeometryType::MESH || !getKey(geometry, key))
+    return nullptr;
+
+  {
+    std::scoped_lock lock(mutex_);
+    auto it = lods_.find(key);
+    if (it != lods_.end())
+    {
+      if (MeshLod::Ptr lod = it->second.lock())
+        return lod;
+    }
+  }
+
+  MeshBuffers::ConstPtr buffers = get(geometry);
+  if (buffers == nullptr)
+    return nullptr;
+
+  auto lod = std::make_shared<MeshLod>(std::move(buffers));
+  {
+    std::scoped_lock lock(mutex_);
+    std::weak_ptr<MeshLod>& entry = lods_[key];
+    if (MeshLod::Ptr existing = entry.lock())
+      return existing;
+
+    entry = lod;
+    if (lod->getLevel(0)->getTriangleCount() < MeshLod::MIN_DECIMATION_TRIANGLE_COUNT)
+      return lod;
+
+    lod_queue_.push_back(lod);
+    if (!lod_thread_.joinable())
+      lod_thread_ = std::thread([this]() { generateLods(); });
+  }
+  lod_condition_.notify_one();
+
+  return lod;
+}
+
+std::size_t MeshCache::getPendingLodCount() const
+{
+  std::scoped_lock lock(mutex_);
+  return lod_queue_.size();
+}
+
+std::size_t MeshCache::size() const
+{
+  std::scoped_lock lock(mutex_);
+  return static_cast<std::size_t>(
+      std::count_if(entries_.begin(), entries_.end(), [](const auto& entry) { return !entry.second.expired(); }));
+}
+
+std::size_t MeshCache::getByteSize() const
+{
+  std::scoped_lock lock(mutex_);
+  std::size_t bytes = 0;
+  for (const auto& entry : entries_)
+  {
+    if (MeshBuffers::ConstPtr buffers = entry.second.lock())
+      bytes += buffers->getByteSize();
+  }
+  return bytes;
+}
+
+std::size_t MeshCache::getHitCount() const { return hits_.load(); }
+
+std::size_t MeshCache::getMissCount() const { return misses_.load(); }
+
+void MeshCache::purge()
+{
+  std::scoped_lock lock(mutex_);
+  purgeLocked();
+}
+
+void MeshCache::purgeLocked()
+{
+  for (auto it = entries_.begin(); it != entries_.end();)
+  {
+    if (it->second.expired())
+      it = entries_.erase(it);
+    else
+      ++it;
+  }
+
+  for (auto it = lods_.begin(); it != lods_.end();)
+  {
+    if (it->second.expired())
+      it = lods_.erase(it);
+    else
+      ++it;
+  }
+}
+
+void MeshCache::generateLods()
+{
+  std::unique_lock lock(mutex_);
+  while (true)
+  {
+    lod_condition_.wait(lock, [this]() { return stopping_ || !lod_queue_.empty(); });
+    if (stopping_)
+      return;
+
+    // Meshes released while waiting are skipped
+    MeshLod::Ptr lod = lod_queue_.front().lock();
+    lod_queue_.pop_front();
+    if (lod == nullptr)
+      continue;
+
+    lock.unlock();
+    lod->generateLevels();
+    lod.reset();
+    lock.lock();
+  }
+}
+
+}  // namespace tesseract_gui
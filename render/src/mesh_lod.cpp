@@ -0,0 +1,216 @@
+/**
+ * @file mesh_lod.cpp
+ * @brief Decimated levels of detail of a mesh
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <Eigen/Geometry>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/render/mesh_lod.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+/** @brief Each grid coordinate is packed into 21 bits of the cell key */
+constexpr int MAX_GRID_RESOLUTION = (1 << 21) - 1;
+
+/** @brief Refinement steps of the grid resolution in decimateMesh() */
+constexpr int MAX_DECIMATION_ITERATIONS = 4;
+
+Eigen::Map<const Eigen::Vector3f> getPosition(const MeshBuffers& mesh, std::size_t vertex)
+{
+  return Eigen::Map<const Eigen::Vector3f>(mesh.vertices.data() + (vertex * MeshBuffers::VERTEX_STRIDE));
+}
+
+Eigen::Map<const Eigen::Vector3f> getNormal(const MeshBuffers& mesh, std::size_t vertex)
+{
+  return Eigen::Map<const Eigen::Vector3f>(mesh.vertices.data() + (vertex * MeshBuffers::VERTEX_STRIDE) + 3);
+}
+
+Eigen::AlignedBox3f computeBounds(const MeshBuffers& mesh)
+{
+  Eigen::AlignedBox3f bounds;
+  for (std::size_t i = 0; i < mesh.getVertexCount(); ++i)
+    bounds.extend(Eigen::Vector3f(getPosition(mesh, i)));
+  return bounds;
+}
+
+MeshBuffers::Ptr clusterVertices(const MeshBuffers& mesh, const Eigen::AlignedBox3f& bounds, int resolution)
+{
+  const float extent = std::max(bounds.sizes().maxCoeff(), std::numeric_limits<float>::epsilon());
+  const float inverse_cell_size = static_cast<float>(resolution) / extent;
+
+  struct Cluster
+  {
+    Eigen::Vector3f position{ Eigen::Vector3f::Zero() };
+    Eigen::Vector3f normal{ Eigen::Vector3f::Zero() };
+    float count{ 0 };
+  };
+
+  std::unordered_map<std::uint64_t, std::uint32_t> cell_clusters;
+  cell_clusters.reserve(mesh.getVertexCount() / 4);
+  std::vector<Cluster> clusters;
+  std::vector<std::uint32_t> vertex_clusters(mesh.getVertexCount());
+  for (std::size_t i = 0; i < mesh.getVertexCount(); ++i)
+  {
+    const Eigen::Vector3f position = getPosition(mesh, i);
+    const Eigen::Vector3f cell = ((position - bounds.min()) * inverse_cell_size).array().floor();
+    const auto x = static_cast<std::uint64_t>(std::clamp(static_cast<int>(cell.x()), 0, resolution));
+    const auto y = static_cast<std::uint64_t>(std::clamp(static_cast<int>(cell.y()), 0, resolution));
+    const auto z = static_cast<std::uint64_t>(std::clamp(static_cast<int>(cell.z()), 0, resolution));
+    const std::uint64_t key = (x << 42U) | (y << 21U) | z;
+
+    auto it = cell_clusters.emplace(key, static_cast<std::uint32_t>(clusters.size())).first;
+    if (it->second == clusters.size())
+      clusters.emplace_back();
+
+    Cluster& cluster = clusters[it->second];
+    cluster.position += position;
+    cluster.normal += getNormal(mesh, i);
+    cluster.count += 1.0F;
+    vertex_clusters[i] = it->second;
+  }
+
+  auto result = std::make_shared<MeshBuffers>();
+  result->vertices.reserve(clusters.size() * MeshBuffers::VERTEX_STRIDE);
+  for (const auto& cluster : clusters)
+  {
+    // Normals of opposite sides of thin walls cancel out, any direction is as good as another then
+    const float length = cluster.normal.norm();
+    const Eigen::Vector3f normal = (length > 1e-6F) ? Eigen::Vector3f(cluster.normal / length) : Eigen::Vector3f::UnitZ();
+    result->addVertex(cluster.position / cluster.count, normal);
+  }
+
+  // Triangles are rotated to start with their smallest index so duplicates with the same winding compare equal
+  std::unordered_set<std::uint64_t> triangles;
+  triangles.reserve(mesh.getTriangleCount() / 4);
+  for (std::size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+  {
+    std::array<std::uint32_t, 3> t{ vertex_clusters[mesh.indices[i]],
+                                    vertex_clusters[mesh.indices[i + 1]],
+                                    vertex_clusters[mesh.indices[i + 2]] };
+    if (t[0] == t[1] || t[1] == t[2] || t[0] == t[2])
+      continue;
+
+    std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+    const std::uint64_t key = (static_cast<std::uint64_t>(t[0]) * 0x9E3779B97F4A7C15ULL) ^
+                              (static_cast<std::uint64_t>(t[1]) << 32U) ^ static_cast<std::uint64_t>(t[2]);
+    if (triangles.insert(key).second)
+      result->addTriangle(t[0], t[1], t[2]);
+  }
+
+  return result;
+}
+}  // namespace
+
+MeshBuffers::Ptr decimateMesh(const MeshBuffers& mesh, std::size_t target_triangle_count)
+{
+  if (mesh.getTriangleCount() <= target_triangle_count)
+    return std::make_shared<MeshBuffers>(mesh);
+
+  const Eigen::AlignedBox3f bounds = computeBounds(mesh);
+
+  // A surface clustered on an n^3 grid keeps roughly 2 * n^2 triangles, start there and correct by the observed ratio
+  double resolution = std::sqrt(static_cast<double>(target_triangle_count) / 2.0);
+  MeshBuffers::Ptr result;
+  for (int i = 0; i < MAX_DECIMATION_ITERATIONS; ++i)
+  {
+    const int grid = std::clamp(static_cast<int>(std::lround(resolution)), 1, MAX_GRID_RESOLUTION);
+    result = clusterVertices(mesh, bounds, grid);
+
+    const double ratio = static_cast<double>(result->getTriangleCount()) / static_cast<double>(target_triangle_count);
+    if (ratio > 0.8 && ratio < 1.25)
+      break;
+
+    resolution /= std::sqrt(std::max(ratio, 0.01));
+  }
+
+  return result;
+}
+
+MeshLod::MeshLod(MeshBuffers::ConstPtr mesh)
+{
+  if (mesh == nullptr)
+    throw std::runtime_error("MeshLod, mesh is a nullptr!");
+
+  const Eigen::AlignedBox3f bounds = computeBounds(*mesh);
+  if (!bounds.isEmpty())
+  {
+    center_ = bounds.center();
+    radius_ = 0.5F * bounds.diagonal().norm();
+  }
+
+  levels_[0] = std::move(mesh);
+}
+
+std::size_t MeshLod::getLevelCount() const { return level_count_.load(std::memory_order_acquire); }
+
+const MeshBuffers::ConstPtr& MeshLod::getLevel(std::size_t level) const { return levels_.at(level); }
+
+std::size_t MeshLod::selectLevel(float screen_diameter, float pixels_per_triangle) const
+{
+  const float edges = screen_diameter / std::max(pixels_per_triangle, 1e-3F);
+  const auto required = static_cast<std::size_t>(std::max(0.0F, edges * edges));
+  for (std::size_t level = getLevelCount() - 1; level > 0; --level)
+  {
+    if (levels_[level]->getTriangleCount() >= required)
+      return level;
+  }
+  return 0;
+}
+
+const Eigen::Vector3f& MeshLod::getCenter() const { return center_; }
+
+float MeshLod::getRadius() const { return radius_; }
+
+void MeshLod::generateLevels()
+{
+  if (complete_)
+    return;
+
+  std::size_t count = 1;
+  if (levels_[0]->getTriangleCount() >= MIN_DECIMATION_TRIANGLE_COUNT)
+  {
+    // Each level targets a quarter of the triangles of the previous one, i.e. half the edge resolution
+    std::size_t target = levels_[0]->getTriangleCount() / 4;
+    while (count < MAX_LEVEL_COUNT && target >= MIN_LEVEL_TRIANGLE_COUNT)
+    {
+      MeshBuffers::Ptr level = decimateMesh(*levels_[count - 1], target);
+      if (4 * level->getTriangleCount() > 3 * levels_[count - 1]->getTriangleCount())
+        break;
+
+      target = level->getTriangleCount() / 4;
+      levels_[count] = std::move(level);
+      level_count_.store(++count, std::memory_order_release);
+    }
+  }
+
+  complete_ = true;
+}
+
+bool MeshLod::isComplete() const { return complete_; }
+
+}  // namespace tesseract_gui
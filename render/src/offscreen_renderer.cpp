@@ -0,0 +1,130 @@
+/**
+ * @file offscreen_renderer.cpp
+ * @brief Renders scenes into images without a window
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <stdexcept>
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLFramebufferObject>
+#include <QOpenGLFunctions>
+#include <QSurfaceFormat>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/render/offscreen_renderer.h>
+
+namespace tesseract_gui
+{
+OffscreenRenderer::OffscreenRenderer(int width, int height)
+{
+  QSurfaceFormat format;
+  format.setVersion(3, 3);
+  format.setProfile(QSurfaceFormat::CoreProfile);
+  format.setDepthBufferSize(24);
+  format.setSamples(0);
+
+  surface_ = std::make_unique<QOffscreenSurface>();
+  surface_->setFormat(format);
+  surface_->create();
+  if (!surface_->isValid())
+    throw std::runtime_error("OffscreenRenderer, failed to create an offscreen surface!");
+
+  context_ = std::make_unique<QOpenGLContext>();
+  context_->setFormat(format);
+  if (!context_->create())
+    throw std::runtime_error("OffscreenRenderer, failed to create an OpenGL context!");
+
+  const QSurfaceFormat actual = context_->format();
+  if (actual.majorVersion() < 3 || (actual.majorVersion() == 3 && actual.minorVersion() < 3))
+    throw std::runtime_error("OffscreenRenderer, OpenGL 3.3 is not available!");
+
+  setSize(width, height);
+}
+
+OffscreenRenderer::~OffscreenRenderer()
+{
+  if (!context_->makeCurrent(surface_.get()))
+    return;
+
+  renderer_.cleanup();
+  framebuffer_.reset();
+  context_->doneCurrent();
+}
+
+void OffscreenRenderer::setSize(int width, int height)
+{
+  if (width <= 0 || height <= 0)
+    throw std::runtime_error("OffscreenRenderer, size must be positive!");
+
+  if (framebuffer_ != nullptr && width == width_ && height == height_)
+    return;
+
+  makeCurrent();
+  framebuffer_ = std::make_unique<QOpenGLFramebufferObject>(width, height, QOpenGLFramebufferObject::Depth);
+  if (!framebuffer_->isValid())
+    throw std::runtime_error("OffscreenRenderer, failed to create a framebuffer!");
+
+  width_ = width;
+  height_ = height;
+}
+
+int OffscreenRenderer::getWidth() const { return width_; }
+
+int OffscreenRenderer::getHeight() const { return height_; }
+
+SceneRenderer& OffscreenRenderer::getRenderer() { return renderer_; }
+
+QImage OffscreenRenderer::render(const RenderScene& scene, const Camera& camera)
+{
+  makeCurrent();
+  framebuffer_->bind();
+  context_->functions()->glDisable(GL_DITHER);
+  renderer_.render(scene, camera, width_, height_);
+  context_->functions()->glFinish();
+  framebuffer_->release();
+  return framebuffer_->toImage();
+}
+
+std::vector<QImage> OffscreenRenderer::render(const RenderScene& scene,
+                                              const tesseract_common::AlignedVector<Camera>& cameras)
+{
+  std::vector<QImage> images;
+  images.reserve(cameras.size());
+  for (const auto& camera : cameras)
+    images.push_back(render(scene, camera));
+  return images;
+}
+
+QImage OffscreenRenderer::render(const tesseract_environment::Environment& environment, const Camera& camera)
+{
+  const tesseract_scene_graph::SceneGraph::ConstPtr scene_graph = environment.getSceneGraph();
+  if (scene_graph == nullptr)
+    throw std::runtime_error("OffscreenRenderer, environment has no scene graph!");
+
+  // A member scene, a new scene at the address of a destroyed one could be mistaken for it by the renderer
+  environment_scene_.loadSceneGraph(*scene_graph);
+  environment_scene_.updateLinkTransforms(environment);
+  return render(environment_scene_, camera);
+}
+
+void OffscreenRenderer::makeCurrent()
+{
+  if (!context_->makeCurrent(surface_.get()))
+    throw std::runtime_error("OffscreenRenderer, failed to make the OpenGL context current!");
+}
+
+}  // namespace tesseract_gui
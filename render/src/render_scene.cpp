@@ -0,0 +1,257 @@
+/**
+ * @file render_scene.cpp
+ * @brief The graphics context independent description of what the renderer draws
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_environment/environment.h>
+#include <tesseract_gui/common/instrumentation.h>
+#include <tesseract_gui/render/render_scene.h>
+#include <tesseract_gui/render/mesh_cache.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+const Eigen::Vector4f DEFAULT_VISUAL_COLOR(0.7F, 0.7F, 0.7F, 1.0F);
+const Eigen::Vector4f DEFAULT_COLLISION_COLOR(0.8F, 0.4F, 0.1F, 0.5F);
+}  // namespace
+
+void RenderScene::clear()
+{
+  link_names_.clear();
+  link_index_.clear();
+  objects_.clear();
+  link_transforms_.clear();
+  ghost_link_transforms_.clear();
+  ghost_colors_.clear();
+  ghost_link_mask_.clear();
+  link_colors_.clear();
+  transform_batch_dirty_ = true;
+  ++revision_;
+  ++transform_revision_;
+}
+
+void RenderScene::loadSceneGraph(const tesseract_scene_graph::SceneGraph& scene_graph)
+{
+  const ScopedTimer timer("render", "load scene graph");
+  clear();
+
+  const std::vector<tesseract_scene_graph::Link::ConstPtr> links = scene_graph.getLinks();
+  link_names_.reserve(links.size());
+  link_transforms_.reserve(links.size() * LinkTransformBatch::MATRIX_SIZE);
+  for (const auto& link : links)
+  {
+    const int link_index = addLink(link->getName());
+    for (const auto& visual : link->visual)
+    {
+      RenderObject object;
+      object.type = RenderObjectType::VISUAL;
+      object.link_index = link_index;
+      object.local_transform = visual->origin.matrix().cast<float>();
+      object.color = (visual->material != nullptr) ? Eigen::Vector4f(visual->material->color.cast<float>()) :
+                                                     DEFAULT_VISUAL_COLOR;
+      object.lod = MeshCache::instance().getLod(*visual->geometry);
+      object.mesh = (object.lod != nullptr) ? object.lod->getLevel(0) : MeshCache::instance().get(*visual->geometry);
+      if (object.mesh != nullptr)
+        objects_.push_back(object);
+    }
+
+    for (const auto& collision : link->collision)
+    {
+      RenderObject object;
+      object.type = RenderObjectType::COLLISION;
+      object.link_index = link_index;
+      object.local_transform = collision->origin.matrix().cast<float>();
+      object.color = DEFAULT_COLLISION_COLOR;
+      object.mesh = MeshCache::instance().get(*collision->geometry);
+      if (object.mesh != nullptr)
+        objects_.push_back(object);
+    }
+  }
+}
+
+int RenderScene::addLink(const std::string& name)
+{
+  auto it = link_index_.find(name);
+  if (it != link_index_.end())
+    return it->second;
+
+  const auto index = static_cast<int>(link_names_.size());
+  link_names_.push_back(name);
+  link_index_[name] = index;
+
+  link_transforms_.resize(link_transforms_.size() + LinkTransformBatch::MATRIX_SIZE);
+  Eigen::Map<Eigen::Matrix4f>(link_transforms_.data() + link_transforms_.size() - LinkTransformBatch::MATRIX_SIZE)
+      .setIdentity();
+
+  // The ghost transforms and link colors are packed per link count
+  ghost_link_transforms_.clear();
+  ghost_colors_.clear();
+  ghost_link_mask_.clear();
+  link_colors_.clear();
+
+  transform_batch_dirty_ = true;
+  ++revision_;
+  ++transform_revision_;
+  return index;
+}
+
+int RenderScene::getLinkIndex(const std::string& name) const
+{
+  auto it = link_index_.find(name);
+  return (it != link_index_.end()) ? it->second : -1;
+}
+
+const std::vector<std::string>& RenderScene::getLinkNames() const { return link_names_; }
+
+void RenderScene::addObject(const RenderObject& object)
+{
+  if (object.link_index < 0 || object.link_index >= static_cast<int>(link_names_.size()))
+    throw std::runtime_error("RenderScene, render object references a link which does not exist!");
+
+  objects_.push_back(object);
+  ++revision_;
+}
+
+const tesseract_common::AlignedVector<RenderObject>& RenderScene::getObjects() const { return objects_; }
+
+void RenderScene::setLinkTransforms(const float* data, std::size_t link_count)
+{
+  if (link_count != link_names_.size())
+    throw std::runtime_error("RenderScene, the number of link transforms does not match the number of links!");
+
+  std::memcpy(link_transforms_.data(), data, link_count * LinkTransformBatch::MATRIX_SIZE * sizeof(float));
+  ++transform_revision_;
+}
+
+std::size_t RenderScene::setGhosts(const float* data,
+                                   const tesseract_common::AlignedVector<Eigen::Vector4f>& colors,
+                                   const std::vector<std::string>& link_names)
+{
+  ghost_link_mask_.clear();
+  if (!link_names.empty())
+  {
+    ghost_link_mask_.assign(link_names_.size(), false);
+    for (const auto& link_name : link_names)
+    {
+      const int index = getLinkIndex(link_name);
+      if (index >= 0)
+        ghost_link_mask_[static_cast<std::size_t>(index)] = true;
+    }
+  }
+
+  const std::size_t count = std::min(colors.size(), getMaxGhostCount());
+  const std::size_t size = count * link_names_.size() * LinkTransformBatch::MATRIX_SIZE;
+  ghost_link_transforms_.assign(data, data + size);
+  ghost_colors_.assign(colors.begin(), colors.begin() + static_cast<std::ptrdiff_t>(count));
+  ++transform_revision_;
+  return count;
+}
+
+void RenderScene::clearGhosts()
+{
+  if (ghost_colors_.empty())
+    return;
+
+  ghost_link_transforms_.clear();
+  ghost_colors_.clear();
+  ghost_link_mask_.clear();
+  ++transform_revision_;
+}
+
+std::size_t RenderScene::getGhostCount() const { return ghost_colors_.size(); }
+
+bool RenderScene::isGhostLink(int link_index) const
+{
+  return ghost_link_mask_.empty() || ghost_link_mask_[static_cast<std::size_t>(link_index)];
+}
+
+std::size_t RenderScene::getMaxGhostCount() const
+{
+  // The scene links take the first slot
+  const std::size_t scene_copies = link_names_.empty() ? 0 : MAX_LINK_TRANSFORM_COUNT / link_names_.size();
+  return (scene_copies > 0) ? scene_copies - 1 : 0;
+}
+
+const std::vector<float>& RenderScene::getGhostLinkTransforms() const { return ghost_link_transforms_; }
+
+const tesseract_common::AlignedVector<Eigen::Vector4f>& RenderScene::getGhostColors() const { return ghost_colors_; }
+
+void RenderScene::setLinkColors(const tesseract_common::AlignedVector<Eigen::Vector4f>& colors)
+{
+  if (colors.size() != link_names_.size())
+    throw std::runtime_error("RenderScene, the number of link colors does not match the number of links!");
+
+  link_colors_ = colors;
+  ++transform_revision_;
+}
+
+void RenderScene::clearLinkColors()
+{
+  if (link_colors_.empty())
+    return;
+
+  link_colors_.clear();
+  ++transform_revision_;
+}
+
+const tesseract_common::AlignedVector<Eigen::Vector4f>& RenderScene::getLinkColors() const { return link_colors_; }
+
+void RenderScene::updateLinkTransforms(const tesseract_scene_graph::SceneState& state)
+{
+  packLinkTransforms(state.link_transforms);
+}
+
+void RenderScene::updateLinkTransforms(const tesseract_environment::Environment& environment)
+{
+  const ScopedTimer timer("fk", "environment state");
+  packLinkTransforms(environment.getState().link_transforms);
+}
+
+const std::vector<float>& RenderScene::getLinkTransforms() const { return link_transforms_; }
+
+void RenderScene::setVisible(RenderObjectType type, bool visible)
+{
+  visible_[static_cast<std::size_t>(type)] = visible;
+  ++revision_;
+}
+
+bool RenderScene::isVisible(RenderObjectType type) const { return visible_[static_cast<std::size_t>(type)]; }
+
+std::uint64_t RenderScene::getRevision() const { return revision_; }
+
+std::uint64_t RenderScene::getTransformRevision() const { return transform_revision_; }
+
+void RenderScene::packLinkTransforms(const tesseract_common::TransformMap& link_transforms)
+{
+  if (transform_batch_dirty_)
+  {
+    transform_batch_.setLinkNames(link_names_);
+    transform_batch_dirty_ = false;
+  }
+
+  // Written straight into the scene buffer, the batch only provides the link order
+  transform_batch_.pack(link_transforms, link_transforms_.data());
+  ++transform_revision_;
+}
+
+}  // namespace tesseract_gui
@@ -0,0 +1,294 @@
+/**
+ * @file render_thumbnails.cpp
+ * @brief Renders images of environments without a display, one process per environment
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QGuiApplication>
+#include <QProcess>
+#include <QThread>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/environment/environment_loader.h>
+#include <tesseract_gui/render/offscreen_renderer.h>
+
+namespace
+{
+struct Options
+{
+  QStringList scenes;
+  QString output_dir{ "." };
+  QString output;
+  int width{ 512 };
+  int height{ 512 };
+  Eigen::Vector3f eye{ 2.5F, 2.5F, 2.0F };
+  Eigen::Vector3f target{ 0.0F, 0.0F, 0.5F };
+  bool collision{ false };
+  bool gpu{ false };
+  int jobs{ 1 };
+
+  /** @brief The arguments passed on to the process of each scene */
+  QStringList forwarded;
+};
+
+bool parseVector(const QString& text, Eigen::Vector3f& vector)
+{
+  const QStringList values = text.split(',');
+  if (values.size() != 3)
+    return false;
+
+  for (int i = 0; i < 3; ++i)
+  {
+    bool ok{ false };
+    vector[i] = values[i].toFloat(&ok);
+    if (!ok)
+      return false;
+  }
+  return true;
+}
+
+bool parseOptions(const QStringList& arguments, Options& options)
+{
+  QCommandLineParser parser;
+  parser.setApplicationDescription(
+      "Render images of environments without a display. Each scene is a URDF optionally followed by a comma and an "
+      "SRDF. Several scenes are rendered in parallel processes.");
+  parser.addHelpOption();
+  parser.addPositionalArgument("scenes", "The scenes to render, urdf[,srdf]", "scene...");
+
+  const QCommandLineOption output_dir_option(
+      { "d", "output-dir" }, "Directory of the images, named after the URDF.", "dir", ".");
+  const QCommandLineOption output_option({ "o", "output" }, "The image file, only for a single scene.", "file");
+  const QCommandLineOption size_option({ "s", "size" }, "Image size.", "WxH", "512x512");
+  const QCommandLineOption eye_option("eye", "Camera position.", "x,y,z", "2.5,2.5,2");
+  const QCommandLineOption target_option("target", "Camera target.", "x,y,z", "0,0,0.5");
+  const QCommandLineOption collision_option("collision", "Render the collision instead of the visual geometry.");
+  const QCommandLineOption gpu_option("gpu", "Use the GPU driver instead of forcing the Mesa software rasterizer.");
+  const QCommandLineOption jobs_option(
+      { "j", "jobs" }, "The number of scenes rendered in parallel.", "n", QString::number(QThread::idealThreadCount()));
+  parser.addOptions({ output_dir_option,
+                      output_option,
+                      size_option,
+                      eye_option,
+                      target_option,
+                      collision_option,
+                      gpu_option,
+                      jobs_option });
+
+  if (!parser.parse(arguments))
+  {
+    std::cerr << parser.errorText().toStdString() << std::endl;
+    return false;
+  }
+
+  if (parser.isSet("help"))
+  {
+    std::cout << parser.helpText().toStdString();
+    return false;
+  }
+
+  options.scenes = parser.positionalArguments();
+  options.output_dir = parser.value(output_dir_option);
+  options.output = parser.value(output_option);
+  options.collision = parser.isSet(collision_option);
+  options.gpu = parser.isSet(gpu_option);
+
+  const QStringList size = parser.value(size_option).split('x');
+  bool width_ok{ false };
+  bool height_ok{ false };
+  if (size.size() == 2)
+  {
+    options.width = size[0].toInt(&width_ok);
+    options.height = size[1].toInt(&height_ok);
+  }
+
+  bool jobs_ok{ false };
+  options.jobs = parser.value(jobs_option).toInt(&jobs_ok);
+
+  if (!width_ok || !height_ok || options.width <= 0 || options.height <= 0 || !jobs_ok || options.jobs <= 0 ||
+      !parseVector(parser.value(eye_option), options.eye) || !parseVector(parser.value(target_option), options.target))
+  {
+    std::cerr << "Invalid size, jobs, eye or target" << std::endl;
+    return false;
+  }
+
+  if (options.scenes.empty() || (!options.output.isEmpty() && options.scenes.size() > 1))
+  {
+    std::cerr << "Expected one or more scenes, --output requires a single scene" << std::endl;
+    return false;
+  }
+
+  for (const auto& option : { size_option, eye_option, target_option })
+    options.forwarded << ("--" + option.names().back()) << parser.value(option);
+  if (options.collision)
+    options.forwarded << "--collision";
+  if (options.gpu)
+    options.forwarded << "--gpu";
+
+  return true;
+}
+
+QString getOutputPath(const Options& options, const QString& scene)
+{
+  if (!options.output.isEmpty())
+    return options.output;
+
+  return QDir(options.output_dir).filePath(QFileInfo(scene.section(',', 0, 0)).completeBaseName() + ".png");
+}
+
+/** @brief Render every scene in its own process, at most jobs at a time */
+int renderParallel(int argc, char** argv, const Options& options)
+{
+  QCoreApplication app(argc, argv);
+
+  int next{ 0 };
+  int running{ 0 };
+  int failed{ 0 };
+  std::function<void()> start_next = [&]() {
+    while (running < options.jobs && next < options.scenes.size())
+    {
+      const QString scene = options.scenes[next++];
+      auto* process = new QProcess(&app);
+      process->setProcessChannelMode(QProcess::ForwardedChannels);
+      auto done = [&, process, scene](bool success) {
+        if (!success)
+        {
+          std::cerr << "Failed to render " << scene.toStdString() << std::endl;
+          ++failed;
+        }
+
+        process->deleteLater();
+        --running;
+        start_next();
+        if (running == 0)
+          app.exit(failed == 0 ? 0 : 1);
+      };
+      QObject::connect(process,
+                       QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+                       [done](int exit_code, QProcess::ExitStatus status) {
+                         done(status == QProcess::NormalExit && exit_code == 0);
+                       });
+
+      // A process which failed to start never finishes. Queued, as start() may report this before the event loop runs
+      QObject::connect(
+          process,
+          &QProcess::errorOccurred,
+          &app,
+          [done](QProcess::ProcessError error) {
+            if (error == QProcess::FailedToStart)
+              done(false);
+          },
+          Qt::QueuedConnection);
+
+      ++running;
+      process->start(QCoreApplication::applicationFilePath(),
+                     QStringList(options.forwarded) << "--output" << getOutputPath(options, scene) << scene);
+    }
+  };
+
+  QDir().mkpath(options.output_dir);
+  start_next();
+  return app.exec();
+}
+
+/** @brief Load and render a single scene in this process */
+int renderScene(int argc, char** argv, const Options& options)
+{
+  // No display is needed, the software rasterizer makes images comparable between machines without a GPU
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+  if (!options.gpu && qEnvironmentVariableIsEmpty("LIBGL_ALWAYS_SOFTWARE"))
+    qputenv("LIBGL_ALWAYS_SOFTWARE", "1");
+
+  QGuiApplication app(argc, argv);
+
+  std::unique_ptr<tesseract_gui::OffscreenRenderer> renderer;
+  try
+  {
+    renderer = std::make_unique<tesseract_gui::OffscreenRenderer>(options.width, options.height);
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+
+  const QString& scene = options.scenes.front();
+  const QString output = getOutputPath(options, scene);
+
+  tesseract_gui::EnvironmentLoader loader;
+  QObject::connect(
+      &loader, &tesseract_gui::EnvironmentLoader::environmentLoaded, [&](tesseract_environment::Environment::Ptr env) {
+        try
+        {
+          tesseract_gui::RenderScene render_scene;
+          render_scene.loadSceneGraph(*env->getSceneGraph());
+          render_scene.updateLinkTransforms(*env);
+          render_scene.setVisible(tesseract_gui::RenderObjectType::VISUAL, !options.collision);
+          render_scene.setVisible(tesseract_gui::RenderObjectType::COLLISION, options.collision);
+
+          tesseract_gui::Camera camera;
+          camera.lookAt(options.eye, options.target);
+
+          const QImage image = renderer->render(render_scene, camera);
+          if (!image.save(output))
+            throw std::runtime_error("Failed to write " + output.toStdString());
+
+          app.exit(0);
+        }
+        catch (const std::exception& e)
+        {
+          std::cerr << e.what() << std::endl;
+          app.exit(1);
+        }
+      });
+  QObject::connect(&loader, &tesseract_gui::EnvironmentLoader::loadFailed, [&](const QString& message) {
+    std::cerr << message.toStdString() << std::endl;
+    app.exit(1);
+  });
+
+  loader.load(scene.section(',', 0, 0).toStdString(), scene.section(',', 1).toStdString());
+  const int result = app.exec();
+
+  // The renderer releases its resources with its context, before the application is destroyed
+  renderer.reset();
+  return result;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  QStringList arguments;
+  for (int i = 0; i < argc; ++i)
+    arguments << QString::fromLocal8Bit(argv[i]);
+
+  Options options;
+  if (!parseOptions(arguments, options))
+    return 1;
+
+  if (options.scenes.size() > 1)
+    return renderParallel(argc, argv, options);
+
+  return renderScene(argc, argv, options);
+}
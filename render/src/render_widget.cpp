@@ -0,0 +1,146 @@
+/**
+ * @file render_widget.cpp
+ * @brief A widget displaying a render scene with an orbit camera
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <QFileDialog>
+#include <QKeyEvent>
+#include <QMessageBox>
+#include <QMouseEvent>
+#include <QSurfaceFormat>
+#include <QWheelEvent>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/common/instrumentation.h>
+#include <tesseract_gui/render/instrumentation_overlay.h>
+#include <tesseract_gui/render/render_widget.h>
+
+namespace tesseract_gui
+{
+RenderWidget::RenderWidget(QWidget* parent)
+  : QOpenGLWidget(parent)
+  , scene_(std::make_shared<RenderScene>())
+  , instrumentation_overlay_(new InstrumentationOverlay(this))
+{
+  instrumentation_overlay_->hide();
+  setFocusPolicy(Qt::StrongFocus);
+
+  QSurfaceFormat format;
+  format.setVersion(3, 3);
+  format.setProfile(QSurfaceFormat::CoreProfile);
+  format.setDepthBufferSize(24);
+  format.setSamples(4);
+  setFormat(format);
+}
+
+RenderWidget::~RenderWidget()
+{
+  makeCurrent();
+  renderer_.cleanup();
+  doneCurrent();
+}
+
+void RenderWidget::setScene(RenderScene::Ptr scene)
+{
+  scene_ = std::move(scene);
+  update();
+}
+
+RenderScene::Ptr RenderWidget::getScene() const { return scene_; }
+
+Camera& RenderWidget::getCamera() { return camera_; }
+
+const Camera& RenderWidget::getCamera() const { return camera_; }
+
+SceneRenderer& RenderWidget::getRenderer() { return renderer_; }
+
+bool RenderWidget::isInstrumentationOverlayVisible() const { return instrumentation_overlay_->isVisible(); }
+
+void RenderWidget::setInstrumentationOverlayVisible(bool visible) { instrumentation_overlay_->setVisible(visible); }
+
+void RenderWidget::initializeGL() { renderer_.initialize(); }
+
+void RenderWidget::paintGL()
+{
+  if (scene_ == nullptr)
+    return;
+
+  const qreal ratio = devicePixelRatioF();
+  renderer_.render(*scene_,
+                   camera_,
+                   static_cast<int>(std::lround(width() * ratio)),
+                   static_cast<int>(std::lround(height() * ratio)));
+}
+
+void RenderWidget::mousePressEvent(QMouseEvent* event) { last_mouse_position_ = event->pos(); }
+
+void RenderWidget::mouseMoveEvent(QMouseEvent* event)
+{
+  const QPoint delta = event->pos() - last_mouse_position_;
+  last_mouse_position_ = event->pos();
+
+  if ((event->buttons() & Qt::LeftButton) != 0U)
+    camera_.orbit(-0.01F * static_cast<float>(delta.x()), 0.01F * static_cast<float>(delta.y()));
+  else if ((event->buttons() & Qt::MiddleButton) != 0U)
+    camera_.pan(-static_cast<float>(delta.x()) / static_cast<float>(std::max(1, height())),
+                static_cast<float>(delta.y()) / static_cast<float>(std::max(1, height())));
+  else
+    return;
+
+  update();
+}
+
+void RenderWidget::wheelEvent(QWheelEvent* event)
+{
+  camera_.zoom(std::pow(0.999F, static_cast<float>(event->angleDelta().y())));
+  update();
+}
+
+void RenderWidget::keyPressEvent(QKeyEvent* event)
+{
+  if (event->key() != Qt::Key_F3)
+  {
+    QOpenGLWidget::keyPressEvent(event);
+    return;
+  }
+
+  if (event->modifiers().testFlag(Qt::ShiftModifier))
+    saveInstrumentationTrace();
+  else
+    setInstrumentationOverlayVisible(!isInstrumentationOverlayVisible());
+}
+
+void RenderWidget::saveInstrumentationTrace()
+{
+  const QString path = QFileDialog::getSaveFileName(this, "Save Trace", "trace.json", "Chrome trace (*.json)");
+  if (path.isEmpty())
+    return;
+
+  try
+  {
+    Instrumentation::instance().saveChromeTrace(path.toStdString());
+  }
+  catch (const std::exception& e)
+  {
+    QMessageBox::warning(this, "Save Trace", QString::fromStdString(e.what()));
+  }
+}
+
+}  // namespace tesseract_gui
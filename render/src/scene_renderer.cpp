@@ -0,0 +1,479 @@
+/**
+ * @file scene_renderer.cpp
+ * @brief Draws a render scene with OpenGL
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <unordered_set>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/common/instrumentation.h>
+#include <tesseract_gui/render/scene_renderer.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+const char* VERTEX_SHADER = R"(
+#version 330 core
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec3 normal;
+
+uniform mat4 view_projection;
+uniform mat4 local_transform;
+uniform int link_index;
+uniform sampler2D link_transforms;
+uniform int links_per_row;
+
+out vec3 world_normal;
+
+mat4 fetchLinkTransform(int index)
+{
+  ivec2 texel = ivec2((index % links_per_row) * 4, index / links_per_row);
+  return mat4(texelFetch(link_transforms, texel, 0),
+              texelFetch(link_transforms, texel + ivec2(1, 0), 0),
+              texelFetch(link_transforms, texel + ivec2(2, 0), 0),
+              texelFetch(link_transforms, texel + ivec2(3, 0), 0));
+}
+
+void main()
+{
+  mat4 model = fetchLinkTransform(link_index) * local_transform;
+  world_normal = mat3(model) * normal;
+  gl_Position = view_projection * model * vec4(position, 1.0);
+}
+)";
+
+const char* FRAGMENT_SHADER = R"(
+#version 330 core
+in vec3 world_normal;
+
+uniform vec4 color;
+uniform vec3 light_direction;
+
+out vec4 fragment_color;
+
+void main()
+{
+  vec3 n = normalize(world_normal);
+  if (!gl_FrontFacing)
+    n = -n;
+  float diffuse = max(dot(n, -light_direction), 0.0);
+  fragment_color = vec4(color.rgb * (0.3 + 0.7 * diffuse), color.a);
+}
+)";
+}  // namespace
+
+// GPU resources can only be released with the context current, owners must call cleanup() before destruction
+SceneRenderer::~SceneRenderer() = default;
+
+void SceneRenderer::initialize()
+{
+  if (initialized_)
+    return;
+
+  initializeOpenGLFunctions();
+
+  program_ = std::make_unique<QOpenGLShaderProgram>();
+  if (!program_->addShaderFromSourceCode(QOpenGLShader::Vertex, VERTEX_SHADER) ||
+      !program_->addShaderFromSourceCode(QOpenGLShader::Fragment, FRAGMENT_SHADER) || !program_->link())
+    throw std::runtime_error("SceneRenderer, failed to build shader program: " + program_->log().toStdString());
+
+  view_projection_location_ = program_->uniformLocation("view_projection");
+  local_transform_location_ = program_->uniformLocation("local_transform");
+  link_index_location_ = program_->uniformLocation("link_index");
+  link_transforms_location_ = program_->uniformLocation("link_transforms");
+  links_per_row_location_ = program_->uniformLocation("links_per_row");
+  color_location_ = program_->uniformLocation("color");
+  light_direction_location_ = program_->uniformLocation("light_direction");
+
+  glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_texture_size_);
+  glGenTextures(1, &link_texture_);
+  glBindTexture(GL_TEXTURE_2D, link_texture_);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  initialized_ = true;
+}
+
+void SceneRenderer::cleanup()
+{
+  if (!initialized_)
+    return;
+
+  for (auto& mesh : meshes_)
+    releaseMesh(mesh.second);
+  meshes_.clear();
+
+  for (auto& overlay : overlays_)
+  {
+    if (overlay.initialized)
+      overlay.overlay->cleanup(*this);
+    overlay.initialized = false;
+  }
+
+  glDeleteTextures(1, &link_texture_);
+  link_texture_ = 0;
+  link_texture_width_ = 0;
+  link_texture_rows_ = 0;
+  program_.reset();
+  uploaded_scene_ = nullptr;
+  initialized_ = false;
+}
+
+bool SceneRenderer::isInitialized() const { return initialized_; }
+
+void SceneRenderer::setBackgroundColor(const Eigen::Vector4f& color) { background_color_ = color; }
+
+void SceneRenderer::setLodEnabled(bool enabled) { lod_enabled_ = enabled; }
+
+bool SceneRenderer::isLodEnabled() const { return lod_enabled_; }
+
+void SceneRenderer::setLodPixelsPerTriangle(float pixels) { lod_pixels_per_triangle_ = std::max(pixels, 0.1F); }
+
+float SceneRenderer::getLodPixelsPerTriangle() const { return lod_pixels_per_triangle_; }
+
+std::size_t SceneRenderer::getMeshCount() const { return meshes_.size(); }
+
+void SceneRenderer::addOverlay(RenderOverlay::Ptr overlay)
+{
+  if (overlay == nullptr)
+    throw std::runtime_error("SceneRenderer, overlay is a nullptr!");
+
+  overlays_.push_back({ std::move(overlay), false });
+}
+
+void SceneRenderer::removeOverlay(const RenderOverlay::Ptr& overlay)
+{
+  auto it = std::find_if(
+      overlays_.begin(), overlays_.end(), [&overlay](const Overlay& entry) { return entry.overlay == overlay; });
+  if (it == overlays_.end())
+    return;
+
+  if (it->initialized)
+    it->overlay->cleanup(*this);
+  overlays_.erase(it);
+}
+
+std::vector<RenderOverlay::Ptr> SceneRenderer::getOverlays() const
+{
+  std::vector<RenderOverlay::Ptr> overlays;
+  overlays.reserve(overlays_.size());
+  for (const auto& entry : overlays_)
+    overlays.push_back(entry.overlay);
+  return overlays;
+}
+
+void SceneRenderer::render(const RenderScene& scene, const Camera& camera, int width, int height)
+{
+  const ScopedTimer timer("render", "frame");
+  if (!initialized_)
+    initialize();
+
+  glViewport(0, 0, width, height);
+  glClearColor(background_color_.x(), background_color_.y(), background_color_.z(), background_color_.w());
+  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+  const bool scene_changed = (&scene != uploaded_scene_ || scene.getRevision() != uploaded_revision_);
+  if (scene_changed)
+    releaseUnusedMeshes(scene);
+
+  if (scene_changed || scene.getTransformRevision() != uploaded_transform_revision_)
+    uploadLinkTransforms(scene);
+
+  uploaded_scene_ = &scene;
+  uploaded_revision_ = scene.getRevision();
+  uploaded_transform_revision_ = scene.getTransformRevision();
+
+  const float aspect_ratio = (height > 0) ? static_cast<float>(width) / static_cast<float>(height) : 1.0F;
+  const Eigen::Matrix4f view_projection = camera.getProjectionMatrix(aspect_ratio) * camera.getViewMatrix();
+  if (scene.getLinkNames().empty())
+  {
+    drawOverlays(view_projection, camera);
+    return;
+  }
+
+  const Eigen::Vector3f light_direction = (camera.getTarget() - camera.getEye()).normalized();
+  eye_ = camera.getEye();
+  pixels_per_unit_at_unit_distance_ = static_cast<float>(height) / (2.0F * std::tan(camera.getFieldOfView() / 2.0F));
+
+  glEnable(GL_DEPTH_TEST);
+  program_->bind();
+  glUniformMatrix4fv(view_projection_location_, 1, GL_FALSE, view_projection.data());
+  glUniform3fv(light_direction_location_, 1, light_direction.data());
+  glActiveTexture(GL_TEXTURE0);
+  glBindTexture(GL_TEXTURE_2D, link_texture_);
+  glUniform1i(link_transforms_location_, 0);
+  glUniform1i(links_per_row_location_, static_cast<GLint>(link_texture_width_));
+
+  drawObjects(scene, false);
+
+  glEnable(GL_BLEND);
+  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  glDepthMask(GL_FALSE);
+  drawObjects(scene, true);
+  drawGhosts(scene);
+  glDepthMask(GL_TRUE);
+  glDisable(GL_BLEND);
+
+  glBindVertexArray(0);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  program_->release();
+
+  drawOverlays(view_projection, camera);
+}
+
+const SceneRenderer::GpuMesh& SceneRenderer::getGpuMesh(const MeshBuffers::ConstPtr& mesh)
+{
+  auto it = meshes_.find(mesh.get());
+  if (it != meshes_.end())
+    return it->second;
+
+  GpuMesh gpu_mesh;
+  gpu_mesh.source = mesh;
+  gpu_mesh.index_count = static_cast<GLsizei>(mesh->indices.size());
+
+  glGenVertexArrays(1, &gpu_mesh.vao);
+  glBindVertexArray(gpu_mesh.vao);
+
+  glGenBuffers(1, &gpu_mesh.vbo);
+  glBindBuffer(GL_ARRAY_BUFFER, gpu_mesh.vbo);
+  glBufferData(GL_ARRAY_BUFFER,
+               static_cast<GLsizeiptr>(mesh->vertices.size() * sizeof(float)),
+               mesh->vertices.data(),
+               GL_STATIC_DRAW);
+
+  glGenBuffers(1, &gpu_mesh.ibo);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gpu_mesh.ibo);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+               static_cast<GLsizeiptr>(mesh->indices.size() * sizeof(std::uint32_t)),
+               mesh->indices.data(),
+               GL_STATIC_DRAW);
+
+  const auto stride = static_cast<GLsizei>(MeshBuffers::VERTEX_STRIDE * sizeof(float));
+  glEnableVertexAttribArray(0);
+  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, nullptr);
+  glEnableVertexAttribArray(1);
+  glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const void*>(3 * sizeof(float)));
+
+  glBindVertexArray(0);
+  return meshes_.emplace(mesh.get(), std::move(gpu_mesh)).first->second;
+}
+
+void SceneRenderer::releaseMesh(GpuMesh& mesh)
+{
+  glDeleteBuffers(1, &mesh.vbo);
+  glDeleteBuffers(1, &mesh.ibo);
+  glDeleteVertexArrays(1, &mesh.vao);
+  mesh.source.reset();
+}
+
+void SceneRenderer::releaseUnusedMeshes(const RenderScene& scene)
+{
+  std::unordered_set<const MeshBuffers*> used;
+  used.reserve(scene.getObjects().size());
+  for (const auto& object : scene.getObjects())
+  {
+    used.insert(object.mesh.get());
+    if (object.lod != nullptr)
+    {
+      for (std::size_t level = 0; level < object.lod->getLevelCount(); ++level)
+        used.insert(object.lod->getLevel(level).get());
+    }
+  }
+
+  for (auto it = meshes_.begin(); it != meshes_.end();)
+  {
+    if (used.count(it->first) == 0)
+    {
+      releaseMesh(it->second);
+      it = meshes_.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+void SceneRenderer::uploadLinkTransforms(const RenderScene& scene)
+{
+  // The links of every ghost follow the scene links, the shader offsets the link index by the ghost
+  const std::size_t link_count = scene.getLinkNames().size();
+  drawn_ghost_count_ = 0;
+  if (link_count == 0)
+    return;
+
+  // Links wrap into rows of four texels per link, so the texture stays within the size limits of the driver
+  const auto max_size = static_cast<std::size_t>(std::max(max_texture_size_, 4));
+  const std::size_t max_links_per_row = max_size / 4;
+  const std::size_t max_link_count = max_links_per_row * max_size;
+  const std::size_t scene_copies = max_link_count / link_count;
+  drawn_ghost_count_ = std::min(scene.getGhostCount(), (scene_copies > 0) ? scene_copies - 1 : 0);
+  if (drawn_ghost_count_ < scene.getGhostCount())
+    recordCounter("render", "dropped ghosts", static_cast<std::int64_t>(scene.getGhostCount() - drawn_ghost_count_));
+
+  const std::size_t count = std::min(link_count * (1 + drawn_ghost_count_), max_link_count);
+  glBindTexture(GL_TEXTURE_2D, link_texture_);
+  if (count > link_texture_width_ * link_texture_rows_)
+  {
+    // Grow with some headroom so adding links one at a time does not reallocate every frame
+    const std::size_t capacity = std::min(count + (count / 2), max_link_count);
+    link_texture_width_ = std::min(capacity, max_links_per_row);
+    link_texture_rows_ = (capacity + link_texture_width_ - 1) / link_texture_width_;
+    glTexImage2D(GL_TEXTURE_2D,
+                 0,
+                 GL_RGBA32F,
+                 static_cast<GLsizei>(4 * link_texture_width_),
+                 static_cast<GLsizei>(link_texture_rows_),
+                 0,
+                 GL_RGBA,
+                 GL_FLOAT,
+                 nullptr);
+  }
+
+  uploadLinkRange(0, std::min(link_count, count), scene.getLinkTransforms().data());
+  if (drawn_ghost_count_ > 0)
+    uploadLinkRange(link_count, count - link_count, scene.getGhostLinkTransforms().data());
+  glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void SceneRenderer::uploadLinkRange(std::size_t first, std::size_t count, const float* data)
+{
+  // A range starts and ends with partial rows, the full rows in between are uploaded at once
+  const std::size_t width = link_texture_width_;
+  while (count > 0)
+  {
+    const std::size_t column = first % width;
+    const std::size_t row = first / width;
+    std::size_t uploaded{ 0 };
+    if (column == 0 && count >= width)
+    {
+      const std::size_t rows = count / width;
+      uploaded = rows * width;
+      glTexSubImage2D(GL_TEXTURE_2D,
+                      0,
+                      0,
+                      static_cast<GLint>(row),
+                      static_cast<GLsizei>(4 * width),
+                      static_cast<GLsizei>(rows),
+                      GL_RGBA,
+                      GL_FLOAT,
+                      data);
+    }
+    else
+    {
+      uploaded = std::min(width - column, count);
+      glTexSubImage2D(GL_TEXTURE_2D,
+                      0,
+                      static_cast<GLint>(4 * column),
+                      static_cast<GLint>(row),
+                      static_cast<GLsizei>(4 * uploaded),
+                      1,
+                      GL_RGBA,
+                      GL_FLOAT,
+                      data);
+    }
+
+    first += uploaded;
+    count -= uploaded;
+    data += uploaded * LinkTransformBatch::MATRIX_SIZE;
+  }
+}
+
+void SceneRenderer::drawObjects(const RenderScene& scene, bool transparent)
+{
+  const tesseract_common::AlignedVector<Eigen::Vector4f>& link_colors = scene.getLinkColors();
+  for (const auto& object : scene.getObjects())
+  {
+    if (!scene.isVisible(object.type) || (object.color.w() < 1.0F) != transparent)
+      continue;
+
+    Eigen::Vector4f color = object.color;
+    if (!link_colors.empty() && object.type == RenderObjectType::VISUAL)
+    {
+      const Eigen::Vector4f& link_color = link_colors[static_cast<std::size_t>(object.link_index)];
+      color.head<3>() += link_color.w() * (link_color.head<3>() - color.head<3>());
+    }
+
+    const GpuMesh& mesh = getGpuMesh(selectMesh(scene, object));
+    glUniformMatrix4fv(local_transform_location_, 1, GL_FALSE, object.local_transform.data());
+    glUniform1i(link_index_location_, object.link_index);
+    glUniform4fv(color_location_, 1, color.data());
+    glBindVertexArray(mesh.vao);
+    glDrawElements(GL_TRIANGLES, mesh.index_count, GL_UNSIGNED_INT, nullptr);
+  }
+}
+
+void SceneRenderer::drawGhosts(const RenderScene& scene)
+{
+  const auto link_count = static_cast<int>(scene.getLinkNames().size());
+  for (std::size_t g = 0; g < drawn_ghost_count_; ++g)
+  {
+    const int link_offset = static_cast<int>(g + 1) * link_count;
+    glUniform4fv(color_location_, 1, scene.getGhostColors()[g].data());
+    for (const auto& object : scene.getObjects())
+    {
+      if (object.type != RenderObjectType::VISUAL || !scene.isGhostLink(object.link_index))
+        continue;
+
+      // The level of detail of the scene object, ghosts are usually close to it and only seen through
+      const GpuMesh& mesh = getGpuMesh(selectMesh(scene, object));
+      glUniformMatrix4fv(local_transform_location_, 1, GL_FALSE, object.local_transform.data());
+      glUniform1i(link_index_location_, object.link_index + link_offset);
+      glBindVertexArray(mesh.vao);
+      glDrawElements(GL_TRIANGLES, mesh.index_count, GL_UNSIGNED_INT, nullptr);
+    }
+  }
+}
+
+void SceneRenderer::drawOverlays(const Eigen::Matrix4f& view_projection, const Camera& camera)
+{
+  glEnable(GL_DEPTH_TEST);
+  for (auto& overlay : overlays_)
+  {
+    if (!overlay.initialized)
+    {
+      overlay.overlay->initialize(*this);
+      overlay.initialized = true;
+    }
+    overlay.overlay->render(*this, view_projection, camera);
+  }
+}
+
+const MeshBuffers::ConstPtr& SceneRenderer::selectMesh(const RenderScene& scene, const RenderObject& object) const
+{
+  if (!lod_enabled_ || object.lod == nullptr || object.lod->getLevelCount() == 1)
+    return object.mesh;
+
+  const Eigen::Map<const Eigen::Matrix4f> link_transform(scene.getLinkTransforms().data() +
+                                                         (static_cast<std::size_t>(object.link_index) *
+                                                          LinkTransformBatch::MATRIX_SIZE));
+  const Eigen::Vector3f center =
+      (link_transform * object.local_transform * object.lod->getCenter().homogeneous()).head<3>();
+  const float distance = (center - eye_).norm();
+  if (distance <= object.lod->getRadius())
+    return object.mesh;
+
+  const float screen_diameter = 2.0F * object.lod->getRadius() * pixels_per_unit_at_unit_distance_ / distance;
+  return object.lod->getLevel(object.lod->selectLevel(screen_diameter, lod_pixels_per_triangle_));
+}
+
+}  // namespace tesseract_gui
@@ -0,0 +1,80 @@
+/**
+ * @file scene_state_updater.cpp
+ * @brief Applies joint values to the link transforms of a render scene
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <stdexcept>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/common/instrumentation.h>
+#include <tesseract_gui/render/scene_state_updater.h>
+
+namespace tesseract_gui
+{
+SceneStateUpdater::SceneStateUpdater(QObject* parent) : QObject(parent) {}
+
+void SceneStateUpdater::setScene(RenderScene::Ptr scene)
+{
+  scene_ = std::move(scene);
+  updateScene();
+}
+
+RenderScene::Ptr SceneStateUpdater::getScene() const { return scene_; }
+
+void SceneStateUpdater::setEnvironment(const tesseract_environment::Environment& environment)
+{
+  tesseract_scene_graph::StateSolver::UPtr solver = environment.getStateSolver();
+  if (solver == nullptr)
+    throw std::runtime_error("SceneStateUpdater, environment has no state solver!");
+
+  solver_ = std::move(solver);
+  const std::vector<std::string> joint_names = solver_->getJointNames();
+  joint_names_ = std::unordered_set<std::string>(joint_names.begin(), joint_names.end());
+  updateScene();
+}
+
+void SceneStateUpdater::setJointValues(const std::unordered_map<std::string, double>& joint_values)
+{
+  if (solver_ == nullptr)
+    return;
+
+  // Some state solvers throw for unknown joints
+  known_values_.clear();
+  for (const auto& joint_value : joint_values)
+  {
+    if (joint_names_.count(joint_value.first) != 0)
+      known_values_.insert(joint_value);
+  }
+
+  if (known_values_.empty())
+    return;
+
+  const ScopedTimer timer("render", "scene state");
+  solver_->setState(known_values_);
+  updateScene();
+}
+
+void SceneStateUpdater::updateScene()
+{
+  if (scene_ == nullptr || solver_ == nullptr)
+    return;
+
+  scene_->updateLinkTransforms(solver_->getState());
+  emit sceneChanged();
+}
+
+}  // namespace tesseract_gui
@@ -0,0 +1,186 @@
+/**
+ * @file scene_graph_model.h
+ * @brief A lazily populated Qt item model wrapping a tesseract scene graph
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#ifndef TESSERACT_GUI_SCENE_GRAPH_SCENE_GRAPH_MODEL_H
+#define TESSERACT_GUI_SCENE_GRAPH_SCENE_GRAPH_MODEL_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <memory>
+#include <string>
+#include <vector>
+#include <QAbstractItemModel>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_scene_graph/graph.h>
+
+namespace tesseract_gui
+{
+/**
+ * @brief A tree model over a tesseract scene graph which only materializes rows when a view asks for them
+ *
+ * The top level contains a "Links" and a "Joints" category. Category rows are handed out in batches of
+ * getFetchBatchSize() through canFetchMore()/fetchMore(), and the children of a link or joint (visuals, collisions,
+ * inertial and their properties) are only created once that row is expanded. Nothing is copied out of the scene
+ * graph; nodes reference the links and joints through their shared pointers and format values on demand in data().
+ *
+ * The links and joints must not be mutated while the model references them. When the data originates from a live
+ * environment pass a clone of its scene graph and apply changes through addLink()/removeLink()/addJoint()/removeJoint()
+ * using new link and joint objects. These only emit row insert/remove and dataChanged signals for the affected rows
+ * so expanded rows and the selection in attached views are preserved.
+ */
+class SceneGraphModel : public QAbstractItemModel
+{
+  Q_OBJECT
+
+public:
+  enum Column
+  {
+    NAME_COLUMN = 0,
+    VALUE_COLUMN = 1,
+    COLUMN_COUNT = 2
+  };
+
+  enum class NodeType
+  {
+    ROOT,
+    LINKS,
+    JOINTS,
+    LINK,
+    JOINT,
+    VISUALS,
+    COLLISIONS,
+    VISUAL,
+    COLLISION,
+    INERTIAL,
+    PROPERTY
+  };
+
+  enum Role
+  {
+    /** @brief The NodeType of the row as an int */
+    NodeTypeRole = Qt::UserRole + 1,
+    /** @brief The name of the link or joint the row belongs to */
+    NameRole
+  };
+
+  explicit SceneGraphModel(QObject* parent = nullptr);
+  ~SceneGraphModel() override;
+  SceneGraphModel(const SceneGraphModel&) = delete;
+  SceneGraphModel& operator=(const SceneGraphModel&) = delete;
+  SceneGraphModel(SceneGraphModel&&) = delete;
+  SceneGraphModel& operator=(SceneGraphModel&&) = delete;
+
+  /**
+   * @brief Reset the model to show the provided scene graph
+   * @param scene_graph The scene graph, if nullptr the model is cleared
+   */
+  void setSceneGraph(const tesseract_scene_graph::SceneGraph::ConstPtr& scene_graph);
+
+  /** @brief Remove all rows */
+  void clear();
+
+  /**
+   * @brief Add a link, replacing the link with the same name if it exists
+   * @param link The link, it must not be mutated afterwards
+   */
+  void addLink(const tesseract_scene_graph::Link::ConstPtr& link);
+
+  /**
+   * @brief Remove a link, this does not remove the joints attached to it
+   * @param name The name of the link
+   */
+  void removeLink(const std::string& name);
+
+  /**
+   * @brief Add a joint, replacing the joint with the same name if it exists
+   * @param joint The joint, it must not be mutated afterwards
+   */
+  void addJoint(const tesseract_scene_graph::Joint::ConstPtr& joint);
+
+  /**
+   * @brief Remove a joint, this does not remove the links attached to it
+   * @param name The name of the joint
+   */
+  void removeJoint(const std::string& name);
+
+  /**
+   * @brief Get a link by name
+   * @return The link, nullptr if it does not exist
+   */
+  tesseract_scene_graph::Link::ConstPtr getLink(const std::string& name) const;
+
+  /**
+   * @brief Get a joint by name
+   * @return The joint, nullptr if it does not exist
+   */
+  tesseract_scene_graph::Joint::ConstPtr getJoint(const std::string& name) const;
+
+  /** @brief Get all links sorted by name */
+  const std::vector<tesseract_scene_graph::Link::ConstPtr>& getLinks() const;
+
+  /** @brief Get all joints sorted by name */
+  const std::vector<tesseract_scene_graph::Joint::ConstPtr>& getJoints() const;
+
+  /**
+   * @brief Set the number of link or joint rows created per fetchMore() call
+   * @param batch_size The batch size, must be greater than zero
+   */
+  void setFetchBatchSize(int batch_size);
+  int getFetchBatchSize() const;
+
+  /** @brief The number of tree nodes currently materialized */
+  std::size_t getNodeCount() const;
+
+  QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+  QModelIndex parent(const QModelIndex& child) const override;
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+  int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+  bool hasChildren(const QModelIndex& parent = QModelIndex()) const override;
+  bool canFetchMore(const QModelIndex& parent) const override;
+  void fetchMore(const QModelIndex& parent) override;
+  QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+  QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+  Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+private:
+  struct Node;
+
+  std::unique_ptr<Node> root_;
+  std::vector<tesseract_scene_graph::Link::ConstPtr> links_;
+  std::vector<tesseract_scene_graph::Joint::ConstPtr> joints_;
+  int fetch_batch_size_{ 256 };
+  std::size_t node_count_{ 1 };
+
+  Node* getNode(const QModelIndex& index) const;
+  int getChildCapacity(const Node& node) const;
+  void appendChildren(Node& node, int count);
+  Node& getCategory(NodeType type);
+  void emitSubtreeChanged(Node& node);
+
+  template <typename T>
+  void insertElement(NodeType category_type,
+                     std::vector<std::shared_ptr<const T>>& elements,
+                     const std::shared_ptr<const T>& element);
+
+  template <typename T>
+  void removeElement(NodeType category_type, std::vector<std::shared_ptr<const T>>& elements, const std::string& name);
+};
+
+}  // namespace tesseract_gui
+
+#endif  // TESSERACT_GUI_SCENE_GRAPH_SCENE_GRAPH_MODEL_H
@@ -0,0 +1,721 @@
+/**
+ * @file scene_graph_model.cpp
+ * @brief A lazily populated Qt item model wrapping a tesseract scene graph
+ *
+ * @par License
+ * GNU Lesser General Public License Version 2.1, February 1999
+ * @par
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * @par
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <QStringList>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_gui/common/instrumentation.h>
+#include <tesseract_gui/scene_graph/scene_graph_model.h>
+
+namespace tesseract_gui
+{
+namespace
+{
+const std::array<const char*, 6> JOINT_PROPERTIES{ "Type", "Parent Link", "Child Link", "Origin", "Axis", "Limits" };
+const std::array<const char*, 3> VISUAL_PROPERTIES{ "Origin", "Geometry", "Material" };
+const std::array<const char*, 2> COLLISION_PROPERTIES{ "Origin", "Geometry" };
+const std::array<const char*, 3> INERTIAL_PROPERTIES{ "Mass", "Origin", "Inertia" };
+
+QString toQString(const Eigen::Vector3d& v)
+{
+  return QString("[%1, %2, %3]").arg(v.x()).arg(v.y()).arg(v.z());
+}
+
+QString toQString(const Eigen::Isometry3d& origin)
+{
+  Eigen::Vector3d rpy = origin.rotation().eulerAngles(2, 1, 0).reverse();
+  return QString("xyz: %1 rpy: %2").arg(toQString(Eigen::Vector3d(origin.translation())), toQString(rpy));
+}
+
+QString toQString(tesseract_scene_graph::JointType type)
+{
+  switch (type)
+  {
+    case tesseract_scene_graph::JointType::REVOLUTE:
+      return "Revolute";
+    case tesseract_scene_graph::JointType::CONTINUOUS:
+      return "Continuous";
+    case tesseract_scene_graph::JointType::PRISMATIC:
+      return "Prismatic";
+    case tesseract_scene_graph::JointType::FLOATING:
+      return "Floating";
+    case tesseract_scene_graph::JointType::PLANAR:
+      return "Planar";
+    case tesseract_scene_graph::JointType::FIXED:
+      return "Fixed";
+    default:
+      return "Unknown";
+  }
+}
+
+QString toQString(const tesseract_geometry::Geometry::ConstPtr& geometry)
+{
+  if (geometry == nullptr)
+    return "None";
+
+  switch (geometry->getType())
+  {
+    case tesseract_geometry::GeometryType::SPHERE:
+      return "Sphere";
+    case tesseract_geometry::GeometryType::CYLINDER:
+      return "Cylinder";
+    case tesseract_geometry::GeometryType::CAPSULE:
+      return "Capsule";
+    case tesseract_geometry::GeometryType::CONE:
+      return "Cone";
+    case tesseract_geometry::GeometryType::BOX:
+      return "Box";
+    case tesseract_geometry::GeometryType::PLANE:
+      return "Plane";
+    case tesseract_geometry::GeometryType::MESH:
+      return "Mesh";
+    case tesseract_geometry::GeometryType::CONVEX_MESH:
+      return "Convex Mesh";
+    case tesseract_geometry::GeometryType::SDF_MESH:
+      return "SDF Mesh";
+    case tesseract_geometry::GeometryType::OCTREE:
+      return "Octree";
+    default:
+      return "Unknown";
+  }
+}
+
+QString toQString(const tesseract_scene_graph::JointLimits::ConstPtr& limits)
+{
+  if (limits == nullptr)
+    return QString();
+
+  return QString("lower: %1 upper: %2 velocity: %3 effort: %4")
+      .arg(limits->lower)
+      .arg(limits->upper)
+      .arg(limits->velocity)
+      .arg(limits->effort);
+}
+
+QString toQString(const tesseract_scene_graph::Material::ConstPtr& material)
+{
+  if (material == nullptr)
+    return QString();
+
+  Eigen::Vector3d rgb = material->color.head<3>();
+  return QString("%1 rgba: [%2, %3, %4, %5]")
+      .arg(QString::fromStdString(material->getName()))
+      .arg(rgb.x())
+      .arg(rgb.y())
+      .arg(rgb.z())
+      .arg(material->color.w());
+}
+
+QString elementName(const std::string& name, const char* prefix, int index)
+{
+  if (!name.empty())
+    return QString::fromStdString(name);
+
+  return QString("%1 %2").arg(prefix).arg(index);
+}
+
+/** @brief The group rows of a link in display order, only groups with content are shown */
+std::vector<SceneGraphModel::NodeType> getLinkGroups(const tesseract_scene_graph::Link& link)
+{
+  std::vector<SceneGraphModel::NodeType> groups;
+  groups.reserve(3);
+  if (!link.visual.empty())
+    groups.push_back(SceneGraphModel::NodeType::VISUALS);
+  if (!link.collision.empty())
+    groups.push_back(SceneGraphModel::NodeType::COLLISIONS);
+  if (link.inertial != nullptr)
+    groups.push_back(SceneGraphModel::NodeType::INERTIAL);
+  return groups;
+}
+
+template <typename Container>
+auto findByName(Container& elements, const std::string& name)
+{
+  return std::lower_bound(
+      elements.begin(), elements.end(), name, [](const auto& e, const std::string& n) { return e->getName() < n; });
+}
+}  // namespace
+
+struct SceneGraphModel::Node
+{
+  Node(NodeType type, Node* parent, int row) : type(type), parent(parent), row(row) {}
+
+  NodeType type;
+  Node* parent;
+  int row;
+
+  /** @brief The visual/collision index for VISUAL and COLLISION nodes, the property index for PROPERTY nodes */
+  int element{ -1 };
+
+  /** @brief Only set for LINK nodes, descendants look it up through getOwner() */
+  tesseract_scene_graph::Link::ConstPtr link;
+
+  /** @brief Only set for JOINT nodes, descendants look it up through getOwner() */
+  tesseract_scene_graph::Joint::ConstPtr joint;
+
+  std::vector<std::unique_ptr<Node>> children;
+
+  /** @brief Get the LINK or JOINT node this node belongs to, nullptr for categories */
+  const Node* getOwner() const
+  {
+    const Node* n = this;
+    while (n != nullptr && n->type != NodeType::LINK && n->type != NodeType::JOINT)
+      n = n->parent;
+    return n;
+  }
+
+  /** @brief The number of nodes in this subtree including this node */
+  std::size_t getSubtreeSize() const
+  {
+    std::size_t size = 1;
+    for (const auto& child : children)
+      size += child->getSubtreeSize();
+    return size;
+  }
+
+  void setElement(const tesseract_scene_graph::Link::ConstPtr& element) { link = element; }
+  void setElement(const tesseract_scene_graph::Joint::ConstPtr& element) { joint = element; }
+
+  void renumberChildren(std::size_t first)
+  {
+    for (std::size_t i = first; i < children.size(); ++i)
+      children[i]->row = static_cast<int>(i);
+  }
+};
+
+SceneGraphModel::SceneGraphModel(QObject* parent)
+  : QAbstractItemModel(parent), root_(std::make_unique<Node>(NodeType::ROOT, nullptr, 0))
+{
+}
+
+SceneGraphModel::~SceneGraphModel() = default;
+
+void SceneGraphModel::setSceneGraph(const tesseract_scene_graph::SceneGraph::ConstPtr& scene_graph)
+{
+  const ScopedTimer timer("scene_graph", "set scene graph");
+  if (scene_graph == nullptr)
+  {
+    clear();
+    return;
+  }
+
+  beginResetModel();
+  root_ = std::make_unique<Node>(NodeType::ROOT, nullptr, 0);
+
+  links_ = scene_graph->getLinks();
+  std::sort(links_.begin(), links_.end(), [](const auto& a, const auto& b) { return a->getName() < b->getName(); });
+
+  joints_ = scene_graph->getJoints();
+  std::sort(joints_.begin(), joints_.end(), [](const auto& a, const auto& b) { return a->getName() < b->getName(); });
+
+  root_->children.push_back(std::make_unique<Node>(NodeType::LINKS, root_.get(), 0));
+  root_->children.push_back(std::make_unique<Node>(NodeType::JOINTS, root_.get(), 1));
+  node_count_ = 3;
+  endResetModel();
+}
+
+void SceneGraphModel::clear()
+{
+  beginResetModel();
+  root_ = std::make_unique<Node>(NodeType::ROOT, nullptr, 0);
+  links_.clear();
+  joints_.clear();
+  node_count_ = 1;
+  endResetModel();
+}
+
+void SceneGraphModel::addLink(const tesseract_scene_graph::Link::ConstPtr& link)
+{
+  insertElement(NodeType::LINKS, links_, link);
+}
+
+void SceneGraphModel::removeLink(const std::string& name) { removeElement(NodeType::LINKS, links_, name); }
+
+void SceneGraphModel::addJoint(const tesseract_scene_graph::Joint::ConstPtr& joint)
+{
+  insertElement(NodeType::JOINTS, joints_, joint);
+}
+
+void SceneGraphModel::removeJoint(const std::string& name) { removeElement(NodeType::JOINTS, joints_, name); }
+
+tesseract_scene_graph::Link::ConstPtr SceneGraphModel::getLink(const std::string& name) const
+{
+  auto it = findByName(links_, name);
+  if (it == links_.end() || (*it)->getName() != name)
+    return nullptr;
+
+  return *it;
+}
+
+tesseract_scene_graph::Joint::ConstPtr SceneGraphModel::getJoint(const std::string& name) const
+{
+  auto it = findByName(joints_, name);
+  if (it == joints_.end() || (*it)->getName() != name)
+    return nullptr;
+
+  return *it;
+}
+
+const std::vector<tesseract_scene_graph::Link::ConstPtr>& SceneGraphModel::getLinks() const { return links_; }
+
+const std::vector<tesseract_scene_graph::Joint::ConstPtr>& SceneGraphModel::getJoints() const { return joints_; }
+
+void SceneGraphModel::setFetchBatchSize(int batch_size)
+{
+  if (batch_size <= 0)
+    throw std::runtime_error("SceneGraphModel, fetch batch size must be greater than zero!");
+
+  fetch_batch_size_ = batch_size;
+}
+
+int SceneGraphModel::getFetchBatchSize() const { return fetch_batch_size_; }
+
+std::size_t SceneGraphModel::getNodeCount() const { return node_count_; }
+
+QModelIndex SceneGraphModel::index(int row, int column, const QModelIndex& parent) const
+{
+  if (row < 0 || column < 0 || column >= COLUMN_COUNT || parent.column() > 0)
+    return {};
+
+  Node* parent_node = getNode(parent);
+  if (row >= static_cast<int>(parent_node->children.size()))
+    return {};
+
+  return createIndex(row, column, parent_node->children[static_cast<std::size_t>(row)].get());
+}
+
+QModelIndex SceneGraphModel::parent(const QModelIndex& child) const
+{
+  if (!child.isValid())
+    return {};
+
+  Node* parent_node = getNode(child)->parent;
+  if (parent_node == nullptr || parent_node == root_.get())
+    return {};
+
+  return createIndex(parent_node->row, 0, parent_node);
+}
+
+int SceneGraphModel::rowCount(const QModelIndex& parent) const
+{
+  if (parent.column() > 0)
+    return 0;
+
+  return static_cast<int>(getNode(parent)->children.size());
+}
+
+int SceneGraphModel::columnCount(const QModelIndex& /*parent*/) const { return COLUMN_COUNT; }
+
+bool SceneGraphModel::hasChildren(const QModelIndex& parent) const
+{
+  if (parent.column() > 0)
+    return false;
+
+  return getChildCapacity(*getNode(parent)) > 0;
+}
+
+bool SceneGraphModel::canFetchMore(const QModelIndex& parent) const
+{
+  if (parent.column() > 0)
+    return false;
+
+  const Node* node = getNode(parent);
+  return static_cast<int>(node->children.size()) < getChildCapacity(*node);
+}
+
+void SceneGraphModel::fetchMore(const QModelIndex& parent)
+{
+  if (parent.column() > 0)
+    return;
+
+  Node* node = getNode(parent);
+  const int first = static_cast<int>(node->children.size());
+  int count = getChildCapacity(*node) - first;
+  if (count <= 0)
+    return;
+
+  // Only the categories can be large, everything below a link or joint is a handful of rows
+  if (node->type == NodeType::LINKS || node->type == NodeType::JOINTS)
+    count = std::min(count, fetch_batch_size_);
+
+  beginInsertRows(parent, first, first + count - 1);
+  appendChildren(*node, count);
+  endInsertRows();
+}
+
+QVariant SceneGraphModel::data(const QModelIndex& index, int role) const
+{
+  if (!index.isValid())
+    return {};
+
+  const Node* node = getNode(index);
+  if (role == NodeTypeRole)
+    return static_cast<int>(node->type);
+
+  const Node* owner = node->getOwner();
+  if (role == NameRole)
+  {
+    if (owner == nullptr)
+      return {};
+
+    return QString::fromStdString(owner->type == NodeType::LINK ? owner->link->getName() : owner->joint->getName());
+  }
+
+  if (role != Qt::DisplayRole)
+    return {};
+
+  const bool name_column = (index.column() == NAME_COLUMN);
+  switch (node->type)
+  {
+    case NodeType::LINKS:
+      return name_column ? QVariant("Links") : QVariant(static_cast<qulonglong>(links_.size()));
+    case NodeType::JOINTS:
+      return name_column ? QVariant("Joints") : QVariant(static_cast<qulonglong>(joints_.size()));
+    case NodeType::LINK:
+      return name_column ? QVariant(QString::fromStdString(node->link->getName())) : QVariant();
+    case NodeType::JOINT:
+      return name_column ? QVariant(QString::fromStdString(node->joint->getName())) :
+                           QVariant(toQString(node->joint->type));
+    case NodeType::VISUALS:
+      return name_column ? QVariant("Visuals") : QVariant(static_cast<qulonglong>(owner->link->visual.size()));
+    case NodeType::COLLISIONS:
+      return name_column ? QVariant("Collisions") : QVariant(static_cast<qulonglong>(owner->link->collision.size()));
+    case NodeType::VISUAL:
+    {
+      const auto& visual = owner->link->visual[static_cast<std::size_t>(node->element)];
+      return name_column ? QVariant(elementName(visual->name, "Visual", node->element)) :
+                           QVariant(toQString(visual->geometry));
+    }
+    case NodeType::COLLISION:
+    {
+      const auto& collision = owner->link->collision[static_cast<std::size_t>(node->element)];
+      return name_column ? QVariant(elementName(collision->name, "Collision", node->element)) :
+                           QVariant(toQString(collision->geometry));
+    }
+    case NodeType::INERTIAL:
+      return name_column ? QVariant("Inertial") : QVariant(owner->link->inertial->mass);
+    case NodeType::PROPERTY:
+      break;
+    default:
+      return {};
+  }
+
+  const auto property = static_cast<std::size_t>(node->element);
+  switch (node->parent->type)
+  {
+    case NodeType::JOINT:
+    {
+      if (name_column)
+        return JOINT_PROPERTIES[property];
+
+      const auto& joint = owner->joint;
+      switch (property)
+      {
+        case 0:
+          return toQString(joint->type);
+        case 1:
+          return QString::fromStdString(joint->parent_link_name);
+        case 2:
+          return QString::fromStdString(joint->child_link_name);
+        case 3:
+          return toQString(joint->parent_to_joint_origin_transform);
+        case 4:
+          return toQString(joint->axis);
+        default:
+          return toQString(joint->limits);
+      }
+    }
+    case NodeType::VISUAL:
+    {
+      if (name_column)
+        return VISUAL_PROPERTIES[property];
+
+      const auto& visual = owner->link->visual[static_cast<std::size_t>(node->parent->element)];
+      switch (property)
+      {
+        case 0:
+          return toQString(visual->origin);
+        case 1:
+          return toQString(visual->geometry);
+        default:
+          return toQString(visual->material);
+      }
+    }
+    case NodeType::COLLISION:
+    {
+      if (name_column)
+        return COLLISION_PROPERTIES[property];
+
+      const auto& collision = owner->link->collision[static_cast<std::size_t>(node->parent->element)];
+      return (property == 0) ? toQString(collision->origin) : toQString(collision->geometry);
+    }
+    case NodeType::INERTIAL:
+    {
+      if (name_column)
+        return INERTIAL_PROPERTIES[property];
+
+      const auto& inertial = owner->link->inertial;
+      switch (property)
+      {
+        case 0:
+          return inertial->mass;
+        case 1:
+          return toQString(inertial->origin);
+        default:
+          return QString("ixx: %1 ixy: %2 ixz: %3 iyy: %4 iyz: %5 izz: %6")
+              .arg(inertial->ixx)
+              .arg(inertial->ixy)
+              .arg(inertial->ixz)
+              .arg(inertial->iyy)
+              .arg(inertial->iyz)
+              .arg(inertial->izz);
+      }
+    }
+    default:
+      return {};
+  }
+}
+
+QVariant SceneGraphModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+  if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+    return {};
+
+  return (section == NAME_COLUMN) ? QVariant("Name") : QVariant("Value");
+}
+
+Qt::ItemFlags SceneGraphModel::flags(const QModelIndex& index) const
+{
+  if (!index.isValid())
+    return Qt::NoItemFlags;
+
+  return Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+}
+
+SceneGraphModel::Node* SceneGraphModel::getNode(const QModelIndex& index) const
+{
+  if (!index.isValid())
+    return root_.get();
+
+  return static_cast<Node*>(index.internalPointer());
+}
+
+int SceneGraphModel::getChildCapacity(const Node& node) const
+{
+  switch (node.type)
+  {
+    case NodeType::ROOT:
+      return static_cast<int>(node.children.size());
+    case NodeType::LINKS:
+      return static_cast<int>(links_.size());
+    case NodeType::JOINTS:
+      return static_cast<int>(joints_.size());
+    case NodeType::LINK:
+      return static_cast<int>(getLinkGroups(*node.link).size());
+    case NodeType::JOINT:
+      return static_cast<int>(JOINT_PROPERTIES.size());
+    case NodeType::VISUALS:
+      return static_cast<int>(node.getOwner()->link->visual.size());
+    case NodeType::COLLISIONS:
+      return static_cast<int>(node.getOwner()->link->collision.size());
+    case NodeType::VISUAL:
+      return static_cast<int>(VISUAL_PROPERTIES.size());
+    case NodeType::COLLISION:
+      return static_cast<int>(COLLISION_PROPERTIES.size());
+    case NodeType::INERTIAL:
+      return static_cast<int>(INERTIAL_PROPERTIES.size());
+    default:
+      return 0;
+  }
+}
+
+void SceneGraphModel::appendChildren(Node& node, int count)
+{
+  const int first = static_cast<int>(node.children.size());
+  node.children.reserve(node.children.size() + static_cast<std::size_t>(count));
+
+  std::vector<NodeType> link_groups;
+  if (node.type == NodeType::LINK)
+    link_groups = getLinkGroups(*node.link);
+
+  for (int row = first; row < first + count; ++row)
+  {
+    const auto i = static_cast<std::size_t>(row);
+    std::unique_ptr<Node> child;
+    switch (node.type)
+    {
+      case NodeType::LINKS:
+        child = std::make_unique<Node>(NodeType::LINK, &node, row);
+        child->link = links_[i];
+        break;
+      case NodeType::JOINTS:
+        child = std::make_unique<Node>(NodeType::JOINT, &node, row);
+        child->joint = joints_[i];
+        break;
+      case NodeType::LINK:
+        child = std::make_unique<Node>(link_groups[i], &node, row);
+        break;
+      case NodeType::VISUALS:
+        child = std::make_unique<Node>(NodeType::VISUAL, &node, row);
+        child->element = row;
+        break;
+      case NodeType::COLLISIONS:
+        child = std::make_unique<Node>(NodeType::COLLISION, &node, row);
+        child->element = row;
+        break;
+      default:
+        child = std::make_unique<Node>(NodeType::PROPERTY, &node, row);
+        child->element = row;
+        break;
+    }
+    node.children.push_back(std::move(child));
+  }
+
+  node_count_ += static_cast<std::size_t>(count);
+}
+
+SceneGraphModel::Node& SceneGraphModel::getCategory(NodeType type)
+{
+  if (root_->children.empty())
+  {
+    beginInsertRows(QModelIndex(), 0, 1);
+    root_->children.push_back(std::make_unique<Node>(NodeType::LINKS, root_.get(), 0));
+    root_->children.push_back(std::make_unique<Node>(NodeType::JOINTS, root_.get(), 1));
+    node_count_ += 2;
+    endInsertRows();
+  }
+
+  return *root_->children[(type == NodeType::LINKS) ? 0 : 1];
+}
+
+void SceneGraphModel::emitSubtreeChanged(Node& node)
+{
+  if (node.children.empty())
+    return;
+
+  Node* first = node.children.front().get();
+  Node* last = node.children.back().get();
+  emit dataChanged(createIndex(first->row, 0, first), createIndex(last->row, COLUMN_COUNT - 1, last));
+
+  for (auto& child : node.children)
+    emitSubtreeChanged(*child);
+}
+
+template <typename T>
+void SceneGraphModel::insertElement(NodeType category_type,
+                                    std::vector<std::shared_ptr<const T>>& elements,
+                                    const std::shared_ptr<const T>& element)
+{
+  Node& category = getCategory(category_type);
+  const QModelIndex category_index = createIndex(category.row, 0, &category);
+  auto it = findByName(elements, element->getName());
+  const auto pos = static_cast<std::size_t>(std::distance(elements.begin(), it));
+
+  // Replace an existing element in place so the row keeps its expansion and selection
+  if (it != elements.end() && (*it)->getName() == element->getName())
+  {
+    *it = element;
+    if (pos >= category.children.size())
+      return;
+
+    Node& node = *category.children[pos];
+    node.setElement(element);
+    const QModelIndex index = createIndex(node.row, 0, &node);
+    emit dataChanged(index, createIndex(node.row, COLUMN_COUNT - 1, &node));
+
+    // The rows below a link depend on which visuals, collisions and inertial it has so they are rebuilt, the rows
+    // below a joint are a fixed set of properties
+    if (node.type == NodeType::LINK && !node.children.empty())
+    {
+      beginRemoveRows(index, 0, static_cast<int>(node.children.size()) - 1);
+      node_count_ -= node.getSubtreeSize() - 1;
+      node.children.clear();
+      endRemoveRows();
+
+      const int capacity = getChildCapacity(node);
+      if (capacity > 0)
+      {
+        beginInsertRows(index, 0, capacity - 1);
+        appendChildren(node, capacity);
+        endInsertRows();
+      }
+    }
+    else
+    {
+      emitSubtreeChanged(node);
+    }
+    return;
+  }
+
+  // Rows past the fetched range are picked up by the next fetchMore(), unless the category was already complete
+  const bool fully_fetched = (category.children.size() == elements.size());
+  if (pos < category.children.size() || fully_fetched)
+  {
+    beginInsertRows(category_index, static_cast<int>(pos), static_cast<int>(pos));
+    elements.insert(it, element);
+    auto node = std::make_unique<Node>(
+        (category_type == NodeType::LINKS) ? NodeType::LINK : NodeType::JOINT, &category, static_cast<int>(pos));
+    node->setElement(element);
+    category.children.insert(category.children.begin() + static_cast<std::ptrdiff_t>(pos), std::move(node));
+    category.renumberChildren(pos + 1);
+    ++node_count_;
+    endInsertRows();
+  }
+  else
+  {
+    elements.insert(it, element);
+  }
+
+  const QModelIndex count_index = createIndex(category.row, VALUE_COLUMN, &category);
+  emit dataChanged(count_index, count_index);
+}
+
+template <typename T>
+void SceneGraphModel::removeElement(NodeType category_type,
+                                    std::vector<std::shared_ptr<const T>>& elements,
+                                    const std::string& name)
+{
+  auto it = findByName(elements, name);
+  if (it == elements.end() || (*it)->getName() != name)
+    return;
+
+  Node& category = getCategory(category_type);
+  const auto pos = static_cast<std::size_t>(std::distance(elements.begin(), it));
+  if (pos < category.children.size())
+  {
+    beginRemoveRows(createIndex(category.row, 0, &category), static_cast<int>(pos), static_cast<int>(pos));
+    node_count_ -= category.children[pos]->getSubtreeSize();
+    category.children.erase(category.children.begin() + static_cast<std::ptrdiff_t>(pos));
+    elements.erase(it);
+    category.renumberChildren(pos);
+    endRemoveRows();
+  }
+  else
+  {
+    elements.erase(it);
+  }
+
+  const QModelIndex count_index = createIndex(category.row, VALUE_COLUMN, &category);
+  emit dataChanged(count_index, count_index);
+}
+
+}  // namespace tesseract_gui